@@ -29,7 +29,12 @@ public:
     Shutdown = 0x40,
   };
 
-  Request(RequestType type, IoUringSocket& socket) : type_(type), socket_(socket) {}
+  Request(RequestType type, IoUringSocket& socket) : type_(type), socket_(&socket) {}
+  /**
+   * Creates a request that does not belong to a socket, e.g. one for regular file I/O.
+   * socket() must not be called on such a request.
+   */
+  explicit Request(RequestType type) : type_(type) {}
   virtual ~Request() = default;
 
   /**
@@ -40,11 +45,11 @@ public:
   /**
    * Returns the io_uring socket the request belongs to.
    */
-  IoUringSocket& socket() const { return socket_; }
+  IoUringSocket& socket() const { return *socket_; }
 
 private:
   RequestType type_;
-  IoUringSocket& socket_;
+  IoUringSocket* socket_{};
 };
 
 /**
@@ -301,6 +301,14 @@ struct mmsghdr {
 };
 #endif
 
+// MSG_ZEROCOPY transmit with completions reported through the socket error queue. Only Linux
+// 4.14+ headers define the required constants.
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#define ENVOY_ZEROCOPY_SEND 1
+#else
+#define ENVOY_ZEROCOPY_SEND 0
+#endif
+
 // TODO: Remove once bazel supports NDKs > 21
 #define SUPPORTS_CPP_17_CONTIGUOUS_ITERATOR
 #ifdef __ANDROID_API__
@@ -125,6 +125,16 @@ public:
                    absl::get<InlinedStringVector>(buffer_).begin(), unary_op);
   }
 
+  /**
+   * Convert the ASCII upper case characters of the InlinedString to lower case. Only supported by
+   * the "Inline" InlinedString representation.
+   */
+  void inlineToLower() {
+    ASSERT(type() == Type::Inline);
+    InlinedStringVector& buffer = getInVec(buffer_);
+    StringUtil::toLowerInPlace(buffer.data(), buffer.size());
+  }
+
   /**
    * Trim trailing whitespaces from the InlinedString. Only supported by the "Inline" InlinedString
    * representation.
@@ -18,6 +18,8 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/hash.h"
 #include "source/common/common/macros.h"
+#include "source/common/common/utility.h"
+#include "source/common/http/character_set_validation.h"
 
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
@@ -30,19 +32,7 @@ namespace Http {
 static inline bool validHeaderString(absl::string_view s) {
   // If you modify this list of illegal embedded characters you will probably
   // want to change header_map_fuzz_impl_test at the same time.
-  for (const char c : s) {
-    switch (c) {
-    case '\0':
-      FALLTHRU;
-    case '\r':
-      FALLTHRU;
-    case '\n':
-      return false;
-    default:
-      continue;
-    }
-  }
-  return true;
+  return isValidHeaderString(s);
 }
 
 /**
@@ -86,7 +76,7 @@ public:
 
 private:
   void lower() {
-    std::transform(string_.begin(), string_.end(), string_.begin(), absl::ascii_tolower);
+    StringUtil::toLowerInPlace(string_.data(), string_.size());
   }
   bool valid() const { return validHeaderString(string_); }
 
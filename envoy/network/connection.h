@@ -6,6 +6,7 @@
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/common/optref.h"
 #include "envoy/common/pure.h"
 #include "envoy/common/scope_tracker.h"
 #include "envoy/event/deferred_deletable.h"
@@ -421,6 +422,14 @@ public:
    * return value is cwnd(in packets) times the connection's MSS.
    */
   virtual absl::optional<uint64_t> congestionWindowInBytes() const PURE;
+
+  /**
+   * @return the IoHandle of the underlying kernel socket if the connection is open, its transport
+   * socket hands bytes to and from the socket unmodified and nothing is buffered in the
+   * connection. A caller may then move payload directly on the descriptor (e.g. with splice(2))
+   * while the connection is read disabled. Returns an empty OptRef otherwise.
+   */
+  virtual OptRef<IoHandle> passthroughIoHandle() PURE;
 };
 
 using ConnectionPtr = std::unique_ptr<Connection>;
@@ -94,6 +94,12 @@ public:
    * @return uint32_t a multiple of the flush interval to perform stats eviction, or 0 if disabled.
    */
   virtual uint32_t evictOnFlush() const PURE;
+
+  /**
+   * @return uint32_t a multiple of the flush interval at which sinks accepting delta snapshots are
+   *         flushed all metrics, or 0 if delta snapshots are disabled.
+   */
+  virtual uint32_t fullFlushOnFlush() const PURE;
 };
 
 /**
@@ -10,6 +10,7 @@
 
 #include "envoy/common/pure.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/stats_matcher.h"
 #include "envoy/stats/tag.h"
 
 #include "absl/strings/string_view.h"
@@ -99,6 +100,25 @@ public:
    */
   virtual void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) PURE;
 
+  /**
+   * Shard counters created from now on whose names are not rejected by the matcher. A sharded
+   * counter keeps one cache line per shard, each incremented by the one thread bound to it, so
+   * that threads incrementing it do not contend on a shared atomic; reads and latches sum the
+   * shards. Each sharded counter takes num_shards + 1 cache lines, so the matcher should be narrow.
+   * @param num_shards the number of shards; unbound threads and threads bound beyond the shards
+   *        share one atomic. Zero disables sharding.
+   * @param matcher selects the counters to shard.
+   */
+  virtual void setCounterSharding(uint32_t num_shards, StatsMatcherPtr&& matcher) PURE;
+
+  /**
+   * Makes stats created from now on share their tag-extracted names and tag names with other stats
+   * of the same shape, e.g. the same stat of each cluster, keeping only their own names and tag
+   * values. This reduces the memory taken by each stat.
+   * @param compact whether to share names.
+   */
+  virtual void setCompactNames(bool compact) PURE;
+
   // TODO(jmarantz): create a parallel mechanism to instantiate histograms. At
   // the moment, histograms don't fit the same pattern of counters and gauges
   // as they are not actually created in the context of a stats allocator.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -192,6 +193,20 @@ public:
    *         the number of detailed buckets.
    */
   virtual std::vector<Bucket> detailedIntervalBuckets() const PURE;
+
+  using BucketFn = std::function<void(const Bucket& bucket)>;
+
+  /**
+   * Calls fn for each bucket that detailedTotalBuckets() would return, without materializing
+   * the vector.
+   */
+  virtual void forEachDetailedTotalBucket(const BucketFn& fn) const PURE;
+
+  /**
+   * Calls fn for each bucket that detailedIntervalBuckets() would return, without materializing
+   * the vector.
+   */
+  virtual void forEachDetailedIntervalBucket(const BucketFn& fn) const PURE;
 };
 
 using ParentHistogramSharedPtr = RefcountPtr<ParentHistogram>;
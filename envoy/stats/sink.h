@@ -107,6 +107,14 @@ public:
    * @param value the value of the sample.
    */
   virtual void onHistogramComplete(const Histogram& histogram, uint64_t value) PURE;
+
+  /**
+   * @return true if the sink can be flushed a snapshot holding only the metrics that changed since
+   *         the previous flush. Such a sink must not rely on every metric being present in each
+   *         snapshot. Delta snapshots are only used if enabled in the bootstrap by
+   *         stats_full_flush_interval, which also sets how often the sink is flushed all metrics.
+   */
+  virtual bool acceptsDeltaSnapshots() const { return false; }
 };
 
 using SinkPtr = std::unique_ptr<Sink>;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -113,6 +114,7 @@ public:
     static constexpr uint8_t LogicAccumulate = 0x02;
     static constexpr uint8_t NeverImport = 0x04;
     static constexpr uint8_t Hidden = 0x08;
+    static constexpr uint8_t Changed = 0x10;
   };
   virtual SymbolTable& symbolTable() PURE;
   virtual const SymbolTable& constSymbolTable() const PURE;
@@ -176,6 +178,14 @@ public:
    */
   virtual void setParentValue(uint64_t parent_value) PURE;
 
+  /**
+   * Returns whether the value has been updated since the previous call, and clears that state.
+   * This is used to build metric snapshots holding only the metrics that changed.
+   *
+   * @return true if the gauge has been updated since latchChanged() was last called.
+   */
+  virtual bool latchChanged() PURE;
+
   /**
    * @return the import mode, dictating behavior of the gauge across hot restarts.
    */
@@ -232,6 +242,12 @@ using SizeFn = std::function<void(std::size_t)>;
  */
 template <typename Stat> using StatFn = std::function<void(Stat&)>;
 
+/**
+ * Callback invoked with the prefix, which may be empty, and the name of a stat in a block of
+ * deferred stats.
+ */
+using DeferredStatNameFn = std::function<void(StatName prefix, StatName name)>;
+
 /**
  * Interface for stats lazy initialization.
  * To save memory and CPU consumption on blocks of stats that are never referenced throughout the
@@ -259,6 +275,17 @@ public:
    */
   virtual bool isPresent() const PURE;
 
+  /**
+   * If the underlying stats have not been initialized yet, calls the functions with the prefix
+   * and name of each counter and gauge they would create, relative to their scope. This allows
+   * stats which are not created yet to be reported, e.g. as zero in admin output.
+   *
+   * @param counter_fn called for each counter.
+   * @param gauge_fn called for each gauge.
+   */
+  virtual void forEachUncreatedStatName(const DeferredStatNameFn& counter_fn,
+                                        const DeferredStatNameFn& gauge_fn) const PURE;
+
   virtual ~DeferredCreationCompatibleInterface() = default;
 };
 
@@ -282,6 +309,14 @@ public:
    */
   bool isPresent() const { return data_->isPresent(); }
 
+  /**
+   * @see DeferredCreationCompatibleInterface::forEachUncreatedStatName().
+   */
+  void forEachUncreatedStatName(const DeferredStatNameFn& counter_fn,
+                                const DeferredStatNameFn& gauge_fn) const {
+    data_->forEachUncreatedStatName(counter_fn, gauge_fn);
+  }
+
 private:
   std::unique_ptr<DeferredCreationCompatibleInterface<StatsStructType>> data_;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include "envoy/stats/histogram.h"
@@ -132,6 +133,11 @@ static inline std::string statPrefixJoin(absl::string_view prefix, absl::string_
 #define MAKE_STATS_STRUCT_STATNAME_HELPER_(name)
 #define GENERATE_STATNAME_STRUCT(name)
 
+// Used for enumerating the counter and gauge names of a stats structure.
+#define MAKE_STATS_STRUCT_COUNTER_NAME_HELPER_(NAME) counter_fn(stat_names.NAME##_);
+#define MAKE_STATS_STRUCT_GAUGE_NAME_HELPER_(NAME, MODE) gauge_fn(stat_names.NAME##_);
+#define MAKE_STATS_STRUCT_HISTOGRAM_NAME_HELPER_(NAME, UNIT)
+
 /**
  * Generates a struct with StatNames for a subsystem, based on the stats macro
  * with COUNTER, GAUGE, HISTOGRAM, TEXT_READOUT, and STATNAME calls. The
@@ -154,7 +160,9 @@ static inline std::string statPrefixJoin(absl::string_view prefix, absl::string_
  * also stored in the structure, for two reasons: (a) as a syntactic convenience
  * for using macros to generate the comma separators for the initializer and (b)
  * as a convenience at the call-site to access STATNAME-declared names from the
- * stats structure.
+ * stats structure. The static forEachCounterAndGaugeName() lists the names of the
+ * counters and gauges in the structure without instantiating them, e.g. to report
+ * a deferred block of stats before it is created.
  */
 #define MAKE_STATS_STRUCT(StatsStruct, StatNamesStruct, ALL_STATS)                                 \
   struct StatsStruct {                                                                             \
@@ -168,6 +176,14 @@ static inline std::string statPrefixJoin(absl::string_view prefix, absl::string_
                         MAKE_STATS_STRUCT_HISTOGRAM_HELPER_,                                       \
                         MAKE_STATS_STRUCT_TEXT_READOUT_HELPER_,                                    \
                         MAKE_STATS_STRUCT_STATNAME_HELPER_) {}                                     \
+    static void forEachCounterAndGaugeName(                                                        \
+        [[maybe_unused]] const StatNamesStruct& stat_names,                                        \
+        [[maybe_unused]] const std::function<void(Envoy::Stats::StatName)>& counter_fn,            \
+        [[maybe_unused]] const std::function<void(Envoy::Stats::StatName)>& gauge_fn) {            \
+      ALL_STATS(MAKE_STATS_STRUCT_COUNTER_NAME_HELPER_, MAKE_STATS_STRUCT_GAUGE_NAME_HELPER_,      \
+                MAKE_STATS_STRUCT_HISTOGRAM_NAME_HELPER_, MAKE_STATS_STRUCT_STATNAME_HELPER_,      \
+                MAKE_STATS_STRUCT_STATNAME_HELPER_)                                                \
+    }                                                                                              \
     const StatNameType& stat_names_;                                                               \
     ALL_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT,           \
               GENERATE_TEXT_READOUT_STRUCT, GENERATE_STATNAME_STRUCT)                              \
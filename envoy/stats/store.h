@@ -18,6 +18,10 @@ namespace Event {
 class Dispatcher;
 }
 
+namespace Thread {
+class ThreadFactory;
+}
+
 namespace ThreadLocal {
 class Instance;
 }
@@ -264,6 +268,31 @@ public:
    */
   virtual void mergeHistograms(PostMergeCb merge_complete_cb) PURE;
 
+  /**
+   * Spreads the merge of the histograms, which otherwise runs on the main thread alone, over
+   * num_threads additional threads. The main thread waits for them to finish, so the merged
+   * histograms are still only read on the main thread.
+   * @param thread_factory used to create the threads.
+   * @param num_threads the number of additional threads; 0 merges on the main thread alone.
+   */
+  virtual void setHistogramMergeThreads(Thread::ThreadFactory& thread_factory,
+                                        uint32_t num_threads) PURE;
+
+  /**
+   * Shards the counters created from now on which the matcher does not reject, so that threads
+   * incrementing them each write to their own cache line. See Allocator::setCounterSharding.
+   * @param num_shards the number of shards of each sharded counter; 0 disables sharding.
+   * @param matcher selects the counters to shard.
+   */
+  virtual void setCounterSharding(uint32_t num_shards, StatsMatcherPtr&& matcher) PURE;
+
+  /**
+   * Makes stats created from now on share the names they have in common with other stats of the
+   * same shape. See Allocator::setCompactNames.
+   * @param compact whether to share names.
+   */
+  virtual void setCompactNames(bool compact) PURE;
+
   /**
    * Set predicates for filtering stats to be flushed to sinks.
    * Note that if the sink predicates object is set, we do not send non-sink stats over to the
@@ -761,6 +761,17 @@ public:
   COUNTER(upstream_rq_dropped)                                                                     \
   COUNTER(upstream_rq_drop_overload)
 
+/**
+ * Cluster circuit breakers gauges tracking whether each circuit breaker is open. These are only set
+ * to non-zero when a circuit breaker opens, so they can be created on first use.
+ */
+#define ALL_CLUSTER_CIRCUIT_BREAKERS_OPEN_STATS(COUNTER, GAUGE, HISTOGRAM, TEXT_READOUT, STATNAME) \
+  GAUGE(cx_open, Accumulate)                                                                       \
+  GAUGE(cx_pool_open, Accumulate)                                                                  \
+  GAUGE(rq_open, Accumulate)                                                                       \
+  GAUGE(rq_pending_open, Accumulate)                                                               \
+  GAUGE(rq_retry_open, Accumulate)
+
 /**
  * Cluster circuit breakers gauges. Note that we do not generate a stats
  * structure from this macro. This is because depending on flags, we want to use
@@ -771,11 +782,7 @@ public:
  * the circuit breaker names, depending on priority settings.
  */
 #define ALL_CLUSTER_CIRCUIT_BREAKERS_STATS(COUNTER, GAUGE, HISTOGRAM, TEXT_READOUT, STATNAME)      \
-  GAUGE(cx_open, Accumulate)                                                                       \
-  GAUGE(cx_pool_open, Accumulate)                                                                  \
-  GAUGE(rq_open, Accumulate)                                                                       \
-  GAUGE(rq_pending_open, Accumulate)                                                               \
-  GAUGE(rq_retry_open, Accumulate)                                                                 \
+  ALL_CLUSTER_CIRCUIT_BREAKERS_OPEN_STATS(COUNTER, GAUGE, HISTOGRAM, TEXT_READOUT, STATNAME)       \
   GAUGE(remaining_cx, Accumulate)                                                                  \
   GAUGE(remaining_cx_pools, Accumulate)                                                            \
   GAUGE(remaining_pending, Accumulate)                                                             \
@@ -809,18 +816,24 @@ public:
 MAKE_STAT_NAMES_STRUCT(ClusterConfigUpdateStatNames, ALL_CLUSTER_CONFIG_UPDATE_STATS);
 MAKE_STATS_STRUCT(ClusterConfigUpdateStats, ClusterConfigUpdateStatNames,
                   ALL_CLUSTER_CONFIG_UPDATE_STATS);
+using DeferredCreationCompatibleClusterConfigUpdateStats =
+    Stats::DeferredCreationCompatibleStats<ClusterConfigUpdateStats>;
 
 /**
  * Struct definition for cluster endpoint related stats. @see stats_macros.h
  */
 MAKE_STAT_NAMES_STRUCT(ClusterEndpointStatNames, ALL_CLUSTER_ENDPOINT_STATS);
 MAKE_STATS_STRUCT(ClusterEndpointStats, ClusterEndpointStatNames, ALL_CLUSTER_ENDPOINT_STATS);
+using DeferredCreationCompatibleClusterEndpointStats =
+    Stats::DeferredCreationCompatibleStats<ClusterEndpointStats>;
 
 /**
  * Struct definition for cluster load balancing stats. @see stats_macros.h
  */
 MAKE_STAT_NAMES_STRUCT(ClusterLbStatNames, ALL_CLUSTER_LB_STATS);
 MAKE_STATS_STRUCT(ClusterLbStats, ClusterLbStatNames, ALL_CLUSTER_LB_STATS);
+using DeferredCreationCompatibleClusterLbStats =
+    Stats::DeferredCreationCompatibleStats<ClusterLbStats>;
 
 /**
  * Struct definition for all cluster traffic stats. @see stats_macros.h
@@ -836,8 +849,12 @@ MAKE_STATS_STRUCT(ClusterLoadReportStats, ClusterLoadReportStatNames,
 
 // We can't use macros to make the Stats class for circuit breakers due to
 // the conditional inclusion of 'remaining' gauges. But we do auto-generate
-// the StatNames struct.
+// the StatNames struct, and the struct of 'open' gauges.
 MAKE_STAT_NAMES_STRUCT(ClusterCircuitBreakersStatNames, ALL_CLUSTER_CIRCUIT_BREAKERS_STATS);
+MAKE_STATS_STRUCT(ClusterCircuitBreakersOpenStats, ClusterCircuitBreakersStatNames,
+                  ALL_CLUSTER_CIRCUIT_BREAKERS_OPEN_STATS);
+using DeferredCreationCompatibleClusterCircuitBreakersOpenStats =
+    Stats::DeferredCreationCompatibleStats<ClusterCircuitBreakersOpenStats>;
 
 MAKE_STAT_NAMES_STRUCT(ClusterRequestResponseSizeStatNames,
                        ALL_CLUSTER_REQUEST_RESPONSE_SIZE_STATS);
@@ -849,10 +866,16 @@ MAKE_STATS_STRUCT(ClusterTimeoutBudgetStats, ClusterTimeoutBudgetStatNames,
                   ALL_CLUSTER_TIMEOUT_BUDGET_STATS);
 
 /**
- * Struct definition for cluster circuit breakers stats. @see stats_macros.h
+ * Struct definition for cluster circuit breakers stats. The "open" gauges may be deferred; the
+ * "remaining" gauges are null gauges unless they are tracked. @see stats_macros.h
  */
 struct ClusterCircuitBreakersStats {
-  ALL_CLUSTER_CIRCUIT_BREAKERS_STATS(c, GENERATE_GAUGE_STRUCT, h, tr, GENERATE_STATNAME_STRUCT)
+  DeferredCreationCompatibleClusterCircuitBreakersOpenStats open_stats_;
+  Stats::Gauge& remaining_cx_;
+  Stats::Gauge& remaining_cx_pools_;
+  Stats::Gauge& remaining_pending_;
+  Stats::Gauge& remaining_retries_;
+  Stats::Gauge& remaining_rq_;
 };
 
 using ClusterRequestResponseSizeStatsPtr = std::unique_ptr<ClusterRequestResponseSizeStats>;
@@ -1082,24 +1105,40 @@ public:
   virtual TransportSocketMatcher& transportSocketMatcher() const PURE;
 
   /**
-   * @return ClusterConfigUpdateStats& config update stats for this cluster.
+   * @return config update stats for this cluster.
+   */
+  virtual DeferredCreationCompatibleClusterConfigUpdateStats& configUpdateStats() const PURE;
+
+  /**
+   * @return the warming_state gauge of the config update stats. Every cluster warms, so this
+   *         gauge is created eagerly even when the rest of configUpdateStats() is deferred.
    */
-  virtual ClusterConfigUpdateStats& configUpdateStats() const PURE;
+  virtual Stats::Gauge& warmingState() const PURE;
 
   /**
-   * @return ClusterLbStats& load-balancer-related stats for this cluster.
+   * @return load-balancer-related stats for this cluster.
    */
-  virtual ClusterLbStats& lbStats() const PURE;
+  virtual DeferredCreationCompatibleClusterLbStats& lbStats() const PURE;
 
   /**
-   * @return ClusterEndpointStats& endpoint related stats for this cluster.
+   * @return endpoint related stats for this cluster.
    */
-  virtual ClusterEndpointStats& endpointStats() const PURE;
+  virtual DeferredCreationCompatibleClusterEndpointStats& endpointStats() const PURE;
 
   /**
    * @return  all traffic related stats for this cluster.
    */
   virtual DeferredCreationCompatibleClusterTrafficStats& trafficStats() const PURE;
+
+  /**
+   * Calls the functions with the prefix and name, relative to statsScope(), of each counter and
+   * gauge of this cluster which has been deferred and not created yet. Admin reports these as
+   * zero.
+   * @param counter_fn called for each counter.
+   * @param gauge_fn called for each gauge.
+   */
+  virtual void forEachUncreatedStat(const Stats::DeferredStatNameFn& counter_fn,
+                                    const Stats::DeferredStatNameFn& gauge_fn) const PURE;
   /**
    * @return the stats scope that contains all cluster stats. This can be used to produce dynamic
    *         stats that will be freed when the cluster is removed.
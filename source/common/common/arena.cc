@@ -0,0 +1,45 @@
+#include "source/common/common/arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+
+Arena::Arena(uint64_t initial_block_size) : next_block_size_(initial_block_size) {
+  if (initial_block_size > 0) {
+    addBlock(initial_block_size);
+  }
+}
+
+Arena::~Arena() {
+  while (blocks_ != nullptr) {
+    Block* next = blocks_->next_;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+}
+
+void* Arena::allocateFromNewBlock(size_t size, size_t alignment) {
+  ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+  if (blocks_ != nullptr) {
+    ++overflow_blocks_;
+  }
+  // Each further block is twice the size of the previous one, so that a stream which outgrows
+  // its initial block needs few more allocations.
+  addBlock(std::max(next_block_size_, size + alignment));
+  return allocate(size, alignment);
+}
+
+void Arena::addBlock(size_t size) {
+  Block* block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+  block->next_ = blocks_;
+  block->size_ = size;
+  blocks_ = block;
+  current_ = block->data();
+  end_ = current_ + size;
+  next_block_size_ = std::max<size_t>(size * 2, next_block_size_);
+}
+
+} // namespace Envoy
@@ -146,6 +146,7 @@ public:
   const std::string& stringRepresentation() const { return suffix_; }
 
 private:
+  friend class StringMatcherImpl;
   const std::string suffix_;
   const bool ignore_case_;
 };
@@ -171,6 +172,7 @@ public:
   const std::string& stringRepresentation() const { return regex_->pattern(); }
 
 private:
+  friend class StringMatcherImpl;
   Regex::CompiledMatcherPtr regex_;
 };
 
@@ -274,6 +276,41 @@ public:
     return false;
   }
 
+  /**
+   * Helps applications optimize the case where a matcher is a case-sensitive
+   * suffix-match.
+   *
+   * @param suffix the returned suffix string
+   * @return true if the matcher is a case-sensitive suffix-match.
+   */
+  bool getCaseSensitiveSuffixMatch(std::string& suffix) const {
+    if (const SuffixStringMatcher* suffix_matcher = absl::get_if<SuffixStringMatcher>(&matcher_)) {
+      if (!suffix_matcher->ignore_case_) {
+        suffix = suffix_matcher->suffix_;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Helps applications combine regex matches that are evaluated by the Google
+   * RE2 engine, e.g. into a single re2::RE2::Set.
+   *
+   * @param pattern the returned regex pattern, which must fully match
+   * @return true if the matcher is a safe_regex compiled with the Google RE2 engine.
+   */
+  bool getGoogleReRegex(std::string& pattern) const {
+    if (const RegexStringMatcher* regex_matcher = absl::get_if<RegexStringMatcher>(&matcher_)) {
+      if (dynamic_cast<const Regex::CompiledGoogleReMatcher*>(regex_matcher->regex_.get()) !=
+          nullptr) {
+        pattern = regex_matcher->regex_->pattern();
+        return true;
+      }
+    }
+    return false;
+  }
+
   /**
    * Returns a string representation of the matcher (the contents to be
    * matched).
@@ -27,6 +27,10 @@
 #include "re2/re2.h"
 #include "spdlog/spdlog.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace Envoy {
 
 namespace {
@@ -659,6 +663,25 @@ std::string StringUtil::toUpper(absl::string_view s) {
   return upper_s;
 }
 
+void StringUtil::toLowerInPlace(char* data, size_t size) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i before_upper_a = _mm_set1_epi8('A' - 1);
+  const __m128i after_upper_z = _mm_set1_epi8('Z' + 1);
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  for (; i + 16 <= size; i += 16) {
+    __m128i* block = reinterpret_cast<__m128i*>(data + i);
+    const __m128i v = _mm_loadu_si128(block);
+    const __m128i upper =
+        _mm_and_si128(_mm_cmpgt_epi8(v, before_upper_a), _mm_cmplt_epi8(v, after_upper_z));
+    _mm_storeu_si128(block, _mm_or_si128(v, _mm_and_si128(upper, case_bit)));
+  }
+#endif
+  for (; i < size; ++i) {
+    data[i] = absl::ascii_tolower(data[i]);
+  }
+}
+
 bool StringUtil::CaseInsensitiveCompare::operator()(absl::string_view lhs,
                                                     absl::string_view rhs) const {
   return absl::EqualsIgnoreCase(lhs, rhs);
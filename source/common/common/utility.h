@@ -513,6 +513,14 @@ public:
    */
   static std::string toUpper(absl::string_view s);
 
+  /**
+   * Convert the ASCII upper case characters of a buffer to lower case, in place. Uses SSE2 where
+   * available, which makes a difference for the header names lowered on every request.
+   * @param data the start of the buffer.
+   * @param size the size of the buffer.
+   */
+  static void toLowerInPlace(char* data, size_t size);
+
   /**
    * Removes all the character indices from str contained in the interval-set.
    * @param str the string containing the characters to be removed.
@@ -3,6 +3,12 @@
 #include <array>
 #include <cstdint>
 
+#include "absl/strings/string_view.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 // A set of tables for validating that a character is in a specific
 // character set. Used to validate RFC compliance for various HTTP protocol elements.
 
@@ -72,5 +78,106 @@ inline constexpr std::array<uint32_t, 8> kUriQueryAndFragmentCharTable = {
     0b00000000000000000000000000000000,
 };
 
+// The validators below check a whole string. Where SSE2 is available, which includes every x86-64
+// target, they check 16 bytes per iteration and only look at single characters for the remainder.
+// Other targets use the scalar loops.
+
+// Returns true if `value` is a valid header value according to RFC 9110, allowing obs-text:
+// HTAB, SP, VCHAR and bytes 0x80-0xFF. This matches the HTTP/2 codec's validation.
+inline bool isValidHeaderValue(absl::string_view value) {
+  const char* data = value.data();
+  const size_t size = value.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i space = _mm_set1_epi8(0x20);
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i del = _mm_set1_epi8(0x7f);
+  for (; i + 16 <= size; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    // Bytes 0x80-0xFF compare as negative, so excluding them leaves the control characters.
+    __m128i invalid = _mm_andnot_si128(_mm_cmplt_epi8(v, zero), _mm_cmplt_epi8(v, space));
+    invalid = _mm_andnot_si128(_mm_cmpeq_epi8(v, tab), invalid);
+    invalid = _mm_or_si128(invalid, _mm_cmpeq_epi8(v, del));
+    if (_mm_movemask_epi8(invalid) != 0) {
+      return false;
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    const uint8_t c = static_cast<uint8_t>(data[i]);
+    if ((c < 0x20 && c != '\t') || c == 0x7f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if `name` only contains characters from kGenericHeaderNameCharTable.
+inline bool isValidHeaderName(absl::string_view name) {
+  const char* data = name.data();
+  const size_t size = name.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  // Blocks of letters, digits, '-' and '_', which make up nearly all header names, are accepted
+  // without table lookups. The first block with any other character is checked with the table.
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  const __m128i before_a = _mm_set1_epi8('a' - 1);
+  const __m128i after_z = _mm_set1_epi8('z' + 1);
+  const __m128i before_0 = _mm_set1_epi8('0' - 1);
+  const __m128i after_9 = _mm_set1_epi8('9' + 1);
+  const __m128i dash = _mm_set1_epi8('-');
+  const __m128i underscore = _mm_set1_epi8('_');
+  for (; i + 16 <= size; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    // Setting the case bit maps exactly the upper case letters onto the lower case ones.
+    const __m128i folded = _mm_or_si128(v, case_bit);
+    __m128i common =
+        _mm_and_si128(_mm_cmpgt_epi8(folded, before_a), _mm_cmplt_epi8(folded, after_z));
+    common = _mm_or_si128(
+        common, _mm_and_si128(_mm_cmpgt_epi8(v, before_0), _mm_cmplt_epi8(v, after_9)));
+    common = _mm_or_si128(common, _mm_cmpeq_epi8(v, dash));
+    common = _mm_or_si128(common, _mm_cmpeq_epi8(v, underscore));
+    if (_mm_movemask_epi8(common) != 0xffff) {
+      break;
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    if (!testCharInTable(kGenericHeaderNameCharTable, data[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if `s` does not contain NUL, CR or LF, which must never appear in a header key or
+// value.
+inline bool isValidHeaderString(absl::string_view s) {
+  const char* data = s.data();
+  const size_t size = s.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i nul = _mm_setzero_si128();
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i lf = _mm_set1_epi8('\n');
+  for (; i + 16 <= size; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i invalid = _mm_or_si128(
+        _mm_cmpeq_epi8(v, nul), _mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf)));
+    if (_mm_movemask_epi8(invalid) != 0) {
+      return false;
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    const char c = data[i];
+    if (c == '\0' || c == '\r' || c == '\n') {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace Http
 } // namespace Envoy
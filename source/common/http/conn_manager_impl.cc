@@ -861,6 +861,11 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
          "set in "
          "ConnectionManagerImpl.");
 
+  if (const uint32_t arena_bytes = connection_manager_.config_->perStreamArenaBytes();
+      arena_bytes > 0) {
+    filter_manager_.enableArena(arena_bytes);
+  }
+
   filter_manager_.streamInfo().setStreamIdProvider(
       std::make_shared<HttpStreamIdProviderImpl>(*this));
 
@@ -964,6 +969,13 @@ void ConnectionManagerImpl::ActiveStream::completeRequest() {
   filter_manager_.streamInfo().onRequestComplete();
 
   connection_manager_.stats_.named_.downstream_rq_active_.dec();
+  if (OptRef<const Arena> arena = filter_manager_.arena(); arena.has_value()) {
+    connection_manager_.stats_.named_.downstream_rq_arena_bytes_.recordValue(
+        arena->bytesAllocated());
+    if (arena->overflowBlocks() > 0) {
+      connection_manager_.stats_.named_.downstream_rq_arena_overflow_.inc();
+    }
+  }
   if (filter_manager_.streamInfo().healthCheck()) {
     connection_manager_.config_->tracingStats().health_check_.inc();
   }
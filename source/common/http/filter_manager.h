@@ -14,6 +14,7 @@
 #include "envoy/protobuf/message_validator.h"
 
 #include "source/common/buffer/watermark_buffer.h"
+#include "source/common/common/arena.h"
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
@@ -37,8 +38,8 @@ class DownstreamFilterManager;
 struct ActiveStreamFilterBase;
 struct ActiveStreamDecoderFilter;
 struct ActiveStreamEncoderFilter;
-using ActiveStreamDecoderFilterPtr = std::unique_ptr<ActiveStreamDecoderFilter>;
-using ActiveStreamEncoderFilterPtr = std::unique_ptr<ActiveStreamEncoderFilter>;
+using ActiveStreamDecoderFilterPtr = ArenaPtr<ActiveStreamDecoderFilter>;
+using ActiveStreamEncoderFilterPtr = ArenaPtr<ActiveStreamEncoderFilter>;
 
 constexpr absl::string_view LocalReplyFilterStateKey =
     "envoy.filters.network.http_connection_manager.local_reply_owner";
@@ -897,6 +898,34 @@ public:
   uint64_t streamId() const { return stream_id_; }
   Buffer::BufferMemoryAccountSharedPtr account() const { return account_; }
 
+  /**
+   * @return the arena bytes taken by the wrappers of one filter which is both a decoder and an
+   *         encoder filter. Only the filter wrappers are created in the arena, so this times the
+   *         number of filters bounds the useful size of its initial block.
+   */
+  static constexpr uint64_t arenaBytesPerFilter() {
+    return sizeof(ActiveStreamDecoderFilter) + alignof(ActiveStreamDecoderFilter) +
+           sizeof(ActiveStreamEncoderFilter) + alignof(ActiveStreamEncoderFilter);
+  }
+
+  /**
+   * Creates the filter wrappers of the filter chain in an arena that is freed with the filter
+   * manager. Must be called before the filter chain is created.
+   * @param initial_block_size the bytes allocated up front for the arena; see
+   *        arenaBytesPerFilter() for sizing it.
+   */
+  void enableArena(uint64_t initial_block_size) {
+    ASSERT(decoder_filters_.entries_.empty() && encoder_filters_.entries_.empty());
+    arena_.emplace(initial_block_size);
+  }
+
+  /**
+   * @return the arena of the stream, if enabled.
+   */
+  OptRef<const Arena> arena() const {
+    return arena_.has_value() ? makeOptRef<const Arena>(*arena_) : absl::nullopt;
+  }
+
   Buffer::InstancePtr& bufferedRequestData() { return buffered_request_data_; }
 
   void contextOnContinue(ScopeTrackedObjectStack& tracked_object_stack);
@@ -985,24 +1014,24 @@ private:
     void addStreamDecoderFilter(Http::StreamDecoderFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
-      manager_.decoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamDecoderFilter>(manager_, std::move(filter), context_));
+      manager_.decoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamDecoderFilter>(
+          manager_.arenaOrNull(), manager_, std::move(filter), context_));
     }
 
     void addStreamEncoderFilter(Http::StreamEncoderFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
-      manager_.encoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamEncoderFilter>(manager_, std::move(filter), context_));
+      manager_.encoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamEncoderFilter>(
+          manager_.arenaOrNull(), manager_, std::move(filter), context_));
     }
 
     void addStreamFilter(Http::StreamFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
-      manager_.decoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamDecoderFilter>(manager_, filter, context_));
-      manager_.encoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamEncoderFilter>(manager_, std::move(filter), context_));
+      manager_.decoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamDecoderFilter>(
+          manager_.arenaOrNull(), manager_, filter, context_));
+      manager_.encoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamEncoderFilter>(
+          manager_.arenaOrNull(), manager_, std::move(filter), context_));
     }
 
     void addAccessLogHandler(AccessLog::InstanceSharedPtr handler) override {
@@ -1094,6 +1123,8 @@ private:
 
   bool isTerminalDecoderFilter(const ActiveStreamDecoderFilter& filter) const;
 
+  Arena* arenaOrNull() { return arena_.has_value() ? &arena_.value() : nullptr; }
+
   FilterManagerCallbacks& filter_manager_callbacks_;
   Event::Dispatcher& dispatcher_;
   // This is unset if there is no downstream connection, e.g. for health check or
@@ -1103,6 +1134,8 @@ private:
   Buffer::BufferMemoryAccountSharedPtr account_;
   const bool proxy_100_continue_;
 
+  // Declared before the filters so that it outlives the objects created in it.
+  absl::optional<Arena> arena_;
   StreamDecoderFilters decoder_filters_;
   StreamEncoderFilters encoder_filters_;
   std::vector<StreamFilterBase*> filters_;
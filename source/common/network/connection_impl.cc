@@ -958,6 +958,19 @@ absl::optional<uint64_t> ConnectionImpl::congestionWindowInBytes() const {
   return socket_->congestionWindowInBytes();
 }
 
+OptRef<IoHandle> ConnectionImpl::passthroughIoHandle() {
+  // Only a raw_buffer transport leaves the byte stream untouched, and only a kernel socket has a
+  // descriptor that can be handed to splice(2). Anything still buffered here must go out through
+  // the regular path first so that bytes are not reordered.
+  if (state() != State::Open || connecting_ || read_end_stream_ || write_end_stream_ ||
+      read_buffer_->length() > 0 || write_buffer_->length() > 0 ||
+      socket_->addressType() != Address::Type::Ip ||
+      dynamic_cast<RawBufferSocket*>(transport_socket_.get()) == nullptr) {
+    return {};
+  }
+  return ioHandle();
+}
+
 void ConnectionImpl::flushWriteBuffer() {
   if (state() == State::Open && write_buffer_->length() > 0) {
     onWriteReady();
@@ -15,6 +15,16 @@
 #include "absl/container/fixed_array.h"
 #include "absl/types/optional.h"
 
+#if ENVOY_ZEROCOPY_SEND
+#include <linux/errqueue.h>
+
+#include <list>
+
+#include "source/common/common/thread_impl.h"
+
+#include "absl/synchronization/mutex.h"
+#endif
+
 using Envoy::Api::SysCallIntResult;
 using Envoy::Api::SysCallSizeResult;
 
@@ -53,6 +63,109 @@ constexpr int messageTruncatedOption() {
 
 namespace Network {
 
+#if ENVOY_ZEROCOPY_SEND
+// Owns sockets that were closed while zero-copy sends were still in flight. The kernel transmits
+// (and retransmits) straight from the pinned user pages and only reports completion through the
+// error queue of the open socket, so both the fd and the pinned data are kept until every send
+// has completed, or until the socket's linger timeout expires. The reaping thread only runs while
+// there are lingering sockets.
+class ZerocopyLinger {
+public:
+  static ZerocopyLinger& get() { MUTABLE_CONSTRUCT_ON_FIRST_USE(ZerocopyLinger); }
+
+  void add(os_fd_t fd, std::deque<IoSocketHandleImpl::ZerocopyPendingSend>&& pending,
+           const ZerocopySendConfig& config) {
+    // Round up so that a non-zero timeout always gets at least one reap.
+    const uint64_t reaps_left =
+        (config.linger_timeout_.count() + ReapInterval.count() - 1) / ReapInterval.count();
+    {
+      absl::MutexLock lock(&mutex_);
+      if (reaps_left > 0 && num_sockets_ < config.max_lingering_sockets_) {
+        ++num_sockets_;
+        sockets_.push_back({fd, std::move(pending), reaps_left});
+        if (!running_) {
+          if (thread_ != nullptr) {
+            // The previous thread stopped touching any state once it cleared running_.
+            thread_->join();
+          }
+          running_ = true;
+          thread_ = thread_factory_->createThread([this]() { reapLoop(); },
+                                                  Thread::Options{"zerocopy_linger"});
+        }
+        return;
+      }
+    }
+    // The caller releases the pinned data once the socket is reset.
+    ENVOY_LOG_MISC(debug, "resetting fd {} with {} zero-copy sends in flight", fd,
+                   pending.size());
+    reset(fd);
+  }
+
+private:
+  struct LingeringSocket {
+    os_fd_t fd_;
+    std::deque<IoSocketHandleImpl::ZerocopyPendingSend> pending_;
+    uint64_t reaps_left_;
+  };
+
+  // Closes `fd` with a reset, which makes the kernel drop the data it has yet to (re)transmit so
+  // that the pinned data can be released.
+  static void reset(os_fd_t fd) {
+    auto& os_syscalls = Api::OsSysCallsSingleton::get();
+    const linger no_linger{/*l_onoff=*/1, /*l_linger=*/0};
+    os_syscalls.setsockopt(fd, SOL_SOCKET, SO_LINGER, &no_linger, sizeof(no_linger));
+    os_syscalls.close(fd);
+  }
+
+  void reapLoop() {
+    while (true) {
+      absl::SleepFor(absl::FromChrono(ReapInterval));
+      // Reap without the lock so that workers closing sockets are never blocked on syscalls.
+      std::list<LingeringSocket> sockets;
+      {
+        absl::MutexLock lock(&mutex_);
+        sockets.swap(sockets_);
+      }
+      size_t num_closed = 0;
+      for (auto it = sockets.begin(); it != sockets.end();) {
+        // The stats may not outlive the workers, so lingering completions are not counted.
+        IoSocketHandleImpl::reapZerocopyCompletions(it->fd_, it->pending_, nullptr);
+        if (it->pending_.empty()) {
+          Api::OsSysCallsSingleton::get().close(it->fd_);
+        } else if (--it->reaps_left_ == 0) {
+          ENVOY_LOG_MISC(debug, "resetting fd {}: {} zero-copy sends did not complete in time",
+                         it->fd_, it->pending_.size());
+          reset(it->fd_);
+        } else {
+          ++it;
+          continue;
+        }
+        it = sockets.erase(it);
+        ++num_closed;
+      }
+      absl::MutexLock lock(&mutex_);
+      num_sockets_ -= num_closed;
+      sockets_.splice(sockets_.end(), sockets);
+      if (sockets_.empty()) {
+        running_ = false;
+        return;
+      }
+    }
+  }
+
+  // Completions usually arrive within a round trip of the last send.
+  static constexpr std::chrono::milliseconds ReapInterval{10};
+
+  absl::Mutex mutex_;
+  std::list<LingeringSocket> sockets_ ABSL_GUARDED_BY(mutex_);
+  // Also counts the sockets the reaping thread holds while it reaps without the lock.
+  size_t num_sockets_ ABSL_GUARDED_BY(mutex_){0};
+  bool running_ ABSL_GUARDED_BY(mutex_){false};
+  Thread::ThreadPtr thread_ ABSL_GUARDED_BY(mutex_);
+  Thread::PosixThreadFactoryPtr thread_factory_{Thread::PosixThreadFactory::create()};
+};
+#endif
+
 IoSocketHandleImpl::~IoSocketHandleImpl() {
   if (SOCKET_VALID(fd_)) {
     IoSocketHandleImpl::close();
@@ -64,6 +177,26 @@ Api::IoCallUint64Result IoSocketHandleImpl::close() {
     file_event_.reset();
   }
 
+#if ENVOY_ZEROCOPY_SEND
+  if (!zerocopy_pending_.empty()) {
+    const ZerocopySendConfig& config = zerocopySendConfig();
+    reapZerocopyCompletions(fd_, zerocopy_pending_, zerocopySendStats());
+    if (!zerocopy_pending_.empty()) {
+      // Reusing the pinned memory would change data the kernel has yet to (re)transmit. Unlike a
+      // plain close(), the fd stays open until the sends complete: shut down the write side so
+      // that the peer still gets the FIN right behind the queued data. This is documented with
+      // the linger_timeout of the zerocopy_send_options.
+      ENVOY_LOG(debug, "closing fd {} with {} zero-copy sends in flight", fd_,
+                zerocopy_pending_.size());
+      Api::OsSysCallsSingleton::get().shutdown(fd_, SHUT_WR);
+      ZerocopyLinger::get().add(fd_, std::move(zerocopy_pending_), config);
+      zerocopy_pending_.clear();
+      SET_SOCKET_INVALID(fd_);
+      return Api::ioCallUint64ResultNoError();
+    }
+  }
+#endif
+
   ASSERT(SOCKET_VALID(fd_));
   const int rc = Api::OsSysCallsSingleton::get().close(fd_).return_value_;
   SET_SOCKET_INVALID(fd_);
@@ -101,6 +234,10 @@ Api::IoCallUint64Result IoSocketHandleImpl::read(Buffer::Instance& buffer,
   if (max_length == 0) {
     return Api::ioCallUint64ResultNoError();
   }
+  if (!zerocopy_pending_.empty()) {
+    // Pending completions raise EPOLLERR, which is delivered as a read event.
+    reapZerocopyCompletions(fd_, zerocopy_pending_, zerocopySendStats());
+  }
   Buffer::Reservation reservation = buffer.reserveForRead();
   Api::IoCallUint64Result result = readv(std::min(reservation.length(), max_length),
                                          reservation.slices(), reservation.numSlices());
@@ -139,6 +276,9 @@ Api::IoCallUint64Result IoSocketHandleImpl::writev(const Buffer::RawSlice* slice
 Api::IoCallUint64Result IoSocketHandleImpl::write(Buffer::Instance& buffer) {
   constexpr uint64_t MaxSlices = 16;
   Buffer::RawSliceVector slices = buffer.getRawSlices(MaxSlices);
+  if (zerocopy_enabled_) {
+    return zerocopyWrite(buffer, slices);
+  }
   Api::IoCallUint64Result result = writev(slices.begin(), slices.size());
   if (result.ok() && result.return_value_ > 0) {
     buffer.drain(static_cast<uint64_t>(result.return_value_));
@@ -146,6 +286,148 @@ Api::IoCallUint64Result IoSocketHandleImpl::write(Buffer::Instance& buffer) {
   return result;
 }
 
+Api::IoCallUint64Result IoSocketHandleImpl::zerocopyWrite(Buffer::Instance& buffer,
+                                                          const Buffer::RawSliceVector& slices) {
+  if (!zerocopy_pending_.empty()) {
+    reapZerocopyCompletions(fd_, zerocopy_pending_, zerocopySendStats());
+  }
+
+  uint64_t num_bytes_to_write = 0;
+  for (const Buffer::RawSlice& slice : slices) {
+    num_bytes_to_write += slice.len_;
+  }
+
+  bool use_zerocopy = num_bytes_to_write >= zerocopySendThreshold();
+  Api::IoCallUint64Result result = Api::ioCallUint64ResultNoError();
+#if ENVOY_ZEROCOPY_SEND
+  if (use_zerocopy) {
+    absl::FixedArray<iovec> iov(slices.size());
+    uint64_t num_slices_to_write = 0;
+    for (const Buffer::RawSlice& slice : slices) {
+      if (slice.mem_ != nullptr && slice.len_ != 0) {
+        iov[num_slices_to_write].iov_base = slice.mem_;
+        iov[num_slices_to_write].iov_len = slice.len_;
+        num_slices_to_write++;
+      }
+    }
+    msghdr message{};
+    message.msg_iov = iov.begin();
+    message.msg_iovlen = num_slices_to_write;
+    const Api::SysCallSizeResult sys_result =
+        Api::OsSysCallsSingleton::get().sendmsg(fd_, &message, MSG_ZEROCOPY);
+    if (sys_result.return_value_ < 0 && sys_result.errno_ == ENOBUFS) {
+      // The socket exceeded its optmem limit of pinned pages. Copy until completions are reaped.
+      use_zerocopy = false;
+    } else if (sys_result.return_value_ < 0 && sys_result.errno_ == EOPNOTSUPP) {
+      // A ULP such as kernel TLS took over the socket and does not accept MSG_ZEROCOPY.
+      zerocopy_enabled_ = false;
+      use_zerocopy = false;
+    } else {
+      result = sysCallResultToIoCallResult(sys_result);
+    }
+  }
+#else
+  use_zerocopy = false;
+#endif
+  if (!use_zerocopy) {
+    result = writev(slices.begin(), slices.size());
+  }
+  if (!result.ok() || result.return_value_ == 0) {
+    return result;
+  }
+
+  if (use_zerocopy) {
+    ZerocopyPendingSend& pending = zerocopy_pending_.emplace_back();
+    pending.id_ = zerocopy_next_id_++;
+  }
+  if (zerocopy_pending_.empty()) {
+    buffer.drain(result.return_value_);
+  } else {
+    pinSentData(buffer, result.return_value_);
+  }
+  return result;
+}
+
+void IoSocketHandleImpl::pinSentData(Buffer::Instance& buffer, uint64_t length) {
+  ASSERT(!zerocopy_pending_.empty());
+  std::vector<Buffer::InstancePtr>& pinned = zerocopy_pending_.back().pinned_;
+  while (length > 0) {
+    const uint64_t slice_length = buffer.frontSlice().len_;
+    if (slice_length > length) {
+      // The slice was only partially sent. Its storage stays alive in `buffer` and is pinned
+      // whenever the remainder is sent.
+      buffer.drain(length);
+      return;
+    }
+    auto holder = std::make_unique<Buffer::OwnedImpl>();
+    // Run drain trackers now so that the rest of the stack observes the data as written.
+    holder->move(buffer, slice_length, /*reset_drain_trackers_and_accounting=*/true);
+    pinned.push_back(std::move(holder));
+    length -= slice_length;
+  }
+}
+
+void IoSocketHandleImpl::reapZerocopyCompletions(os_fd_t fd,
+                                                 std::deque<ZerocopyPendingSend>& pending,
+                                                 const ZerocopySendStats* stats) {
+#if ENVOY_ZEROCOPY_SEND
+  auto& os_syscalls = Api::OsSysCallsSingleton::get();
+  while (true) {
+    // The extended error is followed by the offender address, which is unused for zero-copy.
+    char cbuf[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    msghdr message{};
+    message.msg_control = cbuf;
+    message.msg_controllen = sizeof(cbuf);
+    const Api::SysCallSizeResult result = os_syscalls.recvmsg(fd, &message, MSG_ERRQUEUE);
+    if (result.return_value_ < 0 || message.msg_controllen == 0) {
+      // EAGAIN once the error queue is empty.
+      break;
+    }
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&message, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+      sock_extended_err err;
+      safeMemcpyUnsafeSrc(&err, CMSG_DATA(cmsg));
+      if (err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      // Completions are reported as an inclusive range of send ids, which may wrap.
+      const uint32_t lo = err.ee_info;
+      const uint32_t hi = err.ee_data;
+      // The kernel coalesces consecutive completions, so a range may cover many sends. When it
+      // had to copy the data after all (e.g. on loopback or without NIC scatter-gather support),
+      // the whole range is flagged.
+      const uint64_t num_sends = static_cast<uint64_t>(static_cast<uint32_t>(hi - lo)) + 1;
+      if (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+        ENVOY_LOG(trace, "fd {}: kernel copied zero-copy sends {}..{}", fd, lo, hi);
+        if (stats != nullptr) {
+          stats->copied_.add(num_sends);
+        }
+      }
+      if (stats != nullptr) {
+        stats->completed_.add(num_sends);
+      }
+      for (ZerocopyPendingSend& send : pending) {
+        if (static_cast<uint32_t>(send.id_ - lo) <= static_cast<uint32_t>(hi - lo)) {
+          send.completed_ = true;
+        }
+      }
+    }
+  }
+#else
+  UNREFERENCED_PARAMETER(fd);
+  UNREFERENCED_PARAMETER(stats);
+#endif
+  // A later send may pin the remainder of a slice an earlier send partially referenced, so data
+  // is only released in send order.
+  while (!pending.empty() && pending.front().completed_) {
+    pending.pop_front();
+  }
+}
+
 Api::IoCallUint64Result IoSocketHandleImpl::sendmsg(const Buffer::RawSlice* slices,
                                                     uint64_t num_slice, int flags,
                                                     const Address::Ip* self_ip,
@@ -549,8 +831,16 @@ IoHandlePtr IoSocketHandleImpl::accept(struct sockaddr* addr, socklen_t* addrlen
   if (SOCKET_INVALID(result.return_value_)) {
     return nullptr;
   }
-  return SocketInterfaceImpl::makePlatformSpecificSocket(result.return_value_, socket_v6only_,
-                                                         domain_, {});
+  IoHandlePtr accepted = SocketInterfaceImpl::makePlatformSpecificSocket(
+      result.return_value_, socket_v6only_, domain_, {}, nullptr, zerocopy_send_config_);
+  if (zerocopy_enabled_) {
+    // Accepted sockets inherit SO_ZEROCOPY from the listen socket.
+    auto* accepted_impl = dynamic_cast<IoSocketHandleImpl*>(accepted.get());
+    if (accepted_impl != nullptr) {
+      accepted_impl->zerocopy_enabled_ = true;
+    }
+  }
+  return accepted;
 }
 
 Api::SysCallIntResult IoSocketHandleImpl::connect(Address::InstanceConstSharedPtr address) {
@@ -592,8 +882,17 @@ IoHandlePtr IoSocketHandleImpl::duplicate() {
   RELEASE_ASSERT(result.return_value_ != -1,
                  fmt::format("duplicate failed for '{}': ({}) {}", fd_, result.errno_,
                              errorDetails(result.errno_)));
-  return SocketInterfaceImpl::makePlatformSpecificSocket(result.return_value_, socket_v6only_,
-                                                         domain_, {false, addressCacheMaxSize()});
+  IoHandlePtr duplicated = SocketInterfaceImpl::makePlatformSpecificSocket(
+      result.return_value_, socket_v6only_, domain_, {false, addressCacheMaxSize()}, nullptr,
+      zerocopy_send_config_);
+  if (zerocopy_enabled_) {
+    // The duplicate refers to the same socket, which already has SO_ZEROCOPY set.
+    auto* duplicated_impl = dynamic_cast<IoSocketHandleImpl*>(duplicated.get());
+    if (duplicated_impl != nullptr) {
+      duplicated_impl->zerocopy_enabled_ = true;
+    }
+  }
+  return duplicated;
 }
 
 void IoSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher, Event::FileReadyCb cb,
@@ -623,5 +922,20 @@ Api::SysCallIntResult IoSocketHandleImpl::shutdown(int how) {
   return Api::OsSysCallsSingleton::get().shutdown(fd_, how);
 }
 
+Api::SysCallIntResult IoSocketHandleImpl::setOption(int level, int optname, const void* optval,
+                                                    socklen_t optlen) {
+  const Api::SysCallIntResult result =
+      IoSocketHandleBaseImpl::setOption(level, optname, optval, optlen);
+#if ENVOY_ZEROCOPY_SEND
+  // SO_ZEROCOPY is configured like any other socket option on the listener or cluster; once the
+  // kernel accepts it, writes of at least the configured send threshold switch to MSG_ZEROCOPY.
+  if (result.return_value_ == 0 && level == SOL_SOCKET && optname == SO_ZEROCOPY &&
+      optlen == sizeof(int)) {
+    zerocopy_enabled_ = *static_cast<const int*>(optval) != 0;
+  }
+#endif
+  return result;
+}
+
 } // namespace Network
 } // namespace Envoy
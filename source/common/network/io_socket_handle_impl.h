@@ -1,15 +1,20 @@
 #pragma once
 
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <vector>
 
 #include "envoy/api/io_error.h"
 #include "envoy/api/os_sys_calls.h"
+#include "envoy/buffer/buffer.h"
 #include "envoy/common/platform.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/io_handle.h"
+#include "envoy/stats/stats_macros.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/common/macros.h"
 #include "source/common/network/io_socket_error_impl.h"
 #include "source/common/network/io_socket_handle_base_impl.h"
 #include "source/common/runtime/runtime_features.h"
@@ -21,6 +26,41 @@ namespace Network {
 
 using QuicEnvoyAddressPair = std::pair<quic::QuicSocketAddress, Address::InstanceConstSharedPtr>;
 
+/**
+ * All zero-copy send stats. @see stats_macros.h
+ */
+#define ALL_ZEROCOPY_SEND_STATS(COUNTER)                                                           \
+  COUNTER(completed)                                                                               \
+  COUNTER(copied)
+
+/**
+ * Struct definition for all zero-copy send stats. @see stats_macros.h
+ */
+struct ZerocopySendStats {
+  ALL_ZEROCOPY_SEND_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Process wide settings of MSG_ZEROCOPY sends, from the zerocopy_send_options of the default
+ * socket interface.
+ */
+struct ZerocopySendConfig {
+  // The kernel documentation puts the break-even point of MSG_ZEROCOPY at around 10KB.
+  static constexpr uint64_t DefaultSendThreshold = 16 * 1024;
+  static constexpr std::chrono::milliseconds DefaultLingerTimeout{10000};
+  static constexpr uint32_t DefaultMaxLingeringSockets = 1024;
+
+  static const ZerocopySendConfig& defaults() { CONSTRUCT_ON_FIRST_USE(ZerocopySendConfig); }
+
+  uint64_t send_threshold_{DefaultSendThreshold};
+  std::chrono::milliseconds linger_timeout_{DefaultLingerTimeout};
+  uint32_t max_lingering_sockets_{DefaultMaxLingeringSockets};
+  // Only set if zerocopy_send_options is configured, as there is no stats scope otherwise.
+  absl::optional<ZerocopySendStats> stats_;
+};
+
+using ZerocopySendConfigConstSharedPtr = std::shared_ptr<const ZerocopySendConfig>;
+
 /**
  * IoHandle derivative for sockets.
  */
@@ -28,9 +68,11 @@ class IoSocketHandleImpl : public IoSocketHandleBaseImpl {
 public:
   explicit IoSocketHandleImpl(os_fd_t fd = INVALID_SOCKET, bool socket_v6only = false,
                               absl::optional<int> domain = absl::nullopt,
-                              size_t address_cache_max_capacity = 0)
+                              size_t address_cache_max_capacity = 0,
+                              ZerocopySendConfigConstSharedPtr zerocopy_send_config = nullptr)
       : IoSocketHandleBaseImpl(fd, socket_v6only, domain),
-        address_cache_max_capacity_(address_cache_max_capacity) {
+        address_cache_max_capacity_(address_cache_max_capacity),
+        zerocopy_send_config_(std::move(zerocopy_send_config)) {
     if (address_cache_max_capacity > 0) {
       recent_received_addresses_ = std::vector<QuicEnvoyAddressPair>();
     }
@@ -79,6 +121,26 @@ public:
 
   Api::SysCallIntResult shutdown(int how) override;
 
+  Api::SysCallIntResult setOption(int level, int optname, const void* optval,
+                                  socklen_t optlen) override;
+
+  /**
+   * @return true if SO_ZEROCOPY has been enabled on this socket (either directly or inherited
+   * from the listen socket it was accepted from).
+   */
+  bool zerocopyEnabled() const { return zerocopy_enabled_; }
+
+  /**
+   * @return the minimum number of bytes a write() must carry to be sent with MSG_ZEROCOPY. Smaller
+   * writes are cheaper to copy than to pin and track.
+   */
+  uint64_t zerocopySendThreshold() const { return zerocopySendConfig().send_threshold_; }
+
+  /**
+   * @return the number of MSG_ZEROCOPY sends whose data is still pinned waiting for completion.
+   */
+  size_t pendingZerocopySends() const { return zerocopy_pending_.size(); }
+
 protected:
   // Converts a SysCallSizeResult to IoCallUint64Result.
   template <typename T>
@@ -116,6 +178,37 @@ private:
   Address::InstanceConstSharedPtr getOrCreateEnvoyAddressInstance(sockaddr_storage ss,
                                                                   socklen_t ss_len);
 
+  // Sends the given slices with MSG_ZEROCOPY if they are large enough and pins the sent data
+  // until the kernel reports the send as complete.
+  Api::IoCallUint64Result zerocopyWrite(Buffer::Instance& buffer,
+                                        const Buffer::RawSliceVector& slices);
+
+  // Removes `length` sent bytes from the front of `buffer`, keeping the storage of any slice
+  // that the kernel may still reference alive until the most recent zero-copy send completes.
+  void pinSentData(Buffer::Instance& buffer, uint64_t length);
+
+  // Data pinned by a single MSG_ZEROCOPY send. Each slice is held in its own buffer so that it is
+  // never coalesced (copied) into a neighbour and freed while the kernel still references it.
+  struct ZerocopyPendingSend {
+    uint32_t id_{};
+    bool completed_{};
+    std::vector<Buffer::InstancePtr> pinned_;
+  };
+
+  const ZerocopySendConfig& zerocopySendConfig() const {
+    return zerocopy_send_config_ != nullptr ? *zerocopy_send_config_
+                                            : ZerocopySendConfig::defaults();
+  }
+  const ZerocopySendStats* zerocopySendStats() const {
+    const absl::optional<ZerocopySendStats>& stats = zerocopySendConfig().stats_;
+    return stats.has_value() ? &stats.value() : nullptr;
+  }
+
+  // Reads zero-copy completion notifications from the error queue of `fd` and releases the data
+  // pinned by completed sends. Completions are counted in `stats` if it is not null.
+  static void reapZerocopyCompletions(os_fd_t fd, std::deque<ZerocopyPendingSend>& pending,
+                                      const ZerocopySendStats* stats);
+
   // Caches the address instances of the most recently received packets on this socket.
   // Should only be used by QUIC client sockets to avoid creating multiple address instances for
   // the same address in each read operation. Since the QUIC client sockets are connected via a
@@ -125,6 +218,16 @@ private:
   // Only non-null if address_cache_max_capacity_ is greater than 0.
   absl::optional<std::vector<QuicEnvoyAddressPair>> recent_received_addresses_ = absl::nullopt;
 
+  // Null if the default socket interface has no zerocopy_send_options.
+  const ZerocopySendConfigConstSharedPtr zerocopy_send_config_;
+  bool zerocopy_enabled_{false};
+  // The kernel numbers MSG_ZEROCOPY sends with a 32 bit counter starting at 0.
+  uint32_t zerocopy_next_id_{0};
+  // Sends in the order they were issued; released from the front as they complete.
+  std::deque<ZerocopyPendingSend> zerocopy_pending_;
+
+  // Takes over sockets closed while zero-copy sends are still in flight.
+  friend class ZerocopyLinger;
   // For testing and benchmarking non-public methods.
   friend class IoSocketHandleImplTestWrapper;
 };
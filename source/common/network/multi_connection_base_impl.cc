@@ -314,6 +314,13 @@ absl::optional<uint64_t> MultiConnectionBaseImpl::congestionWindowInBytes() cons
   return connections_[0]->congestionWindowInBytes();
 }
 
+OptRef<IoHandle> MultiConnectionBaseImpl::passthroughIoHandle() {
+  if (!connect_finished_) {
+    return {};
+  }
+  return connections_[0]->passthroughIoHandle();
+}
+
 void MultiConnectionBaseImpl::addConnectionCallbacks(ConnectionCallbacks& cb) {
   if (connect_finished_) {
     connections_[0]->addConnectionCallbacks(cb);
@@ -10,6 +10,7 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/win32_socket_handle_impl.h"
+#include "source/common/protobuf/utility.h"
 
 #if defined(__linux__) && !defined(__ANDROID_API__) && defined(ENVOY_ENABLE_IO_URING)
 #include "source/common/io/io_uring_worker_factory_impl.h"
@@ -36,7 +37,8 @@ void DefaultSocketInterfaceExtension::onWorkerThreadInitialized() {
 IoHandlePtr SocketInterfaceImpl::makePlatformSpecificSocket(
     int socket_fd, bool socket_v6only, absl::optional<int> domain,
     const SocketCreationOptions& options,
-    [[maybe_unused]] Io::IoUringWorkerFactory* io_uring_worker_factory) {
+    [[maybe_unused]] Io::IoUringWorkerFactory* io_uring_worker_factory,
+    ZerocopySendConfigConstSharedPtr zerocopy_send_config) {
   if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
     return std::make_unique<Win32SocketHandleImpl>(socket_fd, socket_v6only, domain);
   }
@@ -50,7 +52,8 @@ IoHandlePtr SocketInterfaceImpl::makePlatformSpecificSocket(
   }
 #endif
   return std::make_unique<IoSocketHandleImpl>(socket_fd, socket_v6only, domain,
-                                              options.max_addresses_cache_size_);
+                                              options.max_addresses_cache_size_,
+                                              std::move(zerocopy_send_config));
 }
 
 IoHandlePtr SocketInterfaceImpl::makeSocket(int socket_fd, bool socket_v6only,
@@ -60,7 +63,7 @@ IoHandlePtr SocketInterfaceImpl::makeSocket(int socket_fd, bool socket_v6only,
     return makePlatformSpecificSocket(socket_fd, socket_v6only, domain, options, nullptr);
   }
   return makePlatformSpecificSocket(socket_fd, socket_v6only, domain, options,
-                                    io_uring_worker_factory_.lock().get());
+                                    io_uring_worker_factory_.lock().get(), zerocopy_send_config_);
 }
 
 IoHandlePtr SocketInterfaceImpl::socket(Socket::Type socket_type, Address::Type addr_type,
@@ -165,12 +168,25 @@ bool SocketInterfaceImpl::ipFamilySupported(int domain) {
 }
 
 Server::BootstrapExtensionPtr SocketInterfaceImpl::createBootstrapExtension(
-    [[maybe_unused]] const Protobuf::Message& config,
-    [[maybe_unused]] Server::Configuration::ServerFactoryContext& context) {
-#if defined(__linux__) && !defined(__ANDROID_API__) && defined(ENVOY_ENABLE_IO_URING)
+    const Protobuf::Message& config, Server::Configuration::ServerFactoryContext& context) {
   const auto& message = MessageUtil::downcastAndValidate<
       const envoy::extensions::network::socket_interface::v3::DefaultSocketInterface&>(
       config, context.messageValidationVisitor());
+  if (message.has_zerocopy_send_options()) {
+    const auto& options = message.zerocopy_send_options();
+    auto zerocopy_send_config = std::make_shared<ZerocopySendConfig>();
+    zerocopy_send_config->send_threshold_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+        options, send_threshold_bytes, ZerocopySendConfig::DefaultSendThreshold);
+    zerocopy_send_config->linger_timeout_ = std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
+        options, linger_timeout, ZerocopySendConfig::DefaultLingerTimeout.count()));
+    zerocopy_send_config->max_lingering_sockets_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+        options, max_lingering_sockets, ZerocopySendConfig::DefaultMaxLingeringSockets);
+    Stats::Scope& scope = context.serverScope();
+    zerocopy_send_config->stats_.emplace(
+        ZerocopySendStats{ALL_ZEROCOPY_SEND_STATS(POOL_COUNTER_PREFIX(scope, "zerocopy_send."))});
+    zerocopy_send_config_ = std::move(zerocopy_send_config);
+  }
+#if defined(__linux__) && !defined(__ANDROID_API__) && defined(ENVOY_ENABLE_IO_URING)
   if (message.has_io_uring_options() && Io::isIoUringSupported()) {
     const auto& options = message.io_uring_options();
     std::shared_ptr<Io::IoUringWorkerFactoryImpl> io_uring_worker_factory =
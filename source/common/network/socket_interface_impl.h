@@ -3,6 +3,7 @@
 #include "envoy/common/io/io_uring.h"
 #include "envoy/network/socket.h"
 
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/socket_interface.h"
 
 namespace Envoy {
@@ -44,7 +45,8 @@ public:
   static IoHandlePtr
   makePlatformSpecificSocket(int socket_fd, bool socket_v6only, absl::optional<int> domain,
                              const SocketCreationOptions& options,
-                             Io::IoUringWorkerFactory* io_uring_worker_factory = nullptr);
+                             Io::IoUringWorkerFactory* io_uring_worker_factory = nullptr,
+                             ZerocopySendConfigConstSharedPtr zerocopy_send_config = nullptr);
 
 protected:
   virtual IoHandlePtr makeSocket(int socket_fd, bool socket_v6only, Socket::Type socket_type,
@@ -53,6 +55,8 @@ protected:
 
 private:
   std::weak_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory_;
+  // Only set if the zerocopy_send_options are configured.
+  ZerocopySendConfigConstSharedPtr zerocopy_send_config_;
 };
 
 DECLARE_FACTORY(SocketInterfaceImpl);
@@ -93,5 +93,21 @@ double getMaxUtilization(const LrsReportMetricNames& metric_names,
   return max_utilization;
 }
 
+double getUtilization(const LrsReportMetricNames& metric_names,
+                      const xds::data::orca::v3::OrcaLoadReport& report) {
+  // If application_utilization is valid, use it as the utilization metric.
+  double utilization = report.application_utilization();
+  if (utilization > 0) {
+    return utilization;
+  }
+  // Otherwise, find the most constrained utilization metric.
+  utilization = getMaxUtilization(metric_names, report);
+  if (utilization > 0) {
+    return utilization;
+  }
+  // If utilization is <= 0, use cpu_utilization.
+  return report.cpu_utilization();
+}
+
 } // namespace Orca
 } // namespace Envoy
@@ -19,5 +19,10 @@ void addOrcaLoadReportToLoadMetricStats(const LrsReportMetricNames& metric_names
 double getMaxUtilization(const LrsReportMetricNames& metric_names,
                          const xds::data::orca::v3::OrcaLoadReport& report);
 
+// Returns the utilization of the backend that sent the `report`: application_utilization if it is
+// positive, otherwise the maximum of metrics with `metric_names`, falling back to cpu_utilization.
+double getUtilization(const LrsReportMetricNames& metric_names,
+                      const xds::data::orca::v3::OrcaLoadReport& report);
+
 } // namespace Orca
 } // namespace Envoy
@@ -146,6 +146,8 @@ public:
   void configureInitialCongestionWindow(uint64_t bandwidth_bits_per_sec,
                                         std::chrono::microseconds rtt) override;
   absl::optional<uint64_t> congestionWindowInBytes() const override;
+  // QUIC streams are multiplexed over a UDP socket, so there is no byte stream to pass through.
+  OptRef<Network::IoHandle> passthroughIoHandle() override { return {}; }
 
   // Network::FilterManagerConnection
   void rawWrite(Buffer::Instance& data, bool end_stream) override;
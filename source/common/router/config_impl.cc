@@ -127,6 +127,24 @@ namespace {
 
 constexpr uint32_t DEFAULT_MAX_DIRECT_RESPONSE_BODY_SIZE_BYTES = 4096;
 
+// Compares every field of the route configurations except the virtual hosts, i.e. everything the
+// shared CommonConfigImpl is built from.
+bool equalWithoutVirtualHosts(const envoy::config::route::v3::RouteConfiguration& lhs,
+                              const envoy::config::route::v3::RouteConfiguration& rhs) {
+#if defined(ENVOY_ENABLE_FULL_PROTOS)
+  Protobuf::util::MessageDifferencer differencer;
+  differencer.IgnoreField(
+      envoy::config::route::v3::RouteConfiguration::GetDescriptor()->FindFieldByNumber(
+          envoy::config::route::v3::RouteConfiguration::kVirtualHostsFieldNumber));
+  return differencer.Compare(lhs, rhs);
+#else
+  UNREFERENCED_PARAMETER(lhs);
+  UNREFERENCED_PARAMETER(rhs);
+  // Without message reflection, err on the side of rebuilding.
+  return false;
+#endif
+}
+
 // Returns an array of header parsers, sorted by specificity. The `specificity_ascend` parameter
 // specifies whether the returned parsers will be sorted from least specific to most specific
 // (global connection manager level header parser, virtual host level header parser and finally
@@ -1753,9 +1771,39 @@ VirtualHostImpl::VirtualHostImpl(const envoy::config::route::v3::VirtualHost& vi
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+    if (routes_.size() >= MinRoutesForPathIndex &&
+        Runtime::runtimeFeatureEnabled("envoy.reloadable_features.router_route_path_index")) {
+      buildPathIndex();
+    }
   }
 }
 
+void VirtualHostImpl::buildPathIndex() {
+  bool ignore_case = false;
+  for (const auto& route : routes_) {
+    ignore_case |= !route->case_sensitive();
+  }
+
+  auto index = std::make_unique<RoutePathIndex>(ignore_case);
+  for (const auto& route : routes_) {
+    const PathMatchCriterion& criterion = route->pathMatchCriterion();
+    switch (criterion.matchType()) {
+    case PathMatchType::Prefix:
+    case PathMatchType::Exact:
+    case PathMatchType::PathSeparatedPrefix:
+      // Every path these routes match starts with the matcher string.
+      index->addRoute(criterion.matcher());
+      break;
+    case PathMatchType::None:
+    case PathMatchType::Regex:
+    case PathMatchType::Template:
+      index->addRoute(absl::nullopt);
+      break;
+    }
+  }
+  path_index_ = std::move(index);
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
     const RouteCallback& cb, const Http::RequestHeaderMap& headers,
     const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
@@ -1793,6 +1841,59 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
   return nullptr;
 }
 
+RouteConstSharedPtr VirtualHostImpl::getRouteFromPathIndex(
+    const RouteCallback& cb, const Http::RequestHeaderMap& headers,
+    const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const {
+  ASSERT(path_index_ != nullptr && path_index_->size() == routes_.size());
+  ASSERT(headers.Path() != nullptr);
+
+  // Strip the path the same way the route path matchers do before comparing it.
+  absl::string_view path = headers.getPathValue();
+  if (shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching()) {
+    path = path.substr(0, path.find(';'));
+  }
+  path = Http::PathUtil::removeQueryAndFragment(path);
+
+  // Only the routes that cannot match are skipped, so the callback sees the same routes with the
+  // same evaluation status as with a linear scan of routes_.
+  RouteConstSharedPtr result;
+  bool exhausted = true;
+  path_index_->forEachCandidate(path, [&](uint32_t position) {
+    const RouteEntryImplBaseConstSharedPtr& route = routes_[position];
+    RouteConstSharedPtr route_entry = route->matches(headers, stream_info, random_value);
+    if (route_entry == nullptr) {
+      return true;
+    }
+
+    if (cb == nullptr) {
+      result = std::move(route_entry);
+      return false;
+    }
+
+    const RouteEvalStatus eval_status = position + 1 == routes_.size()
+                                            ? RouteEvalStatus::NoMoreRoutes
+                                            : RouteEvalStatus::HasMoreRoutes;
+    const RouteMatchStatus match_status = cb(route_entry, eval_status);
+    if (match_status == RouteMatchStatus::Accept) {
+      result = std::move(route_entry);
+      return false;
+    }
+    if (match_status == RouteMatchStatus::Continue &&
+        eval_status == RouteEvalStatus::NoMoreRoutes) {
+      ENVOY_LOG(debug,
+                "return null when route match status is Continue but there is no more routes");
+      exhausted = false;
+      return false;
+    }
+    return true;
+  });
+
+  if (result == nullptr && exhausted) {
+    ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  }
+  return result;
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb,
                                                          const Http::RequestHeaderMap& headers,
                                                          const StreamInfo::StreamInfo& stream_info,
@@ -1842,7 +1943,11 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
-  // Check for a route that matches the request.
+  // Check for a route that matches the request. Requests without a path can only match pathless
+  // routes, which the index does not know about.
+  if (path_index_ != nullptr && headers.Path() != nullptr) {
+    return getRouteFromPathIndex(cb, headers, stream_info, random_value);
+  }
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
@@ -1871,11 +1976,14 @@ absl::StatusOr<std::unique_ptr<RouteMatcher>>
 RouteMatcher::create(const envoy::config::route::v3::RouteConfiguration& route_config,
                      const CommonConfigSharedPtr& global_route_config,
                      Server::Configuration::ServerFactoryContext& factory_context,
-                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters) {
+                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                     const RouteMatcher* previous_matcher,
+                     const envoy::config::route::v3::RouteConfiguration* previous_proto,
+                     bool index_virtual_hosts) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::unique_ptr<RouteMatcher>{new RouteMatcher(route_config, global_route_config,
-                                                            factory_context, validator,
-                                                            validate_clusters, creation_status)};
+  auto ret = std::unique_ptr<RouteMatcher>{new RouteMatcher(
+      route_config, global_route_config, factory_context, validator, validate_clusters,
+      previous_matcher, previous_proto, index_virtual_hosts, creation_status)};
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -1883,15 +1991,42 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
                            const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
                            ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
-                           absl::Status& creation_status)
-    : vhost_scope_(factory_context.scope().scopeFromStatName(
-          factory_context.routerContext().virtualClusterStatNames().vhost_)),
+                           const RouteMatcher* previous_matcher,
+                           const envoy::config::route::v3::RouteConfiguration* previous_proto,
+                           bool index_virtual_hosts, absl::Status& creation_status)
+    : vhost_scope_(previous_matcher != nullptr
+                       ? previous_matcher->vhost_scope_
+                       : factory_context.scope().scopeFromStatName(
+                             factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()) {
-  for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostImplSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, global_route_config, factory_context, *vhost_scope_, validator,
-        validate_clusters, creation_status);
-    SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+  ASSERT(previous_matcher == nullptr || (index_virtual_hosts && previous_proto != nullptr));
+  if (index_virtual_hosts) {
+    virtual_hosts_by_name_.reserve(route_config.virtual_hosts_size());
+  }
+  for (int index = 0; index < route_config.virtual_hosts_size(); ++index) {
+    const auto& virtual_host_config = route_config.virtual_hosts(index);
+    VirtualHostImplSharedPtr virtual_host;
+    if (previous_matcher != nullptr) {
+      // Names need not be unique, so the proto the virtual host was built from decides.
+      const auto it = previous_matcher->virtual_hosts_by_name_.find(virtual_host_config.name());
+      if (it != previous_matcher->virtual_hosts_by_name_.end() &&
+          Protobuf::util::MessageDifferencer::Equals(
+              previous_proto->virtual_hosts(it->second.index_), virtual_host_config)) {
+        virtual_host = it->second.virtual_host_;
+        ++virtual_hosts_reused_;
+      }
+    }
+    if (virtual_host == nullptr) {
+      virtual_host = std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config,
+                                                       factory_context, *vhost_scope_, validator,
+                                                       validate_clusters, creation_status);
+      SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+      ++virtual_hosts_rebuilt_;
+    }
+    if (index_virtual_hosts) {
+      virtual_hosts_by_name_.emplace(virtual_host_config.name(),
+                                     IndexedVirtualHost{index, virtual_host});
+    }
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -2110,17 +2245,55 @@ ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
   return ret;
 }
 
+absl::StatusOr<std::shared_ptr<ConfigImpl>>
+ConfigImpl::createIncremental(const envoy::config::route::v3::RouteConfiguration& config,
+                              Server::Configuration::ServerFactoryContext& factory_context,
+                              ProtobufMessage::ValidationVisitor& validator,
+                              bool validate_clusters_default, const ConfigImpl* previous_config,
+                              const envoy::config::route::v3::RouteConfiguration* previous_proto) {
+  absl::Status creation_status = absl::OkStatus();
+  auto ret = std::shared_ptr<ConfigImpl>(
+      new ConfigImpl(config, factory_context, validator, validate_clusters_default,
+                     previous_config, previous_proto, true, creation_status));
+  RETURN_IF_NOT_OK(creation_status);
+  return ret;
+}
+
 ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
                        Server::Configuration::ServerFactoryContext& factory_context,
                        ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default, absl::Status& creation_status) {
-  auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
-  SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
-  shared_config_ = std::move(config_or_error.value());
+                       bool validate_clusters_default, absl::Status& creation_status)
+    : ConfigImpl(config, factory_context, validator, validate_clusters_default, nullptr, nullptr,
+                 false, creation_status) {}
 
-  auto matcher_or_error = RouteMatcher::create(
-      config, shared_config_, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
+ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                       Server::Configuration::ServerFactoryContext& factory_context,
+                       ProtobufMessage::ValidationVisitor& validator,
+                       bool validate_clusters_default, const ConfigImpl* previous_config,
+                       const envoy::config::route::v3::RouteConfiguration* previous_proto,
+                       bool incremental, absl::Status& creation_status) {
+  ASSERT(previous_config == nullptr || (incremental && previous_proto != nullptr));
+  const bool validate_clusters =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default);
+
+  // Virtual hosts are built against the shared part of the configuration, so they can only be
+  // reused together with it.
+  const RouteMatcher* previous_matcher = nullptr;
+  if (previous_config != nullptr && !validate_clusters &&
+      equalWithoutVirtualHosts(*previous_proto, config)) {
+    shared_config_ = previous_config->shared_config_;
+    previous_matcher = previous_config->route_matcher_.get();
+  }
+
+  if (shared_config_ == nullptr) {
+    auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
+    SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
+    shared_config_ = std::move(config_or_error.value());
+  }
+
+  auto matcher_or_error =
+      RouteMatcher::create(config, shared_config_, factory_context, validator, validate_clusters,
+                           previous_matcher, previous_proto, incremental);
   SET_AND_RETURN_IF_NOT_OK(matcher_or_error.status(), creation_status);
   route_matcher_ = std::move(matcher_or_error.value());
 }
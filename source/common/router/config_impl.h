@@ -32,10 +32,12 @@
 #include "source/common/router/header_parser.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
 #include "source/common/router/per_filter_config.h"
+#include "source/common/router/route_path_index.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -387,15 +389,27 @@ public:
 
   VirtualHostConstSharedPtr virtualHost() const { return shared_virtual_host_; }
 
+  // The smallest route list that is indexed by path. Below this a linear scan is as fast as
+  // walking the index.
+  static constexpr size_t MinRoutesForPathIndex = 16;
+
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  void buildPathIndex();
+  RouteConstSharedPtr getRouteFromPathIndex(const RouteCallback& cb,
+                                            const Http::RequestHeaderMap& headers,
+                                            const StreamInfo::StreamInfo& stream_info,
+                                            uint64_t random_value) const;
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   std::shared_ptr<const SslRedirectRoute> ssl_redirect_route_;
   SslRequirements ssl_requirements_;
 
   std::vector<RouteEntryImplBaseConstSharedPtr> routes_;
+  // Set when routes_ is large enough to be worth skipping the routes that cannot match the path.
+  std::unique_ptr<const RoutePathIndex> path_index_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -826,6 +840,7 @@ public:
   // Sanitizes the |path| before passing it to PathMatcher, if configured, this method makes the
   // path matching to ignore the path-parameters.
   absl::string_view sanitizePathBeforePathMatching(const absl::string_view path) const;
+  bool case_sensitive() const { return case_sensitive_; }
 
 protected:
   const std::string prefix_rewrite_;
@@ -836,7 +851,6 @@ protected:
   const std::string host_rewrite_;
   std::unique_ptr<ConnectConfig> connect_config_;
 
-  bool case_sensitive() const { return case_sensitive_; }
   RouteConstSharedPtr clusterEntry(const Http::RequestHeaderMap& headers,
                                    const StreamInfo::StreamInfo& stream_info,
                                    uint64_t random_value) const;
@@ -1255,23 +1269,39 @@ DECLARE_FACTORY(RouteListMatchActionFactory);
  */
 class RouteMatcher {
 public:
+  /**
+   * @param previous_matcher if not nullptr, a matcher built against the same global_route_config
+   *        whose virtual hosts are reused when their proto is unchanged.
+   * @param previous_proto the route configuration previous_matcher was built from. Only read when
+   *        previous_matcher is set.
+   * @param index_virtual_hosts whether to keep every virtual host keyed by its name so that the
+   *        matcher can be passed as previous_matcher for the next update.
+   */
   static absl::StatusOr<std::unique_ptr<RouteMatcher>>
   create(const envoy::config::route::v3::RouteConfiguration& config,
          const CommonConfigSharedPtr& global_route_config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+         const RouteMatcher* previous_matcher = nullptr,
+         const envoy::config::route::v3::RouteConfiguration* previous_proto = nullptr,
+         bool index_virtual_hosts = false);
 
   VirtualHostRoute route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                          const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
 
   const VirtualHostImpl* findVirtualHost(const Http::RequestHeaderMap& headers) const;
 
+  uint32_t virtualHostsReused() const { return virtual_hosts_reused_; }
+  uint32_t virtualHostsRebuilt() const { return virtual_hosts_rebuilt_; }
+
 private:
   RouteMatcher(const envoy::config::route::v3::RouteConfiguration& config,
                const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
                ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
-               absl::Status& creation_status);
+               const RouteMatcher* previous_matcher,
+               const envoy::config::route::v3::RouteConfiguration* previous_proto,
+               bool index_virtual_hosts, absl::Status& creation_status);
 
   using WildcardVirtualHosts =
       std::map<int64_t, absl::node_hash_map<std::string, VirtualHostImplSharedPtr>, std::greater<>>;
@@ -1296,6 +1326,16 @@ private:
   WildcardVirtualHosts wildcard_virtual_host_prefixes_;
 
   VirtualHostImplSharedPtr default_virtual_host_;
+  // A virtual host with the position of its proto in the route configuration it was built from,
+  // so that the next update can compare against that proto rather than a copy of it.
+  struct IndexedVirtualHost {
+    int index_;
+    VirtualHostImplSharedPtr virtual_host_;
+  };
+  // Virtual hosts keyed by name, only kept when index_virtual_hosts is set.
+  absl::flat_hash_map<std::string, IndexedVirtualHost> virtual_hosts_by_name_;
+  uint32_t virtual_hosts_reused_{};
+  uint32_t virtual_hosts_rebuilt_{};
   const bool ignore_port_in_host_matching_{false};
 };
 
@@ -1381,6 +1421,33 @@ public:
          Server::Configuration::ServerFactoryContext& factory_context,
          ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
 
+  /**
+   * Like create(), for a route configuration that is updated over time. Virtual hosts whose proto
+   * is unchanged since previous_config are shared with it rather than rebuilt, so an update costs
+   * in proportion to the virtual hosts that changed. Nothing is reused if any other part of the
+   * route configuration changed or if clusters are validated, as the cluster manager state may
+   * differ from when the virtual hosts were built.
+   * @param previous_config the configuration being replaced, or nullptr for the first one.
+   * @param previous_proto the route configuration previous_config was built from. Only read when
+   *        previous_config is set.
+   */
+  static absl::StatusOr<std::shared_ptr<ConfigImpl>>
+  createIncremental(const envoy::config::route::v3::RouteConfiguration& config,
+                    Server::Configuration::ServerFactoryContext& factory_context,
+                    ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+                    const ConfigImpl* previous_config,
+                    const envoy::config::route::v3::RouteConfiguration* previous_proto);
+
+  /**
+   * @return the number of virtual hosts shared with the previous configuration.
+   */
+  uint32_t virtualHostsReused() const { return route_matcher_->virtualHostsReused(); }
+
+  /**
+   * @return the number of virtual hosts built for this configuration.
+   */
+  uint32_t virtualHostsRebuilt() const { return route_matcher_->virtualHostsRebuilt(); }
+
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
   }
@@ -1423,6 +1490,12 @@ protected:
              Server::Configuration::ServerFactoryContext& factory_context,
              ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
              absl::Status& creation_status);
+  ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+             Server::Configuration::ServerFactoryContext& factory_context,
+             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+             const ConfigImpl* previous_config,
+             const envoy::config::route::v3::RouteConfiguration* previous_proto, bool incremental,
+             absl::Status& creation_status);
 
 private:
   CommonConfigSharedPtr shared_config_;
@@ -50,12 +50,20 @@ RdsRouteConfigSubscription::RdsRouteConfigSubscription(
                                       manager_identifier, factory_context, stat_prefix + "rds.",
                                       "RDS", route_config_provider_manager, creation_status),
       config_update_info_(static_cast<RouteConfigUpdateReceiver*>(
-          Rds::RdsRouteConfigSubscription::config_update_info_.get())) {}
+          Rds::RdsRouteConfigSubscription::config_update_info_.get())),
+      http_stats_({ALL_HTTP_RDS_STATS(POOL_COUNTER(*scope_))}) {}
 
 RdsRouteConfigSubscription::~RdsRouteConfigSubscription() { config_update_info_.release(); }
 
 absl::Status RdsRouteConfigSubscription::beforeProviderUpdate(
     std::unique_ptr<Init::ManagerImpl>& noop_init_manager, std::unique_ptr<Cleanup>& resume_rds) {
+  if (const auto* config =
+          dynamic_cast<const ConfigImpl*>(config_update_info_->parsedConfiguration().get());
+      config != nullptr) {
+    http_stats_.virtual_host_rebuilt_.add(config->virtualHostsRebuilt());
+    http_stats_.virtual_host_reused_.add(config->virtualHostsReused());
+  }
+
   if (config_update_info_->protobufConfigurationCast().has_vhds() &&
       config_update_info_->vhdsConfigurationChanged()) {
     ENVOY_LOG(debug,
@@ -49,6 +49,20 @@ namespace Router {
 // For friend class declaration in RdsRouteConfigSubscription.
 class ScopedRdsConfigSubscription;
 
+/**
+ * All RDS stats that are specific to HTTP route configurations. @see stats_macros.h
+ */
+#define ALL_HTTP_RDS_STATS(COUNTER)                                                                \
+  COUNTER(virtual_host_rebuilt)                                                                    \
+  COUNTER(virtual_host_reused)
+
+/**
+ * Struct definition for all HTTP specific RDS stats. @see stats_macros.h
+ */
+struct HttpRdsStats {
+  ALL_HTTP_RDS_STATS(GENERATE_COUNTER_STRUCT)
+};
+
 /**
  * A class that fetches the route configuration dynamically using the RDS API and updates them to
  * RDS config providers.
@@ -94,6 +108,7 @@ private:
 
   VhdsSubscriptionPtr vhds_subscription_;
   RouteConfigUpdatePtr config_update_info_;
+  HttpRdsStats http_stats_;
   Common::CallbackManager<> update_callback_manager_;
 
   // Access to addUpdateCallback
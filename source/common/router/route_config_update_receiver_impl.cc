@@ -12,6 +12,7 @@
 #include "source/common/config/resource_name.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/config_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Router {
@@ -44,10 +45,23 @@ ConfigTraitsImpl::createConfig(const Protobuf::Message& rc,
                                Server::Configuration::ServerFactoryContext& factory_context,
                                bool validate_clusters_default) const {
   ASSERT(dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(&rc));
-  return THROW_OR_RETURN_VALUE(
-      ConfigImpl::create(static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc),
-                         factory_context, validator_, validate_clusters_default),
+  const auto& route_config = static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc);
+  if (previous_proto_ == nullptr || !Runtime::runtimeFeatureEnabled(
+                                   "envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts")) {
+    last_config_.reset();
+    return THROW_OR_RETURN_VALUE(
+        ConfigImpl::create(route_config, factory_context, validator_, validate_clusters_default),
+        std::shared_ptr<ConfigImpl>);
+  }
+
+  const std::shared_ptr<const ConfigImpl> previous_config = last_config_.lock();
+  auto config = THROW_OR_RETURN_VALUE(
+      ConfigImpl::createIncremental(route_config, factory_context, validator_,
+                                    validate_clusters_default, previous_config.get(),
+                                    previous_config != nullptr ? &previous_proto_() : nullptr),
       std::shared_ptr<ConfigImpl>);
+  last_config_ = config;
+  return config;
 }
 
 bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include "envoy/config/route/v3/route.pb.h"
@@ -20,7 +21,17 @@ namespace Router {
 
 class ConfigTraitsImpl : public Rds::ConfigTraits {
 public:
-  ConfigTraitsImpl(ProtobufMessage::ValidationVisitor& validator) : validator_(validator) {}
+  // Returns the route configuration the last config created was built from.
+  using PreviousProtoFn = std::function<const envoy::config::route::v3::RouteConfiguration&()>;
+
+  /**
+   * @param previous_proto if set, each config created shares the unchanged virtual hosts of the
+   *        one created before it, comparing against the route configuration this returns. Only
+   *        set this when the configs are successive versions of the same route configuration.
+   */
+  ConfigTraitsImpl(ProtobufMessage::ValidationVisitor& validator,
+                   PreviousProtoFn previous_proto = nullptr)
+      : validator_(validator), previous_proto_(std::move(previous_proto)) {}
 
   Rds::ConfigConstSharedPtr createNullConfig() const override;
   Rds::ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
@@ -29,13 +40,22 @@ public:
 
 private:
   ProtobufMessage::ValidationVisitor& validator_;
+  const PreviousProtoFn previous_proto_;
+  // The last config created, which the next one reuses virtual hosts from. Weak so that this does
+  // not extend the lifetime of a config that has been replaced.
+  mutable std::weak_ptr<const ConfigImpl> last_config_;
 };
 
 class RouteConfigUpdateReceiverImpl : public RouteConfigUpdateReceiver {
 public:
   RouteConfigUpdateReceiverImpl(Rds::ProtoTraits& proto_traits,
                                 Server::Configuration::ServerFactoryContext& factory_context)
-      : config_traits_(factory_context.messageValidationContext().dynamicValidationVisitor()),
+      // The config being replaced is always the one built from the proto held by base_, which is
+      // only replaced once the new config has been created.
+      : config_traits_(factory_context.messageValidationContext().dynamicValidationVisitor(),
+                       [this]() -> const envoy::config::route::v3::RouteConfiguration& {
+                         return protobufConfigurationCast();
+                       }),
         base_(config_traits_, proto_traits, factory_context) {}
 
   using VirtualHostMap = std::map<std::string, envoy::config::route::v3::VirtualHost>;
@@ -0,0 +1,28 @@
+#include "source/common/router/route_path_index.h"
+
+namespace Envoy {
+namespace Router {
+
+void RoutePathIndex::addRoute(absl::optional<absl::string_view> path_prefix) {
+  const uint32_t position = size_++;
+  if (!path_prefix.has_value()) {
+    unindexed_.push_back(position);
+    return;
+  }
+
+  std::string key(path_prefix.value());
+  if (ignore_case_) {
+    absl::AsciiStrToLower(&key);
+  }
+  Bucket* existing = tree_.find(key);
+  if (existing != nullptr) {
+    // Positions are added in increasing order so the bucket stays sorted.
+    existing->push_back(position);
+    return;
+  }
+  buckets_.push_back(std::make_unique<Bucket>(1, position));
+  tree_.add(key, buckets_.back().get());
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/common/radix_tree.h"
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Index over the path matchers of an ordered route list, used to skip the routes that cannot
+ * match a request path without changing which route matches first.
+ *
+ * Routes whose matched paths all start with a known string (prefix, exact path and path separated
+ * prefix routes) are keyed by that string in a radix tree, so for a given path only the routes
+ * keyed by one of its prefixes are candidates. Routes with any other kind of path match (regex,
+ * URI templates, CONNECT) are candidates for every path. Candidates are always visited in their
+ * original order.
+ */
+class RoutePathIndex {
+public:
+  /**
+   * @param ignore_case whether keys and looked up paths are compared ignoring ASCII case. This must
+   *        be set if any indexed route matches its path case insensitively.
+   */
+  explicit RoutePathIndex(bool ignore_case) : ignore_case_(ignore_case) {}
+
+  /**
+   * Adds the route at the next position. Positions are assigned in call order starting at zero.
+   * @param path_prefix a string that every path matched by the route starts with, or
+   *        absl::nullopt if the route must be considered for every path.
+   */
+  void addRoute(absl::optional<absl::string_view> path_prefix);
+
+  /**
+   * @return the number of routes added to the index.
+   */
+  uint32_t size() const { return size_; }
+
+  /**
+   * Calls the callback with the position of every route that may match the path, in increasing
+   * order, until the callback returns false.
+   * @param path the request path with the query, fragment and any ignored path parameters removed.
+   * @param cb a callable taking the route position and returning whether to continue.
+   */
+  template <class Callback> void forEachCandidate(absl::string_view path, Callback&& cb) const {
+    std::string lowered;
+    if (ignore_case_) {
+      lowered = absl::AsciiStrToLower(path);
+      path = lowered;
+    }
+
+    // Each bucket and the unindexed list are sorted, so merge them by repeatedly taking the
+    // smallest head. There is at most one bucket per path prefix, so the number of lists is small.
+    const absl::InlinedVector<Bucket*, 4> buckets = tree_.findMatchingPrefixes(path);
+    absl::InlinedVector<absl::Span<const uint32_t>, 8> lists;
+    lists.reserve(buckets.size() + 1);
+    for (const Bucket* bucket : buckets) {
+      lists.emplace_back(*bucket);
+    }
+    if (!unindexed_.empty()) {
+      lists.emplace_back(unindexed_);
+    }
+
+    while (true) {
+      absl::Span<const uint32_t>* next = nullptr;
+      for (absl::Span<const uint32_t>& list : lists) {
+        if (!list.empty() && (next == nullptr || list.front() < next->front())) {
+          next = &list;
+        }
+      }
+      if (next == nullptr) {
+        return;
+      }
+      const uint32_t position = next->front();
+      next->remove_prefix(1);
+      if (!cb(position)) {
+        return;
+      }
+    }
+  }
+
+private:
+  // Positions of the routes sharing a key, in increasing order.
+  using Bucket = std::vector<uint32_t>;
+
+  const bool ignore_case_;
+  uint32_t size_{};
+  // The tree points into buckets_, which owns the buckets.
+  RadixTree<Bucket*> tree_;
+  std::vector<std::unique_ptr<Bucket>> buckets_;
+  Bucket unindexed_;
+};
+
+} // namespace Router
+} // namespace Envoy
@@ -100,8 +100,16 @@ absl::Status VhdsSubscription::onConfigUpdate(
     added_vhosts.emplace_back(
         dynamic_cast<const envoy::config::route::v3::VirtualHost&>(resource.get().resource()));
   }
-  if (config_update_info_->onVhdsUpdate(added_vhosts, added_resource_ids, removed_resources,
-                                        version_info)) {
+  const bool config_changed = config_update_info_->onVhdsUpdate(
+      added_vhosts, added_resource_ids, removed_resources, version_info);
+  // The route configuration is rebuilt for every update, even one that changes nothing.
+  if (const auto* config =
+          dynamic_cast<const ConfigImpl*>(config_update_info_->parsedConfiguration().get());
+      config != nullptr) {
+    stats_.virtual_host_rebuilt_.add(config->virtualHostsRebuilt());
+    stats_.virtual_host_reused_.add(config->virtualHostsReused());
+  }
+  if (config_changed) {
     stats_.config_reload_.inc();
     ENVOY_LOG(debug, "vhds: loading new configuration: config_name={} hash={}",
               config_update_info_->protobufConfigurationCast().name(),
@@ -30,7 +30,9 @@ namespace Router {
 
 #define ALL_VHDS_STATS(COUNTER)                                                                    \
   COUNTER(config_reload)                                                                           \
-  COUNTER(update_empty)
+  COUNTER(update_empty)                                                                            \
+  COUNTER(virtual_host_rebuilt)                                                                    \
+  COUNTER(virtual_host_reused)
 
 struct VhdsStats {
   ALL_VHDS_STATS(GENERATE_COUNTER_STRUCT)
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
@@ -16,7 +18,11 @@
 #include "source/common/stats/stat_merger.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/base/optimization.h"
+#include "absl/container/fixed_array.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace Stats {
@@ -60,30 +66,111 @@ void AllocatorImpl::debugPrint() {
 #endif
 
 // Counter, Gauge and TextReadout inherit from RefcountInterface and
-// Metric. MetricImpl takes care of most of the Metric API, but we need to cover
-// symbolTable() here, which we don't store directly, but get it via the alloc,
-// which we need in order to clean up the counter and gauge maps in that class
-// when they are destroyed.
-//
-// We implement the RefcountInterface API to avoid weak counter and destructor overhead in
-// shared_ptr.
-template <class BaseClass> class StatsSharedImpl : public MetricImpl<BaseClass> {
+// Metric. The names of a stat are held by one of two bases, FullNamesMetricImpl
+// or CompactMetricImpl, which also cover symbolTable(). Neither stores the
+// SymbolTable directly; they get it via the allocator, which we need in order
+// to clean up the counter and gauge maps in that class when they are destroyed.
+
+// Holds all of a stat's names, and a reference to the allocator.
+template <class BaseClass> class FullNamesMetricImpl : public MetricImpl<BaseClass> {
 public:
-  StatsSharedImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
-                  const StatNameTagVector& stat_name_tags)
+  FullNamesMetricImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
+                      const StatNameTagVector& stat_name_tags)
       : MetricImpl<BaseClass>(name, tag_extracted_name, stat_name_tags, alloc.symbolTable()),
         alloc_(alloc) {}
 
-  ~StatsSharedImpl() override {
+  ~FullNamesMetricImpl() override {
     // MetricImpl must be explicitly cleared() before destruction, otherwise it
     // will not be able to access the SymbolTable& to free the symbols. An RAII
     // alternative would be to store the SymbolTable reference in the
     // MetricImpl, costing 8 bytes per stat.
-    this->clear(symbolTable());
+    this->clear(alloc_.symbolTable());
   }
 
   // Metric
   SymbolTable& symbolTable() final { return alloc_.symbolTable(); }
+
+  AllocatorImpl& allocator() const { return alloc_; }
+
+private:
+  AllocatorImpl& alloc_;
+};
+
+// Holds only a stat's name and tag values, taking the tag-extracted name and
+// the tag names from a MetricShape shared with the other stats of the same
+// shape. The shape also refers to the allocator, so this takes no more room
+// than FullNamesMetricImpl, and the stat's own names take less.
+template <class BaseClass> class CompactMetricImpl : public BaseClass {
+public:
+  CompactMetricImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
+                    const StatNameTagVector& stat_name_tags)
+      : shape_(alloc.acquireShape(tag_extracted_name, tag_extracted_name == name, stat_name_tags)) {
+    const uint32_t num_names = 1 + stat_name_tags.size();
+    absl::FixedArray<StatName> names(num_names);
+    names[0] = name;
+    int index = 0;
+    for (auto& stat_name_tag : stat_name_tags) {
+      names[++index] = stat_name_tag.second;
+    }
+    alloc.symbolTable().populateList(names.begin(), num_names, stat_names_);
+  }
+
+  ~CompactMetricImpl() override {
+    AllocatorImpl& alloc = shape_.allocator();
+    stat_names_.clear(alloc.symbolTable());
+    alloc.releaseShape(shape_);
+  }
+
+  // Metric
+  SymbolTable& symbolTable() final { return shape_.allocator().symbolTable(); }
+  const SymbolTable& constSymbolTable() const override {
+    return shape_.allocator().constSymbolTable();
+  }
+  StatName statName() const override {
+    StatName stat_name;
+    stat_names_.iterate([&stat_name](StatName s) -> bool {
+      stat_name = s;
+      return false; // Returning 'false' stops the iteration.
+    });
+    return stat_name;
+  }
+  StatName tagExtractedStatName() const override {
+    return shape_.tagExtractedIsName() ? statName() : shape_.tagExtractedStatName();
+  }
+  void iterateTagStatNames(const Metric::TagStatNameIterFn& fn) const override {
+    // The tag values follow the name in stat_names_, in the order of the shape's tag names.
+    shape_.iterateTags(stat_names_, 1, fn);
+  }
+  TagVector tags() const override {
+    TagVector tags;
+    const SymbolTable& symbol_table = constSymbolTable();
+    iterateTagStatNames([&tags, &symbol_table](StatName name, StatName value) -> bool {
+      tags.emplace_back(Tag{symbol_table.toString(name), symbol_table.toString(value)});
+      return true;
+    });
+    return tags;
+  }
+  std::string name() const override { return constSymbolTable().toString(statName()); }
+  std::string tagExtractedName() const override {
+    return constSymbolTable().toString(tagExtractedStatName());
+  }
+
+  AllocatorImpl& allocator() const { return shape_.allocator(); }
+
+private:
+  StatNameList stat_names_;
+  const MetricShape& shape_;
+};
+
+// We implement the RefcountInterface API to avoid weak counter and destructor overhead in
+// shared_ptr. MetricBase is FullNamesMetricImpl or CompactMetricImpl.
+template <class MetricBase> class StatsSharedImpl : public MetricBase {
+public:
+  StatsSharedImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
+                  const StatNameTagVector& stat_name_tags)
+      : MetricBase(name, alloc, tag_extracted_name, stat_name_tags) {}
+
+  // Metric
   bool used() const override { return flags_ & Metric::Flags::Used; }
   void markUnused() override { flags_ &= ~Metric::Flags::Used; }
   bool hidden() const override { return flags_ & Metric::Flags::Hidden; }
@@ -102,10 +189,10 @@ public:
     // destruct anything. But it seems preferable at to be conservative here,
     // as stats will only go out of scope when a scope is destructed (during
     // xDS) or during admin stats operations.
-    Thread::LockGuard lock(alloc_.mutex_);
+    Thread::LockGuard lock(this->allocator().mutex_);
     ASSERT(ref_count_ >= 1);
     if (--ref_count_ == 0) {
-      alloc_.sync().syncPoint(AllocatorImpl::DecrementToZeroSyncPoint);
+      this->allocator().sync().syncPoint(AllocatorImpl::DecrementToZeroSyncPoint);
       removeFromSetLockHeld();
       return true;
     }
@@ -118,11 +205,9 @@ public:
    * our ref-count decrement hits zero. The counters and gauges are held in
    * distinct sets so we virtualize this removal helper.
    */
-  virtual void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) PURE;
+  virtual void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(this->allocator().mutex_) PURE;
 
 protected:
-  AllocatorImpl& alloc_;
-
   // ref_count_ can be incremented as an atomic, without taking a new lock, as
   // the critical 0->1 transition occurs in makeCounter and makeGauge, which
   // already hold the lock. Increment also occurs when copying shared pointers,
@@ -137,16 +222,14 @@ protected:
   std::atomic<uint16_t> flags_{0};
 };
 
-class CounterImpl : public StatsSharedImpl<Counter> {
+template <class MetricBase> class CounterImpl : public StatsSharedImpl<MetricBase> {
 public:
-  CounterImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
-              const StatNameTagVector& stat_name_tags)
-      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {}
+  using StatsSharedImpl<MetricBase>::StatsSharedImpl;
 
-  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
-    const size_t count = alloc_.counters_.erase(statName());
+  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(this->allocator().mutex_) override {
+    const size_t count = this->allocator().counters_.erase(this->statName());
     ASSERT(count == 1);
-    alloc_.sinked_counters_.erase(this);
+    this->allocator().sinked_counters_.erase(this);
   }
 
   // Stats::Counter
@@ -155,7 +238,7 @@ public:
     // used(). From a system perspective this should be eventually consistent.
     value_ += amount;
     pending_increment_ += amount;
-    flags_ |= Flags::Used;
+    this->flags_ |= Metric::Flags::Used;
   }
   void inc() override { add(1); }
   uint64_t latch() override { return pending_increment_.exchange(0); }
@@ -167,117 +250,213 @@ private:
   std::atomic<uint64_t> pending_increment_{0};
 };
 
-class GaugeImpl : public StatsSharedImpl<Gauge> {
+namespace {
+
+// The shard of sharded counters that the current thread increments. The server binds the main
+// thread to shard 0 and each worker to the shard after its worker index, so a shard has a single
+// writer and needs no atomic read-modify-write. Other threads are not bound and share an atomic.
+thread_local uint32_t counter_shard_index = AllocatorImpl::NoCounterShard;
+
+} // namespace
+
+void AllocatorImpl::bindThreadToCounterShard(uint32_t index) { counter_shard_index = index; }
+
+// A counter which each bound thread increments in a shard of its own, on its own cache line, rather
+// than in one atomic that every incrementing core must take exclusive ownership of in turn. Unbound
+// threads, and those bound beyond the shards, share an atomic. Reads and latches sum the shards, so
+// they cost more than for CounterImpl, and each counter takes a cache line per shard plus one.
+template <class MetricBase> class ShardedCounterImpl : public StatsSharedImpl<MetricBase> {
+public:
+  ShardedCounterImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
+                     const StatNameTagVector& stat_name_tags, uint32_t num_shards)
+      : StatsSharedImpl<MetricBase>(name, alloc, tag_extracted_name, stat_name_tags),
+        num_shards_(num_shards), shards_(new Shard[num_shards]) {}
+
+  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(this->allocator().mutex_) override {
+    const size_t count = this->allocator().counters_.erase(this->statName());
+    ASSERT(count == 1);
+    this->allocator().sinked_counters_.erase(this);
+  }
+
+  // Stats::Counter
+  void add(uint64_t amount) override {
+    const uint32_t index = counter_shard_index;
+    if (index < num_shards_) {
+      // Only this thread writes the shard, so a load and a store suffice. They are atomic only so
+      // that readers on other threads see whole values.
+      std::atomic<uint64_t>& shard = shards_[index].value_;
+      shard.store(shard.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    } else {
+      shared_.value_.fetch_add(amount, std::memory_order_relaxed);
+    }
+    // Check before setting, so that the flags' cache line is not written on every increment.
+    if ((this->flags_.load(std::memory_order_relaxed) & Metric::Flags::Used) == 0) {
+      this->flags_ |= Metric::Flags::Used;
+    }
+  }
+  void inc() override { add(1); }
+  // Latches are taken on the main thread, which never sees the total go backwards.
+  uint64_t latch() override {
+    const uint64_t total = sum();
+    return total - latched_.exchange(total);
+  }
+  void reset() override { reset_total_ = sum(); }
+  uint64_t value() const override {
+    // A reader other than the one which reset the counter may not yet see the shards it summed.
+    const uint64_t total = sum();
+    const uint64_t reset_total = reset_total_;
+    return total > reset_total ? total - reset_total : 0;
+  }
+
+private:
+  struct alignas(ABSL_CACHELINE_SIZE) Shard {
+    std::atomic<uint64_t> value_{0};
+  };
+
+  uint64_t sum() const {
+    uint64_t total = shared_.value_.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < num_shards_; ++i) {
+      total += shards_[i].value_.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  const uint32_t num_shards_;
+  const std::unique_ptr<Shard[]> shards_;
+  Shard shared_;
+  // The total at the last latch and at the last reset. Both are only written on the main thread.
+  std::atomic<uint64_t> latched_{0};
+  std::atomic<uint64_t> reset_total_{0};
+};
+
+template <class MetricBase> class GaugeImpl : public StatsSharedImpl<MetricBase> {
 public:
   GaugeImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
-            const StatNameTagVector& stat_name_tags, ImportMode import_mode)
-      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {
+            const StatNameTagVector& stat_name_tags, Gauge::ImportMode import_mode)
+      : StatsSharedImpl<MetricBase>(name, alloc, tag_extracted_name, stat_name_tags) {
     switch (import_mode) {
-    case ImportMode::Accumulate:
-      flags_ |= Flags::LogicAccumulate;
+    case Gauge::ImportMode::Accumulate:
+      this->flags_ |= Metric::Flags::LogicAccumulate;
       break;
-    case ImportMode::NeverImport:
-      flags_ |= Flags::NeverImport;
+    case Gauge::ImportMode::NeverImport:
+      this->flags_ |= Metric::Flags::NeverImport;
       break;
-    case ImportMode::Uninitialized:
+    case Gauge::ImportMode::Uninitialized:
       // Note that we don't clear any flag bits for import_mode==Uninitialized,
       // as we may have an established import_mode when this stat was created in
       // an alternate scope. See
       // https://github.com/envoyproxy/envoy/issues/7227.
       break;
-    case ImportMode::HiddenAccumulate:
-      flags_ |= Flags::Hidden;
-      flags_ |= Flags::LogicAccumulate;
+    case Gauge::ImportMode::HiddenAccumulate:
+      this->flags_ |= Metric::Flags::Hidden;
+      this->flags_ |= Metric::Flags::LogicAccumulate;
       break;
     }
   }
 
-  void removeFromSetLockHeld() override ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) {
-    const size_t count = alloc_.gauges_.erase(statName());
+  void removeFromSetLockHeld() override ABSL_EXCLUSIVE_LOCKS_REQUIRED(this->allocator().mutex_) {
+    const size_t count = this->allocator().gauges_.erase(this->statName());
     ASSERT(count == 1);
-    alloc_.sinked_gauges_.erase(this);
+    this->allocator().sinked_gauges_.erase(this);
   }
 
   // Stats::Gauge
   void add(uint64_t amount) override {
     child_value_ += amount;
-    flags_ |= Flags::Used;
+    this->flags_ |= Metric::Flags::Used | Metric::Flags::Changed;
   }
   void dec() override { sub(1); }
   void inc() override { add(1); }
   void set(uint64_t value) override {
     child_value_ = value;
-    flags_ |= Flags::Used;
+    this->flags_ |= Metric::Flags::Used | Metric::Flags::Changed;
   }
   void sub(uint64_t amount) override {
     ASSERT(child_value_ >= amount);
-    ASSERT(used() || amount == 0);
+    ASSERT(this->used() || amount == 0);
     child_value_ -= amount;
+    // Most decrements follow an increment within the same flush interval, so the flag is usually
+    // set already and the read-modify-write can be skipped.
+    if (!(this->flags_.load(std::memory_order_relaxed) & Metric::Flags::Changed)) {
+      this->flags_ |= Metric::Flags::Changed;
+    }
   }
   uint64_t value() const override { return child_value_ + parent_value_; }
+  bool latchChanged() override {
+    if (!(this->flags_.load(std::memory_order_relaxed) & Metric::Flags::Changed)) {
+      return false;
+    }
+    this->flags_ &= ~Metric::Flags::Changed;
+    return true;
+  }
 
   // TODO(diazalan): Rename importMode and to more generic name
-  ImportMode importMode() const override {
-    if (flags_ & Flags::NeverImport) {
-      return ImportMode::NeverImport;
-    } else if ((flags_ & Flags::Hidden) && (flags_ & Flags::LogicAccumulate)) {
-      return ImportMode::HiddenAccumulate;
-    } else if (flags_ & Flags::LogicAccumulate) {
-      return ImportMode::Accumulate;
+  Gauge::ImportMode importMode() const override {
+    if (this->flags_ & Metric::Flags::NeverImport) {
+      return Gauge::ImportMode::NeverImport;
+    } else if ((this->flags_ & Metric::Flags::Hidden) &&
+               (this->flags_ & Metric::Flags::LogicAccumulate)) {
+      return Gauge::ImportMode::HiddenAccumulate;
+    } else if (this->flags_ & Metric::Flags::LogicAccumulate) {
+      return Gauge::ImportMode::Accumulate;
     }
-    return ImportMode::Uninitialized;
+    return Gauge::ImportMode::Uninitialized;
   }
 
   // TODO(diazalan): Rename mergeImportMode and to more generic name
-  void mergeImportMode(ImportMode import_mode) override {
-    ImportMode current = importMode();
+  void mergeImportMode(Gauge::ImportMode import_mode) override {
+    Gauge::ImportMode current = importMode();
     if (current == import_mode) {
       return;
     }
 
     switch (import_mode) {
-    case ImportMode::Uninitialized:
+    case Gauge::ImportMode::Uninitialized:
       // mergeImportNode(ImportMode::Uninitialized) is called when merging an
       // existing stat with importMode() == Accumulate or NeverImport.
       break;
-    case ImportMode::Accumulate:
-      ASSERT(current == ImportMode::Uninitialized);
-      flags_ |= Flags::LogicAccumulate;
+    case Gauge::ImportMode::Accumulate:
+      ASSERT(current == Gauge::ImportMode::Uninitialized);
+      this->flags_ |= Metric::Flags::LogicAccumulate;
       break;
-    case ImportMode::NeverImport:
-      ASSERT(current == ImportMode::Uninitialized);
+    case Gauge::ImportMode::NeverImport:
+      ASSERT(current == Gauge::ImportMode::Uninitialized);
       // A previous revision of Envoy may have transferred a gauge that it
       // thought was Accumulate. But the new version thinks it's NeverImport, so
       // we clear the accumulated value.
       parent_value_ = 0;
-      flags_ &= ~Flags::Used;
-      flags_ |= Flags::NeverImport;
+      this->flags_ &= ~Metric::Flags::Used;
+      this->flags_ |= Metric::Flags::NeverImport;
       break;
-    case ImportMode::HiddenAccumulate:
-      ASSERT(current == ImportMode::Uninitialized);
-      flags_ |= Flags::Hidden;
-      flags_ |= Flags::LogicAccumulate;
+    case Gauge::ImportMode::HiddenAccumulate:
+      ASSERT(current == Gauge::ImportMode::Uninitialized);
+      this->flags_ |= Metric::Flags::Hidden;
+      this->flags_ |= Metric::Flags::LogicAccumulate;
       break;
     }
   }
 
-  void setParentValue(uint64_t value) override { parent_value_ = value; }
+  void setParentValue(uint64_t value) override {
+    if (parent_value_.exchange(value) != value) {
+      this->flags_ |= Metric::Flags::Changed;
+    }
+  }
 
 private:
   std::atomic<uint64_t> parent_value_{0};
   std::atomic<uint64_t> child_value_{0};
 };
 
-class TextReadoutImpl : public StatsSharedImpl<TextReadout> {
+template <class MetricBase> class TextReadoutImpl : public StatsSharedImpl<MetricBase> {
 public:
   TextReadoutImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
                   const StatNameTagVector& stat_name_tags)
-      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {}
+      : StatsSharedImpl<MetricBase>(name, alloc, tag_extracted_name, stat_name_tags) {}
 
-  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
-    const size_t count = alloc_.text_readouts_.erase(statName());
+  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(this->allocator().mutex_) override {
+    const size_t count = this->allocator().text_readouts_.erase(this->statName());
     ASSERT(count == 1);
-    alloc_.sinked_text_readouts_.erase(this);
+    this->allocator().sinked_text_readouts_.erase(this);
   }
 
   // Stats::TextReadout
@@ -285,7 +464,7 @@ public:
     std::string value_copy(value);
     absl::MutexLock lock(&mutex_);
     value_ = std::move(value_copy);
-    flags_ |= Flags::Used;
+    this->flags_ |= Metric::Flags::Used;
   }
   std::string value() const override {
     absl::MutexLock lock(&mutex_);
@@ -326,8 +505,14 @@ GaugeSharedPtr AllocatorImpl::makeGauge(StatName name, StatName tag_extracted_na
   if (iter != gauges_.end()) {
     return {*iter};
   }
-  auto gauge =
-      GaugeSharedPtr(new GaugeImpl(name, *this, tag_extracted_name, stat_name_tags, import_mode));
+  GaugeSharedPtr gauge;
+  if (compact_names_) {
+    gauge = GaugeSharedPtr(new GaugeImpl<CompactMetricImpl<Gauge>>(
+        name, *this, tag_extracted_name, stat_name_tags, import_mode));
+  } else {
+    gauge = GaugeSharedPtr(new GaugeImpl<FullNamesMetricImpl<Gauge>>(
+        name, *this, tag_extracted_name, stat_name_tags, import_mode));
+  }
   gauges_.insert(gauge.get());
   // Add gauge to sinked_gauges_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeGauge(*gauge)) {
@@ -346,8 +531,14 @@ TextReadoutSharedPtr AllocatorImpl::makeTextReadout(StatName name, StatName tag_
   if (iter != text_readouts_.end()) {
     return {*iter};
   }
-  auto text_readout =
-      TextReadoutSharedPtr(new TextReadoutImpl(name, *this, tag_extracted_name, stat_name_tags));
+  TextReadoutSharedPtr text_readout;
+  if (compact_names_) {
+    text_readout = TextReadoutSharedPtr(new TextReadoutImpl<CompactMetricImpl<TextReadout>>(
+        name, *this, tag_extracted_name, stat_name_tags));
+  } else {
+    text_readout = TextReadoutSharedPtr(new TextReadoutImpl<FullNamesMetricImpl<TextReadout>>(
+        name, *this, tag_extracted_name, stat_name_tags));
+  }
   text_readouts_.insert(text_readout.get());
   // Add text_readout to sinked_text_readouts_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeTextReadout(*text_readout)) {
@@ -367,7 +558,134 @@ bool AllocatorImpl::isMutexLockedForTest() {
 
 Counter* AllocatorImpl::makeCounterInternal(StatName name, StatName tag_extracted_name,
                                             const StatNameTagVector& stat_name_tags) {
-  return new CounterImpl(name, *this, tag_extracted_name, stat_name_tags);
+  const bool sharded = counter_shards_ > 0 && !counter_shard_matcher_->rejects(name);
+  if (compact_names_) {
+    if (sharded) {
+      return new ShardedCounterImpl<CompactMetricImpl<Counter>>(
+          name, *this, tag_extracted_name, stat_name_tags, counter_shards_);
+    }
+    return new CounterImpl<CompactMetricImpl<Counter>>(name, *this, tag_extracted_name,
+                                                       stat_name_tags);
+  }
+  if (sharded) {
+    return new ShardedCounterImpl<FullNamesMetricImpl<Counter>>(
+        name, *this, tag_extracted_name, stat_name_tags, counter_shards_);
+  }
+  return new CounterImpl<FullNamesMetricImpl<Counter>>(name, *this, tag_extracted_name,
+                                                       stat_name_tags);
+}
+
+void AllocatorImpl::setCounterSharding(uint32_t num_shards, StatsMatcherPtr&& matcher) {
+  Thread::LockGuard lock(mutex_);
+  counter_shards_ = matcher != nullptr ? num_shards : 0;
+  counter_shard_matcher_ = std::move(matcher);
+}
+
+void AllocatorImpl::setCompactNames(bool compact) {
+  Thread::LockGuard lock(mutex_);
+  compact_names_ = compact;
+}
+
+const MetricShape& AllocatorImpl::acquireShape(StatName tag_extracted_name,
+                                               bool tag_extracted_is_name,
+                                               const StatNameTagVector& stat_name_tags) {
+  const MetricShape::Key key{tag_extracted_name, tag_extracted_is_name, stat_name_tags};
+  Thread::LockGuard lock(shapes_mutex_);
+  auto iter = shapes_.find(key);
+  MetricShape* shape;
+  if (iter != shapes_.end()) {
+    shape = *iter;
+  } else {
+    shape = new MetricShape(*this, key);
+    shapes_.insert(shape);
+  }
+  ++shape->ref_count_;
+  return *shape;
+}
+
+void AllocatorImpl::releaseShape(const MetricShape& const_shape) {
+  // The shape was created non-const by acquireShape().
+  MetricShape* shape = const_cast<MetricShape*>(&const_shape);
+  Thread::LockGuard lock(shapes_mutex_);
+  ASSERT(shape->ref_count_ >= 1);
+  if (--shape->ref_count_ == 0) {
+    shapes_.erase(shape);
+    shape->names_.clear(symbol_table_);
+    delete shape;
+  }
+}
+
+size_t AllocatorImpl::numShapesForTest() const {
+  Thread::LockGuard lock(shapes_mutex_);
+  return shapes_.size();
+}
+
+MetricShape::MetricShape(AllocatorImpl& alloc, const Key& key)
+    : alloc_(alloc), hash_(key.hash_), tag_extracted_is_name_(key.tag_extracted_is_name_),
+      num_tags_(key.stat_name_tags_.size()) {
+  const uint32_t num_names = (tag_extracted_is_name_ ? 0 : 1) + num_tags_;
+  absl::FixedArray<StatName> names(num_names);
+  int index = 0;
+  if (!tag_extracted_is_name_) {
+    names[index++] = key.tag_extracted_name_;
+  }
+  for (auto& stat_name_tag : key.stat_name_tags_) {
+    names[index++] = stat_name_tag.first;
+  }
+  alloc.symbolTable().populateList(names.begin(), num_names, names_);
+}
+
+MetricShape::~MetricShape() {
+  // The names must be freed by AllocatorImpl::releaseShape, which has the SymbolTable.
+  ASSERT(!names_.populated());
+}
+
+StatName MetricShape::tagExtractedStatName() const {
+  ASSERT(!tag_extracted_is_name_);
+  StatName tag_extracted_name;
+  names_.iterate([&tag_extracted_name](StatName s) -> bool {
+    tag_extracted_name = s;
+    return false; // Returning 'false' stops the iteration.
+  });
+  return tag_extracted_name;
+}
+
+void MetricShape::iterateTagNames(const std::function<bool(StatName)>& fn) const {
+  bool skip = !tag_extracted_is_name_;
+  names_.iterate([&fn, &skip](StatName s) -> bool {
+    if (skip) {
+      skip = false;
+      return true;
+    }
+    return fn(s);
+  });
+}
+
+bool MetricShape::matches(const Key& key) const {
+  if (hash_ != key.hash_ || tag_extracted_is_name_ != key.tag_extracted_is_name_ ||
+      num_tags_ != key.stat_name_tags_.size()) {
+    return false;
+  }
+  if (!tag_extracted_is_name_ && tagExtractedStatName() != key.tag_extracted_name_) {
+    return false;
+  }
+  bool matches = true;
+  uint32_t index = 0;
+  iterateTagNames([&key, &matches, &index](StatName tag_name) -> bool {
+    matches = tag_name == key.stat_name_tags_[index++].first;
+    return matches;
+  });
+  return matches;
+}
+
+MetricShape::Key::Key(StatName tag_extracted_name, bool tag_extracted_is_name,
+                      const StatNameTagVector& stat_name_tags)
+    : tag_extracted_name_(tag_extracted_name), tag_extracted_is_name_(tag_extracted_is_name),
+      stat_name_tags_(stat_name_tags) {
+  hash_ = tag_extracted_is_name_ ? 0 : tag_extracted_name_.hash();
+  for (const auto& stat_name_tag : stat_name_tags_) {
+    hash_ = absl::HashOf(hash_, stat_name_tag.first.hash());
+  }
 }
 
 void AllocatorImpl::forEachCounter(SizeFn f_size, StatFn<Counter> f_stat) const {
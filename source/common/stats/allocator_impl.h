@@ -1,11 +1,14 @@
 #pragma once
 
+#include <functional>
+#include <limits>
 #include <vector>
 
 #include "envoy/common/optref.h"
 #include "envoy/stats/allocator.h"
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/stats_matcher.h"
 
 #include "source/common/common/thread_synchronizer.h"
 #include "source/common/stats/metric_impl.h"
@@ -16,6 +19,84 @@
 namespace Envoy {
 namespace Stats {
 
+class AllocatorImpl;
+
+/**
+ * The names which all the stats of one shape, such as the same stat of each
+ * cluster, have in common: the tag-extracted name and the tag names. When
+ * compact names are enabled, AllocatorImpl interns shapes and shares them
+ * between stats, which then hold only their own name and tag values.
+ */
+class MetricShape {
+public:
+  // Describes a shape, for lookups.
+  struct Key {
+    Key(StatName tag_extracted_name, bool tag_extracted_is_name,
+        const StatNameTagVector& stat_name_tags);
+
+    const StatName tag_extracted_name_;
+    // Set for stats whose tag-extracted name is the stat's own name, so that
+    // all such stats without tags share one shape.
+    const bool tag_extracted_is_name_;
+    const StatNameTagVector& stat_name_tags_;
+    size_t hash_;
+  };
+
+  MetricShape(AllocatorImpl& alloc, const Key& key);
+  ~MetricShape();
+
+  AllocatorImpl& allocator() const { return alloc_; }
+  bool tagExtractedIsName() const { return tag_extracted_is_name_; }
+
+  /**
+   * @return the tag-extracted name; only valid if !tagExtractedIsName().
+   */
+  StatName tagExtractedStatName() const;
+
+  /**
+   * Calls fn with each tag name, in order, until it returns false.
+   */
+  void iterateTagNames(const std::function<bool(StatName)>& fn) const;
+
+  /**
+   * Calls fn with each tag name and the corresponding tag value, in order, until it returns
+   * false. Neither list is copied.
+   * @param values a list holding the tag values, in the order of the tag names.
+   * @param values_skip the number of elements of values which precede the tag values.
+   */
+  void iterateTags(const StatNameList& values, uint32_t values_skip,
+                   const std::function<bool(StatName, StatName)>& fn) const {
+    names_.iterateWith(tag_extracted_is_name_ ? 0 : 1, values, values_skip, fn);
+  }
+
+  bool matches(const Key& key) const;
+
+  struct Hash {
+    using is_transparent = void; // NOLINT(readability-identifier-naming)
+    size_t operator()(const MetricShape* a) const { return a->hash_; }
+    size_t operator()(const Key& a) const { return a.hash_; }
+  };
+
+  struct Compare {
+    using is_transparent = void; // NOLINT(readability-identifier-naming)
+    bool operator()(const MetricShape* a, const MetricShape* b) const { return a == b; }
+    bool operator()(const MetricShape* a, const Key& b) const { return a->matches(b); }
+    bool operator()(const Key& a, const MetricShape* b) const { return b->matches(a); }
+  };
+
+private:
+  friend class AllocatorImpl;
+
+  AllocatorImpl& alloc_;
+  // The tag-extracted name, unless tag_extracted_is_name_, followed by the tag names.
+  StatNameList names_;
+  const size_t hash_;
+  const bool tag_extracted_is_name_;
+  const uint32_t num_tags_;
+  // Guarded by AllocatorImpl::shapes_mutex_.
+  uint32_t ref_count_{0};
+};
+
 class AllocatorImpl : public Allocator {
 public:
   static const char DecrementToZeroSyncPoint[];
@@ -45,6 +126,19 @@ public:
   void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const override;
 
   void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) override;
+  void setCounterSharding(uint32_t num_shards, StatsMatcherPtr&& matcher) override;
+
+  static constexpr uint32_t NoCounterShard = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * Binds the calling thread to a shard of sharded counters. At most one thread may be bound to
+   * each index, as the bound thread writes its shard without atomic read-modify-writes. Threads
+   * which are not bound, or bound to an index beyond a counter's shards, share an atomic.
+   * @param index the shard index, or NoCounterShard to unbind the thread.
+   */
+  static void bindThreadToCounterShard(uint32_t index);
+
+  void setCompactNames(bool compact) override;
 #ifndef ENVOY_CONFIG_COVERAGE
   void debugPrint();
 #endif
@@ -63,15 +157,32 @@ public:
   void markGaugeForDeletion(const GaugeSharedPtr& gauge) override;
   void markTextReadoutForDeletion(const TextReadoutSharedPtr& text_readout) override;
 
+  /**
+   * Finds or creates the shape of a stat, and takes a reference to it.
+   */
+  const MetricShape& acquireShape(StatName tag_extracted_name, bool tag_extracted_is_name,
+                                  const StatNameTagVector& stat_name_tags);
+
+  /**
+   * Drops a reference taken by acquireShape(), deleting the shape with its last reference.
+   */
+  void releaseShape(const MetricShape& shape);
+
+  /**
+   * @return the number of distinct stat shapes, exposed for testing purposes.
+   */
+  size_t numShapesForTest() const;
+
 protected:
   virtual Counter* makeCounterInternal(StatName name, StatName tag_extracted_name,
                                        const StatNameTagVector& stat_name_tags);
 
 private:
-  template <class BaseClass> friend class StatsSharedImpl;
-  friend class CounterImpl;
-  friend class GaugeImpl;
-  friend class TextReadoutImpl;
+  template <class MetricBase> friend class StatsSharedImpl;
+  template <class MetricBase> friend class CounterImpl;
+  template <class MetricBase> friend class ShardedCounterImpl;
+  template <class MetricBase> friend class GaugeImpl;
+  template <class MetricBase> friend class TextReadoutImpl;
   friend class NotifyingAllocatorImpl;
 
   // A mutex is needed here to protect both the stats_ object from both
@@ -90,6 +201,20 @@ private:
   StatPointerSet<Gauge> sinked_gauges_ ABSL_GUARDED_BY(mutex_);
   StatPointerSet<TextReadout> sinked_text_readouts_ ABSL_GUARDED_BY(mutex_);
 
+  // Counters not rejected by counter_shard_matcher_ are sharded over counter_shards_ threads.
+  // These are written with mutex_ held, and read in makeCounterInternal(), which is always called
+  // with mutex_ held; they are not annotated as guarded as subclasses override that method.
+  uint32_t counter_shards_{0};
+  StatsMatcherPtr counter_shard_matcher_;
+  // Whether stats created from now on share their shapes; also written with mutex_ held.
+  bool compact_names_{false};
+
+  // The shapes of stats with compact names. This has its own mutex, as shapes are acquired with
+  // mutex_ held, but released without it, when stats are destroyed.
+  mutable Thread::MutexBasicLockable shapes_mutex_;
+  absl::flat_hash_set<MetricShape*, MetricShape::Hash, MetricShape::Compare>
+      shapes_ ABSL_GUARDED_BY(shapes_mutex_);
+
   // Predicates used to filter stats to be flushed.
   std::unique_ptr<SinkPredicates> sink_predicates_;
   SymbolTable& symbol_table_;
@@ -4,7 +4,6 @@
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats.h"
 
-#include "source/common/common/cleanup.h"
 #include "source/common/common/thread.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stats/utility.h"
@@ -24,43 +23,59 @@ namespace Stats {
 template <typename StatsStructType>
 class DeferredStats : public DeferredCreationCompatibleInterface<StatsStructType> {
 public:
-  // Capture the stat names object and the scope with a ctor, that can be used to instantiate a
-  // StatsStructType object later.
-  // Caller should make sure scope and stat_names outlive this object.
+  // Capture the stat names object, the scope and an optional prefix, that can be used to
+  // instantiate a StatsStructType object later.
+  // Caller should make sure stat_names and the storage of prefix outlive this object.
   DeferredStats(const typename StatsStructType::StatNameType& stat_names,
-                Stats::ScopeSharedPtr scope)
-      : initialized_(
+                Stats::ScopeSharedPtr scope, StatName prefix = StatName())
+      : stat_names_(stat_names), scope_(std::move(scope)), prefix_(prefix),
+        initialized_(
             // A lambda is used as we need to register the name into the symbol table.
-            // Note: there is no issue to capture a reference of the scope here as this lambda is
-            // only used to initialize the 'initialized_' Gauge.
-            [&scope]() -> Gauge& {
-              Stats::StatNamePool pool(scope->symbolTable());
-              return Stats::Utility::gaugeFromElements(
-                  *scope, {pool.add(StatsStructType::typeName()), pool.add("initialized")},
-                  Stats::Gauge::ImportMode::HiddenAccumulate);
-            }()),
-        ctor_([this, &stat_names, stats_scope = std::move(scope)]() -> StatsStructType* {
-          initialized_.inc();
-          // Reset ctor_ to save some RAM.
-          Cleanup reset_ctor([this] { ctor_ = nullptr; });
-          return new StatsStructType(stat_names, *stats_scope);
-        }) {
+            [this]() -> Gauge& {
+              Stats::StatNamePool pool(scope_->symbolTable());
+              Stats::ElementVec elements;
+              if (!prefix_.empty()) {
+                elements.push_back(prefix_);
+              }
+              elements.push_back(pool.add(StatsStructType::typeName()));
+              elements.push_back(pool.add("initialized"));
+              return Stats::Utility::gaugeFromElements(*scope_, elements,
+                                                       Stats::Gauge::ImportMode::HiddenAccumulate);
+            }()) {
     if (initialized_.value() > 0) {
       getOrCreateHelper();
     }
   }
   ~DeferredStats() override {
-    if (ctor_ == nullptr) {
+    if (isPresent()) {
       initialized_.dec();
     }
   }
   inline StatsStructType& getOrCreate() override { return getOrCreateHelper(); }
   bool isPresent() const override { return !internal_stats_.isNull(); }
+  void forEachUncreatedStatName(const DeferredStatNameFn& counter_fn,
+                                const DeferredStatNameFn& gauge_fn) const override {
+    if (isPresent()) {
+      return;
+    }
+    StatsStructType::forEachCounterAndGaugeName(
+        stat_names_, [this, &counter_fn](StatName name) { counter_fn(prefix_, name); },
+        [this, &gauge_fn](StatName name) { gauge_fn(prefix_, name); });
+  }
 
 private:
   // We can't call getOrCreate directly from constructor, otherwise the compiler complains about
   // bypassing virtual dispatch even though it's fine.
-  inline StatsStructType& getOrCreateHelper() { return *internal_stats_.get(ctor_); }
+  inline StatsStructType& getOrCreateHelper() {
+    return *internal_stats_.get([this]() -> StatsStructType* {
+      initialized_.inc();
+      return new StatsStructType(stat_names_, *scope_, prefix_);
+    });
+  }
+
+  const typename StatsStructType::StatNameType& stat_names_;
+  const Stats::ScopeSharedPtr scope_;
+  const StatName prefix_;
 
   // In order to preserve stat value continuity across a config reload, we need to automatically
   // re-instantiate lazy stats when they are constructed, if there is already a live instantiation
@@ -78,9 +93,6 @@ private:
   // name to the previous generation's cluster's lazy-init block. We use the value in this shared
   // gauge to determine whether to instantiate the lazy block on construction.
   Gauge& initialized_;
-  // TODO(#26957): Clean up this ctor_ by moving its ownership to AtomicPtr, and drop
-  // the setter lambda when the nested object is created.
-  std::function<StatsStructType*()> ctor_;
   Thread::AtomicPtr<StatsStructType, Thread::AtomicPtrAllocMode::DeleteOnDestruct> internal_stats_;
 };
 
@@ -90,10 +102,13 @@ private:
 template <typename StatsStructType>
 class DirectStats : public DeferredCreationCompatibleInterface<StatsStructType> {
 public:
-  DirectStats(const typename StatsStructType::StatNameType& stat_names, Stats::Scope& scope)
-      : stats_(stat_names, scope) {}
+  DirectStats(const typename StatsStructType::StatNameType& stat_names, Stats::Scope& scope,
+              StatName prefix = StatName())
+      : stats_(stat_names, scope, prefix) {}
   inline StatsStructType& getOrCreate() override { return stats_; }
   bool isPresent() const override { return true; }
+  void forEachUncreatedStatName(const DeferredStatNameFn&,
+                                const DeferredStatNameFn&) const override {}
 
 private:
   StatsStructType stats_;
@@ -102,18 +117,18 @@ private:
 // Template that lazily initializes a StatsStruct.
 // The bootstrap config :ref:`enable_deferred_creation_stats
 // <envoy_v3_api_field_config.bootstrap.v3.Bootstrap.deferred_stat_options>` decides if
-// stats lazy initialization is enabled or not.
+// stats lazy initialization is enabled or not. The optional prefix is prepended to each stat name.
 template <typename StatsStructType>
 DeferredCreationCompatibleStats<StatsStructType>
 createDeferredCompatibleStats(Stats::ScopeSharedPtr scope,
                               const typename StatsStructType::StatNameType& stat_names,
-                              bool defer_creation) {
+                              bool defer_creation, StatName prefix = StatName()) {
   if (defer_creation) {
     return DeferredCreationCompatibleStats<StatsStructType>(
-        std::make_unique<DeferredStats<StatsStructType>>(stat_names, scope));
+        std::make_unique<DeferredStats<StatsStructType>>(stat_names, scope, prefix));
   } else {
     return DeferredCreationCompatibleStats<StatsStructType>(
-        std::make_unique<DirectStats<StatsStructType>>(stat_names, *scope));
+        std::make_unique<DirectStats<StatsStructType>>(stat_names, *scope, prefix));
   }
 }
 
@@ -7,6 +7,7 @@
 
 #include "source/common/common/utility.h"
 
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/match.h"
 
 namespace Envoy {
@@ -17,27 +18,34 @@ namespace Stats {
 StatsMatcherImpl::StatsMatcherImpl(const envoy::config::metrics::v3::StatsConfig& config,
                                    SymbolTable& symbol_table,
                                    Server::Configuration::CommonFactoryContext& context)
+    : StatsMatcherImpl(config.stats_matcher(), symbol_table, context) {}
+
+StatsMatcherImpl::StatsMatcherImpl(const envoy::config::metrics::v3::StatsMatcher& config,
+                                   SymbolTable& symbol_table,
+                                   Server::Configuration::CommonFactoryContext& context)
     : symbol_table_(symbol_table), stat_name_pool_(std::make_unique<StatNamePool>(symbol_table)) {
 
-  switch (config.stats_matcher().stats_matcher_case()) {
+  switch (config.stats_matcher_case()) {
   case envoy::config::metrics::v3::StatsMatcher::StatsMatcherCase::kRejectAll:
     // In this scenario, there are no matchers to store.
-    is_inclusive_ = !config.stats_matcher().reject_all();
+    is_inclusive_ = !config.reject_all();
     break;
   case envoy::config::metrics::v3::StatsMatcher::StatsMatcherCase::kInclusionList:
     // If we have an inclusion list, we are being default-exclusive.
-    for (const auto& stats_matcher : config.stats_matcher().inclusion_list().patterns()) {
+    for (const auto& stats_matcher : config.inclusion_list().patterns()) {
       matchers_.push_back(Matchers::StringMatcherImpl(stats_matcher, context));
       optimizeLastMatcher();
     }
+    optimizeRegexes();
     is_inclusive_ = false;
     break;
   case envoy::config::metrics::v3::StatsMatcher::StatsMatcherCase::kExclusionList:
     // If we have an exclusion list, we are being default-inclusive.
-    for (const auto& stats_matcher : config.stats_matcher().exclusion_list().patterns()) {
+    for (const auto& stats_matcher : config.exclusion_list().patterns()) {
       matchers_.push_back(Matchers::StringMatcherImpl(stats_matcher, context));
       optimizeLastMatcher();
     }
+    optimizeRegexes();
     FALLTHRU;
   default:
     // No matcher was supplied, so we default to inclusion.
@@ -46,14 +54,27 @@ StatsMatcherImpl::StatsMatcherImpl(const envoy::config::metrics::v3::StatsConfig
   }
 }
 
+void StatsMatcherImpl::SymbolTrie::insert(const SymbolVec& symbols) {
+  uint32_t node = 0;
+  for (Symbol symbol : symbols) {
+    auto [iter, inserted] = edges_.try_emplace(std::make_pair(node, symbol), terminal_.size());
+    if (inserted) {
+      terminal_.push_back(false);
+    }
+    node = iter->second;
+  }
+  terminal_[node] = true;
+}
+
 // If the last string-matcher added is a case-sensitive prefix match, and the
-// prefix ends in ".", then this drops that match and adds it to a list of
-// prefixes. This is beneficial because token prefixes can be handled more
-// efficiently as a StatName without requiring conversion to a string.
+// prefix ends in ".", then this drops that match and adds it to a trie of
+// prefixes. Likewise a case-sensitive suffix match beginning with "." is added
+// to a trie of reversed suffixes. This is beneficial because token-aligned
+// prefixes and suffixes can be handled more efficiently as a StatName without
+// requiring conversion to a string.
 //
 // In the future, other matcher patterns could be optimized in a similar way,
 // such as:
-//   * suffixes that begin with "."
 //   * exact-matches
 //   * substrings that begin and end with "."
 //
@@ -61,21 +82,66 @@ StatsMatcherImpl::StatsMatcherImpl(const envoy::config::metrics::v3::StatsConfig
 // and because we haven't observed an acute performance need to optimize those
 // other patterns yet.
 void StatsMatcherImpl::optimizeLastMatcher() {
-  std::string prefix;
-  if (matchers_.back().getCaseSensitivePrefixMatch(prefix) && absl::EndsWith(prefix, ".") &&
-      prefix.size() > 1) {
-    prefixes_.push_back(stat_name_pool_->add(prefix.substr(0, prefix.size() - 1)));
+  std::string pattern;
+  if (matchers_.back().getCaseSensitivePrefixMatch(pattern) && absl::EndsWith(pattern, ".") &&
+      pattern.size() > 1) {
+    prefixes_.insert(SymbolTable::Encoding::decodeSymbols(
+        stat_name_pool_->add(pattern.substr(0, pattern.size() - 1))));
     matchers_.pop_back();
+  } else if (matchers_.back().getCaseSensitiveSuffixMatch(pattern) &&
+             absl::StartsWith(pattern, ".") && pattern.size() > 1 &&
+             !absl::EndsWith(pattern, ".") && !absl::StrContains(pattern, "..")) {
+    SymbolVec symbols =
+        SymbolTable::Encoding::decodeSymbols(stat_name_pool_->add(pattern.substr(1)));
+    std::reverse(symbols.begin(), symbols.end());
+    suffixes_.insert(symbols);
+    suffix_matchers_.push_back(std::move(matchers_.back()));
+    matchers_.pop_back();
+  }
+}
+
+// Moves the regexes evaluated by the Google RE2 engine into a single
+// re2::RE2::Set. This is only worthwhile when there is more than one such
+// regex; if the set cannot be compiled the regexes are left as they are.
+void StatsMatcherImpl::optimizeRegexes() {
+  std::vector<std::string> patterns;
+  std::vector<Matchers::StringMatcherImpl> other_matchers;
+  for (Matchers::StringMatcherImpl& matcher : matchers_) {
+    std::string pattern;
+    if (matcher.getGoogleReRegex(pattern)) {
+      patterns.push_back(std::move(pattern));
+      regex_matchers_.push_back(std::move(matcher));
+    } else {
+      other_matchers.push_back(std::move(matcher));
+    }
+  }
+  auto regex_set = std::make_unique<re2::RE2::Set>(re2::RE2::Quiet, re2::RE2::ANCHOR_BOTH);
+  bool ok = patterns.size() > 1;
+  for (const std::string& pattern : patterns) {
+    ok = ok && regex_set->Add(pattern, nullptr) >= 0;
+  }
+  if (ok && regex_set->Compile()) {
+    regex_set_ = std::move(regex_set);
+    matchers_ = std::move(other_matchers);
+    return;
   }
+  // Restore the original matchers; their order does not affect the result.
+  for (Matchers::StringMatcherImpl& matcher : regex_matchers_) {
+    other_matchers.push_back(std::move(matcher));
+  }
+  regex_matchers_.clear();
+  matchers_ = std::move(other_matchers);
 }
 
 StatsMatcher::FastResult StatsMatcherImpl::fastRejects(StatName stat_name) const {
   if (rejectsAll()) {
     return FastResult::Rejects;
   }
-  bool matches = fastRejectMatch(stat_name);
-  if ((is_inclusive_ || matchers_.empty()) && matches == is_inclusive_) {
-    // We can short-circuit the slow matchers only if they are empty, or if
+  const TokenMatch token_match = fastRejectMatch(stat_name);
+  const bool matches = token_match == TokenMatch::Matches;
+  const bool needs_slow_match = hasSlowMatchers() || token_match == TokenMatch::Undecided;
+  if ((is_inclusive_ || !needs_slow_match) && matches == is_inclusive_) {
+    // We can short-circuit the slow matchers only if they are not needed, or if
     // we are in inclusive-mode and we find a match.
     return FastResult::Rejects;
   } else if (matches) {
@@ -84,9 +150,67 @@ StatsMatcher::FastResult StatsMatcherImpl::fastRejects(StatName stat_name) const
   return FastResult::NoMatch;
 }
 
-bool StatsMatcherImpl::fastRejectMatch(StatName stat_name) const {
-  return std::any_of(prefixes_.begin(), prefixes_.end(),
-                     [stat_name](StatName prefix) { return stat_name.startsWith(prefix); });
+StatsMatcherImpl::TokenMatch StatsMatcherImpl::fastRejectMatch(StatName stat_name) const {
+  if (prefixMatch(stat_name)) {
+    return TokenMatch::Matches;
+  }
+  return suffixMatch(stat_name);
+}
+
+bool StatsMatcherImpl::prefixMatch(StatName stat_name) const {
+  if (prefixes_.empty()) {
+    return false;
+  }
+  // As with StatName::startsWith, a name matches a prefix if its leading
+  // symbols are those of the prefix, including when the name equals the
+  // prefix. Walking stops at the first dynamic token.
+  uint32_t node = 0;
+  bool done = false;
+  bool match = false;
+  SymbolTable::Encoding::decodeTokens(
+      stat_name,
+      [this, &node, &done, &match](Symbol symbol) {
+        if (done) {
+          return;
+        }
+        node = prefixes_.child(node, symbol);
+        match = node != 0 && prefixes_.isTerminal(node);
+        done = node == 0 || match;
+      },
+      [&done](absl::string_view) { done = true; });
+  return match;
+}
+
+StatsMatcherImpl::TokenMatch StatsMatcherImpl::suffixMatch(StatName stat_name) const {
+  if (suffixes_.empty()) {
+    return TokenMatch::NoMatch;
+  }
+  absl::InlinedVector<Symbol, 16> symbols;
+  size_t dynamic_end = 0; // One past the last dynamic token.
+  SymbolTable::Encoding::decodeTokens(
+      stat_name, [&symbols](Symbol symbol) { symbols.push_back(symbol); },
+      [&symbols, &dynamic_end](absl::string_view) {
+        symbols.push_back(0);
+        dynamic_end = symbols.size();
+      });
+
+  // A suffix such as ".b.c" matches "a.b.c" but not "b.c", so at least one
+  // token must precede the matched symbols. Dynamic tokens may contain "." and
+  // cannot be compared as symbols, so reaching one leaves the match undecided.
+  uint32_t node = 0;
+  for (size_t i = symbols.size(); i > 1; --i) {
+    if (i <= dynamic_end) {
+      return TokenMatch::Undecided;
+    }
+    node = suffixes_.child(node, symbols[i - 1]);
+    if (node == 0) {
+      return TokenMatch::NoMatch;
+    }
+    if (suffixes_.isTerminal(node)) {
+      return TokenMatch::Matches;
+    }
+  }
+  return dynamic_end == 1 ? TokenMatch::Undecided : TokenMatch::NoMatch;
 }
 
 bool StatsMatcherImpl::slowRejects(FastResult fast_result, StatName stat_name) const {
@@ -109,12 +233,33 @@ bool StatsMatcherImpl::slowRejects(FastResult fast_result, StatName stat_name) c
 }
 
 bool StatsMatcherImpl::slowRejectMatch(StatName stat_name) const {
-  if (matchers_.empty()) {
+  const bool match_suffixes = suffixMatch(stat_name) == TokenMatch::Undecided;
+  if (!hasSlowMatchers() && !match_suffixes) {
     return false;
   }
   std::string name = symbol_table_->toString(stat_name);
-  return std::any_of(matchers_.begin(), matchers_.end(),
-                     [&name](auto& matcher) { return matcher.match(name); });
+  auto matches = [&name](const Matchers::StringMatcherImpl& matcher) {
+    return matcher.match(name);
+  };
+  return std::any_of(matchers_.begin(), matchers_.end(), matches) || regexMatch(name) ||
+         (match_suffixes && std::any_of(suffix_matchers_.begin(), suffix_matchers_.end(), matches));
+}
+
+bool StatsMatcherImpl::regexMatch(absl::string_view name) const {
+  if (regex_set_ == nullptr) {
+    return false;
+  }
+  re2::RE2::Set::ErrorInfo error_info;
+  if (regex_set_->Match(name, nullptr, &error_info)) {
+    return true;
+  }
+  if (error_info.kind == re2::RE2::Set::kNoError) {
+    return false;
+  }
+  return std::any_of(regex_matchers_.begin(), regex_matchers_.end(),
+                     [name](const Matchers::StringMatcherImpl& matcher) {
+                       return matcher.match(name);
+                     });
 }
 
 } // namespace Stats
@@ -10,7 +10,9 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
+#include "re2/set.h"
 
 namespace Envoy {
 namespace Stats {
@@ -22,6 +24,8 @@ class StatsMatcherImpl : public StatsMatcher {
 public:
   StatsMatcherImpl(const envoy::config::metrics::v3::StatsConfig& config, SymbolTable& symbol_table,
                    Server::Configuration::CommonFactoryContext& context);
+  StatsMatcherImpl(const envoy::config::metrics::v3::StatsMatcher& config,
+                   SymbolTable& symbol_table, Server::Configuration::CommonFactoryContext& context);
 
   // Default constructor simply allows everything.
   StatsMatcherImpl() = default;
@@ -33,17 +37,48 @@ public:
   }
   FastResult fastRejects(StatName name) const override;
   bool slowRejects(FastResult, StatName name) const override;
-  bool acceptsAll() const override {
-    return is_inclusive_ && matchers_.empty() && prefixes_.empty();
-  }
-  bool rejectsAll() const override {
-    return !is_inclusive_ && matchers_.empty() && prefixes_.empty();
-  }
+  bool acceptsAll() const override { return is_inclusive_ && !hasMatchers(); }
+  bool rejectsAll() const override { return !is_inclusive_ && !hasMatchers(); }
 
 private:
+  // The result of matching a StatName's symbols against the token-aligned
+  // prefixes and suffixes. Undecided means a dynamic token was reached, so the
+  // suffixes must be matched against the elaborated string instead.
+  enum class TokenMatch { Matches, NoMatch, Undecided };
+
+  // A trie over sequences of symbols. Nodes are numbered from the root at 0,
+  // and all edges are held in one flat map keyed by (node, symbol).
+  class SymbolTrie {
+  public:
+    void insert(const SymbolVec& symbols);
+
+    /**
+     * @return the child of node reached via symbol, or 0 if there is none.
+     */
+    uint32_t child(uint32_t node, Symbol symbol) const {
+      auto iter = edges_.find(std::make_pair(node, symbol));
+      return iter == edges_.end() ? 0 : iter->second;
+    }
+
+    bool isTerminal(uint32_t node) const { return terminal_[node]; }
+    bool empty() const { return edges_.empty(); }
+
+  private:
+    absl::flat_hash_map<std::pair<uint32_t, Symbol>, uint32_t> edges_;
+    std::vector<bool> terminal_{false};
+  };
+
   void optimizeLastMatcher();
-  bool fastRejectMatch(StatName name) const;
+  void optimizeRegexes();
+  bool hasMatchers() const {
+    return !matchers_.empty() || !prefixes_.empty() || !suffixes_.empty() || regex_set_ != nullptr;
+  }
+  bool hasSlowMatchers() const { return !matchers_.empty() || regex_set_ != nullptr; }
+  TokenMatch fastRejectMatch(StatName name) const;
+  bool prefixMatch(StatName name) const;
+  TokenMatch suffixMatch(StatName name) const;
   bool slowRejectMatch(StatName name) const;
+  bool regexMatch(absl::string_view name) const;
 
   // Bool indicating whether or not the StatsMatcher is including or excluding stats by default. See
   // StatsMatcherImpl::rejects() for much more detail.
@@ -53,7 +88,22 @@ private:
   std::unique_ptr<StatNamePool> stat_name_pool_;
 
   std::vector<Matchers::StringMatcherImpl> matchers_;
-  std::vector<StatName> prefixes_;
+
+  // Case-sensitive prefixes ending in "." are matched by walking the symbols
+  // of the StatName, without decoding it to a string.
+  SymbolTrie prefixes_;
+
+  // Case-sensitive suffixes beginning with "." are matched the same way,
+  // walking the symbols in reverse. The original matchers are kept to evaluate
+  // names that end in dynamic tokens.
+  SymbolTrie suffixes_;
+  std::vector<Matchers::StringMatcherImpl> suffix_matchers_;
+
+  // Regexes evaluated by the Google RE2 engine are combined into one set, so
+  // a name is scanned once regardless of how many regexes are configured. The
+  // original matchers are kept in case the set's DFA runs out of memory.
+  std::unique_ptr<re2::RE2::Set> regex_set_;
+  std::vector<Matchers::StringMatcherImpl> regex_matchers_;
 };
 
 } // namespace Stats
@@ -1,6 +1,7 @@
 #include "source/common/stats/symbol_table.h"
 
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -9,6 +10,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/utility.h"
 
+#include "absl/hash/hash.h"
 #include "absl/strings/str_cat.h"
 
 namespace Envoy {
@@ -31,6 +33,12 @@ static constexpr uint32_t Low7Bits = 0x7f;
 static constexpr Symbol FirstValidSymbol = 1;
 static constexpr uint8_t LiteralStringIndicator = 0;
 
+// The number of names each thread remembers in its encode cache.
+static constexpr size_t EncodeCacheSize = 32;
+
+// Source of SymbolTable::id_. Starts at 1 so that zero-initialized cache entries match no table.
+static std::atomic<uint64_t> next_symbol_table_id{1};
+
 size_t StatName::dataSize() const {
   if (size_and_data_ == nullptr) {
     return 0;
@@ -261,7 +269,7 @@ bool StatName::startsWith(StatName prefix) const {
 
 std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) const {
   std::vector<absl::string_view> strings;
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   Encoding::decodeTokens(
       stat_name,
       [this, &strings](Symbol symbol)
@@ -288,7 +296,8 @@ void SymbolTable::Encoding::appendToMemBlock(StatName stat_name,
 
 SymbolTable::SymbolTable()
     // Have to be explicitly initialized, if we want to use the ABSL_GUARDED_BY macro.
-    : next_symbol_(FirstValidSymbol), monotonic_counter_(FirstValidSymbol) {}
+    : id_(next_symbol_table_id.fetch_add(1, std::memory_order_relaxed)),
+      next_symbol_(FirstValidSymbol), monotonic_counter_(FirstValidSymbol) {}
 
 SymbolTable::~SymbolTable() {
   // To avoid leaks into the symbol table, we expect all StatNames to be freed.
@@ -306,23 +315,57 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
     return;
   }
 
+  std::vector<Symbol> symbols;
+  const bool track_recent_lookups = track_recent_lookups_.load(std::memory_order_relaxed);
+  if (!track_recent_lookups && encodeFromCache(name, symbols)) {
+    encoding.addSymbols(symbols);
+    return;
+  }
+
   // We want to hold the lock for the minimum amount of time, so we do the
   // string-splitting and prepare a temp vector of Symbol first.
   const std::vector<absl::string_view> tokens = absl::StrSplit(name, '.');
-  std::vector<Symbol> symbols;
   symbols.reserve(tokens.size());
 
-  // Now take the lock and populate the Symbol objects, which involves bumping
-  // ref-counts in this.
+  // Names are mostly made of tokens that already have symbols, so first try to
+  // find them all with the lock held shared. This lets threads encoding names
+  // proceed in parallel, only excluding those adding or freeing symbols.
+  if (!track_recent_lookups) {
+    absl::InlinedVector<SharedSymbol*, EncodeCacheEntry::MaxTokens> shared_symbols;
+    uint64_t generation;
+    {
+      absl::ReaderMutexLock lock(&lock_);
+      for (absl::string_view token : tokens) {
+        auto encode_find = encode_map_.find(token);
+        if (encode_find == encode_map_.end()) {
+          break;
+        }
+        encode_find->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
+        symbols.push_back(encode_find->second.symbol_);
+        shared_symbols.push_back(&encode_find->second);
+      }
+      generation = generation_;
+    }
+    if (symbols.size() == tokens.size()) {
+      shared_lookups_.fetch_add(1, std::memory_order_relaxed);
+      saveToCache(name, shared_symbols, generation);
+      encoding.addSymbols(symbols);
+      return;
+    }
+  }
+
+  // Now take the lock exclusively and populate the remaining Symbol objects,
+  // which involves allocating new symbols or bumping ref-counts in this. The
+  // references taken above keep their symbols alive in the meantime.
   {
-    Thread::LockGuard lock(lock_);
+    absl::MutexLock lock(&lock_);
     recent_lookups_.lookup(name);
-    for (auto& token : tokens) {
+    for (size_t i = symbols.size(); i < tokens.size(); ++i) {
       // TODO(jmarantz): consider using StatNameDynamicStorage for tokens with
       // length below some threshold, say 4 bytes. It might be preferable not to
       // reserve Symbols for every 3 digit number found (for example) in ipv4
       // addresses.
-      symbols.push_back(toSymbol(token));
+      symbols.push_back(toSymbol(tokens[i]));
     }
   }
 
@@ -330,8 +373,51 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
   encoding.addSymbols(symbols);
 }
 
+SymbolTable::EncodeCacheEntry& SymbolTable::encodeCacheEntry(absl::string_view name) {
+  static thread_local std::array<EncodeCacheEntry, EncodeCacheSize> cache;
+  return cache[absl::HashOf(name) % EncodeCacheSize];
+}
+
+bool SymbolTable::encodeFromCache(absl::string_view name, std::vector<Symbol>& symbols) {
+  if (name.size() > EncodeCacheEntry::MaxNameSize) {
+    return false;
+  }
+  const EncodeCacheEntry& entry = encodeCacheEntry(name);
+  if (entry.table_id_ != id_ || entry.name() != name) {
+    return false;
+  }
+  {
+    absl::ReaderMutexLock lock(&lock_);
+    if (entry.generation_ != generation_) {
+      return false;
+    }
+    symbols.reserve(entry.num_tokens_);
+    for (uint32_t i = 0; i < entry.num_tokens_; ++i) {
+      entry.symbols_[i]->ref_count_.fetch_add(1, std::memory_order_relaxed);
+      symbols.push_back(entry.symbols_[i]->symbol_);
+    }
+  }
+  shared_lookups_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void SymbolTable::saveToCache(absl::string_view name,
+                              absl::Span<SharedSymbol* const> shared_symbols, uint64_t generation) {
+  if (name.size() > EncodeCacheEntry::MaxNameSize ||
+      shared_symbols.size() > EncodeCacheEntry::MaxTokens) {
+    return;
+  }
+  EncodeCacheEntry& entry = encodeCacheEntry(name);
+  entry.table_id_ = id_;
+  entry.generation_ = generation;
+  entry.name_size_ = name.size();
+  entry.num_tokens_ = shared_symbols.size();
+  std::copy(name.begin(), name.end(), entry.name_);
+  std::copy(shared_symbols.begin(), shared_symbols.end(), entry.symbols_);
+}
+
 uint64_t SymbolTable::numSymbols() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   ASSERT(encode_map_.size() == decode_map_.size());
   return encode_map_.size();
 }
@@ -344,7 +430,9 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
+  // The symbols are already referenced by stat_name, so they cannot be freed
+  // concurrently, and their ref-counts can be bumped with the lock held shared.
+  absl::ReaderMutexLock lock(&lock_);
   for (Symbol symbol : symbols) {
     auto decode_search = decode_map_.find(symbol);
 
@@ -358,7 +446,7 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
            "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
            "debugging-symbol-table-assertions");
 
-    ++encode_search->second.ref_count_;
+    encode_search->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
@@ -366,7 +454,7 @@ void SymbolTable::free(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&lock_);
   for (Symbol symbol : symbols) {
     auto decode_search = decode_map_.find(symbol);
     ASSERT(decode_search != decode_map_.end());
@@ -380,10 +468,11 @@ void SymbolTable::free(const StatName& stat_name) {
     // The "if (--EXPR.ref_count_)" pattern speeds up BM_CreateRace by 20% in
     // symbol_table_speed_test.cc, relative to breaking out the decrement into a
     // separate step, likely due to the non-trivial dereferences in EXPR.
-    if (--encode_search->second.ref_count_ == 0) {
+    if (encode_search->second.ref_count_.fetch_sub(1, std::memory_order_relaxed) == 1) {
       decode_map_.erase(decode_search);
       encode_map_.erase(encode_search);
       pool_.push(symbol);
+      ++generation_;
     }
   }
 }
@@ -395,11 +484,11 @@ uint64_t SymbolTable::getRecentLookups(const RecentLookupsFn& iter) const {
   // We don't want to hold lock_ while calling the iterator, but we need it to
   // access recent_lookups_, so we buffer in name_count_map.
   {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     recent_lookups_.forEach(
         [&name_count_map](absl::string_view str, uint64_t count)
             ABSL_NO_THREAD_SAFETY_ANALYSIS { name_count_map[std::string(str)] += count; });
-    total += recent_lookups_.total();
+    total += recent_lookups_.total() + shared_lookups_.load(std::memory_order_relaxed);
   }
 
   // Now we have the collated name-count map data: we need to vectorize and
@@ -444,17 +533,19 @@ DynamicSpans SymbolTable::getDynamicSpans(StatName stat_name) const {
 }
 
 void SymbolTable::setRecentLookupCapacity(uint64_t capacity) {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&lock_);
   recent_lookups_.setCapacity(capacity);
+  track_recent_lookups_.store(capacity > 0, std::memory_order_relaxed);
 }
 
 void SymbolTable::clearRecentLookups() {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&lock_);
   recent_lookups_.clear();
+  shared_lookups_.store(0, std::memory_order_relaxed);
 }
 
 uint64_t SymbolTable::recentLookupCapacity() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   return recent_lookups_.capacity();
 }
 
@@ -476,6 +567,9 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
     InlineStringPtr str = InlineString::create(sv);
     auto encode_insert = encode_map_.insert({str->toStringView(), SharedSymbol(next_symbol_)});
     ASSERT(encode_insert.second);
+    // Any insert may rehash, either growing the map or compacting erased slots in place without
+    // changing its capacity. Both move the SharedSymbols, invalidating pointers to them.
+    ++generation_;
     auto decode_insert = decode_map_.insert({next_symbol_, std::move(str)});
     ASSERT(decode_insert.second);
 
@@ -485,13 +579,13 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
     // If the insertion didn't take place, return the actual value at that location and up the
     // refcount at that location
     result = encode_find->second.symbol_;
-    ++(encode_find->second.ref_count_);
+    encode_find->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
   }
   return result;
 }
 
 absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   auto search = decode_map_.find(symbol);
   RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
   return search->second->toStringView();
@@ -512,12 +606,12 @@ bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
   // Proactively take the table lock in anticipation that we'll need to
   // convert at least one symbol to a string_view, and it's easier not to
   // bother to lazily take the lock.
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   return lessThanLockHeld(a, b);
 }
 
 bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   Encoding::TokenIter a_iter(a), b_iter(b);
   while (true) {
     Encoding::TokenIter::TokenType a_type = a_iter.next();
@@ -547,7 +641,7 @@ bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
 
 #ifndef ENVOY_CONFIG_COVERAGE
 void SymbolTable::debugPrint() const {
-  Thread::LockGuard lock(lock_);
+  absl::ReaderMutexLock lock(&lock_);
   std::vector<Symbol> symbols;
   for (const auto& p : decode_map_) {
     symbols.push_back(p.first);
@@ -556,7 +650,8 @@ void SymbolTable::debugPrint() const {
   for (Symbol symbol : symbols) {
     const InlineString& token = *decode_map_.find(symbol)->second;
     const SharedSymbol& shared_symbol = encode_map_.find(token.toStringView())->second;
-    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_);
+    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(),
+                   shared_symbol.ref_count_.load(std::memory_order_relaxed));
   }
 }
 #endif
@@ -739,6 +834,29 @@ void StatNameList::iterate(const std::function<bool(StatName)>& f) const {
   }
 }
 
+void StatNameList::iterateWith(uint32_t skip, const StatNameList& other, uint32_t other_skip,
+                               const std::function<bool(StatName, StatName)>& f) const {
+  const uint8_t* p = &storage_[0];
+  const uint8_t* other_p = &other.storage_[0];
+  const uint32_t num_elements = *p++;
+  const uint32_t other_num_elements = *other_p++;
+  for (uint32_t i = 0; i < skip && i < num_elements; ++i) {
+    p += StatName(p).size();
+  }
+  for (uint32_t i = 0; i < other_skip && i < other_num_elements; ++i) {
+    other_p += StatName(other_p).size();
+  }
+  for (uint32_t i = skip, j = other_skip; i < num_elements && j < other_num_elements; ++i, ++j) {
+    const StatName stat_name(p);
+    const StatName other_stat_name(other_p);
+    p += stat_name.size();
+    other_p += other_stat_name.size();
+    if (!f(stat_name, other_stat_name)) {
+      break;
+    }
+  }
+}
+
 void StatNameList::clear(SymbolTable& symbol_table) {
   iterate([&symbol_table](StatName stat_name) -> bool {
     // nolint: https://github.com/llvm/llvm-project/issues/81597
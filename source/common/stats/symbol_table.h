@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -19,6 +20,8 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 namespace Stats {
@@ -349,7 +352,7 @@ public:
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
     // Grab the lock once before sorting begins, so we don't have to re-take
     // it on every comparison.
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -397,13 +400,37 @@ private:
 
   struct SharedSymbol {
     SharedSymbol(Symbol symbol) : symbol_(symbol) {}
+    // The encode map only moves its values while rehashing, which happens with lock_ held
+    // exclusively, so no other thread can be changing the ref-count.
+    SharedSymbol(SharedSymbol&& src) noexcept
+        : symbol_(src.symbol_), ref_count_(src.ref_count_.load(std::memory_order_relaxed)) {}
 
     Symbol symbol_;
-    uint32_t ref_count_{1};
+    // Incremented with lock_ held shared, when an existing symbol is looked up, and decremented
+    // with lock_ held exclusively, so that a symbol can only be erased while nobody is looking it
+    // up.
+    std::atomic<uint32_t> ref_count_{1};
   };
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  // A thread's record of a name it encoded recently, and the symbols that name's tokens map to.
+  // The symbols stay valid while the table's generation_ is unchanged. Names and token counts are
+  // bounded so that the cache needs no heap memory.
+  struct EncodeCacheEntry {
+    static constexpr size_t MaxNameSize = 96;
+    static constexpr size_t MaxTokens = 12;
+
+    absl::string_view name() const { return {name_, name_size_}; }
+
+    uint64_t table_id_;
+    uint64_t generation_;
+    uint32_t name_size_;
+    uint32_t num_tokens_;
+    char name_[MaxNameSize];
+    SharedSymbol* symbols_[MaxTokens];
+  };
+
+  // This must be held exclusively to add or remove symbols, and shared to look them up.
+  mutable absl::Mutex lock_;
 
   /**
    * Decodes a uint8_t array into an array of period-delimited strings. Note
@@ -434,7 +461,7 @@ private:
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const ABSL_SHARED_LOCKS_REQUIRED(lock_);
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
@@ -450,11 +477,49 @@ private:
    */
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
+  /**
+   * Looks up name in this thread's encode cache, taking references to its symbols on a hit.
+   *
+   * @param name The name to look up.
+   * @param symbols Receives the name's symbols on a hit.
+   * @return whether name was found with all its symbols still valid.
+   */
+  bool encodeFromCache(absl::string_view name, std::vector<Symbol>& symbols);
+
+  /**
+   * Records name's symbols in this thread's encode cache, if the name fits in an entry.
+   *
+   * @param name The name that was encoded.
+   * @param shared_symbols The entries in encode_map_ of the name's tokens.
+   * @param generation The value of generation_ when shared_symbols were looked up.
+   */
+  void saveToCache(absl::string_view name, absl::Span<SharedSymbol* const> shared_symbols,
+                   uint64_t generation);
+
+  /**
+   * @return the calling thread's encode cache entry for name, which may hold another name.
+   */
+  static EncodeCacheEntry& encodeCacheEntry(absl::string_view name);
+
   Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(&lock_);
     return monotonic_counter_;
   }
 
+  // Distinguishes this table from all others in the thread-local encode caches, including any
+  // table previously allocated at the same address.
+  const uint64_t id_;
+
+  // Changes whenever a SharedSymbol might move or be erased, i.e. when a symbol is added or
+  // a symbol is freed. Cached SharedSymbol pointers are only used while this is unchanged.
+  uint64_t generation_ ABSL_GUARDED_BY(lock_){0};
+
+  // Lookups must be recorded in recent_lookups_ with lock_ held exclusively while this is set.
+  std::atomic<bool> track_recent_lookups_{false};
+
+  // The number of lookups made with lock_ held shared, which are not counted in recent_lookups_.
+  std::atomic<uint64_t> shared_lookups_{0};
+
   // Stores the symbol to be used at next insertion. This should exist ahead of insertion time so
   // that if insertion succeeds, the value written is the correct one.
   Symbol next_symbol_ ABSL_GUARDED_BY(lock_);
@@ -852,6 +917,19 @@ public:
    */
   void iterate(const std::function<bool(StatName)>& f) const;
 
+  /**
+   * Iterates over this list and another one in lockstep, calling f(StatName, StatName) with an
+   * element of each, without copying either list. f() should return true to keep iterating, or
+   * false to end the iteration. The iteration also ends when either list is exhausted.
+   *
+   * @param skip the number of leading elements of this list to skip.
+   * @param other the list to iterate alongside this one.
+   * @param other_skip the number of leading elements of other to skip.
+   * @param f The function to call on each pair of stats.
+   */
+  void iterateWith(uint32_t skip, const StatNameList& other, uint32_t other_skip,
+                   const std::function<bool(StatName, StatName)>& f) const;
+
   /**
    * Frees each StatName in the list. Failure to call this before destruction
    * results in an ASSERT at destruction of the list and the SymbolTable.
@@ -79,8 +79,14 @@ TagExtractorImplBase::createTagExtractor(absl::string_view name, absl::string_vi
         "No regex specified for tag specifier and no default regex for name: '{}'", name));
   }
   switch (re_type) {
-  case Regex::Type::Re2:
-    return std::make_unique<TagExtractorRe2Impl>(name, regex, substr, negative_match);
+  case Regex::Type::Re2: {
+    auto extractor = std::make_unique<TagExtractorRe2Impl>(name, regex, substr, negative_match);
+    if (!extractor->regex().ok()) {
+      return absl::InvalidArgumentError(
+          fmt::format("Invalid regex '{}': {}", regex, extractor->regex().error()));
+    }
+    return extractor;
+  }
   case Regex::Type::StdRegex:
     ASSERT(negative_match.empty(), "Not supported");
     return std::make_unique<TagExtractorStdRegexImpl>(name, regex, substr);
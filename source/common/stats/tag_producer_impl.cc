@@ -45,8 +45,9 @@ TagProducerImpl::TagProducerImpl(const envoy::config::metrics::v3::StatsConfig&
           return;
         }
       } else {
-        auto extractor_or_error =
-            TagExtractorImplBase::createTagExtractor(name, tag_specifier.regex());
+        auto extractor_or_error = TagExtractorImplBase::createTagExtractor(
+            name, tag_specifier.regex(), "", "",
+            config.use_re2_for_tag_regexes() ? Regex::Type::Re2 : Regex::Type::StdRegex);
         if (!extractor_or_error.ok()) {
           creation_status = extractor_or_error.status();
           return;
@@ -59,6 +60,7 @@ TagProducerImpl::TagProducerImpl(const envoy::config::metrics::v3::StatsConfig&
       fixed_tags_.push_back(Tag{name, tag_specifier.fixed_value()});
     }
   }
+  compileRe2Set();
 }
 
 absl::Status TagProducerImpl::addExtractorsMatching(absl::string_view name) {
@@ -95,6 +97,10 @@ void TagProducerImpl::addExtractor(TagExtractorPtr extractor) {
     other.get().setOtherExtractorWithSameNameExists(true);
   }
 
+  if (const auto* re2_extractor = dynamic_cast<const TagExtractorRe2Impl*>(extractor.get())) {
+    re2_extractors_.push_back(re2_extractor);
+  }
+
   const absl::string_view prefix = extractor->prefixToken();
   if (prefix.empty()) {
     tag_extractors_without_prefix_.emplace_back(std::move(extractor));
@@ -127,8 +133,28 @@ std::string TagProducerImpl::produceTags(absl::string_view metric_name, TagVecto
   TagExtractionContext tag_extraction_context(metric_name);
   std::vector<absl::string_view> tokens;
   absl::flat_hash_set<absl::string_view> dup_set;
-  forEachExtractorMatching(metric_name, [&remove_characters, &tags, &tag_extraction_context,
-                                         &dup_set](const TagExtractorPtr& tag_extractor) {
+
+  // Screen the name against all the RE2 extractors at once. If the set's DFA
+  // runs out of memory every extractor is tried, as without the set.
+  std::vector<int> re2_matches;
+  bool re2_screened = false;
+  if (re2_set_ != nullptr) {
+    re2::RE2::Set::ErrorInfo error_info;
+    re2_set_->Match(metric_name, &re2_matches, &error_info);
+    re2_screened = error_info.kind == re2::RE2::Set::kNoError;
+  }
+
+  forEachExtractorMatching(metric_name, [this, &remove_characters, &tags, &tag_extraction_context,
+                                         &dup_set, &re2_matches,
+                                         re2_screened](const TagExtractorPtr& tag_extractor) {
+    if (re2_screened) {
+      const auto iter = re2_set_index_.find(tag_extractor.get());
+      if (iter != re2_set_index_.end() &&
+          std::find(re2_matches.begin(), re2_matches.end(), iter->second) == re2_matches.end()) {
+        return;
+      }
+    }
+
     // It is relatively cheap to populate a set of string_view for every tag,
     // but it saves 2% CPU time to only populate and check dup_set for tag-names
     // where there is more than one extractor. This is rare. For built-in
@@ -152,6 +178,26 @@ void TagProducerImpl::reserveResources(const envoy::config::metrics::v3::StatsCo
   tag_extractors_without_prefix_.reserve(config.stats_tags().size());
 }
 
+void TagProducerImpl::compileRe2Set() {
+  // With a single RE2 extractor the set would only duplicate its own match.
+  if (re2_extractors_.size() > 1) {
+    auto re2_set = std::make_unique<re2::RE2::Set>(re2::RE2::DefaultOptions, re2::RE2::UNANCHORED);
+    bool ok = true;
+    for (const TagExtractorRe2Impl* extractor : re2_extractors_) {
+      const int index = re2_set->Add(extractor->regex().pattern(), nullptr);
+      ok = ok && index >= 0;
+      re2_set_index_[extractor] = index;
+    }
+    if (ok && re2_set->Compile()) {
+      re2_set_ = std::move(re2_set);
+    } else {
+      re2_set_index_.clear();
+    }
+  }
+  re2_extractors_.clear();
+  re2_extractors_.shrink_to_fit();
+}
+
 absl::Status
 TagProducerImpl::addDefaultExtractors(const envoy::config::metrics::v3::StatsConfig& config) {
   if (!config.has_use_all_default_tags() || config.use_all_default_tags().value()) {
@@ -18,10 +18,13 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
 #include "absl/strings/string_view.h"
+#include "re2/set.h"
 
 namespace Envoy {
 namespace Stats {
 
+class TagExtractorRe2Impl;
+
 /**
  * Organizes a collection of TagExtractors so that stat-names can be processed without
  * iterating through all extractors.
@@ -79,6 +82,12 @@ private:
    */
   void reserveResources(const envoy::config::metrics::v3::StatsConfig& config);
 
+  /**
+   * Combines the regexes of all RE2 extractors into re2_set_, so that produceTags can screen a
+   * stat name against all of them in one pass.
+   */
+  void compileRe2Set();
+
   /**
    * Adds all default extractors from well_known_names.cc into the collection.
    *
@@ -117,6 +126,16 @@ private:
   // send duplicate tag names to Prometheus so this needs to be filtered out.
   absl::flat_hash_map<absl::string_view, std::reference_wrapper<TagExtractor>> extractor_map_;
 
+  // The RE2 extractors, in the order their regexes are added to re2_set_. Only
+  // populated during construction.
+  std::vector<const TagExtractorRe2Impl*> re2_extractors_;
+
+  // All RE2 extractor regexes, matched unanchored like RE2::PartialMatch. An
+  // RE2 extractor whose index in re2_set_index_ is not among the set's matches
+  // for a name cannot extract a tag from it, and is skipped.
+  std::unique_ptr<re2::RE2::Set> re2_set_;
+  absl::flat_hash_map<const TagExtractor*, int> re2_set_index_;
+
   TagVector fixed_tags_;
 };
 
@@ -1,5 +1,7 @@
 #include "source/common/stats/thread_local_store.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <list>
@@ -10,6 +12,7 @@
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
+#include "envoy/thread/thread.h"
 
 #include "source/common/common/lock_guard.h"
 #include "source/common/runtime/runtime_features.h"
@@ -212,6 +215,7 @@ void ThreadLocalStoreImpl::shutdownThreading() {
   // This will block both future cache fills as well as cache flushes.
   shutting_down_ = true;
   ASSERT(!tls_.has_value() || tls_->isShutdown());
+  merge_thread_pool_.reset();
 
   // We can't call runOnAllThreads here as global threading has already been shutdown. It is okay
   // to simply clear the scopes and central cache entries here as they will be cleaned up during
@@ -248,14 +252,110 @@ void ThreadLocalStoreImpl::mergeHistograms(PostMergeCb merge_complete_cb) {
   }
 }
 
+void ThreadLocalStoreImpl::setHistogramMergeThreads(Thread::ThreadFactory& thread_factory,
+                                                    uint32_t num_threads) {
+  merge_thread_pool_.reset();
+  if (num_threads > 0) {
+    merge_thread_pool_ = std::make_unique<MergeThreadPool>(thread_factory, num_threads);
+  }
+}
+
+ThreadLocalStoreImpl::MergeThreadPool::MergeThreadPool(Thread::ThreadFactory& thread_factory,
+                                                       uint32_t num_threads) {
+  threads_.reserve(num_threads);
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(thread_factory.createThread([this]() { threadRoutine(); },
+                                                      Thread::Options{"stats_merge"}));
+  }
+}
+
+ThreadLocalStoreImpl::MergeThreadPool::~MergeThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    terminate_ = true;
+  }
+  for (const Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+void ThreadLocalStoreImpl::MergeThreadPool::run(const std::function<void()>& work) {
+  {
+    absl::MutexLock lock(&mutex_);
+    ASSERT(busy_threads_ == 0);
+    work_ = &work;
+    ++generation_;
+    busy_threads_ = threads_.size();
+  }
+  work();
+  const auto all_done = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return busy_threads_ == 0;
+  };
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(&all_done));
+  work_ = nullptr;
+}
+
+void ThreadLocalStoreImpl::MergeThreadPool::threadRoutine() {
+  uint64_t done_generation = 0;
+  const auto has_work = [this, &done_generation]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return terminate_ || generation_ != done_generation;
+  };
+  while (true) {
+    const std::function<void()>* work;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(&has_work));
+      if (terminate_) {
+        return;
+      }
+      done_generation = generation_;
+      work = work_;
+    }
+    (*work)();
+    absl::MutexLock lock(&mutex_);
+    --busy_threads_;
+  }
+}
+
 void ThreadLocalStoreImpl::mergeInternal(PostMergeCb merge_complete_cb) {
   if (!shutting_down_) {
-    forEachHistogram(nullptr, [](ParentHistogram& histogram) { histogram.merge(); });
+    if (merge_thread_pool_ != nullptr) {
+      mergeOnThreads();
+    } else {
+      forEachHistogram(nullptr, [](ParentHistogram& histogram) { histogram.merge(); });
+    }
     merge_complete_cb();
     merge_in_progress_ = false;
   }
 }
 
+void ThreadLocalStoreImpl::mergeOnThreads() {
+  // Parent histograms are independent of each other, so they can be merged concurrently. The
+  // threads take batches of histograms from a shared index, so that a thread which happens to get
+  // cheap histograms takes more of them. The main thread does its share, and then waits for the
+  // pool threads, so nothing else on the main thread can see a histogram mid-merge.
+  static constexpr size_t BatchSize = 64;
+  const std::vector<ParentHistogramSharedPtr> histograms = this->histograms();
+  std::atomic<size_t> next_batch{0};
+  auto merge_batches = [&histograms, &next_batch]() {
+    for (size_t start = next_batch.fetch_add(BatchSize); start < histograms.size();
+         start = next_batch.fetch_add(BatchSize)) {
+      const size_t end = std::min(start + BatchSize, histograms.size());
+      for (size_t i = start; i < end; ++i) {
+        histograms[i]->merge();
+      }
+    }
+  };
+
+  // Don't wake the pool for a single batch.
+  if (histograms.size() <= BatchSize) {
+    merge_batches();
+    return;
+  }
+  merge_thread_pool_->run(merge_batches);
+}
+
 ThreadLocalStoreImpl::CentralCacheEntry::~CentralCacheEntry() {
   // Assert that the symbol-table is valid, so we get good test coverage of
   // the validity of the symbol table at the time this destructor runs. This
@@ -976,16 +1076,23 @@ std::string ParentHistogramImpl::bucketSummary() const {
 
 std::vector<Stats::ParentHistogram::Bucket>
 ParentHistogramImpl::detailedlBucketsHelper(const histogram_t& histogram) {
+  std::vector<Stats::ParentHistogram::Bucket> buckets;
+  buckets.reserve(hist_num_buckets(&histogram));
+  forEachDetailedBucket(histogram, [&buckets](const Bucket& bucket) { buckets.push_back(bucket); });
+  return buckets;
+}
+
+void ParentHistogramImpl::forEachDetailedBucket(const histogram_t& histogram,
+                                                const BucketFn& fn) {
   const uint32_t num_buckets = hist_num_buckets(&histogram);
-  std::vector<Stats::ParentHistogram::Bucket> buckets(num_buckets);
   hist_bucket_t hist_bucket;
+  ParentHistogram::Bucket bucket;
   for (uint32_t i = 0; i < num_buckets; ++i) {
-    ParentHistogram::Bucket& bucket = buckets[i];
     hist_bucket_idx_bucket(&histogram, i, &hist_bucket, &bucket.count_);
     bucket.lower_bound_ = hist_bucket_to_double(hist_bucket);
     bucket.width_ = hist_bucket_to_double_bin_width(hist_bucket);
+    fn(bucket);
   }
-  return buckets;
 }
 
 void ParentHistogramImpl::addTlsHistogram(const TlsHistogramSharedPtr& hist_ptr) {
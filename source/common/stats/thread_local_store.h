@@ -8,6 +8,7 @@
 #include <string>
 
 #include "envoy/stats/tag.h"
+#include "envoy/thread/thread.h"
 #include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/hash.h"
@@ -21,6 +22,7 @@
 #include "source/common/stats/utility.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "circllhist.h"
 
 namespace Envoy {
@@ -113,6 +115,12 @@ public:
   std::vector<Bucket> detailedIntervalBuckets() const override {
     return detailedlBucketsHelper(*interval_histogram_);
   }
+  void forEachDetailedTotalBucket(const BucketFn& fn) const override {
+    forEachDetailedBucket(*cumulative_histogram_, fn);
+  }
+  void forEachDetailedIntervalBucket(const BucketFn& fn) const override {
+    forEachDetailedBucket(*interval_histogram_, fn);
+  }
 
   // Stats::Metric
   SymbolTable& symbolTable() override;
@@ -133,6 +141,7 @@ private:
   bool usedLockHeld() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(merge_lock_);
   static std::vector<Stats::ParentHistogram::Bucket>
   detailedlBucketsHelper(const histogram_t& histogram);
+  static void forEachDetailedBucket(const histogram_t& histogram, const BucketFn& fn);
 
   Histogram::Unit unit_;
   ThreadLocalStoreImpl& thread_local_store_;
@@ -199,6 +208,12 @@ public:
                            ThreadLocal::Instance& tls) override;
   void shutdownThreading() override;
   void mergeHistograms(PostMergeCb merge_cb) override;
+  void setHistogramMergeThreads(Thread::ThreadFactory& thread_factory,
+                                uint32_t num_threads) override;
+  void setCounterSharding(uint32_t num_shards, StatsMatcherPtr&& matcher) override {
+    alloc_.setCounterSharding(num_shards, std::move(matcher));
+  }
+  void setCompactNames(bool compact) override { alloc_.setCompactNames(compact); }
   void deliverHistogramToSinks(const Histogram& histogram, uint64_t value) override;
 
   Histogram& tlsHistogram(ParentHistogramImpl& parent, uint64_t id);
@@ -515,11 +530,35 @@ private:
                              });
   }
 
+  // Threads started once by setHistogramMergeThreads(), which help the main thread with the
+  // histogram merge at each flush and otherwise sleep.
+  class MergeThreadPool {
+  public:
+    MergeThreadPool(Thread::ThreadFactory& thread_factory, uint32_t num_threads);
+    ~MergeThreadPool();
+
+    // Runs work on the calling thread and on every pool thread, and returns once all of them are
+    // done with it.
+    void run(const std::function<void()>& work);
+
+  private:
+    void threadRoutine();
+
+    absl::Mutex mutex_;
+    const std::function<void()>* work_ ABSL_GUARDED_BY(mutex_){};
+    // Bumped for each run(), so that every thread picks up each run exactly once.
+    uint64_t generation_ ABSL_GUARDED_BY(mutex_){};
+    uint32_t busy_threads_ ABSL_GUARDED_BY(mutex_){};
+    bool terminate_ ABSL_GUARDED_BY(mutex_){};
+    std::vector<Thread::ThreadPtr> threads_;
+  };
+
   std::string getTagsForName(const std::string& name, TagVector& tags) const;
   void clearScopesFromCaches();
   void clearHistogramsFromCaches();
   void releaseScopeCrossThread(ScopeImpl* scope);
   void mergeInternal(PostMergeCb merge_cb);
+  void mergeOnThreads();
   bool slowRejects(StatsMatcher::FastResult fast_reject_result, StatName name) const;
   bool rejects(StatName name) const { return stats_matcher_->rejects(name); }
   StatsMatcher::FastResult fastRejects(StatName name) const;
@@ -550,6 +589,7 @@ private:
   std::atomic<bool> threading_ever_initialized_{};
   std::atomic<bool> shutting_down_{};
   std::atomic<bool> merge_in_progress_{};
+  std::unique_ptr<MergeThreadPool> merge_thread_pool_;
   OptRef<ThreadLocal::Instance> tls_;
 
   NullCounterImpl null_counter_;
@@ -0,0 +1,158 @@
+#include "source/common/tcp_proxy/splice.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/enum_to_int.h"
+#include "source/common/common/macros.h"
+#include "source/common/common/utility.h"
+
+#if defined(__linux__)
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace TcpProxy {
+
+SpliceForwarder::SpliceForwarder(os_fd_t downstream_fd, os_fd_t upstream_fd, Callbacks& callbacks)
+    : callbacks_(callbacks), downstream_fd_(downstream_fd), upstream_fd_(upstream_fd) {}
+
+SpliceForwarder::~SpliceForwarder() {
+  // Drop the file events before closing the pipes so nothing can fire in between.
+  downstream_event_.reset();
+  upstream_event_.reset();
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  for (Pipe& pipe : pipes_) {
+    if (SOCKET_VALID(pipe.read_fd_)) {
+      os_sys_calls.close(pipe.read_fd_);
+    }
+    if (SOCKET_VALID(pipe.write_fd_)) {
+      os_sys_calls.close(pipe.write_fd_);
+    }
+  }
+}
+
+std::unique_ptr<SpliceForwarder> SpliceForwarder::create(Event::Dispatcher& dispatcher,
+                                                         Network::IoHandle& downstream,
+                                                         Network::IoHandle& upstream,
+                                                         Callbacks& callbacks) {
+#if defined(__linux__)
+  std::unique_ptr<SpliceForwarder> forwarder(
+      new SpliceForwarder(downstream.fdDoNotUse(), upstream.fdDoNotUse(), callbacks));
+  for (Pipe& pipe : forwarder->pipes_) {
+    int fds[2];
+    const Api::SysCallIntResult result =
+        Api::LinuxOsSysCallsSingleton::get().pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+    if (result.return_value_ != 0) {
+      ENVOY_LOG(debug, "splice: unable to create pipe: {}", errorDetails(result.errno_));
+      return nullptr;
+    }
+    pipe.read_fd_ = fds[0];
+    pipe.write_fd_ = fds[1];
+  }
+
+  // The connections keep their own file events for these sockets; a second event per socket is
+  // fine as both only ever look at readiness.
+  auto cb = [forwarder = forwarder.get()](uint32_t) {
+    forwarder->onFileEvent();
+    return absl::OkStatus();
+  };
+  forwarder->downstream_event_ =
+      dispatcher.createFileEvent(forwarder->downstream_fd_, cb, Event::PlatformDefaultTriggerType,
+                                 Event::FileReadyType::Read | Event::FileReadyType::Write);
+  forwarder->upstream_event_ =
+      dispatcher.createFileEvent(forwarder->upstream_fd_, cb, Event::PlatformDefaultTriggerType,
+                                 Event::FileReadyType::Read | Event::FileReadyType::Write);
+  // Move anything that is already waiting in the sockets.
+  forwarder->downstream_event_->activate(Event::FileReadyType::Read);
+  return forwarder;
+#else
+  UNREFERENCED_PARAMETER(dispatcher);
+  UNREFERENCED_PARAMETER(downstream);
+  UNREFERENCED_PARAMETER(upstream);
+  UNREFERENCED_PARAMETER(callbacks);
+  return nullptr;
+#endif
+}
+
+void SpliceForwarder::onFileEvent() {
+  if (!pump(Direction::DownstreamToUpstream)) {
+    return;
+  }
+  pump(Direction::UpstreamToDownstream);
+}
+
+bool SpliceForwarder::pump(Direction direction) {
+#if defined(__linux__)
+  Pipe& pipe = pipes_[enumToInt(direction)];
+  const bool to_upstream = direction == Direction::DownstreamToUpstream;
+  const os_fd_t source = to_upstream ? downstream_fd_ : upstream_fd_;
+  const os_fd_t destination = to_upstream ? upstream_fd_ : downstream_fd_;
+  auto& os_sys_calls = Api::LinuxOsSysCallsSingleton::get();
+  constexpr unsigned int flags = SPLICE_F_MOVE | SPLICE_F_NONBLOCK;
+
+  uint64_t sent = 0;
+  bool progress = true;
+  while (progress && !pipe.done_ && sent < MaxBytesPerEvent) {
+    progress = false;
+
+    // Fill the pipe from the source. This stops with EAGAIN either when the source has nothing
+    // more to read or when the pipe is full.
+    if (!pipe.source_end_stream_) {
+      const Api::SysCallSizeResult result = os_sys_calls.splice(
+          source, nullptr, pipe.write_fd_, nullptr, MaxBytesPerEvent - sent, flags);
+      if (result.return_value_ > 0) {
+        pipe.buffered_ += result.return_value_;
+        progress = true;
+        callbacks_.onSpliceBytesReceived(direction, result.return_value_);
+      } else if (result.return_value_ == 0) {
+        pipe.source_end_stream_ = true;
+        progress = true;
+      } else if (result.errno_ != SOCKET_ERROR_AGAIN && result.errno_ != SOCKET_ERROR_INTR) {
+        ENVOY_LOG(debug, "splice: read failed: {}", errorDetails(result.errno_));
+        callbacks_.onSpliceError(direction, result.errno_);
+        return false;
+      }
+    }
+
+    // Drain the pipe into the destination.
+    if (pipe.buffered_ > 0) {
+      const Api::SysCallSizeResult result =
+          os_sys_calls.splice(pipe.read_fd_, nullptr, destination, nullptr, pipe.buffered_, flags);
+      if (result.return_value_ > 0) {
+        ASSERT(static_cast<uint64_t>(result.return_value_) <= pipe.buffered_);
+        pipe.buffered_ -= result.return_value_;
+        sent += result.return_value_;
+        progress = true;
+        callbacks_.onSpliceBytesSent(direction, result.return_value_);
+      } else if (result.return_value_ < 0 && result.errno_ != SOCKET_ERROR_AGAIN &&
+                 result.errno_ != SOCKET_ERROR_INTR) {
+        ENVOY_LOG(debug, "splice: write failed: {}", errorDetails(result.errno_));
+        callbacks_.onSpliceError(direction, result.errno_);
+        return false;
+      }
+    }
+
+    if (pipe.source_end_stream_ && pipe.buffered_ == 0) {
+      pipe.done_ = true;
+      callbacks_.onSpliceEndStream(direction);
+    }
+  }
+
+  if (!pipe.done_ && sent >= MaxBytesPerEvent) {
+    // Edge triggered events will not fire again for data that is already waiting, so come back on
+    // the next loop iteration.
+    (to_upstream ? downstream_event_ : upstream_event_)->activate(Event::FileReadyType::Read);
+  }
+  return true;
+#else
+  UNREFERENCED_PARAMETER(direction);
+  return true;
+#endif
+}
+
+} // namespace TcpProxy
+} // namespace Envoy
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/platform.h"
+#include "envoy/common/pure.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/file_event.h"
+#include "envoy/network/io_handle.h"
+
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+/**
+ * Moves the payload of a proxied connection between the downstream and upstream sockets with
+ * splice(2), through one pipe per direction, so that it is never copied into user space. The pipe
+ * capacity bounds the bytes in flight in each direction: once a pipe is full the forwarder stops
+ * reading from the source socket until the destination accepts more, which gives the same back
+ * pressure as the connection buffer watermarks on the regular path.
+ *
+ * Both connections must stay read disabled while the forwarder is alive so that they do not
+ * consume payload from the sockets themselves.
+ */
+class SpliceForwarder : Logger::Loggable<Logger::Id::filter> {
+public:
+  enum class Direction { DownstreamToUpstream, UpstreamToDownstream };
+
+  class Callbacks {
+  public:
+    virtual ~Callbacks() = default;
+
+    /**
+     * Called when bytes have been read from the source socket of a direction.
+     */
+    virtual void onSpliceBytesReceived(Direction direction, uint64_t bytes) PURE;
+
+    /**
+     * Called when bytes have been written to the destination socket of a direction.
+     */
+    virtual void onSpliceBytesSent(Direction direction, uint64_t bytes) PURE;
+
+    /**
+     * Called once the source socket of a direction has reached end of stream and everything read
+     * from it has been written to the destination. The forwarder no longer reads from the source,
+     * so the caller should hand it back to its connection to observe the end of stream.
+     */
+    virtual void onSpliceEndStream(Direction direction) PURE;
+
+    /**
+     * Called when moving bytes failed with an unrecoverable socket error. The forwarder must be
+     * destroyed; no further callbacks are invoked.
+     */
+    virtual void onSpliceError(Direction direction, int error) PURE;
+  };
+
+  /**
+   * @return a forwarder moving bytes between the two sockets, or nullptr if splicing is not
+   *         available (e.g. the pipes could not be created or the platform lacks splice(2)).
+   */
+  static std::unique_ptr<SpliceForwarder> create(Event::Dispatcher& dispatcher,
+                                                 Network::IoHandle& downstream,
+                                                 Network::IoHandle& upstream,
+                                                 Callbacks& callbacks);
+
+  ~SpliceForwarder();
+
+  // The most bytes written in one direction per event, so that a busy connection cannot starve
+  // the rest of the event loop. The remainder is moved on the next loop iteration.
+  static constexpr uint64_t MaxBytesPerEvent = 1024 * 1024;
+
+private:
+  struct Pipe {
+    os_fd_t read_fd_{INVALID_SOCKET};
+    os_fd_t write_fd_{INVALID_SOCKET};
+    // Bytes spliced into the pipe and not yet written to the destination.
+    uint64_t buffered_{};
+    bool source_end_stream_{};
+    bool done_{};
+  };
+
+  SpliceForwarder(os_fd_t downstream_fd, os_fd_t upstream_fd, Callbacks& callbacks);
+
+  void onFileEvent();
+  // Returns false if an error was raised, in which case the forwarder may have been destroyed.
+  bool pump(Direction direction);
+
+  Callbacks& callbacks_;
+  const os_fd_t downstream_fd_;
+  const os_fd_t upstream_fd_;
+  std::array<Pipe, 2> pipes_;
+  Event::FileEventPtr downstream_event_;
+  Event::FileEventPtr upstream_event_;
+};
+
+using SpliceForwarderPtr = std::unique_ptr<SpliceForwarder>;
+
+} // namespace TcpProxy
+} // namespace Envoy
@@ -114,7 +114,7 @@ Config::SharedConfig::SharedConfig(
     const envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy& config,
     Server::Configuration::FactoryContext& context)
     : stats_scope_(context.scope().createScope(fmt::format("tcp.{}", config.stat_prefix()))),
-      stats_(generateStats(*stats_scope_)) {
+      stats_(generateStats(*stats_scope_)), splice_data_(config.splice_data()) {
   if (config.has_idle_timeout()) {
     const uint64_t timeout = DurationUtil::durationToMilliseconds(config.idle_timeout());
     if (timeout > 0) {
@@ -338,6 +338,7 @@ void Filter::initialize(Network::ReadFilterCallbacks& callbacks, bool set_connec
   getStreamInfo().setUpstreamInfo(std::make_shared<StreamInfo::UpstreamInfoImpl>());
 
   config_->stats().downstream_cx_total_.inc();
+  connection_stats_set_ = set_connection_stats;
   if (set_connection_stats) {
     read_callbacks_->connection().setConnectionStats(
         {config_->stats().downstream_cx_rx_bytes_total_,
@@ -904,6 +905,11 @@ void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
   ENVOY_CONN_LOG(trace, "on downstream event {}, has upstream = {}", read_callbacks_->connection(),
                  static_cast<int>(event), upstream_ != nullptr);
 
+  if (event == Network::ConnectionEvent::LocalClose ||
+      event == Network::ConnectionEvent::RemoteClose) {
+    splice_forwarder_.reset();
+  }
+
   if (upstream_) {
     Tcp::ConnectionPool::ConnectionDataPtr conn_data(upstream_->onDownstreamEvent(event));
     if (conn_data != nullptr &&
@@ -949,6 +955,7 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
 
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
+    splice_forwarder_.reset();
     if (Runtime::runtimeFeatureEnabled(
             "envoy.restart_features.upstream_http_filters_with_tcp_proxy")) {
       read_callbacks_->connection().dispatcher().deferredDelete(std::move(upstream_));
@@ -1020,7 +1027,7 @@ void Filter::onUpstreamConnection() {
 
     // Re-enable downstream reads now that the early data buffer is flushed.
     read_callbacks_->connection().readDisable(false);
-  } else if (!receive_before_connect_) {
+  } else if (!receive_before_connect_ && !maybeStartSplice()) {
     // Re-enable downstream reads now that the upstream connection is established
     read_callbacks_->connection().readDisable(false);
   }
@@ -1064,6 +1071,89 @@ void Filter::onUpstreamConnection() {
   }
 }
 
+bool Filter::maybeStartSplice() {
+  if (!config_->spliceData()) {
+    return false;
+  }
+  // Tunneled upstreams re-frame the payload, so only a plain TCP upstream qualifies.
+  auto* tcp_upstream = dynamic_cast<TcpUpstream*>(upstream_.get());
+  if (tcp_upstream == nullptr || !tcp_upstream->connection().has_value()) {
+    return false;
+  }
+  OptRef<Network::IoHandle> downstream_handle = read_callbacks_->connection().passthroughIoHandle();
+  OptRef<Network::IoHandle> upstream_handle = tcp_upstream->connection()->passthroughIoHandle();
+  if (!downstream_handle.has_value() || !upstream_handle.has_value()) {
+    return false;
+  }
+  splice_forwarder_ = SpliceForwarder::create(read_callbacks_->connection().dispatcher(),
+                                              *downstream_handle, *upstream_handle, *this);
+  if (splice_forwarder_ == nullptr) {
+    return false;
+  }
+
+  // Neither connection may read from its socket while the payload is spliced. The downstream
+  // connection is still read disabled from initialize(); each side is handed back to its
+  // connection once its direction reaches end of stream.
+  upstream_->readDisable(true);
+  config_->stats().downstream_cx_splice_total_.inc();
+  ENVOY_CONN_LOG(debug, "splicing payload between downstream and upstream sockets",
+                 read_callbacks_->connection());
+  return true;
+}
+
+void Filter::onSpliceBytesReceived(SpliceForwarder::Direction direction, uint64_t bytes) {
+  if (direction == SpliceForwarder::Direction::DownstreamToUpstream) {
+    // The network filter manager accounts for bytes it reads itself, see FilterManagerImpl.
+    getStreamInfo().addBytesReceived(bytes);
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(bytes);
+    if (connection_stats_set_) {
+      config_->stats().downstream_cx_rx_bytes_total_.add(bytes);
+    }
+  } else {
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(bytes);
+    read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_rx_bytes_total_.add(
+        bytes);
+  }
+  resetIdleTimer();
+}
+
+void Filter::onSpliceBytesSent(SpliceForwarder::Direction direction, uint64_t bytes) {
+  if (direction == SpliceForwarder::Direction::DownstreamToUpstream) {
+    getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(bytes);
+    read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_tx_bytes_total_.add(
+        bytes);
+  } else {
+    getStreamInfo().addBytesSent(bytes);
+    getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(bytes);
+    if (connection_stats_set_) {
+      config_->stats().downstream_cx_tx_bytes_total_.add(bytes);
+    }
+  }
+  resetIdleTimer();
+}
+
+void Filter::onSpliceEndStream(SpliceForwarder::Direction direction) {
+  // Let the source connection read the end of stream itself so that the half close is propagated
+  // through the regular path.
+  if (direction == SpliceForwarder::Direction::DownstreamToUpstream) {
+    ENVOY_CONN_LOG(trace, "downstream end of stream while splicing", read_callbacks_->connection());
+    read_callbacks_->connection().readDisable(false);
+  } else {
+    ENVOY_CONN_LOG(trace, "upstream end of stream while splicing", read_callbacks_->connection());
+    upstream_->readDisable(false);
+  }
+}
+
+void Filter::onSpliceError(SpliceForwarder::Direction direction, int error) {
+  ENVOY_CONN_LOG(debug, "splice {} failed: {}", read_callbacks_->connection(),
+                 direction == SpliceForwarder::Direction::DownstreamToUpstream ? "to upstream"
+                                                                               : "to downstream",
+                 errorDetails(error));
+  // Closing the downstream connection also closes the upstream one and destroys the forwarder.
+  read_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush,
+                                      "tcp_proxy_splice_error");
+}
+
 void Filter::onIdleTimeout() {
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
@@ -33,6 +33,7 @@
 #include "source/common/network/hash_policy.h"
 #include "source/common/network/utility.h"
 #include "source/common/stream_info/stream_info_impl.h"
+#include "source/common/tcp_proxy/splice.h"
 #include "source/common/tcp_proxy/upstream.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/common/upstream/od_cds_api_impl.h"
@@ -60,6 +61,7 @@ constexpr absl::string_view ReceiveBeforeConnectKey = "envoy.tcp_proxy.receive_b
 #define ALL_TCP_PROXY_STATS(COUNTER, GAUGE)                                                        \
   COUNTER(downstream_cx_no_route)                                                                  \
   COUNTER(downstream_cx_rx_bytes_total)                                                            \
+  COUNTER(downstream_cx_splice_total)                                                              \
   COUNTER(downstream_cx_total)                                                                     \
   COUNTER(downstream_cx_tx_bytes_total)                                                            \
   COUNTER(downstream_flow_control_paused_reading_total)                                            \
@@ -248,6 +250,7 @@ public:
     const Network::ProxyProtocolTLVVector& proxyProtocolTLVs() const {
       return proxy_protocol_tlvs_;
     }
+    bool spliceData() const { return splice_data_; }
 
   private:
     static TcpProxyStats generateStats(Stats::Scope& scope);
@@ -261,6 +264,7 @@ public:
 
     const TcpProxyStats stats_;
     bool flush_access_log_on_connected_;
+    const bool splice_data_;
     absl::optional<std::chrono::milliseconds> idle_timeout_;
     absl::optional<std::chrono::milliseconds> max_downstream_connection_duration_;
     absl::optional<std::chrono::milliseconds> access_log_flush_interval_;
@@ -326,6 +330,7 @@ public:
   const Network::ProxyProtocolTLVVector& proxyProtocolTLVs() const {
     return shared_config_->proxyProtocolTLVs();
   }
+  bool spliceData() const { return shared_config_->spliceData(); }
 
 private:
   struct SimpleRouteImpl : public Route {
@@ -405,7 +410,8 @@ private:
 class Filter : public Network::ReadFilter,
                public Upstream::LoadBalancerContextBase,
                protected Logger::Loggable<Logger::Id::filter>,
-               public GenericConnectionPoolCallbacks {
+               public GenericConnectionPoolCallbacks,
+               public SpliceForwarder::Callbacks {
 public:
   Filter(ConfigSharedPtr config, Upstream::ClusterManager& cluster_manager);
   ~Filter() override;
@@ -425,6 +431,12 @@ public:
                             absl::string_view failure_reason,
                             Upstream::HostDescriptionConstSharedPtr host) override;
 
+  // SpliceForwarder::Callbacks
+  void onSpliceBytesReceived(SpliceForwarder::Direction direction, uint64_t bytes) override;
+  void onSpliceBytesSent(SpliceForwarder::Direction direction, uint64_t bytes) override;
+  void onSpliceEndStream(SpliceForwarder::Direction direction) override;
+  void onSpliceError(SpliceForwarder::Direction direction, int error) override;
+
   // Upstream::LoadBalancerContext
   const Router::MetadataMatchCriteria* metadataMatchCriteria() override;
   absl::optional<uint64_t> computeHashKey() override {
@@ -631,6 +643,10 @@ protected:
   void onUpstreamData(Buffer::Instance& data, bool end_stream);
   void onUpstreamEvent(Network::ConnectionEvent event);
   void onUpstreamConnection();
+  // Starts splicing the payload between the downstream and upstream sockets if configured and both
+  // connections qualify. Returns true if splicing started, in which case the downstream connection
+  // must be left read disabled.
+  bool maybeStartSplice();
   void onIdleTimeout();
   void resetIdleTimer();
   void disableIdleTimer();
@@ -665,6 +681,9 @@ protected:
   // This will be non-null from when an upstream connection is attempted until
   // it either succeeds or fails.
   std::unique_ptr<GenericConnPool> generic_conn_pool_;
+  // Moves the payload between the downstream and upstream sockets when splicing is enabled. It
+  // must not outlive |upstream_|.
+  SpliceForwarderPtr splice_forwarder_;
   // Time the filter first attempted to connect to the upstream after the
   // cluster is discovered. Capture the first time as the filter may try multiple times to connect
   // to the upstream.
@@ -675,6 +694,7 @@ protected:
   Network::Socket::OptionsSharedPtr upstream_options_;
   absl::optional<std::chrono::milliseconds> idle_timeout_;
   uint32_t connect_attempts_{};
+  bool connection_stats_set_{};
   bool connecting_{};
   bool downstream_closed_{};
   // Stores the ReceiveBeforeConnect filter state value which can be set by preceding
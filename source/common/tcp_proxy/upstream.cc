@@ -60,6 +60,13 @@ Ssl::ConnectionInfoConstSharedPtr TcpUpstream::getUpstreamConnectionSslInfo() {
   return nullptr;
 }
 
+OptRef<Network::ClientConnection> TcpUpstream::connection() {
+  if (upstream_conn_data_ == nullptr) {
+    return {};
+  }
+  return upstream_conn_data_->connection();
+}
+
 Tcp::ConnectionPool::ConnectionData*
 TcpUpstream::onDownstreamEvent(Network::ConnectionEvent event) {
   // TODO(botengyao): propagate RST back to upstream connection if RST is received from downstream.
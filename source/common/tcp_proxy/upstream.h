@@ -178,6 +178,9 @@ public:
   bool startUpstreamSecureTransport() override;
   Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() override;
 
+  // @return the upstream connection, or an empty OptRef once it has been handed off for draining.
+  OptRef<Network::ClientConnection> connection();
+
 private:
   Tcp::ConnectionPool::ConnectionDataPtr upstream_conn_data_;
 };
@@ -94,6 +94,12 @@ public:
 
   SslStats& stats() { return stats_; }
 
+  /**
+   * @return true if connections created from this context may be renegotiated after the
+   * handshake.
+   */
+  virtual bool allowsRenegotiation() const { return false; }
+
   /**
    * The global SSL-library index used for storing a pointer to the SslExtendedSocketInfo
    * class in the SSL instance, for retrieval in callbacks.
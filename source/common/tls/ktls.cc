@@ -0,0 +1,218 @@
+#include "source/common/tls/ktls.h"
+
+#include <array>
+
+#include "envoy/common/platform.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/common/utility.h"
+
+#include "absl/container/fixed_array.h"
+#include "absl/strings/str_cat.h"
+#include "openssl/mem.h"
+#include "openssl/nid.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+#endif
+
+#if defined(__linux__) && defined(TLS_TX) && defined(TLS_RX) && defined(TLS_GET_RECORD_TYPE)
+#define ENVOY_KTLS 1
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#else
+#define ENVOY_KTLS 0
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+namespace {
+
+#if ENVOY_KTLS
+// TLS 1.2 AES-GCM nonces are a 4 byte implicit part (the "salt") taken from the key block,
+// followed by an 8 byte explicit part carried in each record.
+constexpr size_t GcmSaltLength = 4;
+constexpr size_t MaxGcmKeyLength = 32;
+
+template <class CryptoInfo>
+Api::SysCallIntResult setGcmCryptoInfo(Network::IoHandle& io_handle, int direction,
+                                       uint16_t cipher_type, const uint8_t* key,
+                                       const uint8_t* salt, uint64_t sequence) {
+  CryptoInfo info{};
+  static_assert(sizeof(info.salt) == GcmSaltLength);
+  static_assert(sizeof(info.iv) == sizeof(info.rec_seq));
+  info.info.version = TLS_1_2_VERSION;
+  info.info.cipher_type = cipher_type;
+  memcpy(info.key, key, sizeof(info.key));
+  memcpy(info.salt, salt, sizeof(info.salt));
+  for (size_t i = 0; i < sizeof(info.rec_seq); ++i) {
+    info.rec_seq[sizeof(info.rec_seq) - 1 - i] = static_cast<uint8_t>(sequence >> (8 * i));
+  }
+  // Like BoringSSL, use the record sequence number as the explicit nonce.
+  memcpy(info.iv, info.rec_seq, sizeof(info.iv));
+  const Api::SysCallIntResult result = io_handle.setOption(SOL_TLS, direction, &info, sizeof(info));
+  OPENSSL_cleanse(&info, sizeof(info));
+  return result;
+}
+
+Api::SysCallIntResult setCryptoInfo(Network::IoHandle& io_handle, int direction, int cipher_nid,
+                                    const uint8_t* key, const uint8_t* salt, uint64_t sequence) {
+  if (cipher_nid == NID_aes_128_gcm) {
+    return setGcmCryptoInfo<tls12_crypto_info_aes_gcm_128>(
+        io_handle, direction, TLS_CIPHER_AES_GCM_128, key, salt, sequence);
+  }
+  ASSERT(cipher_nid == NID_aes_256_gcm);
+  return setGcmCryptoInfo<tls12_crypto_info_aes_gcm_256>(io_handle, direction,
+                                                         TLS_CIPHER_AES_GCM_256, key, salt, sequence);
+}
+#endif
+
+} // namespace
+
+absl::Status Ktls::enable(SSL* ssl, Network::IoHandle& io_handle, KtlsOffload& offload) {
+#if ENVOY_KTLS
+  if (SSL_version(ssl) != TLS1_2_VERSION) {
+    return absl::UnimplementedError(
+        absl::StrCat("kTLS is not supported for ", SSL_get_version(ssl)));
+  }
+  if (SSL_in_init(ssl) || SSL_in_false_start(ssl) || SSL_has_pending(ssl)) {
+    return absl::FailedPreconditionError("TLS session has handshake or record data in flight");
+  }
+
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  const int cipher_nid = SSL_CIPHER_get_cipher_nid(cipher);
+  size_t key_length;
+  switch (cipher_nid) {
+  case NID_aes_128_gcm:
+    key_length = 16;
+    break;
+  case NID_aes_256_gcm:
+    key_length = 32;
+    break;
+  default:
+    return absl::UnimplementedError(
+        absl::StrCat("kTLS is not supported for cipher ", SSL_CIPHER_get_name(cipher)));
+  }
+
+  // For AEAD ciphers the TLS 1.2 key block has no MAC keys: it is client_write_key,
+  // server_write_key, client_write_IV, server_write_IV.
+  std::array<uint8_t, 2 * (MaxGcmKeyLength + GcmSaltLength)> key_block;
+  const size_t key_block_length = 2 * (key_length + GcmSaltLength);
+  if (SSL_get_key_block_len(ssl) != key_block_length ||
+      !SSL_generate_key_block(ssl, key_block.data(), key_block_length)) {
+    return absl::InternalError("unable to export the TLS key block");
+  }
+  const uint8_t* client_key = key_block.data();
+  const uint8_t* server_key = client_key + key_length;
+  const uint8_t* client_salt = server_key + key_length;
+  const uint8_t* server_salt = client_salt + GcmSaltLength;
+  const bool is_server = SSL_is_server(ssl);
+
+  static constexpr char Ulp[] = "tls";
+  Api::SysCallIntResult result = io_handle.setOption(IPPROTO_TCP, TCP_ULP, Ulp, sizeof(Ulp));
+  if (result.return_value_ != 0) {
+    OPENSSL_cleanse(key_block.data(), key_block.size());
+    return absl::UnavailableError(
+        absl::StrCat("unable to attach the TLS ULP: ", errorDetails(result.errno_)));
+  }
+
+  // Until keys are installed for a direction, the ULP passes that direction through untouched.
+  // Receive goes first so that a failure to install transmit keys leaves BoringSSL writing records
+  // itself, which needs no further reads on TLS 1.2.
+  result = setCryptoInfo(io_handle, TLS_RX, cipher_nid, is_server ? client_key : server_key,
+                         is_server ? client_salt : server_salt, SSL_get_read_sequence(ssl));
+  if (result.return_value_ == 0) {
+    offload.rx_ = true;
+    result = setCryptoInfo(io_handle, TLS_TX, cipher_nid, is_server ? server_key : client_key,
+                           is_server ? server_salt : client_salt, SSL_get_write_sequence(ssl));
+    offload.tx_ = result.return_value_ == 0;
+  }
+  OPENSSL_cleanse(key_block.data(), key_block.size());
+
+  if (!offload.tx_) {
+    return absl::UnavailableError(absl::StrCat("unable to install kTLS ",
+                                               offload.rx_ ? "transmit" : "receive",
+                                               " keys: ", errorDetails(result.errno_)));
+  }
+  return absl::OkStatus();
+#else
+  UNREFERENCED_PARAMETER(ssl);
+  UNREFERENCED_PARAMETER(io_handle);
+  UNREFERENCED_PARAMETER(offload);
+  return absl::UnimplementedError("kTLS is not supported on this platform");
+#endif
+}
+
+Api::SysCallSizeResult Ktls::recv(Network::IoHandle& io_handle, Buffer::RawSlice* slices,
+                                  uint64_t num_slice, uint8_t& record_type) {
+  record_type = RecordTypeApplicationData;
+#if ENVOY_KTLS
+  absl::FixedArray<iovec> iov(num_slice);
+  for (uint64_t i = 0; i < num_slice; i++) {
+    iov[i].iov_base = slices[i].mem_;
+    iov[i].iov_len = slices[i].len_;
+  }
+  char cbuf[CMSG_SPACE(sizeof(uint8_t))] = {};
+  msghdr message{};
+  message.msg_iov = iov.begin();
+  message.msg_iovlen = num_slice;
+  message.msg_control = cbuf;
+  message.msg_controllen = sizeof(cbuf);
+  const Api::SysCallSizeResult result =
+      Api::OsSysCallsSingleton::get().recvmsg(io_handle.fdDoNotUse(), &message, 0);
+  if (result.return_value_ > 0) {
+    // The kernel only attaches the record type when it is not application data.
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&message, cmsg)) {
+      if (cmsg->cmsg_level == SOL_TLS && cmsg->cmsg_type == TLS_GET_RECORD_TYPE) {
+        record_type = *CMSG_DATA(cmsg);
+      }
+    }
+  }
+  return result;
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+  UNREFERENCED_PARAMETER(slices);
+  UNREFERENCED_PARAMETER(num_slice);
+  return {-1, SOCKET_ERROR_NOT_SUP};
+#endif
+}
+
+Api::SysCallSizeResult Ktls::sendAlert(Network::IoHandle& io_handle, uint8_t level,
+                                       uint8_t description) {
+#if ENVOY_KTLS
+  uint8_t alert[2] = {level, description};
+  iovec iov{alert, sizeof(alert)};
+  char cbuf[CMSG_SPACE(sizeof(uint8_t))] = {};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = cbuf;
+  message.msg_controllen = sizeof(cbuf);
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint8_t));
+  *CMSG_DATA(cmsg) = RecordTypeAlert;
+  return Api::OsSysCallsSingleton::get().sendmsg(io_handle.fdDoNotUse(), &message, 0);
+#else
+  UNREFERENCED_PARAMETER(io_handle);
+  UNREFERENCED_PARAMETER(level);
+  UNREFERENCED_PARAMETER(description);
+  return {-1, SOCKET_ERROR_NOT_SUP};
+#endif
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+
+#include "envoy/api/os_sys_calls_common.h"
+#include "envoy/buffer/buffer.h"
+#include "envoy/network/io_handle.h"
+
+#include "absl/status/status.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * The directions of a TLS session whose record protection has been handed to the kernel.
+ */
+struct KtlsOffload {
+  bool rx_{false};
+  bool tx_{false};
+};
+
+/**
+ * Kernel TLS (kTLS) helpers. Once a session's record keys are installed on the socket, records
+ * are encrypted and decrypted by the kernel and the connection can use plain socket reads and
+ * writes.
+ */
+class Ktls {
+public:
+  static constexpr uint8_t RecordTypeAlert = 21;
+  static constexpr uint8_t RecordTypeApplicationData = 23;
+
+  /**
+   * Installs the record keys of a completed TLS session on its socket. Only TLS 1.2 with
+   * AES-GCM is supported: BoringSSL does not export TLS 1.3 traffic secrets, and TLS 1.3
+   * post-handshake messages (KeyUpdate, NewSessionTicket) cannot be processed once the keys live
+   * in the kernel.
+   * @param ssl supplies the session. It must have finished its handshake and hold no buffered
+   *        records.
+   * @param io_handle supplies the handle of the TCP socket carrying the session.
+   * @param offload receives the directions that were offloaded. Receive is offloaded before
+   *        transmit, so on failure either nothing or only receive has moved to the kernel.
+   * @return absl::Status OK if both directions were offloaded, otherwise the reason why one or
+   *         both must stay in user space.
+   */
+  static absl::Status enable(SSL* ssl, Network::IoHandle& io_handle, KtlsOffload& offload);
+
+  /**
+   * Reads one or more records of the same type from a socket with receive offload.
+   * @param record_type receives the type of the records read. Anything other than
+   *        RecordTypeApplicationData must be handled by the caller.
+   * @return the result of the recvmsg() call.
+   */
+  static Api::SysCallSizeResult recv(Network::IoHandle& io_handle, Buffer::RawSlice* slices,
+                                     uint64_t num_slice, uint8_t& record_type);
+
+  /**
+   * Sends an alert record on a socket with transmit offload.
+   * @return the result of the sendmsg() call.
+   */
+  static Api::SysCallSizeResult sendAlert(Network::IoHandle& io_handle, uint8_t level,
+                                          uint8_t description);
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -5,11 +5,14 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/empty_string.h"
 #include "source/common/common/hex.h"
+#include "source/common/common/utility.h"
 #include "source/common/http/headers.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/tls/io_handle_bio.h"
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 #include "openssl/err.h"
 #include "openssl/x509v3.h"
@@ -117,6 +120,11 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
     }
   }
 
+  maybeEnableKtls();
+  if (ktls_.rx_) {
+    return doKtlsRead(read_buffer);
+  }
+
   bool keep_reading = true;
   bool end_stream = false;
   PostIoAction action = PostIoAction::KeepOpen;
@@ -208,6 +216,105 @@ void SslSocket::onFailure() { drainErrorQueue(); }
 
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
 
+void SslSocket::maybeEnableKtls() {
+  if (ktls_attempted_ || info_->state() != Ssl::SocketState::HandshakeComplete) {
+    return;
+  }
+  ktls_attempted_ = true;
+  // A renegotiation could not be processed once the keys live in the kernel. A write that
+  // BoringSSL must retry has already been encrypted with the user space keys.
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.tls_kernel_offload") ||
+      ctx_->allowsRenegotiation() || bytes_to_retry_ != 0) {
+    return;
+  }
+
+  const absl::Status status = Ktls::enable(rawSsl(), callbacks_->ioHandle(), ktls_);
+  if (status.ok()) {
+    ctx_->stats().kernel_offload_.inc();
+  } else {
+    ENVOY_CONN_LOG(debug, "TLS kernel offload unavailable: {}", callbacks_->connection(),
+                   status.message());
+    ctx_->stats().kernel_offload_unsupported_.inc();
+  }
+}
+
+Network::IoResult SslSocket::doKtlsRead(Buffer::Instance& read_buffer) {
+  PostIoAction action = PostIoAction::KeepOpen;
+  uint64_t bytes_read = 0;
+  bool end_stream = false;
+  while (true) {
+    Buffer::Reservation reservation = read_buffer.reserveForRead();
+    uint8_t record_type;
+    const Api::SysCallSizeResult result = Ktls::recv(
+        callbacks_->ioHandle(), reservation.slices(), reservation.numSlices(), record_type);
+    ENVOY_CONN_LOG(trace, "ktls read returns: {}", callbacks_->connection(), result.return_value_);
+    if (result.return_value_ < 0) {
+      reservation.commit(0);
+      if (result.errno_ != SOCKET_ERROR_AGAIN) {
+        failure_reason_ = absl::StrCat("TLS_error:|kTLS read:", errorDetails(result.errno_));
+        action = PostIoAction::Close;
+      }
+      break;
+    }
+    if (result.return_value_ == 0) {
+      // Non-graceful shutdown by closing the underlying socket.
+      reservation.commit(0);
+      end_stream = true;
+      break;
+    }
+    if (record_type != Ktls::RecordTypeApplicationData) {
+      const auto* record = static_cast<const uint8_t*>(reservation.slices()[0].mem_);
+      if (record_type == Ktls::RecordTypeAlert && result.return_value_ == 2 &&
+          record[1] == SSL_AD_CLOSE_NOTIFY) {
+        // Graceful shutdown using close_notify TLS alert.
+        end_stream = true;
+      } else {
+        // Fatal alerts and post-handshake messages (e.g. a renegotiation request) cannot be
+        // handled without BoringSSL.
+        failure_reason_ = absl::StrCat("TLS_error:|kTLS unexpected record type ",
+                                       static_cast<int>(record_type));
+        action = PostIoAction::Close;
+      }
+      reservation.commit(0);
+      break;
+    }
+
+    reservation.commit(result.return_value_);
+    bytes_read += result.return_value_;
+    if (callbacks_->shouldDrainReadBuffer()) {
+      callbacks_->setTransportSocketIsReadable();
+      break;
+    }
+  }
+
+  ENVOY_CONN_LOG(trace, "ktls read {} bytes", callbacks_->connection(), bytes_read);
+  return {action, bytes_read, end_stream};
+}
+
+Network::IoResult SslSocket::doKtlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  uint64_t total_bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    const Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "ktls write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+        return {PostIoAction::KeepOpen, total_bytes_written, false};
+      }
+      failure_reason_ = absl::StrCat("TLS_error:|kTLS write:", result.err_->getErrorDetails());
+      return {PostIoAction::Close, total_bytes_written, false};
+    }
+    ENVOY_CONN_LOG(trace, "ktls write returns: {}", callbacks_->connection(), result.return_value_);
+    total_bytes_written += result.return_value_;
+  }
+
+  if (end_stream) {
+    shutdownSsl();
+  }
+
+  return {PostIoAction::KeepOpen, total_bytes_written, false};
+}
+
 void SslSocket::drainErrorQueue() {
   bool saw_error = false;
   bool saw_counted_error = false;
@@ -263,6 +370,11 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  maybeEnableKtls();
+  if (ktls_.tx_) {
+    return doKtlsWrite(write_buffer, end_stream);
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
@@ -321,6 +433,16 @@ void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
+    if (ktls_.tx_) {
+      // BoringSSL's write sequence number is stale once the kernel encrypts records, so the
+      // close_notify alert has to go through the kernel as well.
+      const Api::SysCallSizeResult result =
+          Ktls::sendAlert(callbacks_->ioHandle(), SSL3_AL_WARNING, SSL_AD_CLOSE_NOTIFY);
+      ENVOY_CONN_LOG(debug, "kTLS shutdown: rc={}", callbacks_->connection(),
+                     result.return_value_);
+      info_->setState(Ssl::SocketState::ShutdownSent);
+      return;
+    }
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
@@ -16,6 +16,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/network/transport_socket_options_impl.h"
 #include "source/common/tls/context_impl.h"
+#include "source/common/tls/ktls.h"
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
@@ -94,6 +95,11 @@ private:
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
 
   Network::PostIoAction doHandshake();
+  // Hands the record protection of the session to the kernel, if enabled and supported. Called
+  // once, after the handshake completes.
+  void maybeEnableKtls();
+  Network::IoResult doKtlsRead(Buffer::Instance& read_buffer);
+  Network::IoResult doKtlsWrite(Buffer::Instance& write_buffer, bool end_stream);
   void drainErrorQueue();
   void shutdownSsl();
   void shutdownBasic();
@@ -104,6 +110,8 @@ private:
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
+  bool ktls_attempted_{false};
+  KtlsOffload ktls_;
 
   SslHandshakerImplSharedPtr info_;
 };
@@ -11,6 +11,8 @@ namespace Tls {
 #define ALL_SSL_STATS(COUNTER, GAUGE, HISTOGRAM)                                                   \
   COUNTER(connection_error)                                                                        \
   COUNTER(handshake)                                                                               \
+  COUNTER(kernel_offload)                                                                          \
+  COUNTER(kernel_offload_unsupported)                                                              \
   COUNTER(session_reused)                                                                          \
   COUNTER(no_certificate)                                                                          \
   COUNTER(fail_verify_no_cert)                                                                     \
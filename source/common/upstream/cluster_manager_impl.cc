@@ -118,12 +118,12 @@ void ClusterManagerInitHelper::addCluster(ClusterManagerCluster& cm_cluster) {
 
   const auto initialize_cb = [&cm_cluster, this] {
     RETURN_IF_NOT_OK(onClusterInit(cm_cluster));
-    cm_cluster.cluster().info()->configUpdateStats().warming_state_.set(0);
+    cm_cluster.cluster().info()->warmingState().set(0);
     return absl::OkStatus();
   };
   Cluster& cluster = cm_cluster.cluster();
 
-  cluster.info()->configUpdateStats().warming_state_.set(1);
+  cluster.info()->warmingState().set(1);
   if (cluster.initializePhase() == Cluster::InitializePhase::Primary) {
     // Remove the previous cluster before the cluster object is destroyed.
     primary_init_clusters_.insert_or_assign(cm_cluster.cluster().info()->name(), &cm_cluster);
@@ -761,7 +761,7 @@ ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cluster
   RETURN_IF_NOT_OK_REF(status_or_cluster.status());
   const ClusterDataPtr previous_cluster = std::move(status_or_cluster.value());
   auto& cluster_entry = warming_clusters_.at(cluster_name);
-  cluster_entry->cluster_->info()->configUpdateStats().warming_state_.set(1);
+  cluster_entry->cluster_->info()->warmingState().set(1);
   if (!all_clusters_initialized) {
     ENVOY_LOG(debug, "add/update cluster {} during init", cluster_name);
     init_helper_.addCluster(*cluster_entry);
@@ -770,8 +770,7 @@ ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cluster
     cluster_entry->cluster_->initialize([this, cluster_name] {
       ENVOY_LOG(debug, "warming cluster {} complete", cluster_name);
       auto state_changed_cluster_entry = warming_clusters_.find(cluster_name);
-      state_changed_cluster_entry->second->cluster_->info()->configUpdateStats().warming_state_.set(
-          0);
+      state_changed_cluster_entry->second->cluster_->info()->warmingState().set(0);
       return onClusterInit(*state_changed_cluster_entry->second);
     });
   }
@@ -7,6 +7,8 @@
 
 #include "source/common/common/assert.h"
 
+#include "absl/container/flat_hash_set.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -66,6 +68,23 @@ public:
 
   bool empty() const override { return queue_.empty(); }
 
+  /**
+   * Removes an entry from the schedule. The entry is dropped the next time it reaches the front of
+   * the queue, which keeps removal O(1). Until then a reference to it is held, so that an entry
+   * added later can't be mistaken for it. If removed entries come to make up half of the queue,
+   * the queue is compacted in O(n log n).
+   *
+   * @param entry the entry to remove. It must have been added exactly once.
+   */
+  void remove(std::shared_ptr<C> entry) {
+    prepick_list_.remove_if(
+        [&entry](const std::weak_ptr<C>& prepicked) { return prepicked.lock() == entry; });
+    removed_.insert(std::move(entry));
+    if (removed_.size() * 2 > queue_.size()) {
+      compact();
+    }
+  }
+
   // Creates an EdfScheduler with the given weights and their corresponding
   // entries, and emulating a number of initial picks to be performed. Note that
   // the internal state of the scheduler will be very similar to creating an empty
@@ -190,6 +209,11 @@ private:
         queue_.pop();
         continue;
       }
+      if (!removed_.empty() && removed_.erase(ret) > 0) {
+        EDF_TRACE("Entry has been removed, repick.");
+        queue_.pop();
+        continue;
+      }
       ASSERT(edf_entry.deadline_ >= current_time_);
       current_time_ = edf_entry.deadline_;
       EDF_TRACE("Picked {}, current_time_={}.", static_cast<const void*>(ret.get()), current_time_);
@@ -202,8 +226,8 @@ private:
     double deadline_;
     // Tie breaker for entries with the same deadline. This is used to provide FIFO behavior.
     uint64_t order_offset_;
-    // We only hold a weak pointer, since we don't support a remove operator. This allows entries to
-    // be lazily unloaded from the queue.
+    // We only hold a weak pointer, so that entries which are destroyed without being removed are
+    // lazily unloaded from the queue.
     std::weak_ptr<C> entry_;
 
     // Flip < direction to make this a min queue.
@@ -218,6 +242,21 @@ private:
       : current_time_(current_time), order_offset_(order_offset),
         queue_(scheduler_entries.cbegin(), scheduler_entries.cend()) {}
 
+  // Drops the removed and expired entries from the queue, keeping the deadlines of the others.
+  void compact() {
+    std::vector<EdfEntry> entries;
+    entries.reserve(queue_.size());
+    for (; !queue_.empty(); queue_.pop()) {
+      const EdfEntry& edf_entry = queue_.top();
+      std::shared_ptr<C> entry = edf_entry.entry_.lock();
+      if (entry != nullptr && removed_.erase(entry) == 0) {
+        entries.push_back(edf_entry);
+      }
+    }
+    removed_.clear();
+    queue_ = std::priority_queue<EdfEntry>(entries.cbegin(), entries.cend());
+  }
+
   // Current time in EDF scheduler.
   // TODO(htuch): Is it worth the small extra complexity to use integer time for performance
   // reasons?
@@ -228,6 +267,8 @@ private:
   // Min priority queue for EDF.
   std::priority_queue<EdfEntry> queue_;
   std::list<std::weak_ptr<C>> prepick_list_;
+  // Entries which were removed but are still in the queue.
+  absl::flat_hash_set<std::shared_ptr<C>> removed_;
 };
 
 #undef EDF_DEBUG
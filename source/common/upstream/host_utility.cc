@@ -5,6 +5,8 @@
 #include "source/common/config/well_known_names.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Upstream {
 namespace {
@@ -230,5 +232,66 @@ void HostUtility::forEachHostMetric(
   }
 }
 
+void HostUtility::forEachUncreatedClusterMetric(
+    const ClusterManager& cluster_manager,
+    const std::function<void(Stats::PrimitiveCounterSnapshot&& metric)>& counter_cb,
+    const std::function<void(Stats::PrimitiveGaugeSnapshot&& metric)>& gauge_cb) {
+  for (const auto& [unused_name, cluster_ref] : cluster_manager.clusters().active_clusters_) {
+    Upstream::ClusterInfoConstSharedPtr cluster_info = cluster_ref.get().info();
+    Stats::Scope& scope = cluster_info->statsScope();
+    Stats::SymbolTable& symbol_table = scope.symbolTable();
+    const std::string cluster_name =
+        Stats::Utility::sanitizeStatsName(cluster_info->observabilityName());
+
+    const Stats::TagVector& fixed_tags = scope.store().fixedTags();
+    Stats::TagVector tags;
+    tags.reserve(fixed_tags.size() + 1);
+    tags.insert(tags.end(), fixed_tags.begin(), fixed_tags.end());
+    tags.emplace_back(Stats::Tag{Envoy::Config::TagNames::get().CLUSTER_NAME, cluster_name});
+
+    // Returns the stat's name relative to the scope, or nullopt if a stat of that name was
+    // created in the scope in the meantime, e.g. through another block sharing the name.
+    auto relative_name = [&](Stats::StatName prefix, Stats::StatName name,
+                             bool is_counter) -> absl::optional<std::string> {
+      const Stats::SymbolTable::StoragePtr full_name =
+          prefix.empty() ? symbol_table.join({scope.prefix(), name})
+                         : symbol_table.join({scope.prefix(), prefix, name});
+      if (is_counter ? scope.findCounter(Stats::StatName(full_name.get())).has_value()
+                     : scope.findGauge(Stats::StatName(full_name.get())).has_value()) {
+        return absl::nullopt;
+      }
+      return prefix.empty() ? symbol_table.toString(name)
+                            : absl::StrCat(symbol_table.toString(prefix), ".",
+                                           symbol_table.toString(name));
+    };
+    auto set_metric_metadata = [&](const std::string& name,
+                                   Stats::PrimitiveMetricMetadata& metric) {
+      metric.setName(absl::StrCat("cluster.", cluster_name, ".", name));
+      metric.setTagExtractedName(absl::StrCat("cluster.", name));
+      metric.setTags(tags);
+    };
+
+    cluster_info->forEachUncreatedStat(
+        [&](Stats::StatName prefix, Stats::StatName name) {
+          const absl::optional<std::string> stat_name = relative_name(prefix, name, true);
+          if (stat_name.has_value()) {
+            Stats::PrimitiveCounter zero_counter;
+            Stats::PrimitiveCounterSnapshot metric(zero_counter);
+            set_metric_metadata(*stat_name, metric);
+            counter_cb(std::move(metric));
+          }
+        },
+        [&](Stats::StatName prefix, Stats::StatName name) {
+          const absl::optional<std::string> stat_name = relative_name(prefix, name, false);
+          if (stat_name.has_value()) {
+            Stats::PrimitiveGauge zero_gauge;
+            Stats::PrimitiveGaugeSnapshot metric(zero_gauge);
+            set_metric_metadata(*stat_name, metric);
+            gauge_cb(std::move(metric));
+          }
+        });
+  }
+}
+
 } // namespace Upstream
 } // namespace Envoy
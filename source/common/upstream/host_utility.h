@@ -40,6 +40,14 @@ public:
   forEachHostMetric(const ClusterManager& cluster_manager,
                     const std::function<void(Stats::PrimitiveCounterSnapshot&& metric)>& counter_cb,
                     const std::function<void(Stats::PrimitiveGaugeSnapshot&& metric)>& gauge_cb);
+
+  // Iterate over the counters and gauges of all clusters which were deferred and have not been
+  // created yet, each reported with a value of zero. Only the cluster name and the fixed tags
+  // are set as tags.
+  static void forEachUncreatedClusterMetric(
+      const ClusterManager& cluster_manager,
+      const std::function<void(Stats::PrimitiveCounterSnapshot&& metric)>& counter_cb,
+      const std::function<void(Stats::PrimitiveGaugeSnapshot&& metric)>& gauge_cb);
 };
 
 } // namespace Upstream
@@ -17,23 +17,46 @@ namespace Envoy {
 namespace Upstream {
 
 struct ManagedResourceImpl : public BasicResourceLimitImpl {
+  // Returns the gauge, out of the circuit breaker "open" gauges, for this resource.
+  using OpenGaugeFn = Stats::Gauge& (*)(ClusterCircuitBreakersOpenStats& open_stats);
+
   ManagedResourceImpl(uint64_t max, Runtime::Loader& runtime, const std::string& runtime_key,
                       Stats::Gauge& open_gauge, Stats::Gauge& remaining)
-      : BasicResourceLimitImpl(max, runtime, runtime_key), open_gauge_(open_gauge),
+      : BasicResourceLimitImpl(max, runtime, runtime_key), open_gauge_(&open_gauge),
         remaining_(remaining) {
     remaining_.set(max);
   }
+  ManagedResourceImpl(uint64_t max, Runtime::Loader& runtime, const std::string& runtime_key,
+                      DeferredCreationCompatibleClusterCircuitBreakersOpenStats& open_stats,
+                      OpenGaugeFn open_stats_gauge, Stats::Gauge& remaining)
+      : BasicResourceLimitImpl(max, runtime, runtime_key), open_stats_(&open_stats),
+        open_stats_gauge_(open_stats_gauge), remaining_(remaining) {
+    remaining_.set(max);
+  }
 
   // BasicResourceLimitImpl
   void inc() override {
     BasicResourceLimitImpl::inc();
     updateRemaining();
-    open_gauge_.set(BasicResourceLimitImpl::canCreate() ? 0 : 1);
+    updateOpen();
   }
   void decBy(uint64_t amount) override {
     BasicResourceLimitImpl::decBy(amount);
     updateRemaining();
-    open_gauge_.set(BasicResourceLimitImpl::canCreate() ? 0 : 1);
+    updateOpen();
+  }
+
+  /**
+   * An "open" gauge which has not been created yet reads as zero, so deferred "open" gauges are
+   * only created once a circuit breaker opens.
+   */
+  void updateOpen() {
+    const bool open = !BasicResourceLimitImpl::canCreate();
+    if (open_gauge_ != nullptr) {
+      open_gauge_->set(open ? 1 : 0);
+    } else if (open || open_stats_->isPresent()) {
+      open_stats_gauge_(**open_stats_).set(open ? 1 : 0);
+    }
   }
 
   /**
@@ -52,9 +75,12 @@ struct ManagedResourceImpl : public BasicResourceLimitImpl {
 
   /**
    * A gauge to notify the live circuit breaker state. The gauge is set to 0
-   * to notify that the circuit breaker is not yet triggered.
+   * to notify that the circuit breaker is not yet triggered. It is either given
+   * directly, or looked up in a block of "open" gauges which may be deferred.
    */
-  Stats::Gauge& open_gauge_;
+  Stats::Gauge* const open_gauge_{};
+  DeferredCreationCompatibleClusterCircuitBreakersOpenStats* const open_stats_{};
+  const OpenGaugeFn open_stats_gauge_{};
 
   /**
    * The number of resources remaining before the circuit breaker opens.
@@ -79,19 +105,36 @@ public:
                       uint64_t max_connections_per_host, ClusterCircuitBreakersStats cb_stats,
                       absl::optional<double> budget_percent,
                       absl::optional<uint32_t> min_retry_concurrency)
-      : connections_(max_connections, runtime, runtime_key + "max_connections", cb_stats.cx_open_,
+      : open_stats_(std::move(cb_stats.open_stats_)),
+        connections_(max_connections, runtime, runtime_key + "max_connections", open_stats_,
+                     [](ClusterCircuitBreakersOpenStats& stats) -> Stats::Gauge& {
+                       return stats.cx_open_;
+                     },
                      cb_stats.remaining_cx_),
         pending_requests_(max_pending_requests, runtime, runtime_key + "max_pending_requests",
-                          cb_stats.rq_pending_open_, cb_stats.remaining_pending_),
-        requests_(max_requests, runtime, runtime_key + "max_requests", cb_stats.rq_open_,
+                          open_stats_,
+                          [](ClusterCircuitBreakersOpenStats& stats) -> Stats::Gauge& {
+                            return stats.rq_pending_open_;
+                          },
+                          cb_stats.remaining_pending_),
+        requests_(max_requests, runtime, runtime_key + "max_requests", open_stats_,
+                  [](ClusterCircuitBreakersOpenStats& stats) -> Stats::Gauge& {
+                    return stats.rq_open_;
+                  },
                   cb_stats.remaining_rq_),
         connection_pools_(max_connection_pools, runtime, runtime_key + "max_connection_pools",
-                          cb_stats.cx_pool_open_, cb_stats.remaining_cx_pools_),
+                          open_stats_,
+                          [](ClusterCircuitBreakersOpenStats& stats) -> Stats::Gauge& {
+                            return stats.cx_pool_open_;
+                          },
+                          cb_stats.remaining_cx_pools_),
         max_connections_per_host_(max_connections_per_host),
         retries_(budget_percent, min_retry_concurrency, max_retries, runtime,
-                 runtime_key + "retry_budget.", runtime_key + "max_retries",
-                 cb_stats.rq_retry_open_, cb_stats.remaining_retries_, requests_,
-                 pending_requests_) {}
+                 runtime_key + "retry_budget.", runtime_key + "max_retries", open_stats_,
+                 [](ClusterCircuitBreakersOpenStats& stats) -> Stats::Gauge& {
+                   return stats.rq_retry_open_;
+                 },
+                 cb_stats.remaining_retries_, requests_, pending_requests_) {}
 
   // Upstream::ResourceManager
   ResourceLimit& connections() override { return connections_; }
@@ -101,17 +144,25 @@ public:
   ResourceLimit& connectionPools() override { return connection_pools_; }
   uint64_t maxConnectionsPerHost() override { return max_connections_per_host_; }
 
+  /**
+   * @return the circuit breaker "open" gauges, which may not have been created yet.
+   */
+  const DeferredCreationCompatibleClusterCircuitBreakersOpenStats& openStats() const {
+    return open_stats_;
+  }
+
 private:
   class RetryBudgetImpl : public ResourceLimit {
   public:
     RetryBudgetImpl(absl::optional<double> budget_percent,
                     absl::optional<uint32_t> min_retry_concurrency, uint64_t max_retries,
                     Runtime::Loader& runtime, const std::string& retry_budget_runtime_key,
-                    const std::string& max_retries_runtime_key, Stats::Gauge& open_gauge,
-                    Stats::Gauge& remaining, const ResourceLimit& requests,
-                    const ResourceLimit& pending_requests)
-        : runtime_(runtime),
-          max_retry_resource_(max_retries, runtime, max_retries_runtime_key, open_gauge, remaining),
+                    const std::string& max_retries_runtime_key,
+                    DeferredCreationCompatibleClusterCircuitBreakersOpenStats& open_stats,
+                    ManagedResourceImpl::OpenGaugeFn open_gauge, Stats::Gauge& remaining,
+                    const ResourceLimit& requests, const ResourceLimit& pending_requests)
+        : runtime_(runtime), max_retry_resource_(max_retries, runtime, max_retries_runtime_key,
+                                                 open_stats, open_gauge, remaining),
           budget_percent_(budget_percent), min_retry_concurrency_(min_retry_concurrency),
           budget_percent_key_(retry_budget_runtime_key + "budget_percent"),
           min_retry_concurrency_key_(retry_budget_runtime_key + "min_retry_concurrency"),
@@ -186,6 +237,7 @@ private:
     Stats::Gauge& remaining_;
   };
 
+  DeferredCreationCompatibleClusterCircuitBreakersOpenStats open_stats_;
   ManagedResourceImpl connections_;
   ManagedResourceImpl pending_requests_;
   ManagedResourceImpl requests_;
@@ -1210,29 +1210,38 @@ ClusterInfoImpl::ClusterInfoImpl(
       traffic_stats_(generateStats(
           stats_scope_, factory_context.serverFactoryContext().clusterManager().clusterStatNames(),
           server_context.statsConfig().enableDeferredCreationStats())),
-      config_update_stats_(
+      config_update_stats_(Stats::createDeferredCompatibleStats<ClusterConfigUpdateStats>(
+          stats_scope_,
           factory_context.serverFactoryContext().clusterManager().clusterConfigUpdateStatNames(),
-          *stats_scope_),
-      lb_stats_(factory_context.serverFactoryContext().clusterManager().clusterLbStatNames(),
-                *stats_scope_),
-      endpoint_stats_(
+          server_context.statsConfig().enableDeferredCreationStats())),
+      warming_state_(stats_scope_->gaugeFromStatName(factory_context.serverFactoryContext()
+                                                         .clusterManager()
+                                                         .clusterConfigUpdateStatNames()
+                                                         .warming_state_,
+                                                     Stats::Gauge::ImportMode::NeverImport)),
+      lb_stats_(Stats::createDeferredCompatibleStats<ClusterLbStats>(
+          stats_scope_,
+          factory_context.serverFactoryContext().clusterManager().clusterLbStatNames(),
+          server_context.statsConfig().enableDeferredCreationStats())),
+      endpoint_stats_(Stats::createDeferredCompatibleStats<ClusterEndpointStats>(
+          stats_scope_,
           factory_context.serverFactoryContext().clusterManager().clusterEndpointStatNames(),
-          *stats_scope_),
-      load_report_stats_store_(stats_scope_->symbolTable()),
-      load_report_stats_(generateLoadReportStats(
-          *load_report_stats_store_.rootScope(),
-          factory_context.serverFactoryContext().clusterManager().clusterLoadReportStatNames())),
+          server_context.statsConfig().enableDeferredCreationStats())),
+      load_report_stat_names_(
+          factory_context.serverFactoryContext().clusterManager().clusterLoadReportStatNames()),
       optional_cluster_stats_(
           (config.has_track_cluster_stats() || config.track_timeout_budgets())
               ? std::make_unique<OptionalClusterStats>(
-                    config, *stats_scope_, factory_context.serverFactoryContext().clusterManager())
+                    config, stats_scope_, factory_context.serverFactoryContext().clusterManager(),
+                    server_context.statsConfig().enableDeferredCreationStats())
               : nullptr),
       features_(ClusterInfoImpl::HttpProtocolOptionsConfigImpl::parseFeatures(
           config, *http_protocol_options_)),
-      resource_managers_(config, runtime, name_, *stats_scope_,
+      resource_managers_(config, runtime, name_, stats_scope_,
                          factory_context.serverFactoryContext()
                              .clusterManager()
-                             .clusterCircuitBreakersStatNames()),
+                             .clusterCircuitBreakersStatNames(),
+                         server_context.statsConfig().enableDeferredCreationStats()),
       maintenance_mode_runtime_key_(absl::StrCat("upstream.maintenance_mode.", name_)),
       upstream_local_address_selector_(
           THROW_OR_RETURN_VALUE(createUpstreamLocalAddressSelector(config, bind_config),
@@ -1691,10 +1700,6 @@ ClusterImplBase::ClusterImplBase(const envoy::config::cluster::v3::Cluster& clus
   priority_set_.getOrCreateHostSet(0);
   priority_update_cb_ = priority_set_.addPriorityUpdateCb(
       [this](uint32_t, const HostVector& hosts_added, const HostVector& hosts_removed) {
-        if (!hosts_added.empty() || !hosts_removed.empty()) {
-          info_->endpointStats().membership_change_.inc();
-        }
-
         uint32_t healthy_hosts = 0;
         uint32_t degraded_hosts = 0;
         uint32_t excluded_hosts = 0;
@@ -1705,10 +1710,19 @@ ClusterImplBase::ClusterImplBase(const envoy::config::cluster::v3::Cluster& clus
           degraded_hosts += host_set->degradedHosts().size();
           excluded_hosts += host_set->excludedHosts().size();
         }
-        info_->endpointStats().membership_total_.set(hosts);
-        info_->endpointStats().membership_healthy_.set(healthy_hosts);
-        info_->endpointStats().membership_degraded_.set(degraded_hosts);
-        info_->endpointStats().membership_excluded_.set(excluded_hosts);
+        // Deferred endpoint stats of a cluster that never had hosts would all be zero, which is
+        // what admin reports for them, so they are not created until there are hosts.
+        if (hosts == 0 && !info_->endpointStats().isPresent()) {
+          return absl::OkStatus();
+        }
+
+        if (!hosts_added.empty() || !hosts_removed.empty()) {
+          info_->endpointStats()->membership_change_.inc();
+        }
+        info_->endpointStats()->membership_total_.set(hosts);
+        info_->endpointStats()->membership_healthy_.set(healthy_hosts);
+        info_->endpointStats()->membership_degraded_.set(degraded_hosts);
+        info_->endpointStats()->membership_excluded_.set(excluded_hosts);
         return absl::OkStatus();
       });
   // Drop overload configuration parsing.
@@ -1788,7 +1802,7 @@ void ClusterImplBase::onPreInitComplete() {
 }
 
 void ClusterImplBase::onInitDone() {
-  info()->configUpdateStats().warming_state_.set(0);
+  info()->warmingState().set(0);
   if (health_checker_ && pending_initialize_health_checks_ == 0) {
     for (auto& host_set : prioritySet().hostSetsPerPriority()) {
       for (auto& host : host_set->hosts()) {
@@ -1977,51 +1991,75 @@ absl::Status ClusterImplBase::validateEndpointsForZoneAwareRouting(
 }
 
 ClusterInfoImpl::OptionalClusterStats::OptionalClusterStats(
-    const envoy::config::cluster::v3::Cluster& config, Stats::Scope& stats_scope,
-    const ClusterManager& manager)
-    : timeout_budget_stats_(
-          (config.track_cluster_stats().timeout_budgets() || config.track_timeout_budgets())
-              ? std::make_unique<ClusterTimeoutBudgetStats>(generateTimeoutBudgetStats(
-                    stats_scope, manager.clusterTimeoutBudgetStatNames()))
-              : nullptr),
-      request_response_size_stats_(
-          (config.track_cluster_stats().request_response_sizes()
-               ? std::make_unique<ClusterRequestResponseSizeStats>(generateRequestResponseSizeStats(
-                     stats_scope, manager.clusterRequestResponseSizeStatNames()))
-               : nullptr)) {}
+    const envoy::config::cluster::v3::Cluster& config, const Stats::ScopeSharedPtr& stats_scope,
+    const ClusterManager& manager, bool defer_creation) {
+  if (config.track_cluster_stats().timeout_budgets() || config.track_timeout_budgets()) {
+    timeout_budget_stats_.emplace(Stats::createDeferredCompatibleStats<ClusterTimeoutBudgetStats>(
+        stats_scope, manager.clusterTimeoutBudgetStatNames(), defer_creation));
+  }
+  if (config.track_cluster_stats().request_response_sizes()) {
+    request_response_size_stats_.emplace(
+        Stats::createDeferredCompatibleStats<ClusterRequestResponseSizeStats>(
+            stats_scope, manager.clusterRequestResponseSizeStatNames(), defer_creation));
+  }
+}
+
+ClusterInfoImpl::LoadReportStats::LoadReportStats(Stats::SymbolTable& symbol_table,
+                                                  const ClusterLoadReportStatNames& stat_names)
+    : store_(symbol_table), stats_(generateLoadReportStats(*store_.rootScope(), stat_names)) {}
+
+ClusterLoadReportStats& ClusterInfoImpl::loadReportStats() const {
+  return load_report_stats_
+      .get([this]() {
+        return new LoadReportStats(stats_scope_->symbolTable(), load_report_stat_names_);
+      })
+      ->stats_;
+}
+
+void ClusterInfoImpl::forEachUncreatedStat(const Stats::DeferredStatNameFn& counter_fn,
+                                           const Stats::DeferredStatNameFn& gauge_fn) const {
+  traffic_stats_.forEachUncreatedStatName(counter_fn, gauge_fn);
+  config_update_stats_.forEachUncreatedStatName(counter_fn, gauge_fn);
+  lb_stats_.forEachUncreatedStatName(counter_fn, gauge_fn);
+  endpoint_stats_.forEachUncreatedStatName(counter_fn, gauge_fn);
+  for (const ResourceManagerImplPtr& manager : resource_managers_.managers_) {
+    manager->openStats().forEachUncreatedStatName(counter_fn, gauge_fn);
+  }
+}
 
 ClusterInfoImpl::ResourceManagers::ResourceManagers(
     const envoy::config::cluster::v3::Cluster& config, Runtime::Loader& runtime,
-    const std::string& cluster_name, Stats::Scope& stats_scope,
-    const ClusterCircuitBreakersStatNames& circuit_breakers_stat_names)
-    : circuit_breakers_stat_names_(circuit_breakers_stat_names) {
+    const std::string& cluster_name, Stats::ScopeSharedPtr stats_scope,
+    const ClusterCircuitBreakersStatNames& circuit_breakers_stat_names, bool defer_creation)
+    : circuit_breakers_stat_names_(circuit_breakers_stat_names),
+      prefix_pool_(stats_scope->symbolTable()) {
   managers_[enumToInt(ResourcePriority::Default)] = THROW_OR_RETURN_VALUE(
-      load(config, runtime, cluster_name, stats_scope, envoy::config::core::v3::DEFAULT),
+      load(config, runtime, cluster_name, stats_scope, envoy::config::core::v3::DEFAULT,
+           defer_creation),
       ResourceManagerImplPtr);
   managers_[enumToInt(ResourcePriority::High)] = THROW_OR_RETURN_VALUE(
-      load(config, runtime, cluster_name, stats_scope, envoy::config::core::v3::HIGH),
+      load(config, runtime, cluster_name, stats_scope, envoy::config::core::v3::HIGH,
+           defer_creation),
       ResourceManagerImplPtr);
 }
 
-ClusterCircuitBreakersStats
-ClusterInfoImpl::generateCircuitBreakersStats(Stats::Scope& scope, Stats::StatName prefix,
-                                              bool track_remaining,
-                                              const ClusterCircuitBreakersStatNames& stat_names) {
-  auto make_gauge = [&stat_names, &scope, prefix](Stats::StatName stat_name) -> Stats::Gauge& {
-    return Stats::Utility::gaugeFromElements(scope,
-                                             {stat_names.circuit_breakers_, prefix, stat_name},
+ClusterCircuitBreakersStats ClusterInfoImpl::generateCircuitBreakersStats(
+    Stats::ScopeSharedPtr scope, Stats::StatName prefix, bool track_remaining,
+    const ClusterCircuitBreakersStatNames& stat_names, bool defer_creation) {
+  auto make_gauge = [&scope, prefix](Stats::StatName stat_name) -> Stats::Gauge& {
+    return Stats::Utility::gaugeFromElements(*scope, {prefix, stat_name},
                                              Stats::Gauge::ImportMode::Accumulate);
   };
 
 #define REMAINING_GAUGE(stat_name)                                                                 \
-  track_remaining ? make_gauge(stat_name) : scope.store().nullGauge()
+  track_remaining ? make_gauge(stat_name) : scope->store().nullGauge()
 
+  // The "open" gauges only become non-zero when a circuit breaker opens, so they can be deferred
+  // until then. The "remaining" gauges are set on every allocation, so when they are tracked the
+  // "open" gauges are created eagerly alongside them.
   return {
-      make_gauge(stat_names.cx_open_),
-      make_gauge(stat_names.cx_pool_open_),
-      make_gauge(stat_names.rq_open_),
-      make_gauge(stat_names.rq_pending_open_),
-      make_gauge(stat_names.rq_retry_open_),
+      Stats::createDeferredCompatibleStats<ClusterCircuitBreakersOpenStats>(
+          scope, stat_names, defer_creation && !track_remaining, prefix),
       REMAINING_GAUGE(stat_names.remaining_cx_),
       REMAINING_GAUGE(stat_names.remaining_cx_pools_),
       REMAINING_GAUGE(stat_names.remaining_pending_),
@@ -2103,8 +2141,9 @@ ClusterInfoImpl::createSingletonUpstreamNetworkFilterConfigProviderManager(
 absl::StatusOr<ResourceManagerImplPtr>
 ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluster& config,
                                         Runtime::Loader& runtime, const std::string& cluster_name,
-                                        Stats::Scope& stats_scope,
-                                        const envoy::config::core::v3::RoutingPriority& priority) {
+                                        Stats::ScopeSharedPtr stats_scope,
+                                        const envoy::config::core::v3::RoutingPriority& priority,
+                                        bool defer_creation) {
   uint64_t max_connections = 1024;
   uint64_t max_pending_requests = 1024;
   uint64_t max_requests = 1024;
@@ -2130,6 +2169,9 @@ ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluste
 
   const std::string runtime_prefix =
       fmt::format("circuit_breakers.{}.{}.", cluster_name, priority_name);
+  Stats::SymbolTable::StoragePtr prefix_storage = stats_scope->symbolTable().join(
+      {circuit_breakers_stat_names_.circuit_breakers_, priority_stat_name});
+  const Stats::StatName prefix(prefix_storage.get());
 
   const auto& thresholds = config.circuit_breakers().thresholds();
   const auto it = std::find_if(
@@ -2170,8 +2212,9 @@ ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluste
   return std::make_unique<ResourceManagerImpl>(
       runtime, runtime_prefix, max_connections, max_pending_requests, max_requests, max_retries,
       max_connection_pools, max_connections_per_host,
-      ClusterInfoImpl::generateCircuitBreakersStats(stats_scope, priority_stat_name,
-                                                    track_remaining, circuit_breakers_stat_names_),
+      ClusterInfoImpl::generateCircuitBreakersStats(
+          stats_scope, prefix_pool_.add(prefix), track_remaining, circuit_breakers_stat_names_,
+          defer_creation),
       budget_percent, min_retry_concurrency);
 }
 
@@ -2553,8 +2596,10 @@ bool BaseDynamicClusterImpl::updateDynamicHostList(
   }
 
   // At this point we've accounted for all the new hosts as well the hosts that previously
-  // existed in this priority.
-  info_->endpointStats().max_host_weight_.set(max_host_weight);
+  // existed in this priority. Deferred endpoint stats stay uncreated while there are no hosts.
+  if (!new_hosts.empty() || info_->endpointStats().isPresent()) {
+    info_->endpointStats()->max_host_weight_.set(max_host_weight);
+  }
 
   // Whatever remains in current_priority_hosts should be removed.
   if (!hosts_added_to_current_priority.empty() || !current_priority_hosts.empty()) {
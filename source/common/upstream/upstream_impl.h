@@ -842,9 +842,12 @@ public:
                 bool defer_creation);
   static ClusterLoadReportStats
   generateLoadReportStats(Stats::Scope& scope, const ClusterLoadReportStatNames& stat_names);
+  // The prefix, e.g. "circuit_breakers.default", must outlive the returned stats.
   static ClusterCircuitBreakersStats
-  generateCircuitBreakersStats(Stats::Scope& scope, Stats::StatName prefix, bool track_remaining,
-                               const ClusterCircuitBreakersStatNames& stat_names);
+  generateCircuitBreakersStats(Stats::ScopeSharedPtr scope, Stats::StatName prefix,
+                               bool track_remaining,
+                               const ClusterCircuitBreakersStatNames& stat_names,
+                               bool defer_creation);
   static ClusterRequestResponseSizeStats
   generateRequestResponseSizeStats(Stats::Scope&,
                                    const ClusterRequestResponseSizeStatNames& stat_names);
@@ -948,29 +951,36 @@ public:
   DeferredCreationCompatibleClusterTrafficStats& trafficStats() const override {
     return traffic_stats_;
   }
-  ClusterConfigUpdateStats& configUpdateStats() const override { return config_update_stats_; }
-  ClusterLbStats& lbStats() const override { return lb_stats_; }
-  ClusterEndpointStats& endpointStats() const override { return endpoint_stats_; }
+  DeferredCreationCompatibleClusterConfigUpdateStats& configUpdateStats() const override {
+    return config_update_stats_;
+  }
+  Stats::Gauge& warmingState() const override { return warming_state_; }
+  DeferredCreationCompatibleClusterLbStats& lbStats() const override { return lb_stats_; }
+  DeferredCreationCompatibleClusterEndpointStats& endpointStats() const override {
+    return endpoint_stats_;
+  }
+  void forEachUncreatedStat(const Stats::DeferredStatNameFn& counter_fn,
+                            const Stats::DeferredStatNameFn& gauge_fn) const override;
   Stats::Scope& statsScope() const override { return *stats_scope_; }
 
   ClusterRequestResponseSizeStatsOptRef requestResponseSizeStats() const override {
     if (optional_cluster_stats_ == nullptr ||
-        optional_cluster_stats_->request_response_size_stats_ == nullptr) {
+        !optional_cluster_stats_->request_response_size_stats_.has_value()) {
       return absl::nullopt;
     }
 
-    return std::ref(*(optional_cluster_stats_->request_response_size_stats_));
+    return std::ref(**optional_cluster_stats_->request_response_size_stats_);
   }
 
-  ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
+  ClusterLoadReportStats& loadReportStats() const override;
 
   ClusterTimeoutBudgetStatsOptRef timeoutBudgetStats() const override {
     if (optional_cluster_stats_ == nullptr ||
-        optional_cluster_stats_->timeout_budget_stats_ == nullptr) {
+        !optional_cluster_stats_->timeout_budget_stats_.has_value()) {
       return absl::nullopt;
     }
 
-    return std::ref(*(optional_cluster_stats_->timeout_budget_stats_));
+    return std::ref(**optional_cluster_stats_->timeout_budget_stats_);
   }
 
   bool perEndpointStatsEnabled() const override { return per_endpoint_stats_; }
@@ -1077,24 +1087,40 @@ private:
 
   struct ResourceManagers {
     ResourceManagers(const envoy::config::cluster::v3::Cluster& config, Runtime::Loader& runtime,
-                     const std::string& cluster_name, Stats::Scope& stats_scope,
-                     const ClusterCircuitBreakersStatNames& circuit_breakers_stat_names);
+                     const std::string& cluster_name, Stats::ScopeSharedPtr stats_scope,
+                     const ClusterCircuitBreakersStatNames& circuit_breakers_stat_names,
+                     bool defer_creation);
     absl::StatusOr<ResourceManagerImplPtr>
     load(const envoy::config::cluster::v3::Cluster& config, Runtime::Loader& runtime,
-         const std::string& cluster_name, Stats::Scope& stats_scope,
-         const envoy::config::core::v3::RoutingPriority& priority);
+         const std::string& cluster_name, Stats::ScopeSharedPtr stats_scope,
+         const envoy::config::core::v3::RoutingPriority& priority, bool defer_creation);
 
     using Managers = std::array<ResourceManagerImplPtr, NumResourcePriorities>;
 
-    Managers managers_;
     const ClusterCircuitBreakersStatNames& circuit_breakers_stat_names_;
+    // Holds the "circuit_breakers.<priority>" prefixes, which must outlive the managers' stats.
+    Stats::StatNamePool prefix_pool_;
+    Managers managers_;
   };
 
+  // The histograms enabled by track_cluster_stats. With deferred creation they are only created
+  // when the cluster's first request records them.
   struct OptionalClusterStats {
     OptionalClusterStats(const envoy::config::cluster::v3::Cluster& config,
-                         Stats::Scope& stats_scope, const ClusterManager& manager);
-    const ClusterTimeoutBudgetStatsPtr timeout_budget_stats_;
-    const ClusterRequestResponseSizeStatsPtr request_response_size_stats_;
+                         const Stats::ScopeSharedPtr& stats_scope, const ClusterManager& manager,
+                         bool defer_creation);
+    mutable absl::optional<Stats::DeferredCreationCompatibleStats<ClusterTimeoutBudgetStats>>
+        timeout_budget_stats_;
+    mutable absl::optional<Stats::DeferredCreationCompatibleStats<ClusterRequestResponseSizeStats>>
+        request_response_size_stats_;
+  };
+
+  // The load report stats live in their own store, which is only read by the load stats reporter.
+  // They are created on first use, as most clusters never report load or drop requests.
+  struct LoadReportStats {
+    LoadReportStats(Stats::SymbolTable& symbol_table, const ClusterLoadReportStatNames& stat_names);
+    Stats::IsolatedStoreImpl store_;
+    ClusterLoadReportStats stats_;
   };
 
 #ifdef ENVOY_ENABLE_UHV
@@ -1117,11 +1143,13 @@ private:
   TransportSocketMatcherPtr socket_matcher_;
   Stats::ScopeSharedPtr stats_scope_;
   mutable DeferredCreationCompatibleClusterTrafficStats traffic_stats_;
-  mutable ClusterConfigUpdateStats config_update_stats_;
-  mutable ClusterLbStats lb_stats_;
-  mutable ClusterEndpointStats endpoint_stats_;
-  Stats::IsolatedStoreImpl load_report_stats_store_;
-  mutable ClusterLoadReportStats load_report_stats_;
+  mutable DeferredCreationCompatibleClusterConfigUpdateStats config_update_stats_;
+  Stats::Gauge& warming_state_;
+  mutable DeferredCreationCompatibleClusterLbStats lb_stats_;
+  mutable DeferredCreationCompatibleClusterEndpointStats endpoint_stats_;
+  const ClusterLoadReportStatNames& load_report_stat_names_;
+  mutable Thread::AtomicPtr<LoadReportStats, Thread::AtomicPtrAllocMode::DeleteOnDestruct>
+      load_report_stats_;
   const std::unique_ptr<OptionalClusterStats> optional_cluster_stats_;
   const uint64_t features_;
   mutable ResourceManagers resource_managers_;
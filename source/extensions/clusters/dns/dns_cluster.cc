@@ -353,7 +353,7 @@ void DnsClusterImpl::ResolveTarget::updateLogicalDnsHosts(
     // For logical DNS, we remove the unique logical host, and add the new one.
     parent_.updateAllHosts(new_hosts.hosts, previous_hosts, locality_lb_endpoints_.priority());
   } else {
-    parent_.info_->configUpdateStats().update_no_rebuild_.inc();
+    parent_.info_->configUpdateStats()->update_no_rebuild_.inc();
   }
 }
 
@@ -377,13 +377,13 @@ void DnsClusterImpl::ResolveTarget::updateStrictDnsHosts(const ParsedHosts& new_
 
     parent_.updateAllHosts(hosts_added, hosts_removed, locality_lb_endpoints_.priority());
   } else {
-    parent_.info_->configUpdateStats().update_no_rebuild_.inc();
+    parent_.info_->configUpdateStats()->update_no_rebuild_.inc();
   }
 }
 
 void DnsClusterImpl::ResolveTarget::startResolve() {
   ENVOY_LOG(trace, "starting async DNS resolution for {}", dns_address_);
-  parent_.info_->configUpdateStats().update_attempt_.inc();
+  parent_.info_->configUpdateStats()->update_attempt_.inc();
 
   active_query_ = parent_.dns_resolver_->resolve(
       dns_address_, parent_.dns_lookup_family_,
@@ -395,7 +395,7 @@ void DnsClusterImpl::ResolveTarget::startResolve() {
         std::chrono::milliseconds final_refresh_rate = parent_.dns_refresh_rate_ms_;
 
         if (isSuccessfulResponse(response, status)) {
-          parent_.info_->configUpdateStats().update_success_.inc();
+          parent_.info_->configUpdateStats()->update_success_.inc();
 
           absl::StatusOr<ParsedHosts> new_hosts_or_error;
 
@@ -408,7 +408,7 @@ void DnsClusterImpl::ResolveTarget::startResolve() {
           if (!new_hosts_or_error.ok()) {
             ENVOY_LOG(error, "Failed to process DNS response for {} with error: {}", dns_address_,
                       new_hosts_or_error.status().message());
-            parent_.info_->configUpdateStats().update_failure_.inc();
+            parent_.info_->configUpdateStats()->update_failure_.inc();
             return;
           }
 
@@ -443,7 +443,7 @@ void DnsClusterImpl::ResolveTarget::startResolve() {
           ENVOY_LOG(debug, "DNS refresh rate reset for {}, refresh rate {} ms", dns_address_,
                     final_refresh_rate.count());
         } else {
-          parent_.info_->configUpdateStats().update_failure_.inc();
+          parent_.info_->configUpdateStats()->update_failure_.inc();
 
           final_refresh_rate =
               std::chrono::milliseconds(parent_.failure_backoff_strategy_->nextBackOffMs());
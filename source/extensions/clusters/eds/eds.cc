@@ -153,7 +153,7 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
   }
 
   if (!cluster_rebuilt) {
-    parent_.info_->configUpdateStats().update_no_rebuild_.inc();
+    parent_.info_->configUpdateStats()->update_no_rebuild_.inc();
   }
 
   // If we didn't setup to initialize when our first round of health checking is complete, just
@@ -200,7 +200,7 @@ EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& re
                                const std::string&) {
   if (resources.empty()) {
     ENVOY_LOG(debug, "Missing ClusterLoadAssignment for {} in onConfigUpdate()", edsServiceName());
-    info_->configUpdateStats().update_empty_.inc();
+    info_->configUpdateStats()->update_empty_.inc();
     onPreInitComplete();
     return absl::OkStatus();
   }
@@ -241,7 +241,7 @@ EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& re
       PROTOBUF_GET_MS_OR_DEFAULT(cluster_load_assignment.policy(), endpoint_stale_after, 0);
   if (stale_after_ms > 0) {
     // Stat to track how often we receive valid assignment_timeout in response.
-    info_->configUpdateStats().assignment_timeout_received_.inc();
+    info_->configUpdateStats()->assignment_timeout_received_.inc();
     assignment_timeout_->enableTimer(std::chrono::milliseconds(stale_after_ms));
     if (eds_resources_cache_.has_value()) {
       eds_resources_cache_->setExpiryTimer(edsServiceName(),
@@ -354,7 +354,7 @@ void EdsClusterImpl::onAssignmentTimeout() {
     eds_resources_cache_->removeResource(edsServiceName());
   }
   // Stat to track how often we end up with stale assignments.
-  info_->configUpdateStats().assignment_stale_.inc();
+  info_->configUpdateStats()->assignment_stale_.inc();
 }
 
 void EdsClusterImpl::onCachedResourceRemoved(absl::string_view resource_name) {
@@ -469,7 +469,7 @@ void EdsClusterImpl::onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReas
           edsServiceName());
       envoy::config::endpoint::v3::ClusterLoadAssignment cached_load_assignment =
           dynamic_cast<const envoy::config::endpoint::v3::ClusterLoadAssignment&>(*cached_resource);
-      info_->configUpdateStats().assignment_use_cached_.inc();
+      info_->configUpdateStats()->assignment_use_cached_.inc();
       using_cached_resource_ = true;
       update(cached_load_assignment);
       return;
@@ -130,7 +130,7 @@ LogicalDnsCluster::~LogicalDnsCluster() {
 
 void LogicalDnsCluster::startResolve() {
   ENVOY_LOG(trace, "starting async DNS resolution for {}", dns_address_);
-  info_->configUpdateStats().update_attempt_.inc();
+  info_->configUpdateStats()->update_attempt_.inc();
 
   active_dns_query_ = dns_resolver_->resolve(
       dns_address_, dns_lookup_family_,
@@ -145,7 +145,7 @@ void LogicalDnsCluster::startResolve() {
         // cluster does not update. This ensures that a potentially previously resolved address does
         // not stabilize back to 0 hosts.
         if (status == Network::DnsResolver::ResolutionStatus::Completed && !response.empty()) {
-          info_->configUpdateStats().update_success_.inc();
+          info_->configUpdateStats()->update_success_.inc();
           const auto addrinfo = response.front().addrInfo();
           // TODO(mattklein123): Move port handling into the DNS interface.
           ASSERT(addrinfo.address_ != nullptr);
@@ -181,7 +181,7 @@ void LogicalDnsCluster::startResolve() {
             // checking, and creating real host connections.
             logical_host_->setNewAddresses(new_address, address_list, lbEndpoint());
           } else {
-            info_->configUpdateStats().update_no_rebuild_.inc();
+            info_->configUpdateStats()->update_no_rebuild_.inc();
           }
 
           // reset failure backoff strategy because there was a success.
@@ -203,7 +203,7 @@ void LogicalDnsCluster::startResolve() {
           ENVOY_LOG(debug, "DNS refresh rate reset for {}, refresh rate {} ms", dns_address_,
                     final_refresh_rate.count());
         } else {
-          info_->configUpdateStats().update_failure_.inc();
+          info_->configUpdateStats()->update_failure_.inc();
           final_refresh_rate =
               std::chrono::milliseconds(failure_backoff_strategy_->nextBackOffMs());
           ENVOY_LOG(debug, "DNS refresh rate reset for {}, (failure) refresh rate {} ms",
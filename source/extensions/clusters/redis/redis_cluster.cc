@@ -188,7 +188,7 @@ void RedisCluster::onClusterSlotUpdate(ClusterSlotsSharedPtr&& slots) {
     }));
     updateAllHosts(hosts_added, hosts_removed, localityLbEndpoint().priority());
   } else {
-    info_->configUpdateStats().update_no_rebuild_.inc();
+    info_->configUpdateStats()->update_no_rebuild_.inc();
   }
 
   // TODO(hyang): If there is an initialize callback, fire it now. Note that if the
@@ -236,9 +236,9 @@ void RedisCluster::DnsDiscoveryResolveTarget::startResolveDns() {
         ENVOY_LOG(trace, "async DNS resolution complete for {}", dns_address_);
         if (status == Network::DnsResolver::ResolutionStatus::Failure || response.empty()) {
           if (status == Network::DnsResolver::ResolutionStatus::Failure) {
-            parent_.info_->configUpdateStats().update_failure_.inc();
+            parent_.info_->configUpdateStats()->update_failure_.inc();
           } else {
-            parent_.info_->configUpdateStats().update_empty_.inc();
+            parent_.info_->configUpdateStats()->update_empty_.inc();
           }
 
           if (!resolve_timer_) {
@@ -330,7 +330,7 @@ void RedisCluster::RedisDiscoverySession::registerDiscoveryAddress(
 }
 
 void RedisCluster::RedisDiscoverySession::startResolveRedis() {
-  parent_.info_->configUpdateStats().update_attempt_.inc();
+  parent_.info_->configUpdateStats()->update_attempt_.inc();
   // If a resolution is currently in progress, skip it.
   if (current_request_) {
     ENVOY_LOG(debug, "redis cluster slot request is already in progress for '{}'",
@@ -370,9 +370,9 @@ void RedisCluster::RedisDiscoverySession::startResolveRedis() {
 void RedisCluster::RedisDiscoverySession::updateDnsStats(
     Network::DnsResolver::ResolutionStatus status, bool empty_response) {
   if (status == Network::DnsResolver::ResolutionStatus::Failure) {
-    parent_.info_->configUpdateStats().update_failure_.inc();
+    parent_.info_->configUpdateStats()->update_failure_.inc();
   } else if (empty_response) {
-    parent_.info_->configUpdateStats().update_empty_.inc();
+    parent_.info_->configUpdateStats()->update_empty_.inc();
   }
 }
 
@@ -628,7 +628,7 @@ bool RedisCluster::RedisDiscoverySession::validateCluster(
 void RedisCluster::RedisDiscoverySession::onUnexpectedResponse(
     const NetworkFilters::Common::Redis::RespValuePtr& value) {
   ENVOY_LOG(warn, "Unexpected response to cluster slot command: {}", value->toString());
-  this->parent_.info_->configUpdateStats().update_failure_.inc();
+  this->parent_.info_->configUpdateStats()->update_failure_.inc();
   resolve_timer_->enableTimer(parent_.cluster_refresh_rate_);
 }
 
@@ -639,7 +639,7 @@ void RedisCluster::RedisDiscoverySession::onFailure() {
     auto client_to_delete = client_map_.find(current_host_address_);
     client_to_delete->second->client_->close();
   }
-  parent_.info()->configUpdateStats().update_failure_.inc();
+  parent_.info()->configUpdateStats()->update_failure_.inc();
   resolve_timer_->enableTimer(parent_.cluster_refresh_rate_);
 }
 
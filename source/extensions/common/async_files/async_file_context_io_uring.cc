@@ -0,0 +1,184 @@
+#include "source/extensions/common/async_files/async_file_context_io_uring.h"
+
+#include <sys/uio.h>
+
+#include <climits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/common/async_files/async_file_manager_io_uring.h"
+#include "source/extensions/common/async_files/status_after_file_error.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+namespace {
+
+template <typename T> class IoUringFileAction : public IoUringFileRequest {
+public:
+  IoUringFileAction(Io::Request::RequestType type, Event::Dispatcher* dispatcher,
+                    AsyncFileHandle handle, int fd, absl::AnyInvocable<void(T)> on_complete)
+      : IoUringFileRequest(type, dispatcher), handle_(std::move(handle)), fd_(fd),
+        on_complete_(std::move(on_complete)) {}
+
+  void onComplete() final { std::move(on_complete_)(std::move(result_.value())); }
+
+protected:
+  // Keeps the context alive until the operation has completed.
+  const AsyncFileHandle handle_;
+  // A copy of the context's file descriptor, because close resets it while a previously submitted
+  // operation may still need to be prepared again.
+  const int fd_;
+  absl::optional<T> result_;
+
+private:
+  absl::AnyInvocable<void(T)> on_complete_;
+};
+
+class IoUringReadFile : public IoUringFileAction<absl::StatusOr<Buffer::InstancePtr>> {
+public:
+  IoUringReadFile(Event::Dispatcher* dispatcher, AsyncFileHandle handle, int fd, off_t offset,
+                  size_t length,
+                  absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete)
+      : IoUringFileAction(Io::Request::RequestType::Read, dispatcher, std::move(handle), fd,
+                          std::move(on_complete)),
+        offset_(offset), length_(length), reservation_(buffer_->reserveSingleSlice(length)) {
+    iov_.iov_base = reservation_.slice().mem_;
+    iov_.iov_len = length_;
+  }
+
+  Io::IoUringResult prepare(Io::IoUring& io_uring) override {
+    return io_uring.prepareReadv(fd_, &iov_, 1, offset_, this);
+  }
+
+  bool onResult(int32_t result) override {
+    if (result < 0) {
+      result_ = statusAfterFileError(-result);
+    } else if (static_cast<size_t>(result) != length_) {
+      // Copy a short read so that the result does not hold on to the whole reservation.
+      result_ = std::make_unique<Buffer::OwnedImpl>(reservation_.slice().mem_, result);
+    } else {
+      reservation_.commit(result);
+      result_ = std::move(buffer_);
+    }
+    return true;
+  }
+
+private:
+  const off_t offset_;
+  const size_t length_;
+  Buffer::InstancePtr buffer_ = std::make_unique<Buffer::OwnedImpl>();
+  Buffer::ReservationSingleSlice reservation_;
+  struct iovec iov_ {};
+};
+
+class IoUringWriteFile : public IoUringFileAction<absl::StatusOr<size_t>> {
+public:
+  IoUringWriteFile(Event::Dispatcher* dispatcher, AsyncFileHandle handle, int fd,
+                   Buffer::Instance& contents, off_t offset,
+                   absl::AnyInvocable<void(absl::StatusOr<size_t>)> on_complete)
+      : IoUringFileAction(Io::Request::RequestType::Write, dispatcher, std::move(handle), fd,
+                          std::move(on_complete)),
+        offset_(offset) {
+    contents_.move(contents);
+  }
+
+  Io::IoUringResult prepare(Io::IoUring& io_uring) override {
+    // Submit as many slices as one writev accepts; the rest is submitted once they are written.
+    const Buffer::RawSliceVector slices = contents_.getRawSlices(IOV_MAX);
+    iovecs_.resize(slices.size());
+    for (size_t i = 0; i < slices.size(); i++) {
+      iovecs_[i].iov_base = slices[i].mem_;
+      iovecs_[i].iov_len = slices[i].len_;
+    }
+    return io_uring.prepareWritev(fd_, iovecs_.data(), iovecs_.size(), offset_ + written_, this);
+  }
+
+  bool onResult(int32_t result) override {
+    if (result < 0) {
+      result_ = statusAfterFileError(-result);
+      return true;
+    }
+    written_ += result;
+    contents_.drain(result);
+    if (contents_.length() == 0 || result == 0) {
+      result_ = written_;
+      return true;
+    }
+    return false;
+  }
+
+private:
+  Buffer::OwnedImpl contents_;
+  const off_t offset_;
+  size_t written_{};
+  std::vector<struct iovec> iovecs_;
+};
+
+class IoUringCloseFile : public IoUringFileAction<absl::Status> {
+public:
+  IoUringCloseFile(Event::Dispatcher* dispatcher, AsyncFileHandle handle, int fd,
+                   absl::AnyInvocable<void(absl::Status)> on_complete)
+      : IoUringFileAction(Io::Request::RequestType::Close, dispatcher, std::move(handle), fd,
+                          std::move(on_complete)) {}
+
+  Io::IoUringResult prepare(Io::IoUring& io_uring) override {
+    return io_uring.prepareClose(fd_, this);
+  }
+
+  bool onResult(int32_t result) override {
+    result_ = result < 0 ? statusAfterFileError(-result) : absl::OkStatus();
+    return true;
+  }
+};
+
+} // namespace
+
+AsyncFileContextIoUring::AsyncFileContextIoUring(AsyncFileManagerIoUring& manager, int fd)
+    : AsyncFileContextThreadPool(manager, fd) {}
+
+AsyncFileManagerIoUring& AsyncFileContextIoUring::ioUringManager() const {
+  return static_cast<AsyncFileManagerIoUring&>(manager());
+}
+
+absl::StatusOr<CancelFunction>
+AsyncFileContextIoUring::close(Event::Dispatcher* dispatcher,
+                               absl::AnyInvocable<void(absl::Status)> on_complete) {
+  if (fileDescriptor() == -1) {
+    return absl::FailedPreconditionError("file was already closed");
+  }
+  CancelFunction cancel = ioUringManager().submit(std::make_unique<IoUringCloseFile>(
+      dispatcher, handle(), fileDescriptor(), std::move(on_complete)));
+  fileDescriptor() = -1;
+  return cancel;
+}
+
+absl::StatusOr<CancelFunction> AsyncFileContextIoUring::read(
+    Event::Dispatcher* dispatcher, off_t offset, size_t length,
+    absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) {
+  if (fileDescriptor() == -1) {
+    return absl::FailedPreconditionError("file was already closed");
+  }
+  return ioUringManager().submit(std::make_unique<IoUringReadFile>(
+      dispatcher, handle(), fileDescriptor(), offset, length, std::move(on_complete)));
+}
+
+absl::StatusOr<CancelFunction>
+AsyncFileContextIoUring::write(Event::Dispatcher* dispatcher, Buffer::Instance& contents,
+                               off_t offset,
+                               absl::AnyInvocable<void(absl::StatusOr<size_t>)> on_complete) {
+  if (fileDescriptor() == -1) {
+    return absl::FailedPreconditionError("file was already closed");
+  }
+  return ioUringManager().submit(std::make_unique<IoUringWriteFile>(
+      dispatcher, handle(), fileDescriptor(), contents, offset, std::move(on_complete)));
+}
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
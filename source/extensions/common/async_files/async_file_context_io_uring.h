@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+
+#include "source/extensions/common/async_files/async_file_context_thread_pool.h"
+
+#include "absl/status/statusor.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+class AsyncFileManagerIoUring;
+
+// The io_uring implementation of an AsyncFileContext - reads, writes and closes are submitted
+// through the manager's io_uring, the other actions use the manager's thread pool.
+class AsyncFileContextIoUring final : public AsyncFileContextThreadPool {
+public:
+  AsyncFileContextIoUring(AsyncFileManagerIoUring& manager, int fd);
+
+  absl::StatusOr<CancelFunction> close(Event::Dispatcher* dispatcher,
+                                       absl::AnyInvocable<void(absl::Status)> on_complete) override;
+  absl::StatusOr<CancelFunction>
+  read(Event::Dispatcher* dispatcher, off_t offset, size_t length,
+       absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) override;
+  absl::StatusOr<CancelFunction>
+  write(Event::Dispatcher* dispatcher, Buffer::Instance& contents, off_t offset,
+        absl::AnyInvocable<void(absl::StatusOr<size_t>)> on_complete) override;
+
+private:
+  AsyncFileManagerIoUring& ioUringManager() const;
+};
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -204,7 +204,8 @@ public:
     if (newfd.return_value_ == -1) {
       return statusAfterFileError(newfd);
     }
-    return std::make_shared<AsyncFileContextThreadPool>(context()->manager(), newfd.return_value_);
+    return static_cast<AsyncFileManagerThreadPool&>(context()->manager())
+        .makeFileContext(newfd.return_value_);
   }
 
   void onCancelledBeforeCallback() override {
@@ -0,0 +1,169 @@
+#include "source/extensions/common/async_files/async_file_manager_io_uring.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/extensions/common/async_files/async_file_context_io_uring.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+namespace {
+
+envoy::extensions::common::async_files::v3::AsyncFileManagerConfig threadPoolConfig(
+    const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config) {
+  envoy::extensions::common::async_files::v3::AsyncFileManagerConfig thread_pool_config;
+  thread_pool_config.set_id(config.id());
+  *thread_pool_config.mutable_thread_pool() = config.io_uring().thread_pool();
+  return thread_pool_config;
+}
+
+uint32_t
+ioUringSize(const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config) {
+  const uint32_t size = config.io_uring().io_uring_size();
+  return size == 0 ? AsyncFileManagerIoUring::DefaultIoUringSize : size;
+}
+
+} // namespace
+
+AsyncFileManagerIoUring::AsyncFileManagerIoUring(
+    const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config,
+    Api::OsSysCalls& posix)
+    : AsyncFileManagerThreadPool(threadPoolConfig(config), posix),
+      io_uring_size_(ioUringSize(config)),
+      io_uring_(std::make_unique<Io::IoUringImpl>(io_uring_size_, false)),
+      event_fd_(io_uring_->registerEventfd()) {
+  ENVOY_LOG(info, "AsyncFileManagerIoUring created with id '{}', with io_uring size {}",
+            config.id(), io_uring_size_);
+  reaper_thread_ = std::thread([this]() { reaper(); });
+}
+
+AsyncFileManagerIoUring::~AsyncFileManagerIoUring() ABSL_LOCKS_EXCLUDED(ring_mutex_) {
+  {
+    absl::MutexLock lock(&ring_mutex_);
+    terminate_ = true;
+  }
+  // Wake the completion thread. It exits once every submitted operation has completed.
+  eventfd_write(event_fd_, 1);
+  reaper_thread_.join();
+  io_uring_->unregisterEventfd();
+  Api::OsSysCallsSingleton::get().close(event_fd_);
+}
+
+std::string AsyncFileManagerIoUring::describe() const {
+  return absl::StrCat("io_uring_size = ", io_uring_size_, ", ",
+                      AsyncFileManagerThreadPool::describe());
+}
+
+void AsyncFileManagerIoUring::waitForIdle() {
+  AsyncFileManagerThreadPool::waitForIdle();
+  const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(ring_mutex_) {
+    return in_flight_ == 0;
+  };
+  absl::MutexLock lock(&ring_mutex_);
+  ring_mutex_.Await(absl::Condition(&condition));
+}
+
+AsyncFileHandle AsyncFileManagerIoUring::makeFileContext(int fd) {
+  return std::make_shared<AsyncFileContextIoUring>(*this, fd);
+}
+
+CancelFunction AsyncFileManagerIoUring::submit(std::unique_ptr<IoUringFileRequest> request) {
+  CancelFunction cancel = [dispatcher = request->dispatcher(),
+                           cancelled = request->cancelled()]() {
+    ASSERT(dispatcher == nullptr || dispatcher->isThreadSafe());
+    *cancelled = true;
+  };
+  absl::MutexLock lock(&ring_mutex_);
+  ++in_flight_;
+  // The request is owned by the ring until the completion thread reaps it.
+  prepareLocked(*request.release());
+  io_uring_->submit();
+  return cancel;
+}
+
+void AsyncFileManagerIoUring::prepareLocked(IoUringFileRequest& request) {
+  if (request.prepare(*io_uring_) == Io::IoUringResult::Failed) {
+    // The submission queue is full, so hand its entries to the kernel to make room.
+    io_uring_->submit();
+    RELEASE_ASSERT(request.prepare(*io_uring_) == Io::IoUringResult::Ok,
+                   "unable to prepare io_uring file request");
+  }
+}
+
+void AsyncFileManagerIoUring::reaper() {
+  struct pollfd poll_fd {};
+  poll_fd.fd = event_fd_;
+  poll_fd.events = POLLIN;
+  while (true) {
+    {
+      absl::MutexLock lock(&ring_mutex_);
+      if (terminate_ && in_flight_ == 0) {
+        return;
+      }
+    }
+    // The ring signals the eventfd for every completion; the destructor signals it to terminate.
+    ::poll(&poll_fd, 1, -1);
+
+    std::vector<std::unique_ptr<IoUringFileRequest>> completed;
+    {
+      absl::MutexLock lock(&ring_mutex_);
+      bool resubmit = false;
+      uint32_t reaped;
+      do {
+        reaped = 0;
+        io_uring_->forEveryCompletion(
+            [this, &reaped, &resubmit, &completed](Io::Request* user_data, int32_t result, bool)
+                ABSL_EXCLUSIVE_LOCKS_REQUIRED(ring_mutex_) {
+                  ++reaped;
+                  auto* request = static_cast<IoUringFileRequest*>(user_data);
+                  if (request->onResult(result)) {
+                    completed.emplace_back(request);
+                    return;
+                  }
+                  prepareLocked(*request);
+                  resubmit = true;
+                });
+        // Each call handles at most one batch the size of the ring.
+      } while (reaped == io_uring_size_);
+      if (resubmit) {
+        io_uring_->submit();
+      }
+    }
+
+    const uint64_t completed_count = completed.size();
+    for (std::unique_ptr<IoUringFileRequest>& request : completed) {
+      Event::Dispatcher* dispatcher = request->dispatcher();
+      if (dispatcher == nullptr) {
+        // No need to bother arranging the callback, because a dispatcher was not provided.
+        continue;
+      }
+      dispatcher->post([request = std::move(request)]() {
+        // This callback runs on the caller's thread.
+        if (!*request->cancelled()) {
+          request->onComplete();
+        }
+      });
+    }
+    completed.clear();
+
+    absl::MutexLock lock(&ring_mutex_);
+    in_flight_ -= completed_count;
+  }
+}
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
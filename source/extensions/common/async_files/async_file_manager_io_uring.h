@@ -0,0 +1,89 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "envoy/common/io/io_uring.h"
+#include "envoy/extensions/common/async_files/v3/async_file_manager.pb.h"
+
+#include "source/extensions/common/async_files/async_file_handle.h"
+#include "source/extensions/common/async_files/async_file_manager_thread_pool.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+
+// A file operation submitted through io_uring.
+class IoUringFileRequest : public Io::Request {
+public:
+  IoUringFileRequest(Io::Request::RequestType type, Event::Dispatcher* dispatcher)
+      : Io::Request(type), dispatcher_(dispatcher) {}
+
+  // Puts the operation into the submission queue of the ring, with this request as user data.
+  virtual Io::IoUringResult prepare(Io::IoUring& io_uring) PURE;
+
+  // Captures the result of the operation. Called on the completion thread of the manager.
+  // Returns false if the operation is not finished and must be prepared again, e.g. to write the
+  // remainder of a short write.
+  virtual bool onResult(int32_t result) PURE;
+
+  // Calls the captured callback with the captured result, on the caller's thread.
+  virtual void onComplete() PURE;
+
+  Event::Dispatcher* dispatcher() const { return dispatcher_; }
+  const std::shared_ptr<bool>& cancelled() const { return cancelled_; }
+
+private:
+  Event::Dispatcher* const dispatcher_;
+  // Only accessed from the dispatcher's thread.
+  const std::shared_ptr<bool> cancelled_ = std::make_shared<bool>(false);
+};
+
+// An AsyncFileManager which submits reads, writes and closes through a single io_uring shared by
+// all callers, so that no thread is blocked on them. A completion thread reaps the ring and posts
+// each result to the dispatcher of the caller. The operations that io_uring is not used for are
+// performed in the thread pool inherited from AsyncFileManagerThreadPool.
+//
+// Submitted operations start right away; cancelling one only prevents its callback. Cancelling
+// has nothing to undo, as none of the operations submitted through the ring create resources.
+class AsyncFileManagerIoUring : public AsyncFileManagerThreadPool {
+public:
+  AsyncFileManagerIoUring(
+      const envoy::extensions::common::async_files::v3::AsyncFileManagerConfig& config,
+      Api::OsSysCalls& posix);
+  ~AsyncFileManagerIoUring() ABSL_LOCKS_EXCLUDED(ring_mutex_) override;
+
+  std::string describe() const override;
+  void waitForIdle() ABSL_LOCKS_EXCLUDED(ring_mutex_) override;
+  AsyncFileHandle makeFileContext(int fd) override;
+
+  // Submits an operation to the ring. The manager owns the request until its callback has run.
+  CancelFunction submit(std::unique_ptr<IoUringFileRequest> request)
+      ABSL_LOCKS_EXCLUDED(ring_mutex_);
+
+  // The number of submission queue entries used when the config leaves it unset.
+  static constexpr uint32_t DefaultIoUringSize = 1024;
+
+private:
+  void prepareLocked(IoUringFileRequest& request) ABSL_EXCLUSIVE_LOCKS_REQUIRED(ring_mutex_);
+  void reaper() ABSL_LOCKS_EXCLUDED(ring_mutex_);
+
+  const uint32_t io_uring_size_;
+  absl::Mutex ring_mutex_;
+  const Io::IoUringPtr io_uring_ ABSL_PT_GUARDED_BY(ring_mutex_);
+  os_fd_t event_fd_;
+  // Requests submitted and not yet handed to their dispatcher.
+  uint64_t in_flight_ ABSL_GUARDED_BY(ring_mutex_) = 0;
+  bool terminate_ ABSL_GUARDED_BY(ring_mutex_) = false;
+  std::thread reaper_thread_;
+};
+
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -46,6 +46,10 @@ AsyncFileManagerThreadPool::~AsyncFileManagerThreadPool() ABSL_LOCKS_EXCLUDED(qu
   }
 }
 
+AsyncFileHandle AsyncFileManagerThreadPool::makeFileContext(int fd) {
+  return std::make_shared<AsyncFileContextThreadPool>(*this, fd);
+}
+
 std::string AsyncFileManagerThreadPool::describe() const {
   return absl::StrCat("thread_pool_size = ", thread_pool_.size());
 }
@@ -208,14 +212,14 @@ public:
       if (was_successful_first_call) {
         // This was the thread doing the very first open(O_TMPFILE), and it worked, so no need to do
         // anything else.
-        return std::make_shared<AsyncFileContextThreadPool>(manager_, open_result.return_value_);
+        return manager_.makeFileContext(open_result.return_value_);
       }
       // This was any other thread, but O_TMPFILE proved it worked, so we can do it again.
       open_result = posix().open(path_.c_str(), O_TMPFILE | O_RDWR, S_IRUSR | S_IWUSR);
       if (open_result.return_value_ == -1) {
         return statusAfterFileError(open_result);
       }
-      return std::make_shared<AsyncFileContextThreadPool>(manager_, open_result.return_value_);
+      return manager_.makeFileContext(open_result.return_value_);
     }
 #endif // O_TMPFILE
     // If O_TMPFILE didn't work, fall back to creating a named file and unlinking it.
@@ -245,7 +249,7 @@ public:
           "AsyncFileManagerThreadPool::createAnonymousFile: not supported for "
           "target filesystem (failed to unlink an open file)");
     }
-    return std::make_shared<AsyncFileContextThreadPool>(manager_, open_result.return_value_);
+    return manager_.makeFileContext(open_result.return_value_);
   }
 
 private:
@@ -264,7 +268,7 @@ public:
     if (open_result.return_value_ == -1) {
       return statusAfterFileError(open_result);
     }
-    return std::make_shared<AsyncFileContextThreadPool>(manager_, open_result.return_value_);
+    return manager_.makeFileContext(open_result.return_value_);
   }
 
 private:
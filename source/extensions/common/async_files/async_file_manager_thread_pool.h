@@ -45,6 +45,9 @@ public:
   void waitForIdle() override;
   Api::OsSysCalls& posix() const { return posix_; }
 
+  // Returns a context for a file descriptor opened by this manager.
+  virtual AsyncFileHandle makeFileContext(int fd);
+
 #ifdef O_TMPFILE
   // The first time we try to open an anonymous file, these values are used to capture whether
   // opening with O_TMPFILE works. If it does not, the first open is retried using 'mkstemp',
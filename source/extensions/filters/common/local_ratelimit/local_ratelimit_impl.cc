@@ -22,7 +22,7 @@ public:
   double getTokensShareFactor() const override { return share_factor_.load(); }
   double onLocalClusterUpdate(const Upstream::Cluster& cluster) override {
     ASSERT_IS_MAIN_OR_TEST_THREAD();
-    const auto num = cluster.info()->endpointStats().membership_total_.value();
+    const auto num = cluster.info()->endpointStats()->membership_total_.value();
     const double new_share_factor = num == 0 ? 1.0 : 1.0 / num;
     share_factor_.store(new_share_factor);
     return new_share_factor;
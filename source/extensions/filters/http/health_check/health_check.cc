@@ -149,7 +149,7 @@ void HealthCheckFilter::onComplete() {
           break;
         }
 
-        const auto& endpoint_stats = cluster->info()->endpointStats();
+        const auto& endpoint_stats = *cluster->info()->endpointStats();
         const uint64_t membership_total = endpoint_stats.membership_total_.value();
         if (membership_total == 0) {
           // If the cluster exists but is empty, consider the service unhealthy unless
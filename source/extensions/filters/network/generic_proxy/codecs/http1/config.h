@@ -242,7 +242,7 @@ public:
 
   void completeCurrentHeader() {
     current_header_value_.rtrim();
-    current_header_field_.inlineTransform([](char c) { return absl::ascii_tolower(c); });
+    current_header_field_.inlineToLower();
     headerMap().addViaMove(std::move(current_header_field_), std::move(current_header_value_));
 
     ASSERT(current_header_field_.empty());
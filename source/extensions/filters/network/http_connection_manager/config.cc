@@ -1,5 +1,6 @@
 #include "source/extensions/filters/network/http_connection_manager/config.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -391,6 +392,7 @@ HttpConnectionManagerConfig::HttpConnectionManagerConfig(
       max_connection_duration_(
           PROTOBUF_GET_OPTIONAL_MS(config.common_http_protocol_options(), max_connection_duration)),
       http1_safe_max_connection_duration_(config.http1_safe_max_connection_duration()),
+      per_stream_arena_bytes_(config.per_stream_arena_bytes()),
       max_stream_duration_(
           PROTOBUF_GET_OPTIONAL_MS(config.common_http_protocol_options(), max_stream_duration)),
       stream_idle_timeout_(
@@ -735,6 +737,11 @@ HttpConnectionManagerConfig::HttpConnectionManagerConfig(
   SET_AND_RETURN_IF_NOT_OK(
       helper.processFilters(config.http_filters(), "http", "http", filter_factories_),
       creation_status);
+  // Only the filter wrappers are created in the per-stream arena, so a larger initial block would
+  // be allocated for every stream and never used. Upgrade filter chains may still overflow it.
+  per_stream_arena_bytes_ =
+      std::min<uint64_t>(per_stream_arena_bytes_,
+                         filter_factories_.size() * Http::FilterManager::arenaBytesPerFilter());
 
   for (const auto& upgrade_config : config.upgrade_configs()) {
     const std::string& name = upgrade_config.upgrade_type();
@@ -1,5 +1,6 @@
 #include "source/extensions/filters/udp/udp_proxy/config.h"
 
+#include "source/common/config/utility.h"
 #include "source/common/filter/config_discovery_impl.h"
 #include "source/common/formatter/substitution_format_string.h"
 
@@ -108,7 +109,7 @@ UdpProxyFilterConfigImpl::UdpProxyFilterConfigImpl(
       session_timeout_(PROTOBUF_GET_MS_OR_DEFAULT(config, idle_timeout, 60 * 1000)),
       use_original_src_ip_(config.use_original_src_ip()),
       use_per_packet_load_balancing_(config.use_per_packet_load_balancing()),
-      stats_(generateStats(config.stat_prefix(), context.scope())),
+      stats_(generateStats(config.stat_prefix(), context.scope())), scope_(context.scope()),
       // Default prefer_gro to true for upstream client traffic.
       upstream_socket_config_(config.upstream_socket_config(), true),
       udp_session_filter_config_provider_manager_(
@@ -150,6 +151,13 @@ UdpProxyFilterConfigImpl::UdpProxyFilterConfigImpl(
     tunneling_config_ = std::make_unique<TunnelingConfigImpl>(config.tunneling_config(), context);
   }
 
+  if (config.has_upstream_packet_writer_config()) {
+    auto& factory = Config::Utility::getAndCheckFactory<Network::UdpPacketWriterFactoryFactory>(
+        config.upstream_packet_writer_config());
+    upstream_packet_writer_factory_ =
+        factory.createUdpPacketWriterFactory(config.upstream_packet_writer_config());
+  }
+
   if (config.has_access_log_options()) {
     flush_access_log_on_tunnel_connected_ =
         config.access_log_options().flush_access_log_on_tunnel_connected();
@@ -338,6 +338,14 @@ UdpProxyFilter::UdpActiveSession::UdpActiveSession(
     : ActiveSession(filter, std::move(addresses), std::move(host)),
       use_original_src_ip_(filter_.config_->usingOriginalSrcIp()) {}
 
+UdpProxyFilter::UdpActiveSession::~UdpActiveSession() {
+  // Datagrams still buffered by a batch writer must be sent before the socket is closed.
+  if (flush_upstream_writes_ != nullptr && flush_upstream_writes_->enabled()) {
+    flush_upstream_writes_->cancel();
+    packet_writer_->flush();
+  }
+}
+
 UdpProxyFilter::ActiveSession::~ActiveSession() {
   ENVOY_BUG(on_session_complete_called_, "onSessionComplete() not called");
 }
@@ -555,9 +563,28 @@ void UdpProxyFilter::UdpActiveSession::writeUpstream(Network::UdpRecvData& data)
             host_->address()->asStringView());
 
   const Network::Address::Ip* local_ip = use_original_src_ip_ ? addresses_.peer_->ip() : nullptr;
-  Api::IoCallUint64Result rc = Network::Utility::writeToSocket(
-      udp_socket_->ioHandle(), *data.buffer_, local_ip, *host_->address());
+  if (packet_writer_ == nullptr) {
+    Api::IoCallUint64Result rc = Network::Utility::writeToSocket(
+        udp_socket_->ioHandle(), *data.buffer_, local_ip, *host_->address());
+    onUpstreamWriteResult(rc, tx_buffer_length);
+    return;
+  }
 
+  // The upstream socket is not watched for writability, so a writer blocked by a previous write
+  // simply tries again. As for a direct write, a datagram which cannot be sent is dropped.
+  if (packet_writer_->isWriteBlocked()) {
+    packet_writer_->setWritable();
+  }
+  Api::IoCallUint64Result rc =
+      packet_writer_->writePacket(*data.buffer_, local_ip, *host_->address());
+  if (flush_upstream_writes_ != nullptr && !flush_upstream_writes_->enabled()) {
+    flush_upstream_writes_->scheduleCallbackCurrentIteration();
+  }
+  onUpstreamWriteResult(rc, tx_buffer_length);
+}
+
+void UdpProxyFilter::UdpActiveSession::onUpstreamWriteResult(const Api::IoCallUint64Result& rc,
+                                                             uint64_t tx_buffer_length) {
   if (!rc.ok()) {
     cluster_->cluster_stats_.sess_tx_errors_.inc();
   } else {
@@ -632,6 +659,12 @@ void UdpProxyFilter::UdpActiveSession::createUdpSocket(const Upstream::HostConst
   // NOTE: The socket call can only fail due to memory/fd exhaustion. No local ephemeral port
   //       is bound until the first packet is sent to the upstream host.
   udp_socket_ = filter_.createUdpSocket(host);
+  packet_writer_ = filter_.config_->createUpstreamPacketWriter(udp_socket_->ioHandle());
+  if (packet_writer_ != nullptr && packet_writer_->isBatchMode()) {
+    flush_upstream_writes_ =
+        filter_.read_callbacks_->udpListener().dispatcher().createSchedulableCallback(
+            [this]() { flushUpstreamWrites(); });
+  }
   udp_socket_->ioHandle().initializeFileEvent(
       filter_.read_callbacks_->udpListener().dispatcher(),
       [this](uint32_t) {
@@ -662,6 +695,14 @@ void UdpProxyFilter::UdpActiveSession::createUdpSocket(const Upstream::HostConst
   // handle.
 }
 
+void UdpProxyFilter::UdpActiveSession::flushUpstreamWrites() {
+  const Api::IoCallUint64Result rc = packet_writer_->flush();
+  if (!rc.ok()) {
+    ENVOY_LOG(debug, "cannot flush upstream writes: {}", rc.err_->getErrorDetails());
+    cluster_->cluster_stats_.sess_tx_errors_.inc();
+  }
+}
+
 void UdpProxyFilter::ActiveSession::onInjectReadDatagramToFilterChain(ActiveReadFilter* filter,
                                                                       Network::UdpRecvData& data) {
   ASSERT(filter != nullptr);
@@ -1,10 +1,13 @@
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
 
+#include <limits>
+
 #include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
 #include "envoy/registry/registry.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/http/header_map_impl.h"
+#include "source/common/protobuf/utility.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -31,6 +34,29 @@ absl::optional<Key> variedRequestKey(const LookupRequest& request,
   return varied_request_key;
 }
 
+// Serves a range of a cached body without copying it, keeping the body alive until the buffer it
+// was added to is drained.
+class SharedBodyFragment : public Buffer::BufferFragment {
+public:
+  SharedBodyFragment(std::shared_ptr<const std::string> body, uint64_t offset, uint64_t length)
+      : body_(std::move(body)), offset_(offset), length_(length) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return body_->data() + offset_; }
+  size_t size() const override { return length_; }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const std::string> body_;
+  const uint64_t offset_;
+  const uint64_t length_;
+};
+
+// Returns the limit each shard enforces for a cache wide limit, or no limit if it is unset.
+uint64_t shardLimit(uint64_t limit, size_t shard_count) {
+  return limit / shard_count + (limit % shard_count != 0 ? 1 : 0);
+}
+
 class SimpleLookupContext : public LookupContext {
 public:
   SimpleLookupContext(Event::Dispatcher& dispatcher, SimpleHttpCache& cache,
@@ -43,9 +69,9 @@ public:
     trailers_ = std::move(entry.trailers_);
     LookupResult result = entry.response_headers_
                               ? request_.makeLookupResult(std::move(entry.response_headers_),
-                                                          std::move(entry.metadata_), body_.size())
+                                                          std::move(entry.metadata_), bodyLength())
                               : LookupResult{};
-    bool end_stream = body_.empty() && trailers_ == nullptr;
+    bool end_stream = bodyLength() == 0 && trailers_ == nullptr;
     dispatcher_.post([result = std::move(result), cb = std::move(cb), end_stream,
                       cancelled = cancelled_]() mutable {
       if (!*cancelled) {
@@ -55,9 +81,12 @@ public:
   }
 
   void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
-    ASSERT(range.end() <= body_.length(), "Attempt to read past end of body.");
-    auto result = std::make_unique<Buffer::OwnedImpl>(&body_[range.begin()], range.length());
-    bool end_stream = trailers_ == nullptr && range.end() == body_.length();
+    ASSERT(range.end() <= bodyLength(), "Attempt to read past end of body.");
+    auto result = std::make_unique<Buffer::OwnedImpl>();
+    if (range.length() > 0) {
+      result->addBufferFragment(*new SharedBodyFragment(body_, range.begin(), range.length()));
+    }
+    bool end_stream = trailers_ == nullptr && range.end() == bodyLength();
     dispatcher_.post([result = std::move(result), cb = std::move(cb), end_stream,
                       cancelled = cancelled_]() mutable {
       if (!*cancelled) {
@@ -82,11 +111,13 @@ public:
   Event::Dispatcher& dispatcher() const { return dispatcher_; }
 
 private:
+  uint64_t bodyLength() const { return body_ == nullptr ? 0 : body_->size(); }
+
   Event::Dispatcher& dispatcher_;
   std::shared_ptr<bool> cancelled_ = std::make_shared<bool>(false);
   SimpleHttpCache& cache_;
   const LookupRequest request_;
-  std::string body_;
+  std::shared_ptr<const std::string> body_;
   Http::ResponseTrailerMapPtr trailers_;
 };
 
@@ -172,99 +203,185 @@ LookupContextPtr SimpleHttpCache::makeLookupContext(LookupRequest&& request,
   return std::make_unique<SimpleLookupContext>(callbacks.dispatcher(), *this, std::move(request));
 }
 
+SimpleHttpCache::SimpleHttpCache(const SimpleHttpCacheConfig& config)
+    : config_(config),
+      max_shard_bytes_(config.has_max_cache_size_bytes()
+                           ? shardLimit(config.max_cache_size_bytes().value(), ShardCount)
+                           : std::numeric_limits<uint64_t>::max()),
+      max_shard_entries_(config.has_max_cache_entry_count()
+                             ? shardLimit(config.max_cache_entry_count().value(), ShardCount)
+                             : std::numeric_limits<uint64_t>::max()) {}
+
+SimpleHttpCache::Shard& SimpleHttpCache::shardFor(const Key& key) {
+  // The maps within a shard hash the same key, so pick the shard from the high bits.
+  return shards_[(MessageUtil::hash(key) >> 32) % ShardCount];
+}
+
+uint64_t SimpleHttpCache::entrySize(const Http::ResponseHeaderMap& response_headers,
+                                    const std::string& body,
+                                    const Http::ResponseTrailerMap* trailers) {
+  return response_headers.byteSize() + body.size() + (trailers ? trailers->byteSize() : 0);
+}
+
+SimpleHttpCache::Entry SimpleHttpCache::copyEntry(const StoredEntry& entry) {
+  ASSERT(entry.response_headers_);
+  entry.referenced_.store(true, std::memory_order_relaxed);
+  Http::ResponseTrailerMapPtr trailers_map;
+  if (entry.trailers_) {
+    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*entry.trailers_);
+  }
+  return SimpleHttpCache::Entry{
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*entry.response_headers_),
+      entry.metadata_, entry.body_, std::move(trailers_map)};
+}
+
 void SimpleHttpCache::updateHeaders(const LookupContext& lookup_context,
                                     const Http::ResponseHeaderMap& response_headers,
                                     const ResponseMetadata& metadata,
                                     UpdateHeadersCallback on_complete) {
   const auto& simple_lookup_context = static_cast<const SimpleLookupContext&>(lookup_context);
-  const Key& key = simple_lookup_context.request().key();
-  absl::WriterMutexLock lock(&mutex_);
-  auto iter = map_.find(key);
   auto post_complete = [on_complete = std::move(on_complete),
                         &dispatcher = simple_lookup_context.dispatcher()](bool result) mutable {
     dispatcher.post([on_complete = std::move(on_complete), result]() mutable {
       std::move(on_complete)(result);
     });
   };
-  if (iter == map_.end() || !iter->second.response_headers_) {
-    std::move(post_complete)(false);
-    return;
-  }
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
-    absl::optional<Key> varied_key =
-        variedRequestKey(simple_lookup_context.request(), *iter->second.response_headers_);
-    if (!varied_key.has_value()) {
+  const Key& key = simple_lookup_context.request().key();
+  absl::optional<Key> varied_key;
+  {
+    Shard& shard = shardFor(key);
+    absl::WriterMutexLock lock(&shard.mutex_);
+    auto iter = shard.map_.find(key);
+    if (iter == shard.map_.end() || !iter->second.response_headers_) {
       std::move(post_complete)(false);
       return;
     }
-    iter = map_.find(varied_key.value());
-    if (iter == map_.end() || !iter->second.response_headers_) {
+    if (!VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
+      std::move(post_complete)(
+          updateLocked(shard, iter->first, iter->second, response_headers, metadata));
+      return;
+    }
+    varied_key =
+        variedRequestKey(simple_lookup_context.request(), *iter->second.response_headers_);
+    if (!varied_key.has_value()) {
       std::move(post_complete)(false);
       return;
     }
   }
-  Entry& entry = iter->second;
 
-  applyHeaderUpdate(response_headers, *entry.response_headers_);
-  entry.metadata_ = metadata;
-  std::move(post_complete)(true);
+  // The varied entry may live in another shard; only one shard is ever locked at a time.
+  Shard& shard = shardFor(varied_key.value());
+  absl::WriterMutexLock lock(&shard.mutex_);
+  auto iter = shard.map_.find(varied_key.value());
+  if (iter == shard.map_.end() || !iter->second.response_headers_) {
+    std::move(post_complete)(false);
+    return;
+  }
+  std::move(post_complete)(
+      updateLocked(shard, iter->first, iter->second, response_headers, metadata));
 }
 
 SimpleHttpCache::Entry SimpleHttpCache::lookup(const LookupRequest& request) {
-  absl::ReaderMutexLock lock(&mutex_);
-  auto iter = map_.find(request.key());
-  if (iter == map_.end()) {
-    return Entry{};
-  }
-  ASSERT(iter->second.response_headers_);
+  absl::optional<Key> varied_key;
+  {
+    Shard& shard = shardFor(request.key());
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    auto iter = shard.map_.find(request.key());
+    if (iter == shard.map_.end()) {
+      return Entry{};
+    }
+    ASSERT(iter->second.response_headers_);
 
-  if (VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
-    return varyLookup(request, iter->second.response_headers_);
-  } else {
-    Http::ResponseTrailerMapPtr trailers_map;
-    if (iter->second.trailers_) {
-      trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
+    if (!VaryHeaderUtils::hasVary(*iter->second.response_headers_)) {
+      return copyEntry(iter->second);
     }
-    return SimpleHttpCache::Entry{
-        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-        iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+    // Keep the vary marker entry as long as the responses it leads to are being used.
+    iter->second.referenced_.store(true, std::memory_order_relaxed);
+    varied_key = variedRequestKey(request, *iter->second.response_headers_);
+  }
+  if (!varied_key.has_value()) {
+    return Entry{};
   }
+  return varyLookup(varied_key.value());
 }
 
 bool SimpleHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
                              ResponseMetadata&& metadata, std::string&& body,
                              Http::ResponseTrailerMapPtr&& trailers) {
-  absl::WriterMutexLock lock(&mutex_);
-  map_[key] = SimpleHttpCache::Entry{std::move(response_headers), std::move(metadata),
-                                     std::move(body), std::move(trailers)};
-  return true;
+  Shard& shard = shardFor(key);
+  absl::WriterMutexLock lock(&shard.mutex_);
+  return storeLocked(shard, key, std::move(response_headers), std::move(metadata),
+                     std::make_shared<const std::string>(std::move(body)), std::move(trailers));
 }
 
-SimpleHttpCache::Entry
-SimpleHttpCache::varyLookup(const LookupRequest& request,
-                            const Http::ResponseHeaderMapPtr& response_headers) {
-  // This method should be called from lookup, which holds the mutex for reading.
-  mutex_.AssertReaderHeld();
-
-  absl::optional<Key> varied_key = variedRequestKey(request, *response_headers);
-  if (!varied_key.has_value()) {
+SimpleHttpCache::Entry SimpleHttpCache::varyLookup(const Key& varied_request_key) {
+  Shard& shard = shardFor(varied_request_key);
+  absl::ReaderMutexLock lock(&shard.mutex_);
+  auto iter = shard.map_.find(varied_request_key);
+  if (iter == shard.map_.end()) {
     return SimpleHttpCache::Entry{};
   }
-  Key& varied_request_key = varied_key.value();
+  return copyEntry(iter->second);
+}
 
-  auto iter = map_.find(varied_request_key);
-  if (iter == map_.end()) {
-    return SimpleHttpCache::Entry{};
+bool SimpleHttpCache::updateLocked(Shard& shard, const Key& key, StoredEntry& entry,
+                                   const Http::ResponseHeaderMap& response_headers,
+                                   const ResponseMetadata& metadata) {
+  applyHeaderUpdate(response_headers, *entry.response_headers_);
+  entry.metadata_ = metadata;
+  shard.bytes_ -= entry.size_;
+  entry.size_ = entrySize(*entry.response_headers_, *entry.body_, entry.trailers_.get());
+  shard.bytes_ += entry.size_;
+  return evictLocked(shard, &key);
+}
+
+bool SimpleHttpCache::storeLocked(Shard& shard, const Key& key,
+                                  Http::ResponseHeaderMapPtr&& response_headers,
+                                  ResponseMetadata&& metadata, BodySharedPtr&& body,
+                                  Http::ResponseTrailerMapPtr&& trailers) {
+  const uint64_t size = entrySize(*response_headers, *body, trailers.get());
+  if (size > max_shard_bytes_) {
+    return false;
   }
-  ASSERT(iter->second.response_headers_);
-  Http::ResponseTrailerMapPtr trailers_map;
-  if (iter->second.trailers_) {
-    trailers_map = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*iter->second.trailers_);
+
+  auto [iter, inserted] = shard.map_.try_emplace(key);
+  StoredEntry& entry = iter->second;
+  if (inserted) {
+    shard.clock_.push_back(&iter->first);
+  } else {
+    shard.bytes_ -= entry.size_;
   }
+  entry.response_headers_ = std::move(response_headers);
+  entry.metadata_ = std::move(metadata);
+  entry.body_ = std::move(body);
+  entry.trailers_ = std::move(trailers);
+  entry.size_ = size;
+  shard.bytes_ += size;
+  return evictLocked(shard, &iter->first);
+}
 
-  return SimpleHttpCache::Entry{
-      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*iter->second.response_headers_),
-      iter->second.metadata_, iter->second.body_, std::move(trailers_map)};
+bool SimpleHttpCache::evictLocked(Shard& shard, const Key* keep) {
+  // Every entry but the kept one is evicted within two passes of the hand. The kept entry goes
+  // last, once it alone exceeds the limits (a header update may have grown it).
+  bool kept = true;
+  while (shard.map_.size() > max_shard_entries_ || shard.bytes_ > max_shard_bytes_) {
+    ASSERT(!shard.clock_.empty());
+    const Key* key = shard.clock_.front();
+    shard.clock_.pop_front();
+    auto iter = shard.map_.find(*key);
+    ASSERT(iter != shard.map_.end());
+    const bool spare = key == keep
+                           ? shard.map_.size() > 1
+                           : iter->second.referenced_.exchange(false, std::memory_order_relaxed);
+    if (spare) {
+      shard.clock_.push_back(key);
+      continue;
+    }
+    kept = kept && key != keep;
+    shard.bytes_ -= iter->second.size_;
+    shard.map_.erase(iter);
+  }
+  return kept;
 }
 
 bool SimpleHttpCache::varyInsert(const Key& request_key,
@@ -273,8 +390,6 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
                                  const Http::RequestHeaderMap& request_headers,
                                  const VaryAllowList& vary_allow_list,
                                  Http::ResponseTrailerMapPtr&& trailers) {
-  absl::WriterMutexLock lock(&mutex_);
-
   absl::btree_set<absl::string_view> vary_header_values =
       VaryHeaderUtils::getVaryValues(*response_headers);
   ASSERT(!vary_header_values.empty());
@@ -288,28 +403,57 @@ bool SimpleHttpCache::varyInsert(const Key& request_key,
     return false;
   }
 
+  // The header map owns the strings vary_header_values points into, so build the marker entry
+  // before handing the map over.
+  Envoy::Http::ResponseHeaderMapPtr vary_only_map =
+      Envoy::Http::createHeaderMap<Envoy::Http::ResponseHeaderMapImpl>({});
+  vary_only_map->setCopy(Envoy::Http::CustomHeaders::get().Vary,
+                         absl::StrJoin(vary_header_values, ","));
+
   varied_request_key.add_custom_fields(vary_identifier.value());
-  map_[varied_request_key] = SimpleHttpCache::Entry{
-      std::move(response_headers), std::move(metadata), std::move(body), std::move(trailers)};
+  {
+    Shard& shard = shardFor(varied_request_key);
+    absl::WriterMutexLock lock(&shard.mutex_);
+    if (!storeLocked(shard, varied_request_key, std::move(response_headers), std::move(metadata),
+                     std::make_shared<const std::string>(std::move(body)),
+                     std::move(trailers))) {
+      return false;
+    }
+  }
 
   // Add a special entry to flag that this request generates varied responses.
-  auto iter = map_.find(request_key);
-  if (iter == map_.end()) {
-    Envoy::Http::ResponseHeaderMapPtr vary_only_map =
-        Envoy::Http::createHeaderMap<Envoy::Http::ResponseHeaderMapImpl>({});
-    vary_only_map->setCopy(Envoy::Http::CustomHeaders::get().Vary,
-                           absl::StrJoin(vary_header_values, ","));
+  Shard& shard = shardFor(request_key);
+  absl::WriterMutexLock lock(&shard.mutex_);
+  if (!shard.map_.contains(request_key)) {
     // TODO(cbdm): In a cache that evicts entries, we could maintain a list of the "varykey"s that
     // we have inserted as the body for this first lookup. This way, we would know which keys we
     // have inserted for that resource. For the first entry simply use vary_identifier as the
     // entry_list; for future entries append vary_identifier to existing list.
     std::string entry_list;
-    map_[request_key] =
-        SimpleHttpCache::Entry{std::move(vary_only_map), {}, std::move(entry_list), {}};
+    storeLocked(shard, request_key, std::move(vary_only_map), {},
+                std::make_shared<const std::string>(std::move(entry_list)), {});
   }
   return true;
 }
 
+uint64_t SimpleHttpCache::entryCount() {
+  uint64_t count = 0;
+  for (Shard& shard : shards_) {
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    count += shard.map_.size();
+  }
+  return count;
+}
+
+uint64_t SimpleHttpCache::byteSize() {
+  uint64_t bytes = 0;
+  for (Shard& shard : shards_) {
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    bytes += shard.bytes_;
+  }
+  return bytes;
+}
+
 InsertContextPtr SimpleHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
                                                     Http::StreamFilterCallbacks&) {
   ASSERT(lookup_context != nullptr);
@@ -327,6 +471,38 @@ CacheInfo SimpleHttpCache::cacheInfo() const {
   return cache_info;
 }
 
+namespace {
+
+/**
+ * A singleton that hands out the same cache for equal configs, so that all the filters configured
+ * alike share their storage.
+ */
+class CacheSingleton : public Singleton::Instance {
+public:
+  std::shared_ptr<SimpleHttpCache> get(const SimpleHttpCacheConfig& config) {
+    const uint64_t key = MessageUtil::hash(config);
+    absl::MutexLock lock(&mu_);
+    std::shared_ptr<SimpleHttpCache> cache;
+    auto it = caches_.find(key);
+    if (it != caches_.end()) {
+      cache = it->second.lock();
+    }
+    if (!cache) {
+      cache = std::make_shared<SimpleHttpCache>(config);
+      caches_[key] = cache;
+    }
+    return cache;
+  }
+
+private:
+  absl::Mutex mu_;
+  // We keep weak_ptr here so the caches, and their contents, are released once no filter config
+  // uses them anymore.
+  absl::flat_hash_map<uint64_t, std::weak_ptr<SimpleHttpCache>> caches_ ABSL_GUARDED_BY(mu_);
+};
+
+} // namespace
+
 SINGLETON_MANAGER_REGISTRATION(simple_http_cache_singleton);
 
 class SimpleHttpCacheFactory : public HttpCacheFactory {
@@ -340,15 +516,16 @@ public:
   }
   // From HttpCacheFactory
   std::shared_ptr<HttpCache>
-  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig&,
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
            Server::Configuration::FactoryContext& context) override {
-    return context.serverFactoryContext().singletonManager().getTyped<SimpleHttpCache>(
-        SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton), &createCache);
-  }
-
-private:
-  static std::shared_ptr<Singleton::Instance> createCache() {
-    return std::make_shared<SimpleHttpCache>();
+    SimpleHttpCacheConfig config;
+    THROW_IF_NOT_OK(MessageUtil::unpackTo(filter_config.typed_config(), config));
+    // Pinned so that a filter config update finds the caches still used by the previous config.
+    std::shared_ptr<CacheSingleton> caches =
+        context.serverFactoryContext().singletonManager().getTyped<CacheSingleton>(
+            SINGLETON_MANAGER_REGISTERED_NAME(simple_http_cache_singleton),
+            [] { return std::make_shared<CacheSingleton>(); }, /* pin = */ true);
+    return caches->get(config);
   }
 };
 
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/http/cache/simple_http_cache/v3/config.pb.h"
+
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/cache/http_cache.h"
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/synchronization/mutex.h"
 
 namespace Envoy {
@@ -12,19 +21,72 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Cache {
 
-// Example cache backend that never evicts. Not suitable for production use.
-class SimpleHttpCache : public HttpCache, public Singleton::Instance {
+using SimpleHttpCacheConfig =
+    envoy::extensions::http::cache::simple_http_cache::v3::SimpleHttpCacheConfig;
+
+// In-memory cache backend. Entries are spread over shards by key hash, each with its own lock, so
+// requests for different keys rarely contend and lookups never wait for each other. When limits
+// are configured, each shard evicts with the CLOCK algorithm once it exceeds its share of them.
+class SimpleHttpCache : public HttpCache {
 private:
+  // Cached bodies are immutable and shared with the responses served from them.
+  using BodySharedPtr = std::shared_ptr<const std::string>;
+
   struct Entry {
     Http::ResponseHeaderMapPtr response_headers_;
     ResponseMetadata metadata_;
-    std::string body_;
+    BodySharedPtr body_;
     Http::ResponseTrailerMapPtr trailers_;
   };
 
-  // Looks for a response that has been varied. Only called from lookup.
-  Entry varyLookup(const LookupRequest& request,
-                   const Http::ResponseHeaderMapPtr& response_headers);
+  struct StoredEntry {
+    Http::ResponseHeaderMapPtr response_headers_;
+    ResponseMetadata metadata_;
+    BodySharedPtr body_;
+    Http::ResponseTrailerMapPtr trailers_;
+    // The bytes charged against the shard for this entry.
+    uint64_t size_{};
+    // Set when the entry is looked up and cleared when the eviction hand passes over it; the hand
+    // evicts the entries it finds unreferenced. Lookups only hold the shard lock for reading.
+    mutable std::atomic<bool> referenced_{};
+  };
+
+  struct Shard {
+    absl::Mutex mutex_;
+    absl::node_hash_map<Key, StoredEntry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+    // The keys of map_ in the order the eviction hand visits them.
+    std::deque<const Key*> clock_ ABSL_GUARDED_BY(mutex_);
+    uint64_t bytes_ ABSL_GUARDED_BY(mutex_){};
+  };
+
+  static constexpr size_t ShardCount = 16;
+
+  Shard& shardFor(const Key& key);
+
+  // Returns a copy of the entry for a key that may only be found through the vary marker entry.
+  // Only called from lookup.
+  Entry varyLookup(const Key& varied_request_key);
+
+  // Stores an entry, replacing any entry for the same key, then evicts entries until the shard is
+  // within its limits again. Returns false if the entry is too large to ever fit in the shard.
+  bool storeLocked(Shard& shard, const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
+                   ResponseMetadata&& metadata, BodySharedPtr&& body,
+                   Http::ResponseTrailerMapPtr&& trailers)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  // Applies a header update from validation to a stored entry. Returns false if the updated entry
+  // no longer fits in the shard and was evicted.
+  bool updateLocked(Shard& shard, const Key& key, StoredEntry& entry,
+                    const Http::ResponseHeaderMap& response_headers,
+                    const ResponseMetadata& metadata) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  // Evicts entries other than the one for the key until the shard is within its limits. Returns
+  // false if the kept entry alone exceeded them and had to be evicted as well.
+  bool evictLocked(Shard& shard, const Key* keep) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  static uint64_t entrySize(const Http::ResponseHeaderMap& response_headers,
+                            const std::string& body, const Http::ResponseTrailerMap* trailers);
+  static Entry copyEntry(const StoredEntry& entry);
 
   // A list of headers that we do not want to update upon validation
   // We skip these headers because either it's updated by other application logic
@@ -33,6 +95,9 @@ private:
   static const absl::flat_hash_set<Http::LowerCaseString> headersNotToUpdate();
 
 public:
+  SimpleHttpCache() : SimpleHttpCache(SimpleHttpCacheConfig()) {}
+  explicit SimpleHttpCache(const SimpleHttpCacheConfig& config);
+
   // HttpCache
   LookupContextPtr makeLookupContext(LookupRequest&& request,
                                      Http::StreamFilterCallbacks& callbacks) override;
@@ -54,8 +119,19 @@ public:
                   const Http::RequestHeaderMap& request_headers,
                   const VaryAllowList& vary_allow_list, Http::ResponseTrailerMapPtr&& trailers);
 
-  absl::Mutex mutex_;
-  absl::flat_hash_map<Key, Entry, MessageUtil, MessageUtil> map_ ABSL_GUARDED_BY(mutex_);
+  // @return the number of entries in the cache, including vary marker entries.
+  uint64_t entryCount();
+  // @return the bytes charged for all entries in the cache.
+  uint64_t byteSize();
+
+  const SimpleHttpCacheConfig& config() const { return config_; }
+
+private:
+  const SimpleHttpCacheConfig config_;
+  // The limits each shard enforces.
+  const uint64_t max_shard_bytes_;
+  const uint64_t max_shard_entries_;
+  std::array<Shard, ShardCount> shards_;
 };
 
 } // namespace Cache
@@ -54,8 +54,9 @@ ClientSideWeightedRoundRobinLbConfig::ClientSideWeightedRoundRobinLbConfig(
 }
 
 ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb::WorkerLocalLb(
-    const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterLbStats& stats,
-    Runtime::Loader& runtime, Random::RandomGenerator& random,
+    const PrioritySet& priority_set, const PrioritySet* local_priority_set,
+    DeferredCreationCompatibleClusterLbStats& stats, Runtime::Loader& runtime,
+    Random::RandomGenerator& random,
     const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config,
     TimeSource& time_source, OptRef<ThreadLocalShim> tls_shim)
     : RoundRobinLoadBalancer(priority_set, local_priority_set, stats, runtime, random,
@@ -189,19 +190,7 @@ double
 ClientSideWeightedRoundRobinLoadBalancer::OrcaLoadReportHandler::getUtilizationFromOrcaReport(
     const OrcaLoadReportProto& orca_load_report,
     const std::vector<std::string>& metric_names_for_computing_utilization) {
-  // If application_utilization is valid, use it as the utilization metric.
-  double utilization = orca_load_report.application_utilization();
-  if (utilization > 0) {
-    return utilization;
-  }
-  // Otherwise, find the most constrained utilization metric.
-  utilization =
-      Envoy::Orca::getMaxUtilization(metric_names_for_computing_utilization, orca_load_report);
-  if (utilization > 0) {
-    return utilization;
-  }
-  // If utilization is <= 0, use cpu_utilization.
-  return orca_load_report.cpu_utilization();
+  return Envoy::Orca::getUtilization(metric_names_for_computing_utilization, orca_load_report);
 }
 
 absl::StatusOr<uint32_t>
@@ -145,7 +145,8 @@ public:
   class WorkerLocalLb : public RoundRobinLoadBalancer {
   public:
     WorkerLocalLb(const PrioritySet& priority_set, const PrioritySet* local_priority_set,
-                  ClusterLbStats& stats, Runtime::Loader& runtime, Random::RandomGenerator& random,
+                  DeferredCreationCompatibleClusterLbStats& stats, Runtime::Loader& runtime,
+                  Random::RandomGenerator& random,
                   const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config,
                   TimeSource& time_source, OptRef<ThreadLocalShim> tls_shim);
 
@@ -1,9 +1,9 @@
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
+#include <algorithm>
 #include <atomic>
 #include <bitset>
 #include <cstdint>
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -19,6 +19,8 @@
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -30,6 +32,10 @@ static const std::string RuntimeForceLocalZoneMinSize =
     "upstream.zone_routing.force_local_zone.min_size";
 static const std::string RuntimePanicThreshold = "upstream.healthy_panic_threshold";
 
+// Smaller EDF schedulers are cheap enough to always rebuild on membership updates, which also
+// reseeds their schedule.
+constexpr size_t MinHostsToUpdateSchedulerInPlace = 100;
+
 // Returns true if the weights of all the hosts in the HostVector are equal.
 bool hostWeightsAreEqual(const HostVector& hosts) {
   if (hosts.size() <= 1) {
@@ -95,7 +101,8 @@ LoadBalancerBase::choosePriority(uint64_t hash, const HealthyLoad& healthy_per_p
   return {0, HostAvailability::Healthy};
 }
 
-LoadBalancerBase::LoadBalancerBase(const PrioritySet& priority_set, ClusterLbStats& stats,
+LoadBalancerBase::LoadBalancerBase(const PrioritySet& priority_set,
+                                   DeferredCreationCompatibleClusterLbStats& stats,
                                    Runtime::Loader& runtime, Random::RandomGenerator& random,
                                    uint32_t healthy_panic_threshold)
     : stats_(stats), runtime_(runtime), random_(random),
@@ -386,8 +393,9 @@ uint64_t LoadBalancerBase::random(bool peeking) {
 }
 
 ZoneAwareLoadBalancerBase::ZoneAwareLoadBalancerBase(
-    const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterLbStats& stats,
-    Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
+    const PrioritySet& priority_set, const PrioritySet* local_priority_set,
+    DeferredCreationCompatibleClusterLbStats& stats, Runtime::Loader& runtime,
+    Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
     const absl::optional<LocalityLbConfig> locality_config)
     : LoadBalancerBase(priority_set, stats, runtime, random, healthy_panic_threshold),
       local_priority_set_(local_priority_set),
@@ -421,7 +429,8 @@ ZoneAwareLoadBalancerBase::ZoneAwareLoadBalancerBase(
                                  ? locality_config->zone_aware_lb_config().fail_traffic_on_panic()
                                  : false),
       locality_weighted_balancing_(locality_config.has_value() &&
-                                   locality_config->has_locality_weighted_lb_config()) {
+                                   locality_config->has_locality_weighted_lb_config()),
+      local_percentages_stale_(true) {
   ASSERT(!priority_set.hostSetsPerPriority().empty());
   resizePerPriorityState();
   priority_update_cb_ = priority_set_.addPriorityUpdateCb(
@@ -446,6 +455,7 @@ ZoneAwareLoadBalancerBase::ZoneAwareLoadBalancerBase(
           ASSERT(priority == 0);
           // If the set of local Envoys changes, regenerate routing for P=0 as it does priority
           // based routing.
+          local_percentages_stale_ = true;
           regenerateLocalityRoutingStructures();
           return absl::OkStatus();
         });
@@ -454,7 +464,7 @@ ZoneAwareLoadBalancerBase::ZoneAwareLoadBalancerBase(
 
 void ZoneAwareLoadBalancerBase::regenerateLocalityRoutingStructures() {
   ASSERT(local_priority_set_);
-  stats_.lb_recalculate_zone_structures_.inc();
+  stats_->lb_recalculate_zone_structures_.inc();
   // resizePerPriorityState should ensure these stay in sync.
   ASSERT(per_priority_state_.size() == priority_set_.hostSetsPerPriority().size());
 
@@ -481,9 +491,10 @@ void ZoneAwareLoadBalancerBase::regenerateLocalityRoutingStructures() {
   //
   // Basically, fairness across localities within a priority is guaranteed. Fairness across
   // localities across priorities is not.
-  const HostsPerLocality& localHostsPerLocality = localHostSet().healthyHostsPerLocality();
-  auto locality_percentages =
-      calculateLocalityPercentages(localHostsPerLocality, upstreamHostsPerLocality);
+  if (local_percentages_stale_) {
+    refreshLocalPercentages(localHostSet().healthyHostsPerLocality());
+  }
+  auto locality_percentages = calculateLocalityPercentages(upstreamHostsPerLocality);
 
   if (upstreamHostsPerLocality.hasLocalLocality()) {
     // If we have lower percent of hosts in the local cluster in the same locality,
@@ -526,8 +537,8 @@ void ZoneAwareLoadBalancerBase::regenerateLocalityRoutingStructures() {
   // bucket sizes (residual capacity). For simplicity of finding where specific
   // sampled value is, we accumulate values in residual capacity. This is what it will look like:
   // residual_capacity: 0 10000 15000
-  // Now to find a locality to route (bucket) we could simply iterate over residual_capacity
-  // searching where sampled value is placed.
+  // Now to find a locality to route (bucket) we binary search residual_capacity for where the
+  // sampled value is placed.
   state.residual_capacity_.resize(num_upstream_localities);
   for (uint64_t i = 0; i < num_upstream_localities; ++i) {
     uint64_t last_residual_capacity = i > 0 ? state.residual_capacity_[i - 1] : 0;
@@ -582,7 +593,7 @@ bool ZoneAwareLoadBalancerBase::earlyExitNonLocalityRouting() {
   // about the current one, so they will not factor it into locality routing calculations.
   if (!localHostSet().hostsPerLocality().hasLocalLocality() ||
       localHostSet().hostsPerLocality().get()[0].empty()) {
-    stats_.lb_local_cluster_not_ok_.inc();
+    stats_->lb_local_cluster_not_ok_.inc();
     return true;
   }
 
@@ -590,7 +601,7 @@ bool ZoneAwareLoadBalancerBase::earlyExitNonLocalityRouting() {
   const uint64_t min_cluster_size =
       runtime_.snapshot().getInteger(RuntimeMinClusterSize, min_cluster_size_);
   if (host_set.healthyHosts().size() < min_cluster_size) {
-    stats_.lb_zone_cluster_too_small_.inc();
+    stats_->lb_zone_cluster_too_small_.inc();
     return true;
   }
 
@@ -633,19 +644,27 @@ bool LoadBalancerBase::isHostSetInPanic(const HostSet& host_set) const {
   return false;
 }
 
-absl::FixedArray<ZoneAwareLoadBalancerBase::LocalityPercentages>
-ZoneAwareLoadBalancerBase::calculateLocalityPercentages(
-    const HostsPerLocality& local_hosts_per_locality,
-    const HostsPerLocality& upstream_hosts_per_locality) {
+void ZoneAwareLoadBalancerBase::refreshLocalPercentages(
+    const HostsPerLocality& local_hosts_per_locality) {
   uint64_t total_local_hosts = 0;
-  std::map<envoy::config::core::v3::Locality, uint64_t, LocalityLess> local_counts;
   for (const auto& locality_hosts : local_hosts_per_locality.get()) {
     total_local_hosts += locality_hosts.size();
+  }
+
+  local_percentages_.clear();
+  for (const auto& locality_hosts : local_hosts_per_locality.get()) {
     // If there is no entry in the map for a given locality, it is assumed to have 0 hosts.
     if (!locality_hosts.empty()) {
-      local_counts.insert(std::make_pair(locality_hosts[0]->locality(), locality_hosts.size()));
+      local_percentages_.emplace(locality_hosts[0]->locality(),
+                                 10000ULL * locality_hosts.size() / total_local_hosts);
     }
   }
+  local_percentages_stale_ = false;
+}
+
+absl::FixedArray<ZoneAwareLoadBalancerBase::LocalityPercentages>
+ZoneAwareLoadBalancerBase::calculateLocalityPercentages(
+    const HostsPerLocality& upstream_hosts_per_locality) const {
   uint64_t total_upstream_hosts = 0;
   for (const auto& locality_hosts : upstream_hosts_per_locality.get()) {
     total_upstream_hosts += locality_hosts.size();
@@ -664,11 +683,9 @@ ZoneAwareLoadBalancerBase::calculateLocalityPercentages(
     }
     const auto& locality = upstream_hosts[0]->locality();
 
-    const auto& local_count_it = local_counts.find(locality);
-    const uint64_t local_count = local_count_it == local_counts.end() ? 0 : local_count_it->second;
-
+    const auto local_percentage_it = local_percentages_.find(locality);
     const uint64_t local_percentage =
-        total_local_hosts > 0 ? 10000ULL * local_count / total_local_hosts : 0;
+        local_percentage_it == local_percentages_.end() ? 0 : local_percentage_it->second;
     const uint64_t upstream_percentage =
         total_upstream_hosts > 0 ? 10000ULL * upstream_hosts.size() / total_upstream_hosts : 0;
 
@@ -689,7 +706,7 @@ uint32_t ZoneAwareLoadBalancerBase::tryChooseLocalLocalityHosts(const HostSet& h
   // Try to push all of the requests to the same locality if possible.
   if (state.locality_routing_state_ == LocalityRoutingState::LocalityDirect) {
     ASSERT(host_set.healthyHostsPerLocality().hasLocalLocality());
-    stats_.lb_zone_routing_all_directly_.inc();
+    stats_->lb_zone_routing_all_directly_.inc();
     return 0;
   }
 
@@ -700,17 +717,17 @@ uint32_t ZoneAwareLoadBalancerBase::tryChooseLocalLocalityHosts(const HostSet& h
   // If we cannot route all requests to the same locality, we already calculated how much we can
   // push to the local locality, check if we can push to local locality on current iteration.
   if (random_.random() % 10000 < state.local_percent_to_route_) {
-    stats_.lb_zone_routing_sampled_.inc();
+    stats_->lb_zone_routing_sampled_.inc();
     return 0;
   }
 
   // At this point we must route cross locality as we cannot route to the local locality.
-  stats_.lb_zone_routing_cross_zone_.inc();
+  stats_->lb_zone_routing_cross_zone_.inc();
 
   // This is *extremely* unlikely but possible due to rounding errors when calculating
   // locality percentages. In this case just select random locality.
   if (state.residual_capacity_[number_of_localities - 1] == 0) {
-    stats_.lb_zone_no_capacity_left_.inc();
+    stats_->lb_zone_no_capacity_left_.inc();
     return random_.random() % number_of_localities;
   }
 
@@ -718,19 +735,18 @@ uint32_t ZoneAwareLoadBalancerBase::tryChooseLocalLocalityHosts(const HostSet& h
   // additional capacity in localities.
   uint64_t threshold = random_.random() % state.residual_capacity_[number_of_localities - 1];
 
-  // This potentially can be optimized to be O(log(N)) where N is the number of localities.
-  // Linear scan should be faster for smaller N, in most of the scenarios N will be small.
+  // The selected locality is the first one whose accumulated capacity exceeds the threshold:
   //
   // Bucket 1: [0, state.residual_capacity_[0] - 1]
   // Bucket 2: [state.residual_capacity_[0], state.residual_capacity_[1] - 1]
   // ...
   // Bucket N: [state.residual_capacity_[N-2], state.residual_capacity_[N-1] - 1]
-  int i = 0;
-  while (threshold >= state.residual_capacity_[i]) {
-    i++;
-  }
-
-  return i;
+  //
+  // Localities without residual capacity have empty buckets and are never selected.
+  const auto it = std::upper_bound(state.residual_capacity_.begin(),
+                                   state.residual_capacity_.begin() + number_of_localities,
+                                   threshold);
+  return it - state.residual_capacity_.begin();
 }
 
 absl::optional<ZoneAwareLoadBalancerBase::HostsSource>
@@ -746,7 +762,7 @@ ZoneAwareLoadBalancerBase::hostSourceToUse(LoadBalancerContext* context, uint64_
   // If the selected host set has insufficient healthy hosts, return all hosts (unless we should
   // fail traffic on panic, in which case return no host).
   if (per_priority_panic_[hosts_source.priority_]) {
-    stats_.lb_healthy_panic_.inc();
+    stats_->lb_healthy_panic_.inc();
     if (fail_traffic_on_panic_) {
       return absl::nullopt;
     } else {
@@ -804,7 +820,7 @@ ZoneAwareLoadBalancerBase::hostSourceToUse(LoadBalancerContext* context, uint64_
   }
 
   if (isHostSetInPanic(localHostSet())) {
-    stats_.lb_local_cluster_not_ok_.inc();
+    stats_->lb_local_cluster_not_ok_.inc();
     // If the local Envoy instances are in global panic, and we should not fail traffic, do
     // not do locality based routing.
     if (fail_traffic_on_panic_) {
@@ -846,8 +862,9 @@ const HostVector& ZoneAwareLoadBalancerBase::hostSourceToHosts(HostsSource hosts
 }
 
 EdfLoadBalancerBase::EdfLoadBalancerBase(
-    const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterLbStats& stats,
-    Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
+    const PrioritySet& priority_set, const PrioritySet* local_priority_set,
+    DeferredCreationCompatibleClusterLbStats& stats, Runtime::Loader& runtime,
+    Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
     const absl::optional<LocalityLbConfig> locality_config,
     const absl::optional<SlowStartConfig> slow_start_config, TimeSource& time_source)
     : ZoneAwareLoadBalancerBase(priority_set, local_priority_set, stats, runtime, random,
@@ -867,14 +884,20 @@ EdfLoadBalancerBase::EdfLoadBalancerBase(
                                                slow_start_config.value(), min_weight_percent, 10) /
                                                100.0
                                          : 0.1) {
-  // We fully recompute the schedulers for a given host set here on membership change, which is
-  // consistent with what other LB implementations do (e.g. thread aware).
-  // The downside of a full recompute is that time complexity is O(n * log n),
-  // so we will need to do better at delta tracking to scale (see
-  // https://github.com/envoyproxy/envoy/issues/2874).
+  // We recompute the schedulers for a given host set here on membership change, which is
+  // consistent with what other LB implementations do (e.g. thread aware). A full recompute is
+  // O(n * log n), so schedulers whose host source only changed by the hosts added and removed are
+  // updated in place instead (see https://github.com/envoyproxy/envoy/issues/2874).
   priority_update_cb_ = priority_set.addPriorityUpdateCb(
-      [this](uint32_t priority, const HostVector&, const HostVector&) {
+      [this](uint32_t priority, const HostVector& hosts_added, const HostVector& hosts_removed) {
+        if (Runtime::runtimeFeatureEnabled(
+                "envoy.reloadable_features.edf_lb_update_schedulers_in_place")) {
+          update_hosts_added_ = &hosts_added;
+          update_hosts_removed_ = &hosts_removed;
+        }
         refresh(priority);
+        update_hosts_added_ = nullptr;
+        update_hosts_removed_ = nullptr;
         return absl::OkStatus();
       });
   member_update_cb_ = priority_set.addMemberUpdateCb(
@@ -916,11 +939,86 @@ void EdfLoadBalancerBase::recalculateHostsInSlowStart(const HostVector& hosts) {
   }
 }
 
+bool EdfLoadBalancerBase::updateSchedulerInPlace(
+    Scheduler& scheduler, const HostVectorConstSharedPtr& hosts,
+    const absl::flat_hash_set<const Host*>& updated_hosts) {
+  if (scheduler.edf_ == nullptr || hosts->size() < MinHostsToUpdateSchedulerInPlace) {
+    return false;
+  }
+  // Walk the old and new hosts side by side. Hosts which are not part of the update must line up,
+  // otherwise something else changed the host source (e.g. a health transition).
+  const HostVector& old_hosts = *scheduler.hosts_;
+  HostVector hosts_entering;
+  HostVector hosts_leaving;
+  size_t old_index = 0;
+  const auto skip_leaving_hosts = [&]() {
+    while (old_index < old_hosts.size() && updated_hosts.contains(old_hosts[old_index].get())) {
+      hosts_leaving.push_back(old_hosts[old_index++]);
+    }
+  };
+  for (const HostSharedPtr& host : *hosts) {
+    if (updated_hosts.contains(host.get())) {
+      hosts_entering.push_back(host);
+      continue;
+    }
+    skip_leaving_hosts();
+    if (old_index == old_hosts.size() || old_hosts[old_index] != host) {
+      return false;
+    }
+    ++old_index;
+  }
+  skip_leaving_hosts();
+  if (old_index != old_hosts.size() ||
+      (hosts_entering.size() + hosts_leaving.size()) * 2 > hosts->size()) {
+    return false;
+  }
+
+  // The deadlines of the other hosts are kept. Entering hosts are scheduled from the current time,
+  // as if they had just been picked. Weight changes of the other hosts apply from their next pick.
+  for (HostSharedPtr& host : hosts_leaving) {
+    scheduler.edf_->remove(std::move(host));
+  }
+  for (const HostSharedPtr& host : hosts_entering) {
+    scheduler.edf_->add(hostWeight(*host), host);
+  }
+  if (isSlowStartEnabled()) {
+    recalculateHostsInSlowStart(hosts_entering);
+  }
+  scheduler.hosts_ = hosts;
+  return true;
+}
+
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
-  const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
+  const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
+
+  // The hosts added to and removed from this priority by the membership update being handled.
+  // Host sources which only changed by these hosts have their scheduler updated in place. This is
+  // not worth it for small priorities, or for updates touching a large part of the priority.
+  absl::flat_hash_set<const Host*> updated_hosts;
+  if (update_hosts_added_ != nullptr &&
+      host_set->hosts().size() >= MinHostsToUpdateSchedulerInPlace &&
+      (update_hosts_added_->size() + update_hosts_removed_->size()) * 2 <=
+          host_set->hosts().size()) {
+    updated_hosts.reserve(update_hosts_added_->size() + update_hosts_removed_->size());
+    for (const HostSharedPtr& host : *update_hosts_added_) {
+      updated_hosts.insert(host.get());
+    }
+    for (const HostSharedPtr& host : *update_hosts_removed_) {
+      updated_hosts.insert(host.get());
+    }
+  }
+
+  const auto add_hosts_source = [this, &updated_hosts](HostsSource source,
+                                                       HostVectorConstSharedPtr hosts_ptr) {
+    auto& scheduler = scheduler_[source];
+    if (!updated_hosts.empty() && updateSchedulerInPlace(scheduler, hosts_ptr, updated_hosts)) {
+      refreshHostSource(source);
+      return;
+    }
     // Nuke existing scheduler if it exists.
-    auto& scheduler = scheduler_[source] = Scheduler{};
+    scheduler = Scheduler{};
     refreshHostSource(source);
+    const HostVector& hosts = *hosts_ptr;
     if (isSlowStartEnabled()) {
       recalculateHostsInSlowStart(hosts);
     }
@@ -953,25 +1051,38 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
         // at which point it is reinserted into the EdfScheduler with its new
         // weight in chooseHost().
         [this](const Host& host) { return hostWeight(host); }, seed_));
+    scheduler.hosts_ = std::move(hosts_ptr);
+  };
+  // The host vectors are shared with the host set, rather than copied, so that the schedulers can
+  // tell how their host source changed on the next update.
+  const auto locality_hosts = [](const HostsPerLocalityConstSharedPtr& hosts_per_locality,
+                                 uint32_t locality_index) {
+    return HostVectorConstSharedPtr(hosts_per_locality,
+                                    &hosts_per_locality->get()[locality_index]);
   };
   // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
-  const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
-  add_hosts_source(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hosts());
+  add_hosts_source(HostsSource(priority, HostsSource::SourceType::AllHosts), host_set->hostsPtr());
+  const HealthyHostVectorConstSharedPtr healthy_hosts = host_set->healthyHostsPtr();
   add_hosts_source(HostsSource(priority, HostsSource::SourceType::HealthyHosts),
-                   host_set->healthyHosts());
+                   HostVectorConstSharedPtr(healthy_hosts, &healthy_hosts->get()));
+  const DegradedHostVectorConstSharedPtr degraded_hosts = host_set->degradedHostsPtr();
   add_hosts_source(HostsSource(priority, HostsSource::SourceType::DegradedHosts),
-                   host_set->degradedHosts());
-  for (uint32_t locality_index = 0;
-       locality_index < host_set->healthyHostsPerLocality().get().size(); ++locality_index) {
+                   HostVectorConstSharedPtr(degraded_hosts, &degraded_hosts->get()));
+  const HostsPerLocalityConstSharedPtr healthy_hosts_per_locality =
+      host_set->healthyHostsPerLocalityPtr();
+  for (uint32_t locality_index = 0; locality_index < healthy_hosts_per_locality->get().size();
+       ++locality_index) {
     add_hosts_source(
         HostsSource(priority, HostsSource::SourceType::LocalityHealthyHosts, locality_index),
-        host_set->healthyHostsPerLocality().get()[locality_index]);
+        locality_hosts(healthy_hosts_per_locality, locality_index));
   }
-  for (uint32_t locality_index = 0;
-       locality_index < host_set->degradedHostsPerLocality().get().size(); ++locality_index) {
+  const HostsPerLocalityConstSharedPtr degraded_hosts_per_locality =
+      host_set->degradedHostsPerLocalityPtr();
+  for (uint32_t locality_index = 0; locality_index < degraded_hosts_per_locality->get().size();
+       ++locality_index) {
     add_hosts_source(
         HostsSource(priority, HostsSource::SourceType::LocalityDegradedHosts, locality_index),
-        host_set->degradedHostsPerLocality().get()[locality_index]);
+        locality_hosts(degraded_hosts_per_locality, locality_index));
   }
 }
 
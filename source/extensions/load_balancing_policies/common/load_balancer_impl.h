@@ -170,8 +170,9 @@ protected:
    */
   void recalculateLoadInTotalPanic();
 
-  LoadBalancerBase(const PrioritySet& priority_set, ClusterLbStats& stats, Runtime::Loader& runtime,
-                   Random::RandomGenerator& random, uint32_t healthy_panic_threshold);
+  LoadBalancerBase(const PrioritySet& priority_set, DeferredCreationCompatibleClusterLbStats& stats,
+                   Runtime::Loader& runtime, Random::RandomGenerator& random,
+                   uint32_t healthy_panic_threshold);
 
   // Choose host set randomly, based on the healthy_per_priority_load_ and
   // degraded_per_priority_load_. per_priority_load_ is consulted first, spilling over to
@@ -191,7 +192,7 @@ protected:
   bool isInPanic(uint32_t priority) const { return per_priority_panic_[priority]; }
   uint64_t random(bool peeking);
 
-  ClusterLbStats& stats_;
+  DeferredCreationCompatibleClusterLbStats& stats_;
   Runtime::Loader& runtime_;
   std::deque<uint64_t> stashed_random_;
   Random::RandomGenerator& random_;
@@ -260,8 +261,9 @@ public:
 protected:
   // Both priority_set and local_priority_set if non-null must have at least one host set.
   ZoneAwareLoadBalancerBase(const PrioritySet& priority_set, const PrioritySet* local_priority_set,
-                            ClusterLbStats& stats, Runtime::Loader& runtime,
-                            Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
+                            DeferredCreationCompatibleClusterLbStats& stats,
+                            Runtime::Loader& runtime, Random::RandomGenerator& random,
+                            uint32_t healthy_panic_threshold,
                             const absl::optional<LocalityLbConfig> locality_config);
 
   // When deciding which hosts to use on an LB decision, we need to know how to index into the
@@ -397,10 +399,15 @@ private:
    * @return combined per-locality information about percentages of local/upstream hosts in each
    * upstream locality. See LocalityPercentages for more details. The ordering of localities
    * matches the ordering of upstream localities in the input upstream_hosts_per_locality.
+   * The local percentages are taken from local_percentages_.
    */
   absl::FixedArray<LocalityPercentages>
-  calculateLocalityPercentages(const HostsPerLocality& local_hosts_per_locality,
-                               const HostsPerLocality& upstream_hosts_per_locality);
+  calculateLocalityPercentages(const HostsPerLocality& upstream_hosts_per_locality) const;
+
+  /**
+   * Rebuild local_percentages_ from the healthy hosts of the local cluster.
+   */
+  void refreshLocalPercentages(const HostsPerLocality& local_hosts_per_locality);
 
   /**
    * Regenerate locality aware routing structures for fast decisions on upstream locality selection.
@@ -445,7 +452,8 @@ private:
     LocalityRoutingState locality_routing_state_{LocalityRoutingState::NoLocalityRouting};
     // When locality_routing_state_ == LocalityResidual this tracks the capacity
     // for each of the non-local localities to determine what traffic should be
-    // routed where.
+    // routed where. The capacities are accumulated, so the vector is sorted and
+    // can be binary searched.
     std::vector<uint64_t> residual_capacity_;
   };
   using PerPriorityStatePtr = std::unique_ptr<PerPriorityState>;
@@ -453,6 +461,11 @@ private:
   std::vector<PerPriorityStatePtr> per_priority_state_;
   Common::CallbackHandlePtr priority_update_cb_;
   Common::CallbackHandlePtr local_priority_set_member_update_cb_handle_;
+  // The percentage of local hosts in each locality of the local cluster, scaled by 10000. This only
+  // depends on the local cluster, so it is reused when only upstream hosts change, e.g. when they
+  // flip health.
+  absl::flat_hash_map<envoy::config::core::v3::Locality, uint64_t, LocalityHash, LocalityEqualTo>
+      local_percentages_;
 
   // Config for zone aware routing.
   const uint64_t min_cluster_size_;
@@ -464,6 +477,9 @@ private:
   // If locality weight aware routing is enabled.
   const bool locality_weighted_balancing_ : 1;
 
+  // Whether the local cluster changed since local_percentages_ was last built.
+  bool local_percentages_stale_ : 1;
+
   friend class TestZoneAwareLoadBalancer;
 };
 
@@ -489,7 +505,7 @@ public:
   using SlowStartConfig = envoy::extensions::load_balancing_policies::common::v3::SlowStartConfig;
 
   EdfLoadBalancerBase(const PrioritySet& priority_set, const PrioritySet* local_priority_set,
-                      ClusterLbStats& stats, Runtime::Loader& runtime,
+                      DeferredCreationCompatibleClusterLbStats& stats, Runtime::Loader& runtime,
                       Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
                       const absl::optional<LocalityLbConfig> locality_config,
                       const absl::optional<SlowStartConfig> slow_start_config,
@@ -505,6 +521,8 @@ protected:
     // host weights of 2 or more hosts differ. When not present, the
     // implementation of chooseHostOnce falls back to unweightedHostPick.
     std::unique_ptr<EdfScheduler<Host>> edf_;
+    // The hosts edf_ schedules. Only set along with edf_.
+    HostVectorConstSharedPtr hosts_;
   };
 
   void initialize();
@@ -527,6 +545,12 @@ protected:
 
 private:
   friend class EdfLoadBalancerBasePeer;
+  // Applies a membership update to an existing EDF scheduler in place. This is only done when the
+  // hosts which are not in updated_hosts are the same, in the same order, before and after the
+  // update, and when the update is small compared to the host source.
+  // @return whether the scheduler was updated. If not, it must be rebuilt.
+  bool updateSchedulerInPlace(Scheduler& scheduler, const HostVectorConstSharedPtr& hosts,
+                              const absl::flat_hash_set<const Host*>& updated_hosts);
   virtual void refreshHostSource(const HostsSource& source) PURE;
   virtual double hostWeight(const Host& host) const PURE;
   virtual HostConstSharedPtr unweightedHostPeek(const HostVector& hosts_to_use,
@@ -538,6 +562,9 @@ private:
   absl::flat_hash_map<HostsSource, Scheduler, HostsSourceHash> scheduler_;
   Common::CallbackHandlePtr priority_update_cb_;
   Common::CallbackHandlePtr member_update_cb_;
+  // The hosts added and removed by the membership update refresh() is called for, if any.
+  const HostVector* update_hosts_added_{};
+  const HostVector* update_hosts_removed_{};
 
 protected:
   // Slow start related config
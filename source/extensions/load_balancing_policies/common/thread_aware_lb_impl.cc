@@ -165,8 +165,9 @@ absl::Status ThreadAwareLoadBalancerBase::refresh() {
                                            normalized_host_weights, min_normalized_weight,
                                            max_normalized_weight, locality_weighted_balancing_);
     RETURN_IF_NOT_OK(status);
-    per_priority_state->current_lb_ = createLoadBalancer(
-        std::move(normalized_host_weights), min_normalized_weight, max_normalized_weight);
+    per_priority_state->current_lb_ =
+        createLoadBalancer(priority, std::move(normalized_host_weights), min_normalized_weight,
+                           max_normalized_weight);
   }
 
   {
@@ -213,7 +214,7 @@ ThreadAwareLoadBalancerBase::LoadBalancerImpl::chooseHost(LoadBalancerContext* c
           .first;
   const auto& per_priority_state = (*per_priority_state_)[priority];
   if (per_priority_state->global_panic_) {
-    stats_.lb_healthy_panic_.inc();
+    stats_->lb_healthy_panic_.inc();
   }
 
   const uint32_t max_attempts = context ? context->hostSelectionRetryCount() + 1 : 1;
@@ -111,7 +111,8 @@ public:
   }
 
 protected:
-  ThreadAwareLoadBalancerBase(const PrioritySet& priority_set, ClusterLbStats& stats,
+  ThreadAwareLoadBalancerBase(const PrioritySet& priority_set,
+                              DeferredCreationCompatibleClusterLbStats& stats,
                               Runtime::Loader& runtime, Random::RandomGenerator& random,
                               uint32_t healthy_panic_threshold, bool locality_weighted_balancing,
                               HashPolicySharedPtr hash_policy)
@@ -127,8 +128,8 @@ private:
   using PerPriorityStatePtr = std::unique_ptr<PerPriorityState>;
 
   struct LoadBalancerImpl : public LoadBalancer {
-    LoadBalancerImpl(ClusterLbStats& stats, Random::RandomGenerator& random,
-                     HashPolicySharedPtr hash_policy)
+    LoadBalancerImpl(DeferredCreationCompatibleClusterLbStats& stats,
+                     Random::RandomGenerator& random, HashPolicySharedPtr hash_policy)
         : stats_(stats), random_(random), hash_policy_(std::move(hash_policy)) {}
 
     // Upstream::LoadBalancer
@@ -145,7 +146,7 @@ private:
       return {};
     }
 
-    ClusterLbStats& stats_;
+    DeferredCreationCompatibleClusterLbStats& stats_;
     Random::RandomGenerator& random_;
     HashPolicySharedPtr hash_policy_;
 
@@ -155,7 +156,8 @@ private:
   };
 
   struct LoadBalancerFactoryImpl : public LoadBalancerFactory {
-    LoadBalancerFactoryImpl(ClusterLbStats& stats, Random::RandomGenerator& random,
+    LoadBalancerFactoryImpl(DeferredCreationCompatibleClusterLbStats& stats,
+                            Random::RandomGenerator& random,
                             std::shared_ptr<Http::HashPolicy> hash_policy)
         : stats_(stats), random_(random), hash_policy_(std::move(hash_policy)) {}
 
@@ -163,7 +165,7 @@ private:
     // Ignore the params for the thread-aware LB.
     LoadBalancerPtr create(LoadBalancerParams) override;
 
-    ClusterLbStats& stats_;
+    DeferredCreationCompatibleClusterLbStats& stats_;
     Random::RandomGenerator& random_;
     std::shared_ptr<Http::HashPolicy> hash_policy_;
     absl::Mutex mutex_;
@@ -173,8 +175,12 @@ private:
     std::shared_ptr<DegradedLoad> degraded_per_priority_load_ ABSL_GUARDED_BY(mutex_);
   };
 
+  /**
+   * Build the hashing load balancer for a single priority. Implementations may keep state per
+   * priority to derive the new load balancer from the one built for the previous update.
+   */
   virtual HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double max_normalized_weight) PURE;
   absl::Status refresh();
 
@@ -40,6 +40,28 @@ Upstream::LoadBalancerPtr LeastRequestCreator::operator()(
       typed_lb_config->lb_config_, time_source);
 }
 
+Upstream::ThreadAwareLoadBalancerPtr
+Factory::create(OptRef<const Upstream::LoadBalancerConfig> lb_config,
+                const Upstream::ClusterInfo& cluster_info,
+                const Upstream::PrioritySet& priority_set, Runtime::Loader& runtime,
+                Envoy::Random::RandomGenerator& random, TimeSource& time_source) {
+  auto lb =
+      FactoryBase::create(lb_config, cluster_info, priority_set, runtime, random, time_source);
+
+  const auto typed_lb_config = dynamic_cast<const TypedLeastRequestLbConfig*>(lb_config.ptr());
+  if (typed_lb_config == nullptr || !typed_lb_config->lb_config_.has_orca_utilization()) {
+    return lb;
+  }
+
+  // The utilization hosts report is stored in their lb policy data, which must be attached on the
+  // main thread.
+  const auto& metric_names =
+      typed_lb_config->lb_config_.orca_utilization().metric_names_for_computing_utilization();
+  return std::make_unique<Upstream::LeastRequestOrcaThreadAwareLoadBalancer>(
+      std::move(lb), priority_set,
+      Orca::LrsReportMetricNames(metric_names.begin(), metric_names.end()));
+}
+
 /**
  * Static registration for the Factory. @see RegisterFactory.
  */
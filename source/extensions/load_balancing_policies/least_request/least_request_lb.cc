@@ -3,6 +3,73 @@
 namespace Envoy {
 namespace Upstream {
 
+absl::Status LeastRequestOrcaThreadAwareLoadBalancer::initialize() {
+  // Ensure that all hosts have least request lb policy data before the workers pick them.
+  for (const HostSetPtr& host_set : priority_set_.hostSetsPerPriority()) {
+    addLbPolicyDataToHosts(host_set->hosts());
+  }
+
+  priority_update_cb_ = priority_set_.addPriorityUpdateCb(
+      [this](uint32_t, const HostVector& hosts_added, const HostVector&) -> absl::Status {
+        addLbPolicyDataToHosts(hosts_added);
+        return absl::OkStatus();
+      });
+
+  return lb_->initialize();
+}
+
+void LeastRequestOrcaThreadAwareLoadBalancer::addLbPolicyDataToHosts(const HostVector& hosts) {
+  for (const auto& host : hosts) {
+    if (!host->lbPolicyData().has_value()) {
+      host->setLbPolicyData(std::make_unique<LeastRequestHostLbPolicyData>(metric_names_));
+    }
+  }
+}
+
+HostSelectionResponse LeastRequestLoadBalancer::chooseHost(LoadBalancerContext* context) {
+  if (!host_loads_refresh_interval_.has_value()) {
+    return EdfLoadBalancerBase::chooseHost(context);
+  }
+
+  host_loads_now_ = time_source_.monotonicTime();
+  HostSelectionResponse response = EdfLoadBalancerBase::chooseHost(context);
+  if (response.host != nullptr) {
+    // Account for the request this worker is about to route until the next refresh reads it
+    // from the shared counter. This is done here rather than in chooseHostOnce() so that
+    // candidates rejected by the retry host predicate are not counted.
+    auto it = host_loads_.find(response.host.get());
+    if (it != host_loads_.end()) {
+      ++it->second.active_requests_;
+    }
+  }
+  return response;
+}
+
+double LeastRequestLoadBalancer::hostLoad(const Host& host) const {
+  if (!host_loads_refresh_interval_.has_value()) {
+    return (static_cast<double>(host.stats().rq_active_.value()) + 1) * utilizationFactor(host);
+  }
+
+  // Only the sampled hosts are refreshed, so a pick never reads more shared counters than
+  // it compares.
+  HostLoad& load = host_loads_[&host];
+  if (host_loads_now_ >= load.next_refresh_) {
+    load.active_requests_ = host.stats().rq_active_.value();
+    load.utilization_factor_ = utilizationFactor(host);
+    load.next_refresh_ = host_loads_now_ + host_loads_refresh_interval_.value();
+  }
+  return (static_cast<double>(load.active_requests_) + 1) * load.utilization_factor_;
+}
+
+double LeastRequestLoadBalancer::utilizationFactor(const Host& host) const {
+  if (utilization_bias_ == 0.0) {
+    return 1.0;
+  }
+  const auto lb_policy_data = host.typedLbPolicyData<LeastRequestHostLbPolicyData>();
+  return lb_policy_data.has_value() ? 1.0 + utilization_bias_ * lb_policy_data->utilization()
+                                    : 1.0;
+}
+
 double LeastRequestLoadBalancer::hostWeight(const Host& host) const {
   // This method is called to calculate the dynamic weight as following when all load balancing
   // weights are not equal:
@@ -17,20 +84,15 @@ double LeastRequestLoadBalancer::hostWeight(const Host& host) const {
   // host weight without considering the number of active requests at the time we do the pick.
   //
   // When `active_request_bias > 0.0` we scale the host weight by the number of active
-  // requests at the time we do the pick. We always add 1 to avoid division by 0.
+  // requests at the time we do the pick. We always add 1 to avoid division by 0. The host load
+  // already includes the +1 and is computed in floating point, so it can not overflow to 0.
   //
   // It might be possible to do better by picking two hosts off of the schedule, and selecting the
   // one with fewer active requests at the time of selection.
 
   double host_weight = static_cast<double>(host.weight());
 
-  // If the value of active requests is the max value, adding +1 will overflow
-  // it and cause a divide by zero. This won't happen in normal cases but stops
-  // failing fuzz tests
-  const uint64_t active_request_value =
-      host.stats().rq_active_.value() != std::numeric_limits<uint64_t>::max()
-          ? host.stats().rq_active_.value() + 1
-          : host.stats().rq_active_.value();
+  const double active_request_value = hostLoad(host);
 
   if (active_request_bias_ == 1.0) {
     host_weight = static_cast<double>(host.weight()) / active_request_value;
@@ -89,8 +151,8 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVec
       continue;
     }
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
+    const double candidate_active_rq = hostLoad(*candidate_host);
+    const double sampled_active_rq = hostLoad(*sampled_host);
 
     if (sampled_active_rq < candidate_active_rq) {
       // Reset the count of known tied hosts.
@@ -129,8 +191,8 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVec
       continue;
     }
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
+    const double candidate_active_rq = hostLoad(*candidate_host);
+    const double sampled_active_rq = hostLoad(*sampled_host);
 
     if (sampled_active_rq < candidate_active_rq) {
       candidate_host = sampled_host;
@@ -1,10 +1,65 @@
 #pragma once
 
+#include <atomic>
+
+#include "source/common/orca/orca_load_metrics.h"
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
+/**
+ * Host LB policy data that tracks the utilization a host reports in ORCA load reports. It is
+ * attached to hosts on the main thread and read by the least request load balancers of all
+ * workers.
+ */
+class LeastRequestHostLbPolicyData : public HostLbPolicyData {
+public:
+  LeastRequestHostLbPolicyData(std::shared_ptr<const Orca::LrsReportMetricNames> metric_names)
+      : metric_names_(std::move(metric_names)) {}
+
+  // Upstream::HostLbPolicyData
+  absl::Status onOrcaLoadReport(const OrcaLoadReport& report) override {
+    utilization_.store(Orca::getUtilization(*metric_names_, report), std::memory_order_relaxed);
+    return absl::OkStatus();
+  }
+
+  double utilization() const { return utilization_.load(std::memory_order_relaxed); }
+
+private:
+  const std::shared_ptr<const Orca::LrsReportMetricNames> metric_names_;
+  std::atomic<double> utilization_{0.0};
+};
+
+/**
+ * Thread aware load balancer that attaches LeastRequestHostLbPolicyData to all hosts of the
+ * priority set on the main thread, so that the least request load balancers of the workers can
+ * bias picks by the utilization hosts report.
+ */
+class LeastRequestOrcaThreadAwareLoadBalancer : public ThreadAwareLoadBalancer {
+public:
+  LeastRequestOrcaThreadAwareLoadBalancer(ThreadAwareLoadBalancerPtr lb,
+                                          const PrioritySet& priority_set,
+                                          Orca::LrsReportMetricNames metric_names)
+      : lb_(std::move(lb)), priority_set_(priority_set),
+        metric_names_(
+            std::make_shared<const Orca::LrsReportMetricNames>(std::move(metric_names))) {}
+
+  // Upstream::ThreadAwareLoadBalancer
+  LoadBalancerFactorySharedPtr factory() override { return lb_->factory(); }
+  absl::Status initialize() override;
+
+private:
+  void addLbPolicyDataToHosts(const HostVector& hosts);
+
+  const ThreadAwareLoadBalancerPtr lb_;
+  const PrioritySet& priority_set_;
+  const std::shared_ptr<const Orca::LrsReportMetricNames> metric_names_;
+  Common::CallbackHandlePtr priority_update_cb_;
+};
+
 /**
  * Weighted Least Request load balancer.
  *
@@ -21,12 +76,20 @@ namespace Upstream {
  * 2) Use a weighted Maglev table, and perform P2C on two random hosts selected from the table.
  *    The benefit of the Maglev table is at the expense of resolution, memory usage is capped.
  *    Additionally, the Maglev table can be shared amongst all threads.
+ *
+ * Reading the active requests of a host touches a counter that every worker writes, so with
+ * `worker_local_active_requests` each worker compares hosts using a local snapshot of the
+ * counters instead. The snapshot of a host is refreshed when the host is sampled and the snapshot
+ * is older than the refresh interval, and all snapshots are dropped on membership updates. In
+ * between the worker adds the requests it routed itself. With `orca_utilization` the active
+ * requests of each host are further scaled by the utilization the host reports via ORCA.
  */
 class LeastRequestLoadBalancer : public EdfLoadBalancerBase {
 public:
   LeastRequestLoadBalancer(
-      const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterLbStats& stats,
-      Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
+      const PrioritySet& priority_set, const PrioritySet* local_priority_set,
+      DeferredCreationCompatibleClusterLbStats& stats, Runtime::Loader& runtime,
+      Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
       const envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest&
           least_request_config,
       TimeSource& time_source)
@@ -40,10 +103,25 @@ public:
                 ? absl::optional<Runtime::Double>(
                       {least_request_config.active_request_bias(), runtime})
                 : absl::nullopt),
-        selection_method_(least_request_config.selection_method()) {
+        selection_method_(least_request_config.selection_method()),
+        host_loads_refresh_interval_(
+            least_request_config.has_worker_local_active_requests()
+                ? absl::optional<std::chrono::milliseconds>(
+                      std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
+                          least_request_config.worker_local_active_requests(), refresh_interval,
+                          10)))
+                : absl::nullopt),
+        utilization_bias_(
+            least_request_config.has_orca_utilization()
+                ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(least_request_config.orca_utilization(),
+                                                  utilization_bias, 1.0)
+                : 0.0) {
     initialize();
   }
 
+  // Upstream::ZoneAwareLoadBalancerBase
+  HostSelectionResponse chooseHost(LoadBalancerContext* context) override;
+
 protected:
   void refresh(uint32_t priority) override {
     active_request_bias_ = active_request_bias_runtime_ != absl::nullopt
@@ -57,10 +135,30 @@ protected:
       active_request_bias_ = 1.0;
     }
 
+    // Membership updates may remove hosts, so the snapshots must not outlive them. They are
+    // dropped before the base class rebuilds the EDF schedulers, which reads them via
+    // hostWeight().
+    if (host_loads_refresh_interval_.has_value()) {
+      host_loads_.clear();
+      host_loads_now_ = time_source_.monotonicTime();
+    }
+
     EdfLoadBalancerBase::refresh(priority);
   }
 
 private:
+  // Worker local snapshot of the load of a host.
+  struct HostLoad {
+    uint64_t active_requests_{};
+    double utilization_factor_{1.0};
+    // A default constructed entry is refreshed when it is first read.
+    MonotonicTime next_refresh_{};
+  };
+
+  // Returns `(active_requests + 1) * utilization_factor` for the host, which is what hosts are
+  // compared by. This is never 0.
+  double hostLoad(const Host& host) const;
+  double utilizationFactor(const Host& host) const;
   void refreshHostSource(const HostsSource&) override {}
   double hostWeight(const Host& host) const override;
   HostConstSharedPtr unweightedHostPeek(const HostVector& hosts_to_use,
@@ -80,6 +178,15 @@ private:
   const absl::optional<Runtime::Double> active_request_bias_runtime_;
   const envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::SelectionMethod
       selection_method_{};
+
+  // Only set if `worker_local_active_requests` is configured.
+  const absl::optional<std::chrono::milliseconds> host_loads_refresh_interval_;
+  // Filled lazily by hostLoad(), which is also reached from the const hostWeight().
+  mutable absl::flat_hash_map<const Host*, HostLoad> host_loads_;
+  // The time of the current pick, read once per pick rather than once per sampled host.
+  MonotonicTime host_loads_now_;
+  // 0 if `orca_utilization` is not configured.
+  const double utilization_bias_;
 };
 
 } // namespace Upstream
@@ -80,7 +80,8 @@ TypedMaglevLbConfig::TypedMaglevLbConfig(const MaglevLbProto& lb_config,
       lb_config_(lb_config) {}
 
 ThreadAwareLoadBalancerBase::HashingLoadBalancerSharedPtr
-MaglevLoadBalancer::createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+MaglevLoadBalancer::createLoadBalancer(uint32_t /* priority */,
+                                       const NormalizedHostWeightVector& normalized_host_weights,
                                        double /* min_normalized_weight */,
                                        double max_normalized_weight) {
   HashingLoadBalancerSharedPtr maglev_lb =
@@ -167,14 +168,12 @@ void OriginalMaglevTable::constructImplementationInternals(
         continue;
       }
       entry.target_weight_ += max_normalized_weight;
-      uint64_t c = permutation(entry);
-      while (table_[c] != nullptr) {
-        entry.next_++;
-        c = permutation(entry);
+      while (table_[entry.next_] != nullptr) {
+        advance(entry);
       }
 
-      table_[c] = entry.host_;
-      entry.next_++;
+      table_[entry.next_] = entry.host_;
+      advance(entry);
       entry.count_++;
       table_index++;
     }
@@ -217,19 +216,17 @@ void CompactMaglevTable::constructImplementationInternals(
         continue;
       }
       entry.target_weight_ += max_normalized_weight;
-      // As we're using the compact implementation, our table size is limited to
-      // 32-bit, hence static_cast here should be safe.
-      uint32_t c = static_cast<uint32_t>(permutation(entry));
-      while (occupied[c]) {
-        entry.next_++;
-        c = static_cast<uint32_t>(permutation(entry));
+      while (occupied[entry.next_]) {
+        advance(entry);
       }
 
-      // Record the index of the given host.
+      // Record the index of the given host. As we're using the compact implementation, our table
+      // size is limited to 32-bit, hence static_cast here should be safe.
+      const uint32_t c = static_cast<uint32_t>(entry.next_);
       table_.set(c, i);
       occupied[c] = true;
 
-      entry.next_++;
+      advance(entry);
       entry.count_++;
       table_index++;
     }
@@ -292,11 +289,8 @@ HostSelectionResponse CompactMaglevTable::chooseHost(uint64_t hash, uint32_t att
   return {host_table_[index]};
 }
 
-uint64_t MaglevTable::permutation(const TableBuildEntry& entry) {
-  return (entry.offset_ + (entry.skip_ * entry.next_)) % table_size_;
-}
-
-MaglevLoadBalancer::MaglevLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& stats,
+MaglevLoadBalancer::MaglevLoadBalancer(const PrioritySet& priority_set,
+                                       DeferredCreationCompatibleClusterLbStats& stats,
                                        Stats::Scope& scope, Runtime::Loader& runtime,
                                        Random::RandomGenerator& random,
                                        uint32_t healthy_panic_threshold,
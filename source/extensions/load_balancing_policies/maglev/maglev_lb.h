@@ -75,18 +75,26 @@ public:
 protected:
   struct TableBuildEntry {
     TableBuildEntry(const HostConstSharedPtr& host, uint64_t offset, uint64_t skip, double weight)
-        : host_(host), offset_(offset), skip_(skip), weight_(weight) {}
+        : host_(host), offset_(offset), skip_(skip), weight_(weight), next_(offset) {}
 
     HostConstSharedPtr host_;
     const uint64_t offset_;
     const uint64_t skip_;
     const double weight_;
     double target_weight_{};
-    uint64_t next_{};
+    // The next slot in this host's permutation, i.e. (offset_ + skip_ * j) % table_size_ for the
+    // j-th probe. It is stepped by advance() rather than recomputed with a multiply and a modulo.
+    uint64_t next_;
     uint64_t count_{};
   };
 
-  uint64_t permutation(const TableBuildEntry& entry);
+  void advance(TableBuildEntry& entry) const {
+    // Both next_ and skip_ are below table_size_, so a single conditional subtraction suffices.
+    entry.next_ += entry.skip_;
+    if (entry.next_ >= table_size_) {
+      entry.next_ -= table_size_;
+    }
+  }
 
   /**
    * Template method for constructing the Maglev table.
@@ -167,7 +175,8 @@ private:
  */
 class MaglevLoadBalancer : public ThreadAwareLoadBalancerBase {
 public:
-  MaglevLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
+  MaglevLoadBalancer(const PrioritySet& priority_set,
+                     DeferredCreationCompatibleClusterLbStats& stats, Stats::Scope& scope,
                      Runtime::Loader& runtime, Random::RandomGenerator& random,
                      uint32_t healthy_panic_threshold, const MaglevLbProto& config,
                      HashPolicySharedPtr hash_policy);
@@ -180,7 +189,8 @@ public:
 private:
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t /* priority */,
+                     const NormalizedHostWeightVector& normalized_host_weights,
                      double /* min_normalized_weight */, double max_normalized_weight) override;
 
   Stats::ScopeSharedPtr scope_;
@@ -37,7 +37,6 @@ using ::Envoy::Random::RandomGenerator;
 using ::Envoy::Runtime::Loader;
 using ::Envoy::Server::Configuration::ServerFactoryContext;
 using ::Envoy::Upstream::ClusterInfo;
-using ::Envoy::Upstream::ClusterLbStats;
 using ::Envoy::Upstream::Host;
 using ::Envoy::Upstream::HostConstSharedPtr;
 using ::Envoy::Upstream::HostSelectionResponse;
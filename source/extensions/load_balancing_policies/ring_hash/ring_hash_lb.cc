@@ -8,13 +8,50 @@
 #include "envoy/config/cluster/v3/cluster.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
 namespace Upstream {
 
+namespace {
+
+// Computes the ring hashes of a host's virtual nodes, which are the hashes of "<hash_key>_<i>".
+class VirtualNodeHasher {
+public:
+  explicit VirtualNodeHasher(RingHashLbProto::HashFunction hash_function)
+      : hash_function_(hash_function) {}
+
+  void setHashKey(absl::string_view hash_key) {
+    buffer_.assign(hash_key.begin(), hash_key.end());
+    buffer_.emplace_back('_');
+    prefix_size_ = buffer_.size();
+  }
+
+  uint64_t hash(uint64_t i) {
+    const absl::AlphaNum i_str(i);
+    buffer_.resize(prefix_size_);
+    buffer_.insert(buffer_.end(), i_str.data(), i_str.data() + i_str.size());
+    return (hash_function_ == RingHashLbProto::MURMUR_HASH_2)
+               ? MurmurHash::murmurHash2(lastKey(), MurmurHash::STD_HASH_SEED)
+               : HashUtil::xxHash64(lastKey());
+  }
+
+  absl::string_view lastKey() const { return {buffer_.data(), buffer_.size()}; }
+
+private:
+  const RingHashLbProto::HashFunction hash_function_;
+  absl::InlinedVector<char, 196> buffer_;
+  size_t prefix_size_{};
+};
+
+} // namespace
+
 TypedRingHashLbConfig::TypedRingHashLbConfig(const CommonLbConfigProto& common_lb_config,
                                              const LegacyRingHashLbProto& lb_config) {
   LoadBalancerConfigHelper::convertHashLbConfigTo(common_lb_config, lb_config_);
@@ -41,7 +78,8 @@ TypedRingHashLbConfig::TypedRingHashLbConfig(const RingHashLbProto& lb_config,
                             creation_status),
       lb_config_(lb_config) {}
 
-RingHashLoadBalancer::RingHashLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& stats,
+RingHashLoadBalancer::RingHashLoadBalancer(const PrioritySet& priority_set,
+                                           DeferredCreationCompatibleClusterLbStats& stats,
                                            Stats::Scope& scope, Runtime::Loader& runtime,
                                            Random::RandomGenerator& random,
                                            uint32_t healthy_panic_threshold,
@@ -75,60 +113,85 @@ RingHashLoadBalancerStats RingHashLoadBalancer::generateStats(Stats::Scope& scop
   return {ALL_RING_HASH_LOAD_BALANCER_STATS(POOL_GAUGE(scope))};
 }
 
-HostSelectionResponse RingHashLoadBalancer::Ring::chooseHost(uint64_t h, uint32_t attempt) const {
-  if (ring_.empty()) {
-    return {nullptr};
+ThreadAwareLoadBalancerBase::HashingLoadBalancerSharedPtr
+RingHashLoadBalancer::createLoadBalancer(uint32_t priority,
+                                         const NormalizedHostWeightVector& normalized_host_weights,
+                                         double min_normalized_weight,
+                                         double /* max_normalized_weight */) {
+  if (rings_per_priority_.size() <= priority) {
+    rings_per_priority_.resize(priority + 1);
+  }
+  RingConstSharedPtr& previous_ring = rings_per_priority_[priority];
+  const bool incremental =
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.ring_hash_incremental_rebuild");
+  auto ring = std::make_shared<Ring>(normalized_host_weights, min_normalized_weight,
+                                     min_ring_size_, max_ring_size_, hash_function_,
+                                     use_hostname_for_hashing_, stats_,
+                                     incremental ? previous_ring.get() : nullptr);
+  previous_ring = incremental ? ring : nullptr;
+
+  if (hash_balance_factor_ == 0) {
+    return ring;
   }
 
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c (ketama_get_server)
-  // I've generally kept the variable names to make the code easier to compare.
-  // NOTE: The algorithm depends on using signed integers for lowp, midp, and highp. Do not
-  //       change them!
-  int64_t lowp = 0;
-  int64_t highp = ring_.size();
-  int64_t midp = 0;
-  while (true) {
-    midp = (lowp + highp) / 2;
-
-    if (midp == static_cast<int64_t>(ring_.size())) {
-      midp = 0;
-      break;
-    }
-
-    uint64_t midval = ring_[midp].hash_;
-    uint64_t midval1 = midp == 0 ? 0 : ring_[midp - 1].hash_;
+  return std::make_shared<BoundedLoadHashingLoadBalancer>(
+      std::move(ring), std::move(normalized_host_weights), hash_balance_factor_);
+}
 
-    if (h <= midval && h > midval1) {
-      break;
-    }
+size_t RingHashLoadBalancer::findRingIndex(const std::vector<uint32_t>& hash_high_bits,
+                                          const std::vector<uint32_t>& hash_low_bits, uint64_t h) {
+  const size_t ring_size = hash_high_bits.size();
+  ASSERT(ring_size > 0 && hash_low_bits.size() == ring_size);
 
-    if (midval < h) {
-      lowp = midp + 1;
-    } else {
-      highp = midp - 1;
-    }
+  // Select the first entry whose hash is >= h, wrapping around to the first entry if there is
+  // none. This is the entry the ketama binary search (ketama_get_server in
+  // https://github.com/RJ/ketama/blob/master/libketama/ketama.c) lands on.
+  //
+  // The search only looks at the upper halves of the hashes. It is written without data dependent
+  // branches so that the compiler emits conditional moves, which avoids mispredicting about half
+  // of the ~log2(ring_size) steps. Entries with the same upper half as h are ordered by their
+  // lower halves, so the lower halves are only consulted to skip over those.
+  const uint32_t high_bits = static_cast<uint32_t>(h >> 32);
+  const uint32_t low_bits = static_cast<uint32_t>(h);
+  const uint32_t* first = hash_high_bits.data();
+  size_t length = ring_size;
+  while (length > 1) {
+    const size_t half = length / 2;
+    first += (first[half - 1] < high_bits) ? half : 0;
+    length -= half;
+  }
+  size_t index = (first - hash_high_bits.data()) + (*first < high_bits ? 1 : 0);
+  while (index < ring_size && hash_high_bits[index] == high_bits &&
+         hash_low_bits[index] < low_bits) {
+    ++index;
+  }
+  return index == ring_size ? 0 : index;
+}
 
-    if (lowp > highp) {
-      midp = 0;
-      break;
-    }
+HostSelectionResponse RingHashLoadBalancer::Ring::chooseHost(uint64_t h, uint32_t attempt) const {
+  const size_t ring_size = host_indexes_.size();
+  if (ring_size == 0) {
+    return {nullptr};
   }
 
+  size_t index = findRingIndex(hash_high_bits_, hash_low_bits_, h);
+
   // If a retry host predicate is being applied, behave as if this host was not in the ring.
-  // Note that this does not guarantee a different host: e.g., attempt == ring_.size() or
+  // Note that this does not guarantee a different host: e.g., attempt == ring_size or
   // when the offset causes us to select the same host at another location in the ring.
   if (attempt > 0) {
-    midp = (midp + attempt) % ring_.size();
+    index = (index + attempt) % ring_size;
   }
 
-  return ring_[midp].host_;
+  return hosts_[host_indexes_[index]];
 }
 
 using HashFunction = envoy::config::cluster::v3::Cluster::RingHashLbConfig::HashFunction;
 RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_host_weights,
                                  double min_normalized_weight, uint64_t min_ring_size,
                                  uint64_t max_ring_size, HashFunction hash_function,
-                                 bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats)
+                                 bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats,
+                                 const Ring* previous_ring)
     : stats_(stats) {
   ENVOY_LOG(trace, "ring hash: building ring");
 
@@ -145,12 +208,9 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
   const double scale =
       std::min(std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
                static_cast<double>(max_ring_size));
-
-  // Reserve memory for the entire ring up front.
   const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
 
-  // Populate the hash ring by walking through the (host, weight) pairs in
+  // Determine the number of hashes for each host by walking through the (host, weight) pairs in
   // normalized_host_weights, and generating (scale * weight) hashes for each host. Since these
   // aren't necessarily whole numbers, we maintain running sums -- current_hashes and
   // target_hashes -- which allows us to populate the ring in a mostly stable way.
@@ -167,8 +227,8 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
   // For stats reporting, keep track of the minimum and maximum actual number of hashes per host.
   // Users should hopefully pay attention to these numbers and alert if min_hashes_per_host is too
   // low, since that implies an inaccurate request distribution.
-
-  absl::InlinedVector<char, 196> hash_key_buffer;
+  hosts_.reserve(normalized_host_weights.size());
+  virtual_nodes_.reserve(normalized_host_weights.size());
   double current_hashes = 0.0;
   double target_hashes = 0.0;
   uint64_t min_hashes_per_host = ring_size;
@@ -178,42 +238,39 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
     const absl::string_view key_to_hash = hashKey(host, use_hostname_for_hashing);
     ASSERT(!key_to_hash.empty());
 
-    hash_key_buffer.assign(key_to_hash.begin(), key_to_hash.end());
-    hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
-
     // As noted above: maintain current_hashes and target_hashes as running sums across the entire
-    // host set. `i` is needed only to construct the hash key, and tally min/max hashes per host.
+    // host set.
     target_hashes += scale * entry.second;
     uint64_t i = 0;
     while (current_hashes < target_hashes) {
-      const std::string i_str = absl::StrCat("", i);
-      hash_key_buffer.insert(offset_start, i_str.begin(), i_str.end());
-
-      absl::string_view hash_key(static_cast<char*>(hash_key_buffer.data()),
-                                 hash_key_buffer.size());
-
-      const uint64_t hash = (hash_function == HashFunction::RingHash_HashFunction_MURMUR_HASH_2)
-                                ? MurmurHash::murmurHash2(hash_key, MurmurHash::STD_HASH_SEED)
-                                : HashUtil::xxHash64(hash_key);
-
-      ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hash_key, hash);
-      ring_.push_back({hash, host});
       ++i;
       ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
     }
+    hosts_.push_back(host);
+    virtual_nodes_.push_back({std::string(key_to_hash), i});
     min_hashes_per_host = std::min(i, min_hashes_per_host);
     max_hashes_per_host = std::max(i, max_hashes_per_host);
   }
 
-  std::sort(ring_.begin(), ring_.end(), [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
-    return lhs.hash_ < rhs.hash_;
-  });
+  std::vector<RingEntry> ring;
+  if (previous_ring == nullptr || !buildRingFromPrevious(hash_function, *previous_ring, ring)) {
+    ring.clear();
+    ring.reserve(ring_size);
+    buildRing(hash_function, ring);
+  }
+
+  hash_high_bits_.reserve(ring.size());
+  hash_low_bits_.reserve(ring.size());
+  host_indexes_.reserve(ring.size());
+  for (const RingEntry& entry : ring) {
+    hash_high_bits_.push_back(static_cast<uint32_t>(entry.hash_ >> 32));
+    hash_low_bits_.push_back(static_cast<uint32_t>(entry.hash_));
+    host_indexes_.push_back(entry.host_index_);
+  }
   if (ENVOY_LOG_CHECK_LEVEL(trace)) {
-    for (const auto& entry : ring_) {
-      const absl::string_view key_to_hash = hashKey(entry.host_, use_hostname_for_hashing);
-      ENVOY_LOG(trace, "ring hash: host={} hash={}", key_to_hash, entry.hash_);
+    for (const RingEntry& entry : ring) {
+      ENVOY_LOG(trace, "ring hash: host={} hash={}", virtual_nodes_[entry.host_index_].hash_key_,
+                entry.hash_);
     }
   }
 
@@ -222,5 +279,114 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
   stats_.max_hashes_per_host_.set(max_hashes_per_host);
 }
 
+void RingHashLoadBalancer::Ring::buildRing(HashFunction hash_function,
+                                           std::vector<RingEntry>& ring) const {
+  VirtualNodeHasher hasher(hash_function);
+  for (uint32_t host_index = 0; host_index < virtual_nodes_.size(); ++host_index) {
+    const VirtualNodes& virtual_nodes = virtual_nodes_[host_index];
+    hasher.setHashKey(virtual_nodes.hash_key_);
+    for (uint64_t i = 0; i < virtual_nodes.count_; ++i) {
+      const uint64_t hash = hasher.hash(i);
+      ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hasher.lastKey(), hash);
+      ring.push_back({hash, host_index});
+    }
+  }
+
+  std::sort(ring.begin(), ring.end(), [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
+    return lhs.hash_ < rhs.hash_;
+  });
+}
+
+bool RingHashLoadBalancer::Ring::buildRingFromPrevious(HashFunction hash_function,
+                                                       const Ring& previous_ring,
+                                                       std::vector<RingEntry>& ring) const {
+  // A host keeps the first min(old count, new count) of its virtual nodes, as long as its hash key
+  // did not change. Everything else on the previous ring goes away and the missing virtual nodes
+  // are hashed anew. If that is a large part of the ring, a full build is just as cheap.
+  absl::flat_hash_map<const Host*, uint32_t> previous_host_indexes;
+  previous_host_indexes.reserve(previous_ring.hosts_.size());
+  for (uint32_t previous_index = 0; previous_index < previous_ring.hosts_.size();
+       ++previous_index) {
+    previous_host_indexes.emplace(previous_ring.hosts_[previous_index].get(), previous_index);
+  }
+  const size_t previous_ring_size = previous_ring.host_indexes_.size();
+  std::vector<uint32_t> new_host_indexes(previous_ring.hosts_.size(), NoHostIndex);
+  std::vector<uint64_t> kept_per_host(hosts_.size(), 0);
+  uint64_t kept = 0;
+  uint64_t added = 0;
+  for (uint32_t host_index = 0; host_index < hosts_.size(); ++host_index) {
+    const VirtualNodes& virtual_nodes = virtual_nodes_[host_index];
+    const auto it = previous_host_indexes.find(hosts_[host_index].get());
+    if (it != previous_host_indexes.end() &&
+        previous_ring.virtual_nodes_[it->second].hash_key_ == virtual_nodes.hash_key_) {
+      kept_per_host[host_index] =
+          std::min(virtual_nodes.count_, previous_ring.virtual_nodes_[it->second].count_);
+      new_host_indexes[it->second] = host_index;
+    }
+    kept += kept_per_host[host_index];
+    added += virtual_nodes.count_ - kept_per_host[host_index];
+  }
+  const uint64_t removed = previous_ring_size - kept;
+  if ((added + removed) * 2 > previous_ring_size) {
+    return false;
+  }
+
+  // Hash the virtual nodes that are new to the ring, and the ones that a surviving host lost so
+  // they can be told apart from the ones it keeps.
+  VirtualNodeHasher hasher(hash_function);
+  std::vector<RingEntry> added_entries;
+  added_entries.reserve(added);
+  std::vector<bool> shrunk_hosts(hosts_.size(), false);
+  absl::flat_hash_set<std::pair<uint32_t, uint64_t>> removed_entries;
+  for (uint32_t host_index = 0; host_index < hosts_.size(); ++host_index) {
+    const VirtualNodes& virtual_nodes = virtual_nodes_[host_index];
+    hasher.setHashKey(virtual_nodes.hash_key_);
+    for (uint64_t i = kept_per_host[host_index]; i < virtual_nodes.count_; ++i) {
+      added_entries.push_back({hasher.hash(i), host_index});
+    }
+    if (kept_per_host[host_index] == 0) {
+      continue;
+    }
+    const uint64_t previous_count =
+        previous_ring.virtual_nodes_[previous_host_indexes.at(hosts_[host_index].get())].count_;
+    for (uint64_t i = kept_per_host[host_index]; i < previous_count; ++i) {
+      removed_entries.emplace(host_index, hasher.hash(i));
+    }
+    shrunk_hosts[host_index] = previous_count > kept_per_host[host_index];
+  }
+  std::sort(added_entries.begin(), added_entries.end(),
+            [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
+              return lhs.hash_ < rhs.hash_;
+            });
+
+  // Merge the new virtual nodes into the surviving ones, which are already sorted.
+  ring.reserve(kept + added);
+  auto added_it = added_entries.begin();
+  for (size_t i = 0; i < previous_ring_size; ++i) {
+    const uint32_t host_index = new_host_indexes[previous_ring.host_indexes_[i]];
+    if (host_index == NoHostIndex || kept_per_host[host_index] == 0) {
+      continue;
+    }
+    const uint64_t hash = previous_ring.hashAt(i);
+    if (shrunk_hosts[host_index] && removed_entries.contains({host_index, hash})) {
+      continue;
+    }
+    while (added_it != added_entries.end() && added_it->hash_ < hash) {
+      ring.push_back(*added_it++);
+    }
+    ring.push_back({hash, host_index});
+  }
+  ring.insert(ring.end(), added_it, added_entries.end());
+
+  // The order of entries with equal hashes is unspecified for a full build, so only a ring of
+  // distinct hashes is guaranteed to be identical to it. Colliding hashes are vanishingly rare
+  // unless two hosts share a hash key, in which case fall back to the full build.
+  bool strictly_sorted = ring.size() == kept + added;
+  for (size_t i = 1; strictly_sorted && i < ring.size(); ++i) {
+    strictly_sorted = ring[i - 1].hash_ < ring[i].hash_;
+  }
+  return strictly_sorted;
+}
+
 } // namespace Upstream
 } // namespace Envoy
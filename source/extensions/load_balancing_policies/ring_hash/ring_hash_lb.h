@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
+#include <string>
 #include <vector>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -61,54 +64,88 @@ struct RingHashLoadBalancerStats {
  */
 class RingHashLoadBalancer : public ThreadAwareLoadBalancerBase {
 public:
-  RingHashLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
+  RingHashLoadBalancer(const PrioritySet& priority_set,
+                       DeferredCreationCompatibleClusterLbStats& stats, Stats::Scope& scope,
                        Runtime::Loader& runtime, Random::RandomGenerator& random,
                        uint32_t healthy_panic_threshold, const RingHashLbProto& config,
                        HashPolicySharedPtr hash_policy);
 
   const RingHashLoadBalancerStats& stats() const { return stats_; }
 
+  /**
+   * @return the index of the first ring entry whose hash is >= hash, or 0 if there is none.
+   * @param hash_high_bits the upper halves of the ring's hashes, sorted by full hash.
+   * @param hash_low_bits the lower halves of the ring's hashes, in the same order.
+   * @param hash the hash to look up.
+   */
+  static size_t findRingIndex(const std::vector<uint32_t>& hash_high_bits,
+                              const std::vector<uint32_t>& hash_low_bits, uint64_t hash);
+
 private:
   using HashFunction = RingHashLbProto::HashFunction;
 
+  // A virtual node of a host while a ring is being built.
   struct RingEntry {
     uint64_t hash_;
-    HostConstSharedPtr host_;
+    uint32_t host_index_;
+  };
+
+  // The hash key and number of hashes a host contributes to a ring.
+  struct VirtualNodes {
+    std::string hash_key_;
+    uint64_t count_;
   };
 
   struct Ring : public HashingLoadBalancer {
+    /**
+     * Builds the ring for the given hosts. If previous_ring is set, the ring is derived from it
+     * by only hashing the virtual nodes that were added and merging them into the surviving
+     * entries. The resulting ring is always identical to one built from scratch.
+     */
     Ring(const NormalizedHostWeightVector& normalized_host_weights, double min_normalized_weight,
          uint64_t min_ring_size, uint64_t max_ring_size, HashFunction hash_function,
-         bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats);
+         bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats,
+         const Ring* previous_ring = nullptr);
 
     // ThreadAwareLoadBalancerBase::HashingLoadBalancer
     HostSelectionResponse chooseHost(uint64_t hash, uint32_t attempt) const override;
 
-    std::vector<RingEntry> ring_;
+    uint64_t hashAt(size_t index) const {
+      return (static_cast<uint64_t>(hash_high_bits_[index]) << 32) | hash_low_bits_[index];
+    }
+
+    // The ring entries sorted by hash, stored as a struct of arrays: lookups search the densely
+    // packed upper halves of the hashes and only touch the other arrays for the selected entry.
+    // Each entry refers to its host by index into hosts_ rather than holding a reference to it.
+    std::vector<uint32_t> hash_high_bits_;
+    std::vector<uint32_t> hash_low_bits_;
+    std::vector<uint32_t> host_indexes_;
+    std::vector<HostConstSharedPtr> hosts_;
+    // Virtual nodes of every host in hosts_, used to derive the next ring from this one.
+    std::vector<VirtualNodes> virtual_nodes_;
 
     RingHashLoadBalancerStats& stats_;
+
+  private:
+    static constexpr uint32_t NoHostIndex = std::numeric_limits<uint32_t>::max();
+
+    void buildRing(HashFunction hash_function, std::vector<RingEntry>& ring) const;
+    bool buildRingFromPrevious(HashFunction hash_function, const Ring& previous_ring,
+                               std::vector<RingEntry>& ring) const;
   };
   using RingConstSharedPtr = std::shared_ptr<const Ring>;
 
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
-                     double min_normalized_weight, double /* max_normalized_weight */) override {
-    HashingLoadBalancerSharedPtr ring_hash_lb =
-        std::make_shared<Ring>(normalized_host_weights, min_normalized_weight, min_ring_size_,
-                               max_ring_size_, hash_function_, use_hostname_for_hashing_, stats_);
-    if (hash_balance_factor_ == 0) {
-      return ring_hash_lb;
-    }
-
-    return std::make_shared<BoundedLoadHashingLoadBalancer>(
-        ring_hash_lb, std::move(normalized_host_weights), hash_balance_factor_);
-  }
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
+                     double min_normalized_weight, double /* max_normalized_weight */) override;
 
   static RingHashLoadBalancerStats generateStats(Stats::Scope& scope);
 
   Stats::ScopeSharedPtr scope_;
   RingHashLoadBalancerStats stats_;
+  // The most recently built ring of each priority, used to build the next one incrementally.
+  std::vector<RingConstSharedPtr> rings_per_priority_;
 
   static const uint64_t DefaultMinRingSize = 1024;
   static const uint64_t DefaultMaxRingSize = 1024 * 1024 * 8;
@@ -28,8 +28,9 @@ public:
 class RoundRobinLoadBalancer : public EdfLoadBalancerBase {
 public:
   RoundRobinLoadBalancer(
-      const PrioritySet& priority_set, const PrioritySet* local_priority_set, ClusterLbStats& stats,
-      Runtime::Loader& runtime, Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
+      const PrioritySet& priority_set, const PrioritySet* local_priority_set,
+      DeferredCreationCompatibleClusterLbStats& stats, Runtime::Loader& runtime,
+      Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
       const envoy::extensions::load_balancing_policies::round_robin::v3::RoundRobin&
           round_robin_config,
       TimeSource& time_source)
@@ -47,7 +47,8 @@ using HostPredicate = std::function<bool(const Host&)>;
 SubsetLoadBalancer::SubsetLoadBalancer(const SubsetLoadBalancerConfig& lb_config,
                                        const Upstream::ClusterInfo& cluster_info,
                                        const PrioritySet& priority_set,
-                                       const PrioritySet* local_priority_set, ClusterLbStats& stats,
+                                       const PrioritySet* local_priority_set,
+                                       DeferredCreationCompatibleClusterLbStats& stats,
                                        Stats::Scope& scope, Runtime::Loader& runtime,
                                        Random::RandomGenerator& random, TimeSource& time_source)
     : lb_config_(lb_config), cluster_info_(cluster_info), stats_(stats), scope_(scope),
@@ -100,8 +101,8 @@ SubsetLoadBalancer::~SubsetLoadBalancer() {
   // Ensure gauges reflect correct values.
   forEachSubset(subsets_, [&](LbSubsetEntryPtr entry) {
     if (entry->active()) {
-      stats_.lb_subsets_removed_.inc();
-      stats_.lb_subsets_active_.dec();
+      stats_->lb_subsets_removed_.inc();
+      stats_->lb_subsets_active_.dec();
     }
   });
 }
@@ -289,14 +290,14 @@ HostConstSharedPtr SubsetLoadBalancer::chooseHostIteration(LoadBalancerContext*
 
   HostSelectionResponse host_response = fallback_subset_->lb_subset_->chooseHost(context);
   if (host_response.host || host_response.cancelable) {
-    stats_.lb_subsets_fallback_.inc();
+    stats_->lb_subsets_fallback_.inc();
     return host_response.host;
   }
 
   if (panic_mode_subset_ != nullptr) {
     HostSelectionResponse host_response = panic_mode_subset_->lb_subset_->chooseHost(context);
     if (host_response.host || host_response.cancelable) {
-      stats_.lb_subsets_fallback_panic_.inc();
+      stats_->lb_subsets_fallback_panic_.inc();
       return host_response.host;
     }
   }
@@ -378,7 +379,7 @@ HostConstSharedPtr SubsetLoadBalancer::tryChooseHostFromContext(LoadBalancerCont
   }
 
   host_chosen = true;
-  stats_.lb_subsets_selected_.inc();
+  stats_->lb_subsets_selected_.inc();
   return Upstream::LoadBalancer::onlyAllowSynchronousHostSelection(
       entry->lb_subset_->chooseHost(context));
 }
@@ -467,8 +468,8 @@ void SubsetLoadBalancer::initLbSubsetEntryOnce(LbSubsetEntryPtr& entry, bool sin
     entry->single_host_subset_ = false;
   }
 
-  stats_.lb_subsets_active_.inc();
-  stats_.lb_subsets_created_.inc();
+  stats_->lb_subsets_active_.inc();
+  stats_->lb_subsets_created_.inc();
 }
 
 // Iterates all the hosts of specified priority, looking up an LbSubsetEntryPtr for each and add
@@ -687,8 +688,8 @@ void SubsetLoadBalancer::purgeEmptySubsets(LbSubsetMap& subsets) {
 
       // If it wasn't initialized, it wasn't accounted for.
       if (entry->initialized()) {
-        stats_.lb_subsets_active_.dec();
-        stats_.lb_subsets_removed_.inc();
+        stats_->lb_subsets_active_.dec();
+        stats_->lb_subsets_removed_.inc();
       }
 
       auto next_it = std::next(it);
@@ -36,8 +36,9 @@ class SubsetLoadBalancer : public LoadBalancer, Logger::Loggable<Logger::Id::ups
 public:
   SubsetLoadBalancer(const SubsetLoadBalancerConfig& lb_config,
                      const Upstream::ClusterInfo& cluster_info, const PrioritySet& priority_set,
-                     const PrioritySet* local_priority_set, ClusterLbStats& stats,
-                     Stats::Scope& scope, Runtime::Loader& runtime, Random::RandomGenerator& random,
+                     const PrioritySet* local_priority_set,
+                     DeferredCreationCompatibleClusterLbStats& stats, Stats::Scope& scope,
+                     Runtime::Loader& runtime, Random::RandomGenerator& random,
                      TimeSource& time_source);
   ~SubsetLoadBalancer() override;
 
@@ -346,7 +347,7 @@ private:
 
   const SubsetLoadBalancerConfig& lb_config_;
   const Upstream::ClusterInfo& cluster_info_;
-  ClusterLbStats& stats_;
+  DeferredCreationCompatibleClusterLbStats& stats_;
   Stats::Scope& scope_;
   Runtime::Loader& runtime_;
   Random::RandomGenerator& random_;
@@ -60,6 +60,9 @@ public:
   // Stats::Sink
   void flush(Stats::MetricSnapshot& snapshot) override;
   void onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) override;
+  // statsd servers keep the last value of a gauge and sum counter deltas, so unchanged metrics
+  // need not be sent.
+  bool acceptsDeltaSnapshots() const override { return true; }
 
   bool getUseTagForTest() { return use_tag_; }
   uint64_t getBufferSizeForTest() { return buffer_size_; }
@@ -116,6 +119,9 @@ public:
   // Stats::Sink
   void flush(Stats::MetricSnapshot& snapshot) override;
   void onHistogramComplete(const Stats::Histogram& histogram, uint64_t value) override;
+  // statsd servers keep the last value of a gauge and sum counter deltas, so unchanged metrics
+  // need not be sent.
+  bool acceptsDeltaSnapshots() const override { return true; }
 
   const std::string& getPrefix() { return prefix_; }
 
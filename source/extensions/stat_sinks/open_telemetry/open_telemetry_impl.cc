@@ -1,5 +1,9 @@
 #include "source/extensions/stat_sinks/open_telemetry/open_telemetry_impl.h"
 
+#include <cmath>
+#include <limits>
+
+#include "source/common/protobuf/protobuf.h"
 #include "source/common/tracing/null_span_impl.h"
 
 namespace Envoy {
@@ -7,6 +11,54 @@ namespace Extensions {
 namespace StatSinks {
 namespace OpenTelemetry {
 
+namespace {
+
+using ExponentialBucketsProto =
+    opentelemetry::proto::metrics::v1::ExponentialHistogramDataPoint::Buckets;
+
+constexpr uint32_t DefaultExponentialHistogramMaxBuckets = 160;
+
+// Circllhist bins are at least ~1% wide, so finer scales would add buckets without adding
+// resolution. At scale 6 adjacent bucket boundaries are ~1.1% apart.
+constexpr int32_t ExponentialHistogramMaxScale = 6;
+
+// Bin counts keyed by their exponential bucket index at ExponentialHistogramMaxScale. Lowering
+// the scale by one merges pairs of buckets, i.e. shifts every index right by one.
+struct ExponentialBuckets {
+  void add(double value, uint64_t count) {
+    // Bucket i covers (2^(i/2^scale), 2^((i+1)/2^scale)].
+    const double scaled_log = std::ldexp(std::log2(value), ExponentialHistogramMaxScale);
+    const int32_t index = static_cast<int32_t>(std::ceil(scaled_log)) - 1;
+    min_index_ = std::min(min_index_, index);
+    max_index_ = std::max(max_index_, index);
+    indexed_counts_.emplace_back(index, count);
+  }
+
+  bool fits(uint32_t shift, uint32_t max_buckets) const {
+    return indexed_counts_.empty() ||
+           static_cast<uint32_t>((max_index_ >> shift) - (min_index_ >> shift)) < max_buckets;
+  }
+
+  void fill(uint32_t shift, ExponentialBucketsProto& buckets) const {
+    if (indexed_counts_.empty()) {
+      return;
+    }
+    const int32_t offset = min_index_ >> shift;
+    buckets.set_offset(offset);
+    auto* bucket_counts = buckets.mutable_bucket_counts();
+    bucket_counts->Resize((max_index_ >> shift) - offset + 1, 0);
+    for (const auto& [index, count] : indexed_counts_) {
+      *bucket_counts->Mutable((index >> shift) - offset) += count;
+    }
+  }
+
+  std::vector<std::pair<int32_t, uint64_t>> indexed_counts_;
+  int32_t min_index_{std::numeric_limits<int32_t>::max()};
+  int32_t max_index_{std::numeric_limits<int32_t>::min()};
+};
+
+} // namespace
+
 Protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue>
 generateResourceAttributes(const Tracers::OpenTelemetry::Resource& resource) {
   Protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue> resource_attributes;
@@ -27,6 +79,11 @@ OtlpOptions::OtlpOptions(const SinkConfig& sink_config,
       use_tag_extracted_name_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, use_tag_extracted_name, true)),
       stat_prefix_(!sink_config.prefix().empty() ? sink_config.prefix() + "." : ""),
+      exponential_histogram_max_buckets_(
+          sink_config.has_exponential_histogram()
+              ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config.exponential_histogram(), max_buckets,
+                                                DefaultExponentialHistogramMaxBuckets)
+              : 0),
       resource_attributes_(generateResourceAttributes(resource)) {}
 
 OpenTelemetryGrpcMetricsExporterImpl::OpenTelemetryGrpcMetricsExporterImpl(
@@ -35,8 +92,8 @@ OpenTelemetryGrpcMetricsExporterImpl::OpenTelemetryGrpcMetricsExporterImpl(
       service_method_(*Protobuf::DescriptorPool::generated_pool()->FindMethodByName(
           "opentelemetry.proto.collector.metrics.v1.MetricsService.Export")) {}
 
-void OpenTelemetryGrpcMetricsExporterImpl::send(MetricsExportRequestPtr&& export_request) {
-  client_->send(service_method_, *export_request, *this, Tracing::NullSpan::instance(),
+void OpenTelemetryGrpcMetricsExporterImpl::send(const MetricsExportRequest& export_request) {
+  client_->send(service_method_, export_request, *this, Tracing::NullSpan::instance(),
                 Http::AsyncClient::RequestOptions());
 }
 
@@ -55,15 +112,18 @@ void OpenTelemetryGrpcMetricsExporterImpl::onFailure(Grpc::Status::GrpcStatus re
   ENVOY_LOG(debug, "export failure; status: {}, message: {}", response_status, response_message);
 }
 
-MetricsExportRequestPtr OtlpMetricsFlusherImpl::flush(Stats::MetricSnapshot& snapshot) const {
-  auto request = std::make_unique<MetricsExportRequest>();
-  auto* resource_metrics = request->add_resource_metrics();
+void OtlpMetricsFlusherImpl::flush(Stats::MetricSnapshot& snapshot,
+                                   MetricsExportRequest& request) const {
+  auto* resource_metrics = request.add_resource_metrics();
   auto* scope_metrics = resource_metrics->add_scope_metrics();
   resource_metrics->mutable_resource()->mutable_attributes()->CopyFrom(
       config_->resource_attributes());
   int64_t snapshot_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
                                  snapshot.snapshotTime().time_since_epoch())
                                  .count();
+  scope_metrics->mutable_metrics()->Reserve(
+      snapshot.gauges().size() + snapshot.hostGauges().size() + snapshot.counters().size() +
+      snapshot.hostCounters().size() + snapshot.histograms().size());
 
   for (const auto& gauge : snapshot.gauges()) {
     if (predicate_(gauge)) {
@@ -88,12 +148,15 @@ MetricsExportRequestPtr OtlpMetricsFlusherImpl::flush(Stats::MetricSnapshot& sna
   }
 
   for (const auto& histogram : snapshot.histograms()) {
-    if (predicate_(histogram)) {
+    if (!predicate_(histogram)) {
+      continue;
+    }
+    if (config_->exponentialHistogramMaxBuckets() > 0) {
+      flushExponentialHistogram(*scope_metrics->add_metrics(), histogram, snapshot_time_ns);
+    } else {
       flushHistogram(*scope_metrics->add_metrics(), histogram, snapshot_time_ns);
     }
   }
-
-  return request;
 }
 
 template <class GaugeType>
@@ -157,32 +220,70 @@ void OtlpMetricsFlusherImpl::flushHistogram(opentelemetry::proto::metrics::v1::M
   data_point->add_bucket_counts(histogram_stats.outOfBoundCount());
 }
 
-template <class StatType>
-void OtlpMetricsFlusherImpl::setMetricCommon(
+void OtlpMetricsFlusherImpl::flushExponentialHistogram(
     opentelemetry::proto::metrics::v1::Metric& metric,
-    opentelemetry::proto::metrics::v1::NumberDataPoint& data_point, int64_t snapshot_time_ns,
-    const StatType& stat) const {
-  data_point.set_time_unix_nano(snapshot_time_ns);
-  // TODO(ohadvano): support ``start_time_unix_nano`` optional field
-  metric.set_name(absl::StrCat(config_->statPrefix(), config_->useTagExtractedName()
-                                                          ? stat.tagExtractedName()
-                                                          : stat.name()));
+    const Stats::ParentHistogram& parent_histogram, int64_t snapshot_time_ns) const {
+  auto* histogram = metric.mutable_exponential_histogram();
+  auto* data_point = histogram->add_data_points();
+  setMetricCommon(metric, *data_point, snapshot_time_ns, parent_histogram);
 
-  if (config_->emitTagsAsAttributes()) {
-    for (const auto& tag : stat.tags()) {
-      auto* attribute = data_point.add_attributes();
-      attribute->set_key(tag.name_);
-      attribute->mutable_value()->set_string_value(tag.value_);
+  histogram->set_aggregation_temporality(
+      config_->reportHistogramsAsDeltas()
+          ? AggregationTemporality::AGGREGATION_TEMPORALITY_DELTA
+          : AggregationTemporality::AGGREGATION_TEMPORALITY_CUMULATIVE);
+
+  const Stats::HistogramStatistics& histogram_stats = config_->reportHistogramsAsDeltas()
+                                                          ? parent_histogram.intervalStatistics()
+                                                          : parent_histogram.cumulativeStatistics();
+  data_point->set_count(histogram_stats.sampleCount());
+  data_point->set_sum(histogram_stats.sampleSum());
+
+  // The circllhist bins are used directly rather than the supported buckets, so no resolution is
+  // lost beyond placing each bin's midpoint into its exponential bucket. The bins are visited in
+  // place to avoid copying them into a vector per histogram on every flush.
+  const double scale_factor = parent_histogram.unit() == Stats::Histogram::Unit::Percent
+                                  ? 1.0 / Stats::Histogram::PercentScale
+                                  : 1.0;
+  ExponentialBuckets positive;
+  ExponentialBuckets negative;
+  uint64_t zero_count = 0;
+  const Stats::ParentHistogram::BucketFn add_bin = [&](const Stats::ParentHistogram::Bucket& bin) {
+    if (bin.count_ == 0) {
+      return;
+    }
+    // The lower bound is the edge of the bin closest to zero.
+    const double magnitude = (std::abs(bin.lower_bound_) + bin.width_ / 2) * scale_factor;
+    if (magnitude == 0) {
+      zero_count += bin.count_;
+    } else if (bin.lower_bound_ < 0) {
+      negative.add(magnitude, bin.count_);
+    } else {
+      positive.add(magnitude, bin.count_);
     }
+  };
+  if (config_->reportHistogramsAsDeltas()) {
+    parent_histogram.forEachDetailedIntervalBucket(add_bin);
+  } else {
+    parent_histogram.forEachDetailedTotalBucket(add_bin);
+  }
+
+  const uint32_t max_buckets = config_->exponentialHistogramMaxBuckets();
+  uint32_t shift = 0;
+  while (!positive.fits(shift, max_buckets) || !negative.fits(shift, max_buckets)) {
+    ++shift;
   }
+  data_point->set_scale(ExponentialHistogramMaxScale - static_cast<int32_t>(shift));
+  data_point->set_zero_count(zero_count);
+  positive.fill(shift, *data_point->mutable_positive());
+  negative.fill(shift, *data_point->mutable_negative());
 }
 
-void OtlpMetricsFlusherImpl::setMetricCommon(
-    opentelemetry::proto::metrics::v1::Metric& metric,
-    opentelemetry::proto::metrics::v1::HistogramDataPoint& data_point, int64_t snapshot_time_ns,
-    const Stats::Metric& stat) const {
+template <class DataPointType, class StatType>
+void OtlpMetricsFlusherImpl::setMetricCommon(opentelemetry::proto::metrics::v1::Metric& metric,
+                                             DataPointType& data_point, int64_t snapshot_time_ns,
+                                             const StatType& stat) const {
   data_point.set_time_unix_nano(snapshot_time_ns);
-  // TODO(ohadvano): support ``start_time_unix_nano optional`` field
+  // TODO(ohadvano): support ``start_time_unix_nano`` optional field
   metric.set_name(absl::StrCat(config_->statPrefix(), config_->useTagExtractedName()
                                                           ? stat.tagExtractedName()
                                                           : stat.name()));
@@ -196,6 +297,28 @@ void OtlpMetricsFlusherImpl::setMetricCommon(
   }
 }
 
+void OpenTelemetryGrpcSink::flush(Stats::MetricSnapshot& snapshot) {
+  size_t space_allocated;
+  {
+    Protobuf::ArenaOptions options;
+    options.initial_block = arena_block_.get();
+    options.initial_block_size = arena_block_size_;
+    Protobuf::Arena arena(options);
+    auto* request = Protobuf::Arena::Create<MetricsExportRequest>(&arena);
+    metrics_flusher_->flush(snapshot, *request);
+    // The request is serialized into the gRPC frame inside send(), so the arena can be released
+    // right after. Serialization stays on the main thread: the async client has to be driven from
+    // its dispatcher, and there is no worker pool to hand the request to.
+    metrics_exporter_->send(*request);
+    space_allocated = arena.SpaceAllocated();
+  }
+  // Grow the initial block only once the arena using the previous one has been destroyed.
+  if (space_allocated > arena_block_size_) {
+    arena_block_size_ = space_allocated;
+    arena_block_ = std::make_unique<char[]>(arena_block_size_);
+  }
+}
+
 } // namespace OpenTelemetry
 } // namespace StatSinks
 } // namespace Extensions
@@ -43,6 +43,9 @@ public:
   bool emitTagsAsAttributes() { return emit_tags_as_attributes_; }
   bool useTagExtractedName() { return use_tag_extracted_name_; }
   const std::string& statPrefix() { return stat_prefix_; }
+  // Maximum number of buckets per exponential histogram data point, or 0 if histograms are
+  // emitted with explicit bucket bounds.
+  uint32_t exponentialHistogramMaxBuckets() { return exponential_histogram_max_buckets_; }
   const Protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue>&
   resource_attributes() const {
     return resource_attributes_;
@@ -54,6 +57,7 @@ private:
   const bool emit_tags_as_attributes_;
   const bool use_tag_extracted_name_;
   const std::string stat_prefix_;
+  const uint32_t exponential_histogram_max_buckets_;
   const Protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue> resource_attributes_;
 };
 
@@ -63,11 +67,22 @@ class OtlpMetricsFlusher {
 public:
   virtual ~OtlpMetricsFlusher() = default;
 
+  /**
+   * Populates an OTLP export request from metric snapshot.
+   * @param snapshot supplies the metrics snapshot to send.
+   * @param request supplies the empty request to populate, which may be arena allocated.
+   */
+  virtual void flush(Stats::MetricSnapshot& snapshot, MetricsExportRequest& request) const PURE;
+
   /**
    * Creates an OTLP export request from metric snapshot.
    * @param snapshot supplies the metrics snapshot to send.
    */
-  virtual MetricsExportRequestPtr flush(Stats::MetricSnapshot& snapshot) const PURE;
+  MetricsExportRequestPtr flush(Stats::MetricSnapshot& snapshot) const {
+    auto request = std::make_unique<MetricsExportRequest>();
+    flush(snapshot, *request);
+    return request;
+  }
 };
 
 using OtlpMetricsFlusherSharedPtr = std::shared_ptr<OtlpMetricsFlusher>;
@@ -82,7 +97,8 @@ public:
                                              [](const auto& metric) { return metric.used(); })
       : config_(config), predicate_(predicate) {}
 
-  MetricsExportRequestPtr flush(Stats::MetricSnapshot& snapshot) const override;
+  using OtlpMetricsFlusher::flush;
+  void flush(Stats::MetricSnapshot& snapshot, MetricsExportRequest& request) const override;
 
 private:
   template <class GaugeType>
@@ -97,14 +113,14 @@ private:
                       const Stats::ParentHistogram& parent_histogram,
                       int64_t snapshot_time_ns) const;
 
-  template <class StatType>
-  void setMetricCommon(opentelemetry::proto::metrics::v1::Metric& metric,
-                       opentelemetry::proto::metrics::v1::NumberDataPoint& data_point,
-                       int64_t snapshot_time_ns, const StatType& stat) const;
+  void flushExponentialHistogram(opentelemetry::proto::metrics::v1::Metric& metric,
+                                 const Stats::ParentHistogram& parent_histogram,
+                                 int64_t snapshot_time_ns) const;
 
+  template <class DataPointType, class StatType>
   void setMetricCommon(opentelemetry::proto::metrics::v1::Metric& metric,
-                       opentelemetry::proto::metrics::v1::HistogramDataPoint& data_point,
-                       int64_t snapshot_time_ns, const Stats::Metric& stat) const;
+                       DataPointType& data_point, int64_t snapshot_time_ns,
+                       const StatType& stat) const;
 
   const OtlpOptionsSharedPtr config_;
   const std::function<bool(const Stats::Metric&)> predicate_;
@@ -115,10 +131,11 @@ public:
   ~OpenTelemetryGrpcMetricsExporter() override = default;
 
   /**
-   * Send Metrics Message.
+   * Send Metrics Message. The request is serialized before this returns, so the caller keeps
+   * ownership and may release or reuse its storage afterwards.
    * @param message supplies the metrics to send.
    */
-  virtual void send(MetricsExportRequestPtr&& metrics) PURE;
+  virtual void send(const MetricsExportRequest& metrics) PURE;
 
   // Grpc::AsyncRequestCallbacks
   void onCreateInitialMetadata(Http::RequestHeaderMap&) override {}
@@ -137,7 +154,7 @@ public:
                                        Grpc::RawAsyncClientSharedPtr raw_async_client);
 
   // OpenTelemetryGrpcMetricsExporter
-  void send(MetricsExportRequestPtr&& metrics) override;
+  void send(const MetricsExportRequest& metrics) override;
 
   // Grpc::AsyncRequestCallbacks
   void onSuccess(Grpc::ResponsePtr<MetricsExportResponse>&&, Tracing::Span&) override;
@@ -159,15 +176,18 @@ public:
       : metrics_flusher_(otlp_metrics_flusher), metrics_exporter_(grpc_metrics_exporter) {}
 
   // Stats::Sink
-  void flush(Stats::MetricSnapshot& snapshot) override {
-    metrics_exporter_->send(metrics_flusher_->flush(snapshot));
-  }
+  void flush(Stats::MetricSnapshot& snapshot) override;
 
   void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
+  bool acceptsDeltaSnapshots() const override { return true; }
 
 private:
   const OtlpMetricsFlusherSharedPtr metrics_flusher_;
   const OpenTelemetryGrpcMetricsExporterSharedPtr metrics_exporter_;
+  // Initial block of the per-flush request arena, grown to the largest request built so far so
+  // that steady-state flushes build the request without further heap allocations.
+  std::unique_ptr<char[]> arena_block_;
+  size_t arena_block_size_{0};
 };
 
 } // namespace OpenTelemetry
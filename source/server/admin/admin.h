@@ -149,6 +149,7 @@ public:
     return max_connection_duration_;
   }
   bool http1SafeMaxConnectionDuration() const override { return false; }
+  uint32_t perStreamArenaBytes() const override { return 0; }
   uint32_t maxRequestHeadersKb() const override { return max_request_headers_kb_; }
   uint32_t maxRequestHeadersCount() const override { return max_request_headers_count_; }
   std::chrono::milliseconds streamIdleTimeout() const override { return {}; }
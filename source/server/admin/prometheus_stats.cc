@@ -1,6 +1,8 @@
 #include "source/server/admin/prometheus_stats.h"
 
+#include <algorithm>
 #include <cmath>
+#include <tuple>
 
 #include "source/common/common/empty_string.h"
 #include "source/common/common/macros.h"
@@ -64,9 +66,8 @@ struct PrimitiveMetricSnapshotLessThan {
   }
 };
 
-std::string generateNumericOutput(uint64_t value, const Stats::TagVector& tags,
+std::string generateNumericOutput(uint64_t value, const std::string& formatted_tags,
                                   const std::string& prefixed_tag_extracted_name) {
-  const std::string formatted_tags = PrometheusStatsFormatter::formattedTags(tags);
   return fmt::format("{0}{{{1}}} {2}\n", prefixed_tag_extracted_name, formatted_tags, value);
 }
 
@@ -74,9 +75,9 @@ std::string generateNumericOutput(uint64_t value, const Stats::TagVector& tags,
  * Return the prometheus output for a numeric Stat (Counter or Gauge).
  */
 template <class StatType>
-std::string generateStatNumericOutput(const StatType& metric,
+std::string generateStatNumericOutput(const StatType& metric, const std::string& formatted_tags,
                                       const std::string& prefixed_tag_extracted_name) {
-  return generateNumericOutput(metric.value(), metric.tags(), prefixed_tag_extracted_name);
+  return generateNumericOutput(metric.value(), formatted_tags, prefixed_tag_extracted_name);
 }
 
 /*
@@ -87,11 +88,12 @@ std::string generateStatNumericOutput(const StatType& metric,
  * tag {"text_value":"textReadout.value"}.
  */
 std::string generateTextReadoutOutput(const Stats::TextReadout& text_readout,
+                                      const std::string& formatted_tags,
                                       const std::string& prefixed_tag_extracted_name) {
-  auto tags = text_readout.tags();
-  tags.push_back(Stats::Tag{"text_value", text_readout.value()});
-  const std::string formattedTags = PrometheusStatsFormatter::formattedTags(tags);
-  return fmt::format("{0}{{{1}}} 0\n", prefixed_tag_extracted_name, formattedTags);
+  const std::string text_value = PrometheusStatsFormatter::formattedTags(
+      {Stats::Tag{"text_value", text_readout.value()}});
+  return fmt::format("{0}{{{1}{2}{3}}} 0\n", prefixed_tag_extracted_name, formatted_tags,
+                     formatted_tags.empty() ? "" : ",", text_value);
 }
 
 /*
@@ -100,9 +102,9 @@ std::string generateTextReadoutOutput(const Stats::TextReadout& text_readout,
  * (metric_name plus all tags).
  */
 std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
+                                    const std::string& tags,
                                     const std::string& prefixed_tag_extracted_name) {
-  const std::string tags = PrometheusStatsFormatter::formattedTags(histogram.tags());
-  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
+  const std::string hist_tags = tags.empty() ? EMPTY_STRING : (tags + ",");
 
   const Stats::HistogramStatistics& stats = histogram.cumulativeStatistics();
   Stats::ConstSupportedBuckets& supported_buckets = stats.supportedBuckets();
@@ -130,6 +132,70 @@ std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
   return output;
 };
 
+// Zero-valued cluster metrics whose creation was deferred, as formatted tags keyed by
+// tag-extracted name. All lines of a metric must form a single group, so each is rendered with
+// the created metrics sharing its name where there are any.
+using UncreatedGroups = std::map<std::string, std::vector<std::string>>;
+
+void collectUncreatedMetrics(const Upstream::ClusterManager& cluster_manager,
+                             const StatsParams& params, UncreatedGroups& counters,
+                             UncreatedGroups& gauges) {
+  // Metrics which were never created were never used either.
+  if (params.used_only_) {
+    return;
+  }
+  Upstream::HostUtility::forEachUncreatedClusterMetric(
+      cluster_manager,
+      [&](Stats::PrimitiveCounterSnapshot&& metric) {
+        if (params.shouldShowMetric(metric)) {
+          counters[metric.tagExtractedName()].push_back(
+              PrometheusStatsFormatter::formattedTags(metric.tags()));
+        }
+      },
+      [&](Stats::PrimitiveGaugeSnapshot&& metric) {
+        if (params.shouldShowMetric(metric)) {
+          gauges[metric.tagExtractedName()].push_back(
+              PrometheusStatsFormatter::formattedTags(metric.tags()));
+        }
+      });
+}
+
+// Renders the uncreated metrics named `tag_extracted_name`, if any, into the group whose TYPE
+// line was just added, and drops them from `uncreated`.
+void outputUncreatedGroup(Buffer::Instance& response, UncreatedGroups& uncreated,
+                          const std::string& tag_extracted_name,
+                          const std::string& prefixed_tag_extracted_name) {
+  auto it = uncreated.find(tag_extracted_name);
+  if (it == uncreated.end()) {
+    return;
+  }
+  for (const std::string& tags : it->second) {
+    response.add(generateNumericOutput(0, tags, prefixed_tag_extracted_name));
+  }
+  uncreated.erase(it);
+}
+
+// Renders the uncreated metrics left in `uncreated`, which share no name with a created metric.
+uint64_t outputUncreatedGroups(Buffer::Instance& response, UncreatedGroups& uncreated,
+                               absl::string_view type,
+                               const Stats::CustomStatNamespaces& custom_namespaces) {
+  uint64_t result = 0;
+  for (const auto& [tag_extracted_name, tags_list] : uncreated) {
+    const absl::optional<std::string> prefixed_tag_extracted_name =
+        PrometheusStatsFormatter::metricName(tag_extracted_name, custom_namespaces);
+    if (!prefixed_tag_extracted_name.has_value()) {
+      continue;
+    }
+    ++result;
+    response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
+    for (const std::string& tags : tags_list) {
+      response.add(generateNumericOutput(0, tags, prefixed_tag_extracted_name.value()));
+    }
+  }
+  uncreated.clear();
+  return result;
+}
+
 /**
  * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
  * them by tag-extracted metric name, and then outputting them in the correct sorted order into
@@ -142,14 +208,17 @@ std::string generateHistogramOutput(const Stats::ParentHistogram& histogram,
  *        to be included in the same output.
  * @param generate_output A function which returns the output text for this metric.
  * @param type The name of the prometheus metric type for used in TYPE annotations.
+ * @param uncreated If non-null, uncreated metrics to render within the group sharing their name.
  */
 template <class StatType>
 uint64_t outputStatType(
     Buffer::Instance& response, const StatsParams& params,
     const std::vector<Stats::RefcountPtr<StatType>>& metrics,
-    const std::function<std::string(
-        const StatType& metric, const std::string& prefixed_tag_extracted_name)>& generate_output,
-    absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces) {
+    const std::function<std::string(const StatType& metric, const std::string& formatted_tags,
+                                    const std::string& prefixed_tag_extracted_name)>&
+        generate_output,
+    absl::string_view type, const Stats::CustomStatNamespaces& custom_namespaces,
+    UncreatedGroups* uncreated = nullptr) {
 
   /*
    * From
@@ -194,14 +263,18 @@ uint64_t outputStatType(
 
   auto result = groups.size();
   for (auto& group : groups) {
+    const std::string tag_extracted_name = global_symbol_table.toString(group.first);
     const absl::optional<std::string> prefixed_tag_extracted_name =
-        PrometheusStatsFormatter::metricName(global_symbol_table.toString(group.first),
-                                             custom_namespaces);
+        PrometheusStatsFormatter::metricName(tag_extracted_name, custom_namespaces);
     if (!prefixed_tag_extracted_name.has_value()) {
       --result;
       continue;
     }
     response.add(fmt::format("# TYPE {0} {1}\n", prefixed_tag_extracted_name.value(), type));
+    if (uncreated != nullptr) {
+      outputUncreatedGroup(response, *uncreated, tag_extracted_name,
+                           prefixed_tag_extracted_name.value());
+    }
 
     // Sort before producing the final output to satisfy the "preferred" ordering from the
     // prometheus spec: metrics will be sorted by their tags' textual representation, which will
@@ -209,7 +282,8 @@ uint64_t outputStatType(
     std::sort(group.second.begin(), group.second.end(), MetricLessThan());
 
     for (const auto& metric : group.second) {
-      response.add(generate_output(*metric, prefixed_tag_extracted_name.value()));
+      response.add(generate_output(*metric, PrometheusStatsFormatter::formattedTags(metric->tags()),
+                                   prefixed_tag_extracted_name.value()));
     }
   }
   return result;
@@ -269,7 +343,8 @@ uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams&
     std::sort(group.second.begin(), group.second.end(), PrimitiveMetricSnapshotLessThan());
 
     for (const auto& metric : group.second) {
-      response.add(generateNumericOutput(metric->value(), metric->tags(),
+      response.add(generateNumericOutput(metric->value(),
+                                         PrometheusStatsFormatter::formattedTags(metric->tags()),
                                          prefixed_tag_extracted_name.value()));
     }
   }
@@ -282,9 +357,9 @@ uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams&
  * (metric_name plus all tags).
  */
 std::string generateSummaryOutput(const Stats::ParentHistogram& histogram,
+                                  const std::string& tags,
                                   const std::string& prefixed_tag_extracted_name) {
-  const std::string tags = PrometheusStatsFormatter::formattedTags(histogram.tags());
-  const std::string hist_tags = histogram.tags().empty() ? EMPTY_STRING : (tags + ",");
+  const std::string hist_tags = tags.empty() ? EMPTY_STRING : (tags + ",");
 
   const Stats::HistogramStatistics& stats = histogram.intervalStatistics();
   Stats::ConstSupportedBuckets& supported_quantiles = stats.supportedQuantiles();
@@ -305,6 +380,75 @@ std::string generateSummaryOutput(const Stats::ParentHistogram& histogram,
   return output;
 };
 
+// Note: This assumes that there is no overlap in stat name between per-endpoint stats and all
+// other stats. If this is not true, then the counters/gauges for per-endpoint need to be combined
+// with the counter/gauge output so that stats can be properly grouped.
+uint64_t outputHostMetrics(const Upstream::ClusterManager& cluster_manager,
+                           Buffer::Instance& response, const StatsParams& params,
+                           const Stats::CustomStatNamespaces& custom_namespaces) {
+  std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
+  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
+  Upstream::HostUtility::forEachHostMetric(
+      cluster_manager,
+      [&](Stats::PrimitiveCounterSnapshot&& metric) {
+        host_counters.emplace_back(std::move(metric));
+      },
+      [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
+
+  return outputPrimitiveStatType(response, params, host_counters, "counter", custom_namespaces) +
+         outputPrimitiveStatType(response, params, host_gauges, "gauge", custom_namespaces);
+}
+
+/**
+ * Drops the metrics which the params exclude, and sorts the rest in the order outputStatType()
+ * renders them: by tag-extracted name, and within each tag-extracted name by full name. Unlike
+ * outputStatType(), this needs no map of groups, so the metrics can be rendered a few at a time.
+ */
+template <class StatType>
+void sortForExposition(std::vector<Stats::RefcountPtr<StatType>>& metrics,
+                       const StatsParams& params) {
+  metrics.erase(std::remove_if(metrics.begin(), metrics.end(),
+                               [&params](const Stats::RefcountPtr<StatType>& metric) {
+                                 return !params.shouldShowMetric(*metric);
+                               }),
+                metrics.end());
+  if (metrics.empty()) {
+    return;
+  }
+  const Stats::SymbolTable& symbol_table = metrics.front()->constSymbolTable();
+  std::sort(metrics.begin(), metrics.end(),
+            [&symbol_table](const Stats::RefcountPtr<StatType>& a,
+                            const Stats::RefcountPtr<StatType>& b) {
+              const Stats::StatName a_name = a->tagExtractedStatName();
+              const Stats::StatName b_name = b->tagExtractedStatName();
+              if (a_name != b_name) {
+                // Differently encoded names may still be equal, e.g. if one is dynamic.
+                if (symbol_table.lessThan(a_name, b_name)) {
+                  return true;
+                }
+                if (symbol_table.lessThan(b_name, a_name)) {
+                  return false;
+                }
+              }
+              return symbol_table.lessThan(a->statName(), b->statName());
+            });
+}
+
+/**
+ * As sortForExposition(), for per-host metrics, which carry their names as strings.
+ */
+template <class SnapshotType>
+void sortHostMetricsForExposition(std::vector<SnapshotType>& metrics, const StatsParams& params) {
+  metrics.erase(std::remove_if(metrics.begin(), metrics.end(),
+                               [&params](const SnapshotType& metric) {
+                                 return !params.shouldShowMetric(metric);
+                               }),
+                metrics.end());
+  std::sort(metrics.begin(), metrics.end(), [](const SnapshotType& a, const SnapshotType& b) {
+    return std::tie(a.tagExtractedName(), a.name()) < std::tie(b.tagExtractedName(), b.name());
+  });
+}
+
 } // namespace
 
 std::string PrometheusStatsFormatter::formattedTags(const std::vector<Stats::Tag>& tags) {
@@ -366,14 +510,22 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
     const Upstream::ClusterManager& cluster_manager, Buffer::Instance& response,
     const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces) {
 
+  UncreatedGroups uncreated_counters;
+  UncreatedGroups uncreated_gauges;
+  collectUncreatedMetrics(cluster_manager, params, uncreated_counters, uncreated_gauges);
+
   uint64_t metric_name_count = 0;
-  metric_name_count += outputStatType<Stats::Counter>(response, params, counters,
-                                                      generateStatNumericOutput<Stats::Counter>,
-                                                      "counter", custom_namespaces);
+  metric_name_count += outputStatType<Stats::Counter>(
+      response, params, counters, generateStatNumericOutput<Stats::Counter>, "counter",
+      custom_namespaces, &uncreated_counters);
+  metric_name_count +=
+      outputUncreatedGroups(response, uncreated_counters, "counter", custom_namespaces);
 
   metric_name_count += outputStatType<Stats::Gauge>(response, params, gauges,
                                                     generateStatNumericOutput<Stats::Gauge>,
-                                                    "gauge", custom_namespaces);
+                                                    "gauge", custom_namespaces, &uncreated_gauges);
+  metric_name_count +=
+      outputUncreatedGroups(response, uncreated_gauges, "gauge", custom_namespaces);
 
   // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
   metric_name_count += outputStatType<Stats::TextReadout>(
@@ -397,25 +549,248 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
     break;
   }
 
-  // Note: This assumes that there is no overlap in stat name between per-endpoint stats and all
-  // other stats. If this is not true, then the counters/gauges for per-endpoint need to be combined
-  // with the above counter/gauge calls so that stats can be properly grouped.
-  std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
-  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
-  Upstream::HostUtility::forEachHostMetric(
-      cluster_manager,
-      [&](Stats::PrimitiveCounterSnapshot&& metric) {
-        host_counters.emplace_back(std::move(metric));
-      },
-      [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
+  metric_name_count += outputHostMetrics(cluster_manager, response, params, custom_namespaces);
+  return metric_name_count;
+}
 
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_counters, "counter", custom_namespaces);
+PrometheusNameCache::PrometheusNameCache(Stats::SymbolTable& symbol_table)
+    : symbol_table_(symbol_table) {}
 
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_gauges, "gauge", custom_namespaces);
+PrometheusNameCache::~PrometheusNameCache() {
+  // Release the symbols held by all the entries.
+  evict(metric_names_, generation_ + 1);
+  evict(tag_names_, generation_ + 1);
+}
 
-  return metric_name_count;
+void PrometheusNameCache::endScrape(uint64_t generation) {
+  evict(metric_names_, generation);
+  evict(tag_names_, generation);
+}
+
+template <class Value> void PrometheusNameCache::evict(EntryMap<Value>& map, uint64_t generation) {
+  for (auto iter = map.begin(); iter != map.end();) {
+    if (iter->second.generation_ < generation) {
+      iter->second.storage_.free(symbol_table_);
+      map.erase(iter++);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+template <class Value, class ComputeFn>
+const Value& PrometheusNameCache::lookup(EntryMap<Value>& map, Stats::StatName name,
+                                         uint64_t generation, ComputeFn compute) {
+  auto iter = map.find(name);
+  if (iter == map.end()) {
+    Stats::StatNameStorage storage(name, symbol_table_);
+    const Stats::StatName key = storage.statName();
+    iter = map.emplace(key, Entry<Value>{std::move(storage), compute(), generation}).first;
+  }
+  iter->second.generation_ = std::max(iter->second.generation_, generation);
+  return iter->second.value_;
+}
+
+const absl::optional<std::string>&
+PrometheusNameCache::metricName(Stats::StatName tag_extracted_name,
+                                const Stats::CustomStatNamespaces& custom_namespaces,
+                                uint64_t generation) {
+  return lookup(metric_names_, tag_extracted_name, generation, [&]() {
+    return PrometheusStatsFormatter::metricName(symbol_table_.toString(tag_extracted_name),
+                                                custom_namespaces);
+  });
+}
+
+const std::string& PrometheusNameCache::tagName(Stats::StatName tag_name, uint64_t generation) {
+  return lookup(tag_names_, tag_name, generation,
+                [&]() { return sanitizeName(symbol_table_.toString(tag_name)); });
+}
+
+PrometheusStatsRequest::PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                                               const Upstream::ClusterManager& cluster_manager,
+                                               const Stats::CustomStatNamespaces& custom_namespaces,
+                                               PrometheusNameCacheSharedPtr name_cache)
+    : params_(params), stats_(stats), cluster_manager_(cluster_manager),
+      custom_namespaces_(custom_namespaces), name_cache_(std::move(name_cache)),
+      generation_(name_cache_->startScrape()) {}
+
+PrometheusStatsRequest::~PrometheusStatsRequest() { name_cache_->endScrape(generation_); }
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap&) {
+  startPhase();
+  return Http::Code::OK;
+}
+
+void PrometheusStatsRequest::startPhase() {
+  next_ = 0;
+  switch (phase_) {
+  case Phase::Counters:
+    stats_.forEachCounter([this](size_t size) { counters_.reserve(size); },
+                          [this](Stats::Counter& counter) { counters_.emplace_back(&counter); });
+    sortForExposition(counters_, params_);
+    collectUncreatedMetrics(cluster_manager_, params_, uncreated_counters_, uncreated_gauges_);
+    break;
+  case Phase::Gauges:
+    counters_ = std::vector<Stats::CounterSharedPtr>();
+    stats_.forEachGauge([this](size_t size) { gauges_.reserve(size); },
+                        [this](Stats::Gauge& gauge) { gauges_.emplace_back(&gauge); });
+    sortForExposition(gauges_, params_);
+    break;
+  case Phase::TextReadouts:
+    gauges_ = std::vector<Stats::GaugeSharedPtr>();
+    if (params_.prometheus_text_readouts_) {
+      stats_.forEachTextReadout(
+          [this](size_t size) { text_readouts_.reserve(size); },
+          [this](Stats::TextReadout& text_readout) { text_readouts_.emplace_back(&text_readout); });
+      sortForExposition(text_readouts_, params_);
+    }
+    break;
+  case Phase::Histograms:
+    text_readouts_ = std::vector<Stats::TextReadoutSharedPtr>();
+    stats_.forEachHistogram(
+        [this](size_t size) { histograms_.reserve(size); },
+        [this](Stats::ParentHistogram& histogram) { histograms_.emplace_back(&histogram); });
+    sortForExposition(histograms_, params_);
+    break;
+  case Phase::HostCounters:
+    histograms_ = std::vector<Stats::ParentHistogramSharedPtr>();
+    // Note: This assumes that there is no overlap in stat name between per-endpoint stats and
+    // all other stats, as for statsAsPrometheus().
+    Upstream::HostUtility::forEachHostMetric(
+        cluster_manager_,
+        [this](Stats::PrimitiveCounterSnapshot&& metric) {
+          host_counters_.emplace_back(std::move(metric));
+        },
+        [this](Stats::PrimitiveGaugeSnapshot&& metric) {
+          host_gauges_.emplace_back(std::move(metric));
+        });
+    sortHostMetricsForExposition(host_counters_, params_);
+    sortHostMetricsForExposition(host_gauges_, params_);
+    break;
+  case Phase::HostGauges:
+    host_counters_ = std::vector<Stats::PrimitiveCounterSnapshot>();
+    break;
+  case Phase::Done:
+    host_gauges_ = std::vector<Stats::PrimitiveGaugeSnapshot>();
+    break;
+  }
+}
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  // As for StatsRequest, the caller need not drain the response between calls.
+  const uint64_t limit = response.length() + chunk_size_;
+  while (response.length() < limit) {
+    bool phase_done = true;
+    switch (phase_) {
+    case Phase::Counters:
+      phase_done =
+          renderMetrics<Stats::Counter>(counters_, "counter",
+                                        generateStatNumericOutput<Stats::Counter>, response, limit,
+                                        &uncreated_counters_);
+      break;
+    case Phase::Gauges:
+      phase_done =
+          renderMetrics<Stats::Gauge>(gauges_, "gauge", generateStatNumericOutput<Stats::Gauge>,
+                                      response, limit, &uncreated_gauges_);
+      break;
+    case Phase::TextReadouts:
+      // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
+      phase_done = renderMetrics<Stats::TextReadout>(text_readouts_, "gauge",
+                                                     generateTextReadoutOutput, response, limit);
+      break;
+    case Phase::Histograms:
+      // Detailed and Disjoint are rejected by validateParams() before a request is made.
+      phase_done =
+          params_.histogram_buckets_mode_ == Utility::HistogramBucketsMode::Summary
+              ? renderMetrics<Stats::ParentHistogram>(histograms_, "summary", generateSummaryOutput,
+                                                      response, limit)
+              : renderMetrics<Stats::ParentHistogram>(histograms_, "histogram",
+                                                      generateHistogramOutput, response, limit);
+      break;
+    case Phase::HostCounters:
+      phase_done = renderHostMetrics(host_counters_, "counter", response, limit);
+      break;
+    case Phase::HostGauges:
+      phase_done = renderHostMetrics(host_gauges_, "gauge", response, limit);
+      break;
+    case Phase::Done:
+      return false;
+    }
+    if (phase_done) {
+      phase_ = static_cast<Phase>(static_cast<int>(phase_) + 1);
+      startPhase();
+    }
+  }
+  return phase_ != Phase::Done;
+}
+
+template <class StatType>
+bool PrometheusStatsRequest::renderMetrics(
+    const std::vector<Stats::RefcountPtr<StatType>>& metrics, absl::string_view type,
+    OutputFn<StatType> generate_output, Buffer::Instance& response, uint64_t limit,
+    UncreatedGroups* uncreated) {
+  for (; next_ < metrics.size(); ++next_) {
+    if (response.length() >= limit) {
+      return false;
+    }
+    const StatType& metric = *metrics[next_];
+    const Stats::StatName tag_extracted_name = metric.tagExtractedStatName();
+    if (next_ == 0 || metric.constSymbolTable().lessThan(
+                          metrics[next_ - 1]->tagExtractedStatName(), tag_extracted_name)) {
+      group_name_ = name_cache_->metricName(tag_extracted_name, custom_namespaces_, generation_);
+      if (group_name_.has_value()) {
+        response.addFragments({"# TYPE ", group_name_.value(), " ", type, "\n"});
+        if (uncreated != nullptr && !uncreated->empty()) {
+          outputUncreatedGroup(response, *uncreated,
+                               metric.constSymbolTable().toString(tag_extracted_name),
+                               group_name_.value());
+        }
+      }
+    }
+    if (group_name_.has_value()) {
+      response.add(generate_output(metric, formattedTags(metric), group_name_.value()));
+    }
+  }
+  if (uncreated != nullptr) {
+    outputUncreatedGroups(response, *uncreated, type, custom_namespaces_);
+  }
+  return true;
+}
+
+template <class SnapshotType>
+bool PrometheusStatsRequest::renderHostMetrics(const std::vector<SnapshotType>& metrics,
+                                               absl::string_view type, Buffer::Instance& response,
+                                               uint64_t limit) {
+  for (; next_ < metrics.size(); ++next_) {
+    if (response.length() >= limit) {
+      return false;
+    }
+    const SnapshotType& metric = metrics[next_];
+    if (next_ == 0 || metric.tagExtractedName() != metrics[next_ - 1].tagExtractedName()) {
+      group_name_ =
+          PrometheusStatsFormatter::metricName(metric.tagExtractedName(), custom_namespaces_);
+      if (group_name_.has_value()) {
+        response.addFragments({"# TYPE ", group_name_.value(), " ", type, "\n"});
+      }
+    }
+    if (group_name_.has_value()) {
+      response.add(generateNumericOutput(metric.value(),
+                                         PrometheusStatsFormatter::formattedTags(metric.tags()),
+                                         group_name_.value()));
+    }
+  }
+  return true;
+}
+
+std::string PrometheusStatsRequest::formattedTags(const Stats::Metric& metric) {
+  const Stats::SymbolTable& symbol_table = metric.constSymbolTable();
+  std::string tags;
+  metric.iterateTagStatNames([&](Stats::StatName name, Stats::StatName value) -> bool {
+    absl::StrAppend(&tags, tags.empty() ? "" : ",", name_cache_->tagName(name, generation_), "=\"",
+                    sanitizeValue(symbol_table.toString(value)), "\"");
+    return true;
+  });
+  return tags;
 }
 
 } // namespace Server
@@ -1,13 +1,20 @@
 #pragma once
 
+#include <map>
 #include <regex>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
+#include "envoy/stats/primitive_stats.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/stats/symbol_table.h"
 #include "source/server/admin/stats_params.h"
 
 namespace Envoy {
@@ -53,5 +60,142 @@ public:
              const Stats::CustomStatNamespaces& custom_namespace_factory);
 };
 
+/**
+ * Remembers the Prometheus form of tag-extracted metric names and of tag names between scrapes,
+ * so that each scrape need not decode and sanitize them again. Entries which a scrape did not use
+ * are dropped when that scrape ends, so the cache only holds names of live metrics.
+ *
+ * Only accessed from the main thread.
+ */
+class PrometheusNameCache {
+public:
+  explicit PrometheusNameCache(Stats::SymbolTable& symbol_table);
+  ~PrometheusNameCache();
+
+  /**
+   * Starts a scrape. Every scrape must be ended with endScrape().
+   * @return the scrape's generation, to pass to the lookup methods and endScrape().
+   */
+  uint64_t startScrape() { return ++generation_; }
+
+  /**
+   * Drops the entries not used since the given scrape started.
+   */
+  void endScrape(uint64_t generation);
+
+  /**
+   * @return the Prometheus metric name for a tag-extracted name, as computed by
+   *         PrometheusStatsFormatter::metricName(). The reference is valid until the next call.
+   */
+  const absl::optional<std::string>&
+  metricName(Stats::StatName tag_extracted_name,
+             const Stats::CustomStatNamespaces& custom_namespaces, uint64_t generation);
+
+  /**
+   * @return the sanitized Prometheus label for a tag name. The reference is valid until the next
+   *         call.
+   */
+  const std::string& tagName(Stats::StatName tag_name, uint64_t generation);
+
+  /**
+   * @return the number of cached names.
+   */
+  uint64_t size() const { return metric_names_.size() + tag_names_.size(); }
+
+private:
+  template <class Value> struct Entry {
+    Stats::StatNameStorage storage_;
+    Value value_;
+    uint64_t generation_;
+  };
+  // The keys refer to the bytes held by each entry's storage_, which don't move with the entry.
+  template <class Value> using EntryMap = Stats::StatNameHashMap<Entry<Value>>;
+
+  template <class Value, class ComputeFn>
+  const Value& lookup(EntryMap<Value>& map, Stats::StatName name, uint64_t generation,
+                      ComputeFn compute);
+  template <class Value> void evict(EntryMap<Value>& map, uint64_t generation);
+
+  Stats::SymbolTable& symbol_table_;
+  EntryMap<absl::optional<std::string>> metric_names_;
+  EntryMap<std::string> tag_names_;
+  uint64_t generation_{0};
+};
+
+using PrometheusNameCacheSharedPtr = std::shared_ptr<PrometheusNameCache>;
+
+/**
+ * Streams the stats in the Prometheus exposition format, in chunks of about chunk_size_ bytes.
+ *
+ * Each metric type is handled in turn: the metrics to show are collected and sorted by their
+ * tag-extracted name, which groups them as the exposition format requires, and the sorted metrics
+ * are then rendered a chunk at a time. The rendered output is thus never held beyond one chunk,
+ * and the metrics of only one type are held at a time.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Upstream::ClusterManager& cluster_manager,
+                         const Stats::CustomStatNamespaces& custom_namespaces,
+                         PrometheusNameCacheSharedPtr name_cache);
+  ~PrometheusStatsRequest() override;
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+private:
+  // The order of the output, which matches PrometheusStatsFormatter::statsAsPrometheus().
+  enum class Phase { Counters, Gauges, TextReadouts, Histograms, HostCounters, HostGauges, Done };
+
+  // Formatted tags of zero-valued uncreated cluster metrics, keyed by tag-extracted name.
+  using UncreatedGroups = std::map<std::string, std::vector<std::string>>;
+
+  template <class StatType>
+  using OutputFn = std::string (*)(const StatType& metric, const std::string& formatted_tags,
+                                   const std::string& prefixed_tag_extracted_name);
+
+  void startPhase();
+  // Renders metrics from next_ on until the response reaches `limit` bytes. If `uncreated` is
+  // non-null, its metrics are rendered within the group sharing their name, and the rest after
+  // all the metrics.
+  // @return true if all the metrics have been rendered.
+  template <class StatType>
+  bool renderMetrics(const std::vector<Stats::RefcountPtr<StatType>>& metrics,
+                     absl::string_view type, OutputFn<StatType> generate_output,
+                     Buffer::Instance& response, uint64_t limit,
+                     UncreatedGroups* uncreated = nullptr);
+  // As renderMetrics(), for per-host metrics.
+  template <class SnapshotType>
+  bool renderHostMetrics(const std::vector<SnapshotType>& metrics, absl::string_view type,
+                         Buffer::Instance& response, uint64_t limit);
+  std::string formattedTags(const Stats::Metric& metric);
+
+  const StatsParams params_;
+  Stats::Store& stats_;
+  const Upstream::ClusterManager& cluster_manager_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  PrometheusNameCacheSharedPtr name_cache_;
+  const uint64_t generation_;
+  Phase phase_{Phase::Counters};
+  std::vector<Stats::CounterSharedPtr> counters_;
+  std::vector<Stats::GaugeSharedPtr> gauges_;
+  std::vector<Stats::TextReadoutSharedPtr> text_readouts_;
+  std::vector<Stats::ParentHistogramSharedPtr> histograms_;
+  std::vector<Stats::PrimitiveCounterSnapshot> host_counters_;
+  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges_;
+  UncreatedGroups uncreated_counters_;
+  UncreatedGroups uncreated_gauges_;
+  size_t next_{0};
+  // The name of the group of the metric last rendered.
+  absl::optional<std::string> group_name_;
+  uint64_t chunk_size_{DefaultChunkSize};
+};
+
 } // namespace Server
 } // namespace Envoy
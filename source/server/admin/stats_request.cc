@@ -86,6 +86,7 @@ bool StatsRequest::nextChunk(Buffer::Instance& response) {
           // no stats in the phase, and then after that this function returns without the normal
           // advancing to the next phase.
           renderPerHostMetrics(response);
+          renderUncreatedClusterMetrics(response);
         }
 
         if (phase_stat_count_ == 0) {
@@ -109,6 +110,7 @@ bool StatsRequest::nextChunk(Buffer::Instance& response) {
         break;
       case Phase::CountersAndGauges:
         renderPerHostMetrics(response);
+        renderUncreatedClusterMetrics(response);
 
         phase_ = Phase::Histograms;
         phase_string_ = "Histograms";
@@ -244,6 +246,29 @@ void StatsRequest::renderPerHostMetrics(Buffer::Instance& response) {
       });
 }
 
+void StatsRequest::renderUncreatedClusterMetrics(Buffer::Instance& response) {
+  if (params_.used_only_) {
+    return;
+  }
+  // Like the per-host metrics above, these are generated in one batch rather than streamed.
+  Upstream::HostUtility::forEachUncreatedClusterMetric(
+      cluster_manager_,
+      [&](Stats::PrimitiveCounterSnapshot&& metric) {
+        if ((params_.type_ == StatsType::All || params_.type_ == StatsType::Counters) &&
+            params_.shouldShowMetric(metric)) {
+          ++phase_stat_count_;
+          render_->generate(response, metric.name(), metric.value());
+        }
+      },
+      [&](Stats::PrimitiveGaugeSnapshot&& metric) {
+        if ((params_.type_ == StatsType::All || params_.type_ == StatsType::Gauges) &&
+            params_.shouldShowMetric(metric)) {
+          ++phase_stat_count_;
+          render_->generate(response, metric.name(), metric.value());
+        }
+      });
+}
+
 template <class SharedStatType>
 void StatsRequest::renderStat(const std::string& name, Buffer::Instance& response,
                               StatOrScopes& variant) {
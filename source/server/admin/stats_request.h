@@ -95,6 +95,11 @@ public:
 
   void renderPerHostMetrics(Buffer::Instance& response);
 
+  // Renders the cluster counters and gauges whose creation was deferred and
+  // which do not exist yet as zero. These are never used, so they are skipped
+  // for ``usedonly``.
+  void renderUncreatedClusterMetrics(Buffer::Instance& response);
+
   // Renders the templatized type, exploiting the fact that Render::generate is
   // generic to avoid code duplication.
   template <class SharedStatType>
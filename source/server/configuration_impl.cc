@@ -107,6 +107,15 @@ StatsConfigImpl::StatsConfigImpl(const envoy::config::bootstrap::v3::Bootstrap&
     return;
   }
   evict_on_flush_ = evict_interval_ms / flush_interval_.count();
+
+  const auto full_flush_interval_ms =
+      PROTOBUF_GET_MS_OR_DEFAULT(bootstrap, stats_full_flush_interval, 0);
+  if (full_flush_interval_ms % flush_interval_.count() != 0) {
+    status = absl::InvalidArgumentError(
+        "stats_full_flush_interval must be a multiple of stats_flush_interval");
+    return;
+  }
+  full_flush_on_flush_ = full_flush_interval_ms / flush_interval_.count();
 }
 
 absl::Status MainImpl::initialize(const envoy::config::bootstrap::v3::Bootstrap& bootstrap,
@@ -1,5 +1,6 @@
 #include "source/server/server.h"
 
+#include <algorithm>
 #include <csignal>
 #include <cstdint>
 #include <ctime>
@@ -45,6 +46,7 @@
 #include "source/common/runtime/runtime_impl.h"
 #include "source/common/runtime/runtime_keys.h"
 #include "source/common/signal/fatal_error_handler.h"
+#include "source/common/stats/allocator_impl.h"
 #include "source/common/stats/stats_matcher_impl.h"
 #include "source/common/stats/tag_producer_impl.h"
 #include "source/common/stats/thread_local_store.h"
@@ -170,35 +172,71 @@ void InstanceBase::failHealthcheck(bool fail) {
 
 MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
                                        Upstream::ClusterManager& cluster_manager,
-                                       TimeSource& time_source) {
+                                       TimeSource& time_source, Contents contents) {
+  const bool full = contents != Contents::Delta;
+  const bool delta = contents != Contents::Full;
+  // A delta snapshot only references, and so only needs to keep alive, the metrics that changed.
   store.forEachSinkedCounter(
-      [this](std::size_t size) {
-        snapped_counters_.reserve(size);
-        counters_.reserve(size);
+      [this, full](std::size_t size) {
+        if (full) {
+          snapped_counters_.reserve(size);
+          counters_.reserve(size);
+        }
       },
-      [this](Stats::Counter& counter) {
-        snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
-        counters_.push_back({counter.latch(), counter});
+      [this, full, delta](Stats::Counter& counter) {
+        const uint64_t latched = counter.latch();
+        const bool changed = delta && latched > 0;
+        if (full || changed) {
+          snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
+        }
+        if (full) {
+          counters_.push_back({latched, counter});
+        }
+        if (changed) {
+          delta_.counters_.push_back({latched, counter});
+        }
       });
 
   store.forEachSinkedGauge(
-      [this](std::size_t size) {
-        snapped_gauges_.reserve(size);
-        gauges_.reserve(size);
+      [this, full](std::size_t size) {
+        if (full) {
+          snapped_gauges_.reserve(size);
+          gauges_.reserve(size);
+        }
       },
-      [this](Stats::Gauge& gauge) {
-        snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
-        gauges_.push_back(gauge);
+      [this, full, delta](Stats::Gauge& gauge) {
+        // Latched on every snapshot, so that a delta snapshot holds the changes since the
+        // previous snapshot whether or not that one was a delta.
+        const bool changed = gauge.latchChanged() && delta;
+        if (full || changed) {
+          snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
+        }
+        if (full) {
+          gauges_.push_back(gauge);
+        }
+        if (changed) {
+          delta_.gauges_.push_back(gauge);
+        }
       });
 
   store.forEachSinkedHistogram(
-      [this](std::size_t size) {
-        snapped_histograms_.reserve(size);
-        histograms_.reserve(size);
+      [this, full](std::size_t size) {
+        if (full) {
+          snapped_histograms_.reserve(size);
+          histograms_.reserve(size);
+        }
       },
-      [this](Stats::ParentHistogram& histogram) {
-        snapped_histograms_.push_back(Stats::ParentHistogramSharedPtr(&histogram));
-        histograms_.push_back(histogram);
+      [this, full, delta](Stats::ParentHistogram& histogram) {
+        const bool changed = delta && histogram.intervalStatistics().sampleCount() > 0;
+        if (full || changed) {
+          snapped_histograms_.push_back(Stats::ParentHistogramSharedPtr(&histogram));
+        }
+        if (full) {
+          histograms_.push_back(histogram);
+        }
+        if (changed) {
+          delta_.histograms_.push_back(histogram);
+        }
       });
 
   store.forEachSinkedTextReadout(
@@ -213,8 +251,13 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
 
   Upstream::HostUtility::forEachHostMetric(
       cluster_manager,
-      [this](Stats::PrimitiveCounterSnapshot&& metric) {
-        host_counters_.emplace_back(std::move(metric));
+      [this, full, delta](Stats::PrimitiveCounterSnapshot&& metric) {
+        if (delta && metric.delta() > 0) {
+          delta_.host_counters_.push_back(metric);
+        }
+        if (full) {
+          host_counters_.emplace_back(std::move(metric));
+        }
       },
       [this](Stats::PrimitiveGaugeSnapshot&& metric) {
         host_gauges_.emplace_back(std::move(metric));
@@ -224,14 +267,31 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
 }
 
 void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                       Upstream::ClusterManager& cm, TimeSource& time_source) {
+                                       Upstream::ClusterManager& cm, TimeSource& time_source,
+                                       bool delta_flush) {
+  const bool build_delta =
+      delta_flush && std::any_of(sinks.begin(), sinks.end(), [](const Stats::SinkPtr& sink) {
+        return sink->acceptsDeltaSnapshots();
+      });
+  // Only build the full snapshot if some sink is going to get it.
+  MetricSnapshotImpl::Contents contents = MetricSnapshotImpl::Contents::Full;
+  if (build_delta) {
+    contents = std::all_of(sinks.begin(), sinks.end(),
+                           [](const Stats::SinkPtr& sink) { return sink->acceptsDeltaSnapshots(); })
+                   ? MetricSnapshotImpl::Contents::Delta
+                   : MetricSnapshotImpl::Contents::FullAndDelta;
+  }
   // Create a snapshot and flush to all sinks.
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
-  MetricSnapshotImpl snapshot(store, cm, time_source);
+  MetricSnapshotImpl snapshot(store, cm, time_source, contents);
   for (const auto& sink : sinks) {
-    sink->flush(snapshot);
+    if (build_delta && sink->acceptsDeltaSnapshots()) {
+      sink->flush(snapshot.deltaSnapshot());
+    } else {
+      sink->flush(snapshot);
+    }
   }
 }
 
@@ -290,8 +350,14 @@ void InstanceBase::updateServerStats() {
 void InstanceBase::flushStatsInternal() {
   updateServerStats();
   auto& stats_config = config_.statsConfig();
+  // Every full_flush_on_flush-th flush, starting with the first, holds all metrics.
+  bool delta_flush = false;
+  if (const auto full_flush_on_flush = stats_config.fullFlushOnFlush(); full_flush_on_flush > 0) {
+    delta_flush = stats_full_flush_counter_ != 0;
+    stats_full_flush_counter_ = (stats_full_flush_counter_ + 1) % full_flush_on_flush;
+  }
   InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, clusterManager(),
-                                    timeSource());
+                                    timeSource(), delta_flush);
   if (const auto evict_on_flush = stats_config.evictOnFlush(); evict_on_flush > 0) {
     stats_eviction_counter_ = (stats_eviction_counter_ + 1) % evict_on_flush;
     if (stats_eviction_counter_ == 0) {
@@ -550,6 +616,22 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
       bootstrap_.stats_config(), stats_store_.symbolTable(), server_contexts_));
   stats_store_.setHistogramSettings(
       std::make_unique<Stats::HistogramSettingsImpl>(bootstrap_.stats_config(), server_contexts_));
+  stats_store_.setHistogramMergeThreads(api_->threadFactory(),
+                                        bootstrap_.stats_config().histogram_merge_threads());
+  stats_store_.setCompactNames(bootstrap_.stats_config().compact_stat_names());
+  if (bootstrap_.stats_config().sharded_counters().has_counters()) {
+    const auto& sharded_counters = bootstrap_.stats_config().sharded_counters();
+    // Only the main thread and the workers are bound to shards, so more shards would never be
+    // written but would still take a cache line in every sharded counter.
+    const uint32_t max_shards = options_.concurrency() + 1;
+    const uint32_t shards = sharded_counters.shards() > 0
+                                ? std::min(sharded_counters.shards(), max_shards)
+                                : max_shards;
+    Stats::AllocatorImpl::bindThreadToCounterShard(0);
+    stats_store_.setCounterSharding(
+        shards, std::make_unique<Stats::StatsMatcherImpl>(
+                    sharded_counters.counters(), stats_store_.symbolTable(), server_contexts_));
+  }
 
   const std::string server_stats_prefix = "server.";
   const std::string server_compilation_settings_stats_prefix = "server.compilation_settings";
@@ -132,9 +132,12 @@ public:
    * flush() on each sink.
    * @param sinks supplies the list of sinks.
    * @param store provides the store being flushed.
+   * @param delta_flush if true, sinks which accept delta snapshots are only flushed the metrics
+   *        which changed since the previous flush.
    */
   static void flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                  Upstream::ClusterManager& cm, TimeSource& time_source);
+                                  Upstream::ClusterManager& cm, TimeSource& time_source,
+                                  bool delta_flush = false);
 
   /**
    * Load a bootstrap config and perform validation.
@@ -454,6 +457,7 @@ private:
   };
 
   uint32_t stats_eviction_counter_{0};
+  uint32_t stats_full_flush_counter_{0};
 
 #ifdef ENVOY_PERFETTO
   std::unique_ptr<perfetto::TracingSession> tracing_session_{};
@@ -470,10 +474,21 @@ private:
 //                     copying and probably be a cleaner API in general.
 class MetricSnapshotImpl : public Stats::MetricSnapshot {
 public:
+  // Which metrics a snapshot collects. Every snapshot latches all counters and gauges either way.
+  enum class Contents {
+    // All metrics, served by the snapshot itself.
+    Full,
+    // Only the metrics which changed since the previous snapshot, served by deltaSnapshot(). The
+    // snapshot itself only holds the text readouts and host gauges.
+    Delta,
+    // Both of the above, for a mix of sinks.
+    FullAndDelta,
+  };
+
   // MetricSnapshotImpl captures a snapshot of metrics by latching the delta usage, and optionally
   // marking the stats as used.
   explicit MetricSnapshotImpl(Stats::Store& store, Upstream::ClusterManager& cluster_manager,
-                              TimeSource& time_source);
+                              TimeSource& time_source, Contents contents = Contents::Full);
 
   // Stats::MetricSnapshot
   const std::vector<CounterSnapshot>& counters() override { return counters_; }
@@ -492,7 +507,43 @@ public:
   const std::vector<Stats::PrimitiveGaugeSnapshot>& hostGauges() override { return host_gauges_; }
   SystemTime snapshotTime() const override { return snapshot_time_; }
 
+  // The counters with a non-zero delta, the gauges updated since the previous snapshot, and the
+  // histograms with samples in the last interval. Text readouts and host gauges have no change
+  // state, so all of them are included. Empty for Contents::Full.
+  Stats::MetricSnapshot& deltaSnapshot() { return delta_; }
+
 private:
+  class DeltaSnapshot : public Stats::MetricSnapshot {
+  public:
+    explicit DeltaSnapshot(const MetricSnapshotImpl& parent) : parent_(parent) {}
+
+    // Stats::MetricSnapshot
+    const std::vector<CounterSnapshot>& counters() override { return counters_; }
+    const std::vector<std::reference_wrapper<const Stats::Gauge>>& gauges() override {
+      return gauges_;
+    };
+    const std::vector<std::reference_wrapper<const Stats::ParentHistogram>>&
+    histograms() override {
+      return histograms_;
+    }
+    const std::vector<std::reference_wrapper<const Stats::TextReadout>>& textReadouts() override {
+      return parent_.text_readouts_;
+    }
+    const std::vector<Stats::PrimitiveCounterSnapshot>& hostCounters() override {
+      return host_counters_;
+    }
+    const std::vector<Stats::PrimitiveGaugeSnapshot>& hostGauges() override {
+      return parent_.host_gauges_;
+    }
+    SystemTime snapshotTime() const override { return parent_.snapshot_time_; }
+
+    const MetricSnapshotImpl& parent_;
+    std::vector<CounterSnapshot> counters_;
+    std::vector<std::reference_wrapper<const Stats::Gauge>> gauges_;
+    std::vector<std::reference_wrapper<const Stats::ParentHistogram>> histograms_;
+    std::vector<Stats::PrimitiveCounterSnapshot> host_counters_;
+  };
+
   std::vector<Stats::CounterSharedPtr> snapped_counters_;
   std::vector<CounterSnapshot> counters_;
   std::vector<Stats::GaugeSharedPtr> snapped_gauges_;
@@ -504,6 +555,7 @@ private:
   std::vector<Stats::PrimitiveCounterSnapshot> host_counters_;
   std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges_;
   SystemTime snapshot_time_;
+  DeltaSnapshot delta_{*this};
 };
 
 } // namespace Server
@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/common/common/arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+class Tracked {
+public:
+  Tracked(int& destroyed, std::string value) : destroyed_(destroyed), value_(std::move(value)) {}
+  ~Tracked() { ++destroyed_; }
+
+  const std::string& value() const { return value_; }
+
+private:
+  int& destroyed_;
+  const std::string value_;
+};
+
+TEST(ArenaTest, AllocationsFitInInitialBlock) {
+  Arena arena(64);
+  EXPECT_NE(nullptr, arena.allocate(16, 8));
+  EXPECT_NE(nullptr, arena.allocate(16, 8));
+  EXPECT_EQ(32U, arena.bytesAllocated());
+  EXPECT_EQ(0U, arena.overflowBlocks());
+}
+
+TEST(ArenaTest, AllocationsAreAligned) {
+  Arena arena(256);
+  arena.allocate(1, 1);
+  for (size_t alignment : {2, 4, 8, 16, 64}) {
+    void* memory = arena.allocate(3, alignment);
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(memory) % alignment) << alignment;
+  }
+}
+
+TEST(ArenaTest, OverflowAddsBlocks) {
+  Arena arena(16);
+  arena.allocate(16, 1);
+  EXPECT_EQ(0U, arena.overflowBlocks());
+  arena.allocate(1, 1);
+  EXPECT_EQ(1U, arena.overflowBlocks());
+  // Larger than any block so far.
+  char* large = static_cast<char*>(arena.allocate(1000, 1));
+  std::fill(large, large + 1000, 'a');
+  EXPECT_EQ(2U, arena.overflowBlocks());
+  EXPECT_EQ(1017U, arena.bytesAllocated());
+}
+
+TEST(ArenaTest, EmptyArenaAllocatesOnDemand) {
+  Arena arena(0);
+  EXPECT_NE(nullptr, arena.allocate(8, 8));
+  EXPECT_EQ(8U, arena.bytesAllocated());
+}
+
+TEST(ArenaTest, ArenaPtrDestroysObjects) {
+  int destroyed = 0;
+  {
+    Arena arena(32);
+    std::vector<ArenaPtr<Tracked>> objects;
+    for (int i = 0; i < 10; i++) {
+      objects.push_back(makeArenaPtr<Tracked>(&arena, destroyed, std::string(100, 'a' + i)));
+    }
+    EXPECT_GT(arena.overflowBlocks(), 0U);
+    EXPECT_EQ(std::string(100, 'c'), objects[2]->value());
+    objects.pop_back();
+    EXPECT_EQ(1, destroyed);
+  }
+  EXPECT_EQ(10, destroyed);
+}
+
+TEST(ArenaTest, ArenaPtrWithoutArenaUsesHeap) {
+  int destroyed = 0;
+  {
+    ArenaPtr<Tracked> object = makeArenaPtr<Tracked>(nullptr, destroyed, "heap");
+    EXPECT_EQ("heap", object->value());
+  }
+  EXPECT_EQ(1, destroyed);
+}
+
+} // namespace
+} // namespace Envoy
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cmath>
@@ -15,6 +16,7 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "gmock/gmock.h"
@@ -389,6 +391,23 @@ TEST(StringUtil, toUpper) {
   EXPECT_EQ(StringUtil::toUpper("X asdf aAf"), "X ASDF AAF");
 }
 
+TEST(StringUtil, toLowerInPlace) {
+  // Every byte value, so that both the block and the per-character loops see all of them.
+  std::string all_bytes;
+  for (int c = 0; c < 256; ++c) {
+    all_bytes.push_back(static_cast<char>(c));
+  }
+  std::string expected = all_bytes;
+  std::transform(expected.begin(), expected.end(), expected.begin(), absl::ascii_tolower);
+  StringUtil::toLowerInPlace(all_bytes.data(), all_bytes.size());
+  EXPECT_EQ(expected, all_bytes);
+
+  std::string mixed = "X-Forwarded-FOR";
+  StringUtil::toLowerInPlace(mixed.data(), mixed.size());
+  EXPECT_EQ("x-forwarded-for", mixed);
+  StringUtil::toLowerInPlace(nullptr, 0);
+}
+
 TEST(StringUtil, StringViewLtrim) {
   EXPECT_EQ("", StringUtil::ltrim("     "));
   EXPECT_EQ("hello \t\f\v\n\r", StringUtil::ltrim("   hello \t\f\v\n\r"));
@@ -1,3 +1,5 @@
+#include <string>
+
 #include "source/common/http/character_set_validation.h"
 
 #include "gtest/gtest.h"
@@ -33,5 +35,38 @@ TEST(CharacterSetValidationTest, Test) {
   }
 }
 
+// Places every byte value at every position of strings long enough to be checked in blocks, to
+// compare the bulk validators with their definitions one character at a time.
+TEST(CharacterSetValidationTest, BulkValidatorsCheckEveryPosition) {
+  for (unsigned c = 0; c < 256; ++c) {
+    const bool valid_value_char = c == '\t' || (c >= 0x20 && c != 0x7f);
+    const bool valid_name_char = testCharInTable(kGenericHeaderNameCharTable, static_cast<char>(c));
+    const bool valid_string_char = c != '\0' && c != '\r' && c != '\n';
+    for (size_t length : {1, 15, 16, 17, 40}) {
+      for (size_t position = 0; position < length; ++position) {
+        std::string value(length, 'a');
+        value[position] = static_cast<char>(c);
+        SCOPED_TRACE(testing::Message() << "char " << c << " at " << position << "/" << length);
+        EXPECT_EQ(valid_value_char, isValidHeaderValue(value));
+        EXPECT_EQ(valid_name_char, isValidHeaderName(value));
+        EXPECT_EQ(valid_string_char, isValidHeaderString(value));
+      }
+    }
+  }
+}
+
+TEST(CharacterSetValidationTest, BulkValidatorsAcceptEmptyStrings) {
+  EXPECT_TRUE(isValidHeaderValue(""));
+  EXPECT_TRUE(isValidHeaderName(""));
+  EXPECT_TRUE(isValidHeaderString(""));
+}
+
+TEST(CharacterSetValidationTest, HeaderNameWithUncommonTokenCharacters) {
+  EXPECT_TRUE(isValidHeaderName("x-envoy-UPSTREAM_service-time-0123456789"));
+  EXPECT_TRUE(isValidHeaderName("x-custom!#$%&'*+.^`|~-header-with-all-token-chars"));
+  EXPECT_FALSE(isValidHeaderName("x-custom!#$%&'*+.^`|~-header-with-a-space here"));
+  EXPECT_FALSE(isValidHeaderName("x-a-long-header-name-with-a-colon-after:"));
+}
+
 } // namespace Http
 } // namespace Envoy
@@ -156,6 +156,7 @@ public:
   bool http1SafeMaxConnectionDuration() const override {
     return http1_safe_max_connection_duration_;
   }
+  uint32_t perStreamArenaBytes() const override { return 0; }
   absl::optional<std::chrono::milliseconds> maxStreamDuration() const override {
     return max_stream_duration_;
   }
@@ -56,6 +56,7 @@ public:
   bool http1SafeMaxConnectionDuration() const override {
     return parent_.http1SafeMaxConnectionDuration();
   }
+  uint32_t perStreamArenaBytes() const override { return parent_.perStreamArenaBytes(); }
   uint32_t maxRequestHeadersKb() const override { return parent_.maxRequestHeadersKb(); }
   uint32_t maxRequestHeadersCount() const override { return parent_.maxRequestHeadersCount(); }
   std::chrono::milliseconds streamIdleTimeout() const override {
@@ -1,8 +1,10 @@
 #include "source/common/http/header_map_impl.h"
+#include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
 
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "benchmark/benchmark.h"
 
 namespace Envoy {
@@ -362,5 +364,57 @@ BENCHMARK(bmHeaderMapImplResponseStaticLookupHits);
 BENCHMARK(bmHeaderMapImplRequestStaticLookupMisses);
 BENCHMARK(bmHeaderMapImplResponseStaticLookupMisses);
 
+/**
+ * Builds a request with the given number of headers, shaped like typical HTTP/1 browser traffic:
+ * mixed case names and values from a few bytes to a few hundred.
+ */
+static std::vector<std::pair<std::string, std::string>> makeRequestHeaders(size_t num_headers) {
+  const std::vector<std::pair<std::string, std::string>> common = {
+      {"Host", "www.example.com"},
+      {"User-Agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+                     "Chrome/120.0.0.0 Safari/537.36"},
+      {"Accept", "text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,*/*;q=0.8"},
+      {"Accept-Language", "en-US,en;q=0.9"},
+      {"Accept-Encoding", "gzip, deflate, br"},
+      {"Cookie", "session=0123456789abcdef0123456789abcdef; theme=dark; "
+                 "tracking=aGVsbG8gd29ybGQgaGVsbG8gd29ybGQgaGVsbG8gd29ybGQ="},
+      {"X-Forwarded-For", "203.0.113.195, 70.41.3.18, 150.172.238.178"},
+      {"X-Request-Id", "7f3c2a4e-9b1d-4c8e-a6f5-2d0b8e1a9c47"},
+  };
+  std::vector<std::pair<std::string, std::string>> headers;
+  for (size_t i = 0; i < num_headers; i++) {
+    const auto& header = common[i % common.size()];
+    headers.emplace_back(absl::StrCat(header.first, i < common.size() ? "" : absl::StrCat("-", i)),
+                         header.second);
+  }
+  return headers;
+}
+
+/** Measure the speed of validating the names and values of a request's headers. */
+static void headerUtilityValidateHeaders(benchmark::State& state) {
+  const auto headers = makeRequestHeaders(state.range(0));
+  for (auto _ : state) { // NOLINT
+    bool valid = true;
+    for (const auto& header : headers) {
+      valid &= HeaderUtility::headerNameIsValid(header.first);
+      valid &= HeaderUtility::headerValueIsValid(header.second);
+    }
+    benchmark::DoNotOptimize(valid);
+  }
+}
+BENCHMARK(headerUtilityValidateHeaders)->Arg(10)->Arg(40)->Arg(100);
+
+/** Measure the speed of lower casing the names of a request's headers. */
+static void headerMapImplLowerCaseString(benchmark::State& state) {
+  const auto headers = makeRequestHeaders(state.range(0));
+  for (auto _ : state) { // NOLINT
+    for (const auto& header : headers) {
+      LowerCaseString key(header.first);
+      benchmark::DoNotOptimize(key.get().data());
+    }
+  }
+}
+BENCHMARK(headerMapImplLowerCaseString)->Arg(10)->Arg(40)->Arg(100);
+
 } // namespace Http
 } // namespace Envoy
@@ -1,8 +1,10 @@
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_error_impl.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/listen_socket_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
 
 #include "test/mocks/api/mocks.h"
 #include "test/test_common/environment.h"
@@ -10,9 +12,14 @@
 #include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#if ENVOY_ZEROCOPY_SEND
+#include <linux/errqueue.h>
+#endif
+
 using testing::_;
 using testing::Eq;
 using testing::Invoke;
@@ -297,6 +304,320 @@ TEST_P(IoSocketHandleImplTest, InterfaceNameForLoopback) {
   }
 }
 
+#if ENVOY_ZEROCOPY_SEND
+// Completes the zero-copy sends with ids in [lo, hi] through the socket error queue.
+Api::SysCallSizeResult zerocopyCompletion(msghdr* msg, uint32_t lo, uint32_t hi, bool copied) {
+  cmsghdr* cmsg = CMSG_FIRSTHDR(msg);
+  cmsg->cmsg_level = SOL_IP;
+  cmsg->cmsg_type = IP_RECVERR;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(sock_extended_err));
+  sock_extended_err err{};
+  err.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+  err.ee_code = copied ? SO_EE_CODE_ZEROCOPY_COPIED : 0;
+  err.ee_info = lo;
+  err.ee_data = hi;
+  memcpy(CMSG_DATA(cmsg), &err, sizeof(err));
+  msg->msg_controllen = cmsg->cmsg_len;
+  return {0, 0};
+}
+
+TEST(IoSocketHandleImpl, ZerocopyWritePinsDataUntilCompletion) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  auto os_calls =
+      std::make_unique<Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl>>(
+          &os_sys_calls);
+  ON_CALL(os_sys_calls, recvmsg(_, _, MSG_ERRQUEUE))
+      .WillByDefault(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+
+  IoSocketHandleImpl io_handle(42);
+  EXPECT_FALSE(io_handle.zerocopyEnabled());
+  const int enable = 1;
+  EXPECT_EQ(0, io_handle.setOption(SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)).return_value_);
+  EXPECT_TRUE(io_handle.zerocopyEnabled());
+
+  // Writes below the threshold are copied.
+  Buffer::OwnedImpl small("hello");
+  EXPECT_CALL(os_sys_calls, send(42, _, 5, 0)).WillOnce(Return(Api::SysCallSizeResult{5, 0}));
+  EXPECT_EQ(5, io_handle.write(small).return_value_);
+  EXPECT_EQ(0, small.length());
+  EXPECT_EQ(0, io_handle.pendingZerocopySends());
+
+  const std::string data(ZerocopySendConfig::DefaultSendThreshold, 'a');
+  Buffer::OwnedImpl buffer(data);
+  bool drained = false;
+  buffer.addDrainTracker([&drained]() { drained = true; });
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{static_cast<ssize_t>(data.size()), 0}));
+  EXPECT_EQ(data.size(), io_handle.write(buffer).return_value_);
+  // The data leaves the buffer immediately but stays pinned until the kernel reports completion.
+  EXPECT_EQ(0, buffer.length());
+  EXPECT_TRUE(drained);
+  EXPECT_EQ(1, io_handle.pendingZerocopySends());
+
+  EXPECT_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillOnce(Invoke([](os_fd_t, msghdr* msg, int) {
+        return zerocopyCompletion(msg, 0, 0, /*copied=*/true);
+      }))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+  Buffer::OwnedImpl empty;
+  EXPECT_EQ(0, io_handle.write(empty).return_value_);
+  EXPECT_EQ(0, io_handle.pendingZerocopySends());
+}
+
+TEST(IoSocketHandleImpl, ZerocopySendThresholdFromConfig) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  auto os_calls =
+      std::make_unique<Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl>>(
+          &os_sys_calls);
+
+  EXPECT_EQ(ZerocopySendConfig::DefaultSendThreshold,
+            IoSocketHandleImpl(42).zerocopySendThreshold());
+
+  auto config = std::make_shared<ZerocopySendConfig>();
+  config->send_threshold_ = 1024;
+  IoSocketHandleImpl io_handle(42, false, absl::nullopt, 0, config);
+  EXPECT_EQ(1024, io_handle.zerocopySendThreshold());
+
+  // SO_ZEROCOPY is passed to the kernel unchanged, which only accepts 0 or 1.
+  const int invalid = 1024;
+  EXPECT_CALL(os_sys_calls, setsockopt_(42, SOL_SOCKET, SO_ZEROCOPY, _, sizeof(int)))
+      .WillOnce(Invoke([](os_fd_t, int, int, const void* optval, socklen_t) {
+        EXPECT_EQ(1024, *static_cast<const int*>(optval));
+        return -1;
+      }));
+  EXPECT_EQ(-1, io_handle.setOption(SOL_SOCKET, SO_ZEROCOPY, &invalid, sizeof(invalid))
+                    .return_value_);
+  EXPECT_FALSE(io_handle.zerocopyEnabled());
+
+  const int enable = 1;
+  EXPECT_CALL(os_sys_calls, setsockopt_(42, SOL_SOCKET, SO_ZEROCOPY, _, sizeof(int)))
+      .WillOnce(Return(0));
+  io_handle.setOption(SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable));
+  EXPECT_TRUE(io_handle.zerocopyEnabled());
+
+  // Accepted sockets inherit both the setting and the config.
+  EXPECT_CALL(os_sys_calls, accept(42, _, _)).WillOnce(Return(Api::SysCallSocketResult{43, 0}));
+  IoHandlePtr accepted = io_handle.accept(nullptr, nullptr);
+  auto* accepted_impl = dynamic_cast<IoSocketHandleImpl*>(accepted.get());
+  ASSERT_NE(nullptr, accepted_impl);
+  EXPECT_TRUE(accepted_impl->zerocopyEnabled());
+  EXPECT_EQ(1024, accepted_impl->zerocopySendThreshold());
+
+  const int disable = 0;
+  EXPECT_CALL(os_sys_calls, setsockopt_(42, SOL_SOCKET, SO_ZEROCOPY, _, sizeof(int)))
+      .WillOnce(Return(0));
+  io_handle.setOption(SOL_SOCKET, SO_ZEROCOPY, &disable, sizeof(disable));
+  EXPECT_FALSE(io_handle.zerocopyEnabled());
+}
+
+TEST(IoSocketHandleImpl, ZerocopyPartialWrite) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  auto os_calls =
+      std::make_unique<Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl>>(
+          &os_sys_calls);
+  ON_CALL(os_sys_calls, recvmsg(_, _, MSG_ERRQUEUE))
+      .WillByDefault(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+
+  auto config = std::make_shared<ZerocopySendConfig>();
+  config->send_threshold_ = 1024;
+  IoSocketHandleImpl io_handle(42, false, absl::nullopt, 0, config);
+  const int enable = 1;
+  io_handle.setOption(SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable));
+
+  Buffer::OwnedImpl buffer(std::string(4096, 'a'));
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{1024, 0}));
+  EXPECT_EQ(1024, io_handle.write(buffer).return_value_);
+  EXPECT_EQ(3072, buffer.length());
+  EXPECT_EQ(1, io_handle.pendingZerocopySends());
+
+  // The kernel ran out of optmem: the remainder is copied, and the slice whose prefix is still in
+  // flight is handed to the pending send instead of being freed.
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, ENOBUFS}));
+  EXPECT_CALL(os_sys_calls, send(42, _, 3072, 0))
+      .WillOnce(Return(Api::SysCallSizeResult{3072, 0}));
+  EXPECT_EQ(3072, io_handle.write(buffer).return_value_);
+  EXPECT_EQ(0, buffer.length());
+  EXPECT_EQ(1, io_handle.pendingZerocopySends());
+
+  EXPECT_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillOnce(Invoke([](os_fd_t, msghdr* msg, int) {
+        return zerocopyCompletion(msg, 0, 0, /*copied=*/false);
+      }))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+  Buffer::OwnedImpl empty;
+  io_handle.write(empty);
+  EXPECT_EQ(0, io_handle.pendingZerocopySends());
+}
+
+TEST(IoSocketHandleImpl, ZerocopyCloseWithSendsInFlight) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  auto os_calls =
+      std::make_unique<Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl>>(
+          &os_sys_calls);
+  std::atomic<bool> completed{false};
+  ON_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillByDefault(Invoke([&completed](os_fd_t, msghdr* msg, int) {
+        if (completed.exchange(false)) {
+          return zerocopyCompletion(msg, 0, 0, /*copied=*/false);
+        }
+        return Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN};
+      }));
+
+  IoSocketHandleImpl io_handle(42);
+  const int enable = 1;
+  io_handle.setOption(SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable));
+
+  const std::string data(ZerocopySendConfig::DefaultSendThreshold, 'a');
+  std::atomic<bool> released{false};
+  absl::Notification done;
+  auto* fragment = new Buffer::BufferFragmentImpl(
+      data.data(), data.size(),
+      [&released, &done](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) {
+        released = true;
+        delete fragment;
+        done.Notify();
+      });
+  Buffer::OwnedImpl buffer;
+  buffer.addBufferFragment(*fragment);
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{static_cast<ssize_t>(data.size()), 0}));
+  EXPECT_EQ(data.size(), io_handle.write(buffer).return_value_);
+
+  // The socket is closed with the send still in flight: the FIN is queued behind the data, but
+  // the fd stays open and the data stays pinned until the kernel reports the completion.
+  EXPECT_CALL(os_sys_calls, shutdown(42, SHUT_WR));
+  EXPECT_CALL(os_sys_calls, close(42)).Times(0);
+  EXPECT_TRUE(io_handle.close().ok());
+  EXPECT_FALSE(io_handle.isOpen());
+  EXPECT_FALSE(done.WaitForNotificationWithTimeout(absl::Milliseconds(50)));
+  EXPECT_FALSE(released);
+  testing::Mock::VerifyAndClearExpectations(&os_sys_calls);
+
+  EXPECT_CALL(os_sys_calls, close(42));
+  completed = true;
+  done.WaitForNotification();
+  EXPECT_TRUE(released);
+}
+
+TEST(IoSocketHandleImpl, ZerocopyCompletionStats) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  auto os_calls =
+      std::make_unique<Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl>>(
+          &os_sys_calls);
+  ON_CALL(os_sys_calls, recvmsg(_, _, MSG_ERRQUEUE))
+      .WillByDefault(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+
+  Stats::IsolatedStoreImpl store;
+  Stats::Scope& scope = *store.rootScope();
+  auto config = std::make_shared<ZerocopySendConfig>();
+  config->send_threshold_ = 1024;
+  config->stats_.emplace(
+      ZerocopySendStats{ALL_ZEROCOPY_SEND_STATS(POOL_COUNTER_PREFIX(scope, "zerocopy_send."))});
+  IoSocketHandleImpl io_handle(42, false, absl::nullopt, 0, config);
+  const int enable = 1;
+  io_handle.setOption(SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable));
+
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .Times(3)
+      .WillRepeatedly(Return(Api::SysCallSizeResult{1024, 0}));
+  for (int i = 0; i < 3; ++i) {
+    Buffer::OwnedImpl buffer(std::string(1024, 'a'));
+    EXPECT_EQ(1024, io_handle.write(buffer).return_value_);
+  }
+  EXPECT_EQ(3, io_handle.pendingZerocopySends());
+
+  // The first two sends complete in one notification, the third one was copied by the kernel.
+  EXPECT_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillOnce(Invoke([](os_fd_t, msghdr* msg, int) {
+        return zerocopyCompletion(msg, 0, 1, /*copied=*/false);
+      }))
+      .WillOnce(Invoke([](os_fd_t, msghdr* msg, int) {
+        return zerocopyCompletion(msg, 2, 2, /*copied=*/true);
+      }))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+  Buffer::OwnedImpl empty;
+  io_handle.write(empty);
+  EXPECT_EQ(0, io_handle.pendingZerocopySends());
+  EXPECT_EQ(3, config->stats_->completed_.value());
+  EXPECT_EQ(1, config->stats_->copied_.value());
+}
+
+// Sends that never complete do not keep the socket open past the linger timeout.
+TEST(IoSocketHandleImpl, ZerocopyCloseResetsAfterLingerTimeout) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  auto os_calls =
+      std::make_unique<Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl>>(
+          &os_sys_calls);
+  ON_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillByDefault(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+
+  auto config = std::make_shared<ZerocopySendConfig>();
+  config->linger_timeout_ = std::chrono::milliseconds(20);
+  IoSocketHandleImpl io_handle(42, false, absl::nullopt, 0, config);
+  const int enable = 1;
+  io_handle.setOption(SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable));
+
+  Buffer::OwnedImpl buffer(std::string(ZerocopySendConfig::DefaultSendThreshold, 'a'));
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{
+          static_cast<ssize_t>(ZerocopySendConfig::DefaultSendThreshold), 0}));
+  io_handle.write(buffer);
+
+  absl::Notification closed;
+  EXPECT_CALL(os_sys_calls, shutdown(42, SHUT_WR));
+  EXPECT_CALL(os_sys_calls, setsockopt_(42, SOL_SOCKET, SO_LINGER, _, sizeof(linger)))
+      .WillOnce(Invoke([](os_fd_t, int, int, const void* optval, socklen_t) {
+        EXPECT_EQ(1, static_cast<const linger*>(optval)->l_onoff);
+        EXPECT_EQ(0, static_cast<const linger*>(optval)->l_linger);
+        return 0;
+      }));
+  EXPECT_CALL(os_sys_calls, close(42)).WillOnce(Invoke([&closed](os_fd_t) {
+    closed.Notify();
+    return Api::SysCallIntResult{0, 0};
+  }));
+  EXPECT_TRUE(io_handle.close().ok());
+  closed.WaitForNotification();
+}
+
+// Sockets closed beyond the lingering socket limit are reset right away.
+TEST(IoSocketHandleImpl, ZerocopyCloseOverLingeringSocketLimit) {
+  NiceMock<Envoy::Api::MockOsSysCalls> os_sys_calls;
+  auto os_calls =
+      std::make_unique<Envoy::TestThreadsafeSingletonInjector<Envoy::Api::OsSysCallsImpl>>(
+          &os_sys_calls);
+  ON_CALL(os_sys_calls, recvmsg(42, _, MSG_ERRQUEUE))
+      .WillByDefault(Return(Api::SysCallSizeResult{-1, SOCKET_ERROR_AGAIN}));
+
+  auto config = std::make_shared<ZerocopySendConfig>();
+  config->max_lingering_sockets_ = 0;
+  IoSocketHandleImpl io_handle(42, false, absl::nullopt, 0, config);
+  const int enable = 1;
+  io_handle.setOption(SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable));
+
+  const std::string data(ZerocopySendConfig::DefaultSendThreshold, 'a');
+  bool released = false;
+  auto* fragment = new Buffer::BufferFragmentImpl(
+      data.data(), data.size(),
+      [&released](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) {
+        released = true;
+        delete fragment;
+      });
+  Buffer::OwnedImpl buffer;
+  buffer.addBufferFragment(*fragment);
+  EXPECT_CALL(os_sys_calls, sendmsg(42, _, MSG_ZEROCOPY))
+      .WillOnce(Return(Api::SysCallSizeResult{static_cast<ssize_t>(data.size()), 0}));
+  io_handle.write(buffer);
+  EXPECT_FALSE(released);
+
+  EXPECT_CALL(os_sys_calls, setsockopt_(42, SOL_SOCKET, SO_LINGER, _, sizeof(linger)));
+  EXPECT_CALL(os_sys_calls, close(42));
+  EXPECT_TRUE(io_handle.close().ok());
+  EXPECT_TRUE(released);
+}
+#endif
+
 } // namespace
 
 // This test wrapper is a friend class of IoSocketHandleImpl, so it has access to its private and
@@ -129,6 +129,20 @@ TEST(OrcaLoadMetricsTest, AddAllReportedMetrics) {
                      Field(&LoadMetricStats::Stat::total_metric_value, DoubleEq(11))))));
 }
 
+TEST(OrcaLoadMetricsTest, GetUtilization) {
+  xds::data::orca::v3::OrcaLoadReport report;
+  report.set_cpu_utilization(0.5);
+  EXPECT_EQ(getUtilization({"named_metrics.foo"}, report), 0.5);
+
+  report.mutable_named_metrics()->insert({"foo", 0.3});
+  report.mutable_named_metrics()->insert({"bar", 0.7});
+  EXPECT_EQ(getUtilization({"named_metrics.foo"}, report), 0.3);
+  EXPECT_EQ(getUtilization({"named_metrics.foo", "named_metrics.bar"}, report), 0.7);
+
+  report.set_application_utilization(0.2);
+  EXPECT_EQ(getUtilization({"named_metrics.foo", "named_metrics.bar"}, report), 0.2);
+}
+
 } // namespace
 } // namespace Orca
 } // namespace Envoy
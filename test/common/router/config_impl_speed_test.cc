@@ -6,6 +6,7 @@
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -197,15 +198,20 @@ static RouteConfiguration genPrefixMatcherTreeRouteConfig(benchmark::State& stat
 
 /**
  * Measure the speed of doing a route match against a route table of varying sizes.
- * Why? Currently, route matching is linear in first-to-win ordering.
+ * Why? Route matching is first-to-win, which is linear in the table size unless the path index
+ * can skip the routes that cannot match.
  *
  * We construct the first `n - 1` items in the route table so they are not
  * matched by the incoming request. Only the last route will be matched.
  * We then time how long it takes for the request to be matched against the
  * last route.
  */
-static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type) {
+static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type,
+                             bool path_index = true) {
   // Setup router for benchmarking.
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.router_route_path_index", path_index ? "true" : "false"}});
   Api::ApiPtr api = Api::createApiForTest();
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
   NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
@@ -244,6 +250,22 @@ static void bmRouteTableSizeWithExactPathMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPath);
 }
 
+/**
+ * The same as bmRouteTableSizeWithPathPrefixMatch, with the route path index disabled so that
+ * every route is scanned in order.
+ */
+static void bmRouteTableSizeWithPathPrefixMatchLinearScan(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPrefix, false);
+}
+
+/**
+ * The same as bmRouteTableSizeWithExactPathMatch, with the route path index disabled so that
+ * every route is scanned in order.
+ */
+static void bmRouteTableSizeWithExactPathMatchLinearScan(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPath, false);
+}
+
 /**
  * Benchmark a route table with regex path matchers in the form of:
  * - /shelves/{shelf_id}/route_1
@@ -314,6 +336,11 @@ static void bmRouteTableSizeWithPrefixMatcherTree(benchmark::State& state) {
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+// Compare the indexed and linear lookups at 1k and 10k routes.
+BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->Arg(1000)->Arg(10000);
+BENCHMARK(bmRouteTableSizeWithPathPrefixMatchLinearScan)->Arg(1000)->Arg(10000);
+BENCHMARK(bmRouteTableSizeWithExactPathMatch)->Arg(1000)->Arg(10000);
+BENCHMARK(bmRouteTableSizeWithExactPathMatchLinearScan)->Arg(1000)->Arg(10000);
 
 BENCHMARK(bmRouteTableSizeWithExactMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithPrefixMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
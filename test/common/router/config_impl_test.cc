@@ -1216,6 +1216,97 @@ virtual_hosts:
   }
 }
 
+// Large route tables are matched through a path index. Check that the first matching route is
+// the same as with a linear scan for a mix of indexed and unindexed route kinds.
+TEST_F(RouteMatcherTest, PathIndexPreservesFirstMatch) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: www
+  domains: ["*"]
+  routes:
+  - match:
+      prefix: "/api/v1/users"
+      headers:
+      - name: x-canary
+        present_match: true
+    route: { cluster: canary }
+  - match: { safe_regex: { regex: "/api/v[0-9]+/health" } }
+    route: { cluster: health }
+  - match: { path: "/api/v1/users/me" }
+    route: { cluster: me }
+  - match: { prefix: "/API/V1/", case_sensitive: false }
+    route: { cluster: api_v1_any_case }
+  - match: { path_separated_prefix: "/api/v2" }
+    route: { cluster: api_v2 }
+  - match: { prefix: "/api" }
+    route: { cluster: api }
+  - match: { prefix: "/" }
+    route: { cluster: default }
+)EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"pad", "canary", "health", "me", "api_v1_any_case", "api_v2", "api", "default"}, {});
+
+  // Put enough never matching routes in front to get the table indexed.
+  envoy::config::route::v3::RouteConfiguration proto_config =
+      parseRouteConfigurationFromYaml(yaml);
+  auto* virtual_host = proto_config.mutable_virtual_hosts(0);
+  const auto routes = virtual_host->routes();
+  virtual_host->clear_routes();
+  for (size_t i = 0; i < VirtualHostImpl::MinRoutesForPathIndex; ++i) {
+    auto* route = virtual_host->add_routes();
+    route->mutable_match()->set_prefix(absl::StrCat("/pad/", i, "/"));
+    route->mutable_route()->set_cluster("pad");
+  }
+  for (const auto& route : routes) {
+    *virtual_host->add_routes() = route;
+  }
+
+  const std::vector<std::pair<Http::TestRequestHeaderMapImpl, std::string>> expectations = {
+      {genHeaders("www.lyft.com", "/api/v1/users", "GET"), "api_v1_any_case"},
+      {genHeaders("www.lyft.com", "/api/v1/health", "GET"), "health"},
+      {genHeaders("www.lyft.com", "/api/v1/users/me?x=1", "GET"), "me"},
+      {genHeaders("www.lyft.com", "/Api/V1/users/me", "GET"), "api_v1_any_case"},
+      {genHeaders("www.lyft.com", "/api/v2", "GET"), "api_v2"},
+      {genHeaders("www.lyft.com", "/api/v2/x#fragment", "GET"), "api_v2"},
+      {genHeaders("www.lyft.com", "/api/v2x", "GET"), "api"},
+      {genHeaders("www.lyft.com", "/pad/3/x", "GET"), "pad"},
+      {genHeaders("www.lyft.com", "/pad/3", "GET"), "default"},
+      {genHeaders("www.lyft.com", "/other", "GET"), "default"},
+  };
+
+  for (const bool indexed : {true, false}) {
+    mergeValues(
+        {{"envoy.reloadable_features.router_route_path_index", indexed ? "true" : "false"}});
+    TestConfigImpl config(proto_config, factory_context_, true, creation_status_);
+
+    for (const auto& [headers, cluster] : expectations) {
+      EXPECT_EQ(cluster, config.route(headers, 0)->routeEntry()->clusterName())
+          << headers.getPathValue() << " indexed: " << indexed;
+    }
+
+    Http::TestRequestHeaderMapImpl canary_headers =
+        genHeaders("www.lyft.com", "/api/v1/users", "GET");
+    canary_headers.addCopy("x-canary", "true");
+    EXPECT_EQ("canary", config.route(canary_headers, 0)->routeEntry()->clusterName());
+
+    // The callback sees every matching route in order, with the evaluation status of the full
+    // route list.
+    std::vector<std::string> clusters;
+    RouteConstSharedPtr accepted_route = config.route(
+        [&clusters](RouteConstSharedPtr route, RouteEvalStatus eval_status) -> RouteMatchStatus {
+          clusters.push_back(route->routeEntry()->clusterName());
+          EXPECT_EQ(clusters.back() == "default" ? RouteEvalStatus::NoMoreRoutes
+                                                 : RouteEvalStatus::HasMoreRoutes,
+                    eval_status);
+          return RouteMatchStatus::Continue;
+        },
+        canary_headers);
+    EXPECT_EQ(nullptr, accepted_route);
+    EXPECT_THAT(clusters, ElementsAre("canary", "api_v1_any_case", "api", "default"));
+  }
+}
+
 TEST_F(RouteMatcherTest, TestRoutesWithWildcardAndDefaultOnly) {
   const std::string yaml = R"EOF(
 virtual_hosts:
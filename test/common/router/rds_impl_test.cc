@@ -636,6 +636,84 @@ TEST_F(RdsImplTest, VHDSandRDSupdateTogether) {
                        ->clusterName());
 }
 
+// Virtual hosts that an update leaves unchanged are shared with the previous config.
+TEST_F(RdsImplTest, ReuseUnchangedVirtualHosts) {
+  setup();
+
+  const auto make_response = [](const std::string& version, const std::string& bar_cluster,
+                                const std::string& internal_only_header) {
+    return TestUtility::parseYaml<envoy::service::discovery::v3::DiscoveryResponse>(fmt::format(
+        R"EOF(
+version_info: "{}"
+resources:
+- "@type": type.googleapis.com/envoy.config.route.v3.RouteConfiguration
+  name: foo_route_config
+  internal_only_headers: ["{}"]
+  virtual_hosts:
+  - name: foo
+    domains: ["foo"]
+    routes:
+    - match: {{ prefix: "/" }}
+      route: {{ cluster: foo }}
+  - name: bar
+    domains: ["bar"]
+    routes:
+    - match: {{ prefix: "/" }}
+      route: {{ cluster: {} }}
+)EOF",
+        version, internal_only_header, bar_cluster));
+  };
+  const auto update = [this](const envoy::service::discovery::v3::DiscoveryResponse& response) {
+    const auto decoded_resources =
+        TestUtility::decodeResources<envoy::config::route::v3::RouteConfiguration>(response);
+    EXPECT_TRUE(
+        rds_callbacks_->onConfigUpdate(decoded_resources.refvec_, response.version_info()).ok());
+  };
+  const auto rebuilt = [this]() {
+    return scope_.counter("foo.rds.foo_route_config.virtual_host_rebuilt").value();
+  };
+  const auto reused = [this]() {
+    return scope_.counter("foo.rds.foo_route_config.virtual_host_reused").value();
+  };
+
+  EXPECT_CALL(init_watcher_, ready());
+  update(make_response("1", "bar", "x-internal"));
+  EXPECT_EQ(2UL, rebuilt());
+  EXPECT_EQ(0UL, reused());
+  const RouteConstSharedPtr foo_route =
+      route(Http::TestRequestHeaderMapImpl{{":authority", "foo"}, {":path", "/"}});
+  const RouteConstSharedPtr bar_route =
+      route(Http::TestRequestHeaderMapImpl{{":authority", "bar"}, {":path", "/"}});
+
+  // Only the changed virtual host is built again.
+  update(make_response("2", "bar2", "x-internal"));
+  EXPECT_EQ(3UL, rebuilt());
+  EXPECT_EQ(1UL, reused());
+  EXPECT_EQ(foo_route,
+            route(Http::TestRequestHeaderMapImpl{{":authority", "foo"}, {":path", "/"}}));
+  const RouteConstSharedPtr bar2_route =
+      route(Http::TestRequestHeaderMapImpl{{":authority", "bar"}, {":path", "/"}});
+  EXPECT_NE(bar_route, bar2_route);
+  EXPECT_EQ("bar2", bar2_route->routeEntry()->clusterName());
+
+  // A change outside of the virtual hosts rebuilds all of them.
+  update(make_response("3", "bar2", "x-other-internal"));
+  EXPECT_EQ(5UL, rebuilt());
+  EXPECT_EQ(1UL, reused());
+  EXPECT_NE(foo_route,
+            route(Http::TestRequestHeaderMapImpl{{":authority", "foo"}, {":path", "/"}}));
+  EXPECT_EQ(std::vector<Http::LowerCaseString>{Http::LowerCaseString("x-other-internal")},
+            rds_->configCast()->internalOnlyHeaders());
+
+  // Nothing is reused with the runtime guard disabled.
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.rds_reuse_unchanged_virtual_hosts", "false"}});
+  update(make_response("4", "bar3", "x-other-internal"));
+  EXPECT_EQ(7UL, rebuilt());
+  EXPECT_EQ(1UL, reused());
+}
+
 // Validate behavior when the config fails delivery at the subscription level.
 TEST_F(RdsImplTest, FailureSubscription) {
   InSequence s;
@@ -0,0 +1,68 @@
+#include <vector>
+
+#include "source/common/router/route_path_index.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+std::vector<uint32_t> candidates(const RoutePathIndex& index, absl::string_view path) {
+  std::vector<uint32_t> result;
+  index.forEachCandidate(path, [&result](uint32_t position) {
+    result.push_back(position);
+    return true;
+  });
+  return result;
+}
+
+TEST(RoutePathIndexTest, CandidatesInRouteOrder) {
+  RoutePathIndex index(false);
+  index.addRoute(absl::string_view("/foo/bar")); // 0
+  index.addRoute(absl::nullopt);                 // 1
+  index.addRoute(absl::string_view("/foo"));     // 2
+  index.addRoute(absl::string_view("/baz"));     // 3
+  index.addRoute(absl::string_view("/foo/bar")); // 4
+  index.addRoute(absl::nullopt);                 // 5
+  index.addRoute(absl::string_view(""));         // 6
+  EXPECT_EQ(7U, index.size());
+
+  EXPECT_THAT(candidates(index, "/foo/bar/x"), ElementsAre(0, 1, 2, 4, 5, 6));
+  EXPECT_THAT(candidates(index, "/foo/ba"), ElementsAre(1, 2, 5, 6));
+  EXPECT_THAT(candidates(index, "/baz"), ElementsAre(1, 3, 5, 6));
+  EXPECT_THAT(candidates(index, "/FOO/bar"), ElementsAre(1, 5, 6));
+  EXPECT_THAT(candidates(index, ""), ElementsAre(1, 5, 6));
+}
+
+TEST(RoutePathIndexTest, IgnoreCase) {
+  RoutePathIndex index(true);
+  index.addRoute(absl::string_view("/Foo"));
+  index.addRoute(absl::string_view("/bar"));
+
+  EXPECT_THAT(candidates(index, "/FOO/x"), ElementsAre(0));
+  EXPECT_THAT(candidates(index, "/BaR"), ElementsAre(1));
+  EXPECT_THAT(candidates(index, "/baz"), IsEmpty());
+}
+
+TEST(RoutePathIndexTest, StopsWhenCallbackReturnsFalse) {
+  RoutePathIndex index(false);
+  index.addRoute(absl::string_view("/"));
+  index.addRoute(absl::nullopt);
+  index.addRoute(absl::string_view("/a"));
+
+  std::vector<uint32_t> visited;
+  index.forEachCandidate("/a", [&visited](uint32_t position) {
+    visited.push_back(position);
+    return position < 1;
+  });
+  EXPECT_THAT(visited, ElementsAre(0, 1));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -153,6 +153,41 @@ TEST_F(VhdsTest, VhdsAddsVirtualHosts) {
       vhost, config_update_info->protobufConfigurationCast().virtual_hosts(0)));
 }
 
+// verify that virtual hosts left unchanged by an update are not built again
+TEST_F(VhdsTest, VhdsReusesUnchangedVirtualHosts) {
+  const auto route_config =
+      TestUtility::parseYaml<envoy::config::route::v3::RouteConfiguration>(default_vhds_config_);
+  RouteConfigUpdatePtr config_update_info = makeRouteConfigUpdate(route_config);
+
+  VhdsSubscriptionPtr subscription = VhdsSubscription::createVhdsSubscription(
+                                         config_update_info, factory_context_, context_, provider_)
+                                         .value();
+  const Protobuf::RepeatedPtrField<std::string> removed_resources;
+
+  const auto& added_resources_1 = buildAddedResources({buildVirtualHost("vhost1", "vhost.first")});
+  const auto decoded_resources_1 =
+      TestUtility::decodeResources<envoy::config::route::v3::VirtualHost>(added_resources_1);
+  EXPECT_TRUE(factory_context_.cluster_manager_.subscription_factory_.callbacks_
+                  ->onConfigUpdate(decoded_resources_1.refvec_, removed_resources, "1")
+                  .ok());
+  EXPECT_EQ(1UL,
+            factory_context_.store_.counter("vhds_testvhds.my_route.virtual_host_rebuilt").value());
+  EXPECT_EQ(0UL,
+            factory_context_.store_.counter("vhds_testvhds.my_route.virtual_host_reused").value());
+
+  const auto& added_resources_2 = buildAddedResources({buildVirtualHost("vhost2", "vhost.second")});
+  const auto decoded_resources_2 =
+      TestUtility::decodeResources<envoy::config::route::v3::VirtualHost>(added_resources_2);
+  EXPECT_TRUE(factory_context_.cluster_manager_.subscription_factory_.callbacks_
+                  ->onConfigUpdate(decoded_resources_2.refvec_, removed_resources, "2")
+                  .ok());
+  EXPECT_EQ(2UL, config_update_info->protobufConfigurationCast().virtual_hosts_size());
+  EXPECT_EQ(2UL,
+            factory_context_.store_.counter("vhds_testvhds.my_route.virtual_host_rebuilt").value());
+  EXPECT_EQ(1UL,
+            factory_context_.store_.counter("vhds_testvhds.my_route.virtual_host_reused").value());
+}
+
 // verify that an RDS update of virtual hosts leaves VHDS virtual hosts intact
 TEST_F(VhdsTest, RdsUpdatesVirtualHosts) {
   const auto route_config =
@@ -0,0 +1,68 @@
+// Note: this should be run with --compilation_mode=opt, and on a machine with at least as many
+// cores as the largest thread count, since it measures contention between cores.
+//
+// Measures counter increments made by several threads at once to the same counter, kept either in
+// one atomic or in per-thread shards.
+
+#include <memory>
+
+#include "source/common/common/assert.h"
+#include "source/common/stats/allocator_impl.h"
+#include "source/common/stats/stats_matcher_impl.h"
+#include "source/common/stats/symbol_table.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Stats {
+namespace {
+
+constexpr uint32_t MaxThreads = 32;
+
+class CounterContention {
+public:
+  CounterContention() : pool_(symbol_table_), alloc_(symbol_table_) {
+    atomic_ = alloc_.makeCounter(pool_.add("atomic"), StatName(), {});
+    alloc_.setCounterSharding(MaxThreads, std::make_unique<StatsMatcherImpl>());
+    sharded_ = alloc_.makeCounter(pool_.add("sharded"), StatName(), {});
+  }
+
+  Counter& counter(bool sharded) { return sharded ? *sharded_ : *atomic_; }
+
+private:
+  SymbolTableImpl symbol_table_;
+  StatNamePool pool_;
+  AllocatorImpl alloc_;
+  CounterSharedPtr atomic_;
+  CounterSharedPtr sharded_;
+};
+
+CounterContention& counterContention() {
+  static CounterContention* contention = new CounterContention;
+  return *contention;
+}
+
+void incrementCounter(benchmark::State& state, bool sharded) {
+  Counter& counter = counterContention().counter(sharded);
+  // Bind each thread to a shard as the server binds its workers.
+  AllocatorImpl::bindThreadToCounterShard(state.thread_index());
+  for (auto _ : state) { // NOLINT
+    counter.inc();
+  }
+  if (state.thread_index() == 0) {
+    // Keep the reads of the counter in the benchmark, as a flush would make them.
+    RELEASE_ASSERT(counter.value() > 0, "");
+  }
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_AtomicCounterInc(benchmark::State& state) { incrementCounter(state, false); }
+BENCHMARK(BM_AtomicCounterInc)->ThreadRange(1, MaxThreads)->UseRealTime();
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_ShardedCounterInc(benchmark::State& state) { incrementCounter(state, true); }
+BENCHMARK(BM_ShardedCounterInc)->ThreadRange(1, MaxThreads)->UseRealTime();
+
+} // namespace
+} // namespace Stats
+} // namespace Envoy
@@ -5,6 +5,7 @@
 #include "envoy/stats/sink.h"
 
 #include "source/common/stats/allocator_impl.h"
+#include "source/common/stats/stats_matcher_impl.h"
 
 #include "test/common/stats/stat_test_utility.h"
 #include "test/test_common/logging.h"
@@ -154,6 +155,169 @@ TEST_F(AllocatorImplTest, HiddenGauge) {
   EXPECT_FALSE(never_import_hidden_gauge->hidden());
 }
 
+TEST_F(AllocatorImplTest, GaugeLatchChanged) {
+  GaugeSharedPtr gauge =
+      alloc_.makeGauge(makeStat("gauge"), StatName(), {}, Gauge::ImportMode::Accumulate);
+  EXPECT_FALSE(gauge->latchChanged());
+
+  gauge->set(5);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+
+  gauge->inc();
+  gauge->dec();
+  EXPECT_TRUE(gauge->latchChanged());
+  gauge->sub(1);
+  EXPECT_TRUE(gauge->latchChanged());
+
+  gauge->setParentValue(3);
+  EXPECT_TRUE(gauge->latchChanged());
+  gauge->setParentValue(3);
+  EXPECT_FALSE(gauge->latchChanged());
+}
+
+// Accepts only the given stat names.
+class AcceptNamesMatcher : public StatsMatcher {
+public:
+  explicit AcceptNamesMatcher(const std::vector<StatName>& names)
+      : names_(names.begin(), names.end()) {}
+
+  // StatsMatcher
+  bool rejects(StatName name) const override { return !names_.contains(name); }
+  FastResult fastRejects(StatName name) const override {
+    return rejects(name) ? FastResult::Rejects : FastResult::Matches;
+  }
+  bool slowRejects(FastResult fast_result, StatName) const override {
+    return fast_result == FastResult::Rejects;
+  }
+  bool acceptsAll() const override { return false; }
+  bool rejectsAll() const override { return names_.empty(); }
+
+private:
+  const StatNameHashSet names_;
+};
+
+TEST_F(AllocatorImplTest, ShardedCounterSumsThreads) {
+  const StatName hot_name = makeStat("hot");
+  // Fewer shards than threads, so the threads bound beyond the shards share the overflow atomic,
+  // as does this unbound thread.
+  alloc_.setCounterSharding(2,
+                            std::make_unique<AcceptNamesMatcher>(std::vector<StatName>{hot_name}));
+  CounterSharedPtr hot = alloc_.makeCounter(hot_name, StatName(), {});
+  CounterSharedPtr cold = alloc_.makeCounter(makeStat("cold"), StatName(), {});
+  EXPECT_FALSE(hot->used());
+
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t i = 0; i < 4; ++i) {
+    threads.push_back(thread_factory.createThread([&, i]() {
+      AllocatorImpl::bindThreadToCounterShard(i);
+      for (int j = 0; j < 1000; ++j) {
+        hot->inc();
+        cold->add(2);
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  EXPECT_TRUE(hot->used());
+  EXPECT_EQ(4000U, hot->value());
+  EXPECT_EQ(8000U, cold->value());
+  EXPECT_EQ(4000U, hot->latch());
+  EXPECT_EQ(0U, hot->latch());
+
+  hot->add(5);
+  EXPECT_EQ(4005U, hot->value());
+  EXPECT_EQ(5U, hot->latch());
+
+  // Like other counters, a reset does not affect the increment since the last latch.
+  hot->inc();
+  hot->reset();
+  EXPECT_EQ(0U, hot->value());
+  hot->inc();
+  EXPECT_EQ(1U, hot->value());
+  EXPECT_EQ(2U, hot->latch());
+}
+
+TEST_F(AllocatorImplTest, ShardingAppliesToNewCounters) {
+  CounterSharedPtr before = alloc_.makeCounter(makeStat("before"), StatName(), {});
+  alloc_.setCounterSharding(4, std::make_unique<StatsMatcherImpl>());
+  CounterSharedPtr after = alloc_.makeCounter(makeStat("after"), StatName(), {});
+  // Sharding is transparent to readers, whichever implementation a counter has.
+  before->inc();
+  after->inc();
+  EXPECT_EQ(1U, before->value());
+  EXPECT_EQ(1U, after->value());
+  EXPECT_EQ(after.get(), alloc_.makeCounter(after->statName(), StatName(), {}).get());
+
+  // Disabling sharding keeps the counters already sharded.
+  alloc_.setCounterSharding(0, nullptr);
+  after->inc();
+  EXPECT_EQ(2U, after->value());
+}
+
+TEST_F(AllocatorImplTest, CompactNamesShareShapes) {
+  alloc_.setCompactNames(true);
+  const StatName tag_extracted_name = makeStat("cluster.upstream_rq");
+  const StatName tag_name = makeStat("envoy.cluster_name");
+  CounterSharedPtr a = alloc_.makeCounter(makeStat("cluster.a.upstream_rq"), tag_extracted_name,
+                                          {{tag_name, makeStat("a")}});
+  GaugeSharedPtr b =
+      alloc_.makeGauge(makeStat("cluster.b.upstream_rq"), tag_extracted_name,
+                       {{tag_name, makeStat("b")}}, Gauge::ImportMode::Accumulate);
+  EXPECT_EQ(1U, alloc_.numShapesForTest());
+  EXPECT_EQ("cluster.a.upstream_rq", a->name());
+  EXPECT_EQ("cluster.upstream_rq", a->tagExtractedName());
+  EXPECT_EQ((TagVector{{"envoy.cluster_name", "a"}}), a->tags());
+  EXPECT_EQ("cluster.b.upstream_rq", b->name());
+  EXPECT_EQ((TagVector{{"envoy.cluster_name", "b"}}), b->tags());
+
+  // Stats without tags whose tag-extracted name is their name share a shape too.
+  const StatName untagged_name = makeStat("untagged");
+  TextReadoutSharedPtr untagged = alloc_.makeTextReadout(untagged_name, untagged_name, {});
+  CounterSharedPtr other_untagged =
+      alloc_.makeCounter(makeStat("other_untagged"), makeStat("other_untagged"), {});
+  EXPECT_EQ(2U, alloc_.numShapesForTest());
+  EXPECT_EQ("untagged", untagged->tagExtractedName());
+  EXPECT_EQ("other_untagged", other_untagged->tagExtractedName());
+  EXPECT_TRUE(untagged->tags().empty());
+
+  // A shape goes with the last stat which has it.
+  a.reset();
+  EXPECT_EQ(2U, alloc_.numShapesForTest());
+  b.reset();
+  EXPECT_EQ(1U, alloc_.numShapesForTest());
+  untagged.reset();
+  other_untagged.reset();
+  EXPECT_EQ(0U, alloc_.numShapesForTest());
+}
+
+TEST_F(AllocatorImplTest, CompactNamesWithMultipleTags) {
+  alloc_.setCompactNames(true);
+  const StatName tag_extracted_name = makeStat("http.rq");
+  const StatNameTagVector tags{{makeStat("prefix"), makeStat("ingress")},
+                               {makeStat("code"), makeStat("200")}};
+  GaugeSharedPtr gauge = alloc_.makeGauge(makeStat("http.ingress.rq.200"), tag_extracted_name, tags,
+                                          Gauge::ImportMode::NeverImport);
+  EXPECT_EQ((TagVector{{"prefix", "ingress"}, {"code", "200"}}), gauge->tags());
+  std::vector<std::string> tag_names;
+  gauge->iterateTagStatNames([&](StatName name, StatName) -> bool {
+    tag_names.push_back(symbol_table_.toString(name));
+    return false;
+  });
+  EXPECT_EQ(std::vector<std::string>{"prefix"}, tag_names);
+  EXPECT_EQ(Gauge::ImportMode::NeverImport, gauge->importMode());
+
+  // Stats created before compact names were turned off keep them.
+  alloc_.setCompactNames(false);
+  CounterSharedPtr counter = alloc_.makeCounter(makeStat("http.egress.rq.200"), tag_extracted_name,
+                                                {{makeStat("prefix"), makeStat("egress")}});
+  EXPECT_EQ(1U, alloc_.numShapesForTest());
+  EXPECT_EQ("http.rq", counter->tagExtractedName());
+  EXPECT_EQ("http.rq", gauge->tagExtractedName());
+}
+
 TEST_F(AllocatorImplTest, ForEachCounter) {
   StatNameHashSet stat_names;
   std::vector<CounterSharedPtr> counters;
@@ -89,3 +89,33 @@ static void BM_Exclusion(benchmark::State& state) {
   }
 }
 BENCHMARK(BM_Exclusion);
+
+// Models an exclusion list of a few hundred patterns, checked against the
+// names created for a cluster.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_ExclusionManyPatterns(benchmark::State& state) {
+  Envoy::Stats::StatsMatcherPerf context;
+  for (auto idx = 0; idx < 100; ++idx) {
+    context.exclusionList()->set_prefix(absl::StrCat("cluster.svc_", idx, "."));
+    context.exclusionList()->set_suffix(absl::StrCat(".metric_", idx));
+    context.exclusionList()->MergeFrom(Envoy::TestUtility::createRegexMatcher(
+        absl::StrCat("cluster\\.[a-z_0-9]+\\.upstream_rq_", idx, "xx")));
+  }
+  context.initMatcher();
+  std::vector<Envoy::Stats::StatName> stat_names;
+  stat_names.reserve(100);
+  for (auto idx = 0; idx < 100; ++idx) {
+    stat_names.push_back(context.pool_.add(
+        absl::StrCat("cluster.backend_", idx, ".upstream_cx_", idx % 2 ? "total" : "active")));
+  }
+
+  for (auto _ : state) { // NOLINT
+    for (auto idx = 0; idx < 1000; ++idx) {
+      const Envoy::Stats::StatName stat_name = stat_names[idx % 100];
+      const Envoy::Stats::StatsMatcher::FastResult fast_result =
+          context.stats_matcher_impl_->fastRejects(stat_name);
+      context.stats_matcher_impl_->slowRejects(fast_result, stat_name);
+    }
+  }
+}
+BENCHMARK(BM_ExclusionManyPatterns);
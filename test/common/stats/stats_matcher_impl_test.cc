@@ -56,6 +56,14 @@ TEST_F(StatsMatcherTest, CheckDefault) {
   EXPECT_FALSE(stats_matcher_impl_->rejectsAll());
 }
 
+TEST_F(StatsMatcherTest, ConstructFromStatsMatcher) {
+  envoy::config::metrics::v3::StatsMatcher config;
+  config.mutable_inclusion_list()->add_patterns()->set_prefix("cluster.");
+  stats_matcher_impl_ = std::make_unique<StatsMatcherImpl>(config, symbol_table_, context_);
+  expectAccepted({"cluster.foo"});
+  expectDenied({"listener.foo"});
+}
+
 // Across-the-board matchers.
 
 TEST_F(StatsMatcherTest, CheckRejectAll) {
@@ -256,6 +264,49 @@ TEST_F(StatsMatcherTest, CheckMultipleExcludeSuffix) {
   EXPECT_FALSE(stats_matcher_impl_->rejectsAll());
 }
 
+TEST_F(StatsMatcherTest, CheckIncludeSuffixDot) {
+  inclusionList()->set_suffix(".abc");
+  initMatcher();
+  expectAccepted({"foo.abc", "foo.bar.abc"});
+  expectDenied({"abc", "fooabc", "foo.abcd", "foo.abc.bar", "foo.ABC"});
+  EXPECT_FALSE(stats_matcher_impl_->acceptsAll());
+  EXPECT_FALSE(stats_matcher_impl_->rejectsAll());
+  EXPECT_EQ(StatsMatcher::FastResult::Matches,
+            stats_matcher_impl_->fastRejects(pool_.add("foo.abc")));
+  EXPECT_EQ(StatsMatcher::FastResult::Rejects, stats_matcher_impl_->fastRejects(pool_.add("abc")));
+}
+
+TEST_F(StatsMatcherTest, CheckExcludeMultiTokenSuffixDot) {
+  exclusionList()->set_suffix(".abc.def");
+  exclusionList()->set_suffix(".xyz");
+  initMatcher();
+  expectAccepted({"abc.def", "foo.def", "foo.abcdef", "foo.abc.def.bar", "xyz"});
+  expectDenied({"foo.abc.def", "foo.bar.abc.def", "foo.xyz"});
+  EXPECT_EQ(StatsMatcher::FastResult::Rejects,
+            stats_matcher_impl_->fastRejects(pool_.add("foo.abc.def")));
+}
+
+TEST_F(StatsMatcherTest, CheckSuffixDotWithDynamicTokens) {
+  exclusionList()->set_suffix(".abc.def");
+  initMatcher();
+  StatNameDynamicPool dynamic_pool(symbol_table_);
+
+  // A dynamic token may contain ".", so these can only be decided from the
+  // elaborated name.
+  StatName joined_dynamic = dynamic_pool.add("foo.abc.def");
+  EXPECT_EQ(StatsMatcher::FastResult::NoMatch, stats_matcher_impl_->fastRejects(joined_dynamic));
+  EXPECT_TRUE(stats_matcher_impl_->rejects(joined_dynamic));
+
+  SymbolTable::StoragePtr storage =
+      symbol_table_.join({pool_.add("foo"), dynamic_pool.add("abc"), pool_.add("def")});
+  StatName mixed(storage.get());
+  EXPECT_EQ(StatsMatcher::FastResult::NoMatch, stats_matcher_impl_->fastRejects(mixed));
+  EXPECT_TRUE(stats_matcher_impl_->rejects(mixed));
+
+  storage = symbol_table_.join({dynamic_pool.add("foo"), pool_.add("def")});
+  EXPECT_FALSE(stats_matcher_impl_->rejects(StatName(storage.get())));
+}
+
 // Multiple regex matchers.
 
 TEST_F(StatsMatcherTest, CheckMultipleIncludeRegex) {
@@ -278,6 +329,19 @@ TEST_F(StatsMatcherTest, CheckMultipleExcludeRegex) {
   EXPECT_FALSE(stats_matcher_impl_->rejectsAll());
 }
 
+TEST_F(StatsMatcherTest, CheckMultipleIncludeRegexAnchored) {
+  // Regexes are combined into one set, but each must still match the whole name.
+  inclusionList()->MergeFrom(TestUtility::createRegexMatcher("cluster\\.[a-z]+\\.upstream_rq"));
+  inclusionList()->MergeFrom(TestUtility::createRegexMatcher("http\\..*\\.downstream_rq_[0-9]xx"));
+  inclusionList()->MergeFrom(TestUtility::createRegexMatcher("server\\..*"));
+  inclusionList()->set_exact("runtime.load_success");
+  initMatcher();
+  expectAccepted({"cluster.foo.upstream_rq", "http.ingress.downstream_rq_2xx", "server.uptime",
+                  "runtime.load_success"});
+  expectDenied({"cluster.foo.upstream_rq_total", "x.cluster.foo.upstream_rq",
+                "http.ingress.downstream_rq_2xx.x", "servers.uptime", "runtime.load_error"});
+}
+
 // Multiple prefix/suffix/regex matchers.
 //
 // Matchers are "any_of", so strings matching any of the rules are expected to pass or fail,
@@ -331,6 +331,51 @@ TEST_F(StatNameTest, FreePoolTest) {
   EXPECT_EQ(table_.numSymbols(), 6);
 }
 
+TEST_F(StatNameTest, EncodeCacheIgnoresFreedSymbols) {
+  // Encoding a name whose tokens all exist leaves it in this thread's encode
+  // cache. Once its symbols are freed and reused for other tokens, the cached
+  // entry must not be used to encode the name again.
+  StatName first = makeStat("cached.name");
+  EXPECT_EQ(first, makeStat("cached.name"));
+  clearStorage();
+
+  StatName other = makeStat("other.tokens");
+  StatName second = makeStat("cached.name");
+  EXPECT_EQ("other.tokens", table_.toString(other));
+  EXPECT_EQ("cached.name", table_.toString(second));
+  EXPECT_EQ(4, table_.numSymbols());
+}
+
+TEST_F(StatNameTest, EncodeCacheAfterRehash) {
+  StatName first = makeStat("cached.name");
+  EXPECT_EQ(first, makeStat("cached.name"));
+
+  // Adding symbols rehashes the table, moving the entries the cache refers to.
+  for (int i = 0; i < 1000; ++i) {
+    makeStat(absl::StrCat("token", i));
+  }
+  EXPECT_EQ(first, makeStat("cached.name"));
+  EXPECT_EQ("cached.name", table_.toString(makeStat("cached.name")));
+}
+
+TEST_F(StatNameTest, EncodeCacheAfterInPlaceRehash) {
+  // Erasing symbols leaves deleted slots, which later inserts may reclaim by rehashing the
+  // encode map in place, moving the entries without changing its capacity.
+  for (int i = 0; i < 1000; ++i) {
+    StatNameStorage storage(absl::StrCat("erased", i), table_);
+    storage.free(table_);
+  }
+  StatName first = makeStat("cached.name");
+  EXPECT_EQ(first, makeStat("cached.name"));
+  for (int i = 0; i < 1000; ++i) {
+    makeStat(absl::StrCat("token", i));
+  }
+  EXPECT_EQ(first, makeStat("cached.name"));
+  EXPECT_EQ("cached.name", table_.toString(makeStat("cached.name")));
+  // Ref-counts taken through the cache landed on the right symbols.
+  clearStorage();
+}
+
 TEST_F(StatNameTest, TestShrinkingExpectation) {
   // We expect that as we free stat names, the memory used to store those underlying symbols will
   // be freed.
@@ -412,6 +457,48 @@ TEST_F(StatNameTest, List) {
   EXPECT_FALSE(name_list.populated());
 }
 
+TEST_F(StatNameTest, ListIterateWith) {
+  StatName names[] = {makeStat("a"), makeStat("b"), makeStat("c")};
+  StatName other_names[] = {makeStat("x"), makeStat("y")};
+  StatNameList name_list;
+  StatNameList other_list;
+  table_.populateList(names, ARRAY_SIZE(names), name_list);
+  table_.populateList(other_names, ARRAY_SIZE(other_names), other_list);
+
+  std::vector<std::string> pairs;
+  const auto collect = [this, &pairs](StatName a, StatName b) -> bool {
+    pairs.push_back(absl::StrCat(table_.toString(a), "=", table_.toString(b)));
+    return true;
+  };
+
+  // The iteration stops at the end of the shorter list.
+  name_list.iterateWith(0, other_list, 0, collect);
+  EXPECT_EQ((std::vector<std::string>{"a=x", "b=y"}), pairs);
+
+  pairs.clear();
+  name_list.iterateWith(1, other_list, 0, collect);
+  EXPECT_EQ((std::vector<std::string>{"b=x", "c=y"}), pairs);
+
+  pairs.clear();
+  name_list.iterateWith(2, other_list, 1, collect);
+  EXPECT_EQ((std::vector<std::string>{"c=y"}), pairs);
+
+  pairs.clear();
+  name_list.iterateWith(3, other_list, 0, collect);
+  EXPECT_TRUE(pairs.empty());
+
+  // Returning false ends the iteration.
+  pairs.clear();
+  name_list.iterateWith(0, other_list, 0, [&collect](StatName a, StatName b) -> bool {
+    collect(a, b);
+    return false;
+  });
+  EXPECT_EQ((std::vector<std::string>{"a=x"}), pairs);
+
+  name_list.clear(table_);
+  other_list.clear(table_);
+}
+
 TEST_F(StatNameTest, HashTable) {
   StatName ac = makeStat("a.c");
   StatName ab = makeStat("a.b");
@@ -532,20 +619,10 @@ TEST_F(StatNameTest, RacingSymbolCreation) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
+  // Existing symbols are looked up with the SymbolTable lock held shared, so
+  // these accesses don't contend with each other. We can't EXPECT that no
+  // further contentions are traced, though, as the tracer also counts the
+  // threads waking up on the ConditionalInitializer mutexes.
   //
   // Note also that we cannot guarantee there *will* be contentions
   // as a machine or OS is free to run all threads serially.
@@ -600,20 +677,10 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
+  // Existing symbols are looked up with the SymbolTable lock held shared, so
+  // these accesses don't contend with each other. We can't EXPECT that no
+  // further contentions are traced, though, as the tracer also counts the
+  // threads waking up on the ConditionalInitializer mutexes.
   //
   // Note also that we cannot guarantee there *will* be contentions
   // as a machine or OS is free to run all threads serially.
@@ -714,6 +781,21 @@ TEST_F(StatNameTest, RecentLookups) {
   EXPECT_EQ(0, num_calls);
 }
 
+TEST_F(StatNameTest, RecentLookupsWithoutCapacityCountsTotal) {
+  // Without a capacity, lookups of existing names take the lock shared and are
+  // only counted.
+  encodeDecode("direct.stat");
+  encodeDecode("direct.stat");
+  encodeDecode("direct.stat");
+  uint32_t num_calls = 0;
+  EXPECT_EQ(3, table_.getRecentLookups([&num_calls](absl::string_view, uint64_t) { ++num_calls; }));
+  EXPECT_EQ(0, num_calls);
+
+  table_.clearRecentLookups();
+  EXPECT_EQ(0, table_.getRecentLookups([&num_calls](absl::string_view, uint64_t) { ++num_calls; }));
+  EXPECT_EQ(0, num_calls);
+}
+
 TEST_F(StatNameTest, StatNameEmptyEquivalent) {
   StatName empty1;
   StatName empty2 = makeStat("");
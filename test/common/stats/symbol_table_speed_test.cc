@@ -139,6 +139,39 @@ static void bmCompareElements(benchmark::State& state) {
 }
 BENCHMARK(bmCompareElements);
 
+// Encodes names whose tokens are all in the symbol table already, from several
+// threads at once, as filters do when they make stats with dynamic names on
+// workers. Each iteration encodes a batch of names; freeing them is not timed.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmEncodeExistingNames(benchmark::State& state) {
+  static Envoy::Stats::SymbolTable* symbol_table = new Envoy::Stats::SymbolTableImpl;
+  static const std::vector<std::string>* names = [] {
+    auto* pool = new Envoy::Stats::StatNamePool(*symbol_table);
+    auto* strings = new std::vector<std::string>;
+    for (Envoy::Stats::StatName stat_name : prepareNames(*pool, 64)) {
+      strings->push_back(symbol_table->toString(stat_name));
+    }
+    return strings;
+  }();
+
+  std::vector<Envoy::Stats::StatNameStorage> storage;
+  storage.reserve(names->size());
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (const std::string& name : *names) {
+      storage.emplace_back(name, *symbol_table);
+    }
+    state.PauseTiming();
+    for (Envoy::Stats::StatNameStorage& stat_name_storage : storage) {
+      stat_name_storage.free(*symbol_table);
+    }
+    storage.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * names->size());
+}
+BENCHMARK(bmEncodeExistingNames)->ThreadRange(1, 16)->UseRealTime();
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmSortByStatNames(benchmark::State& state) {
   Envoy::Stats::SymbolTableImpl symbol_table;
@@ -85,6 +85,14 @@ TEST(TagExtractorTest, BadRegex) {
       EnvoyException, "Invalid regex '\\+invalid':");
 }
 
+TEST(TagExtractorTest, BadRe2Regex) {
+  auto extractor_or_error = TagExtractorImplBase::createTagExtractor(
+      "cluster_name", "+invalid", "", "", Regex::Type::Re2);
+  EXPECT_FALSE(extractor_or_error.ok());
+  EXPECT_THAT(std::string(extractor_or_error.status().message()),
+              testing::HasSubstr("Invalid regex '+invalid':"));
+}
+
 class DefaultTagRegexTester {
 public:
   DefaultTagRegexTester()
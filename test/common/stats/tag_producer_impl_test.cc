@@ -131,6 +131,49 @@ TEST_F(TagProducerTest, DuplicateConfigCliTagBehavior) {
   }
 }
 
+TEST_F(TagProducerTest, Re2TagRegexes) {
+  stats_config_.set_use_re2_for_tag_regexes(true);
+  for (int i = 0; i < 10; ++i) {
+    addSpecifier(absl::StrCat("custom_", i), absl::StrCat("^cluster\\.\\w+\\.custom_", i,
+                                                          "\\.((\\w+)\\.)"));
+  }
+  auto producer = TagProducerImpl::createTagProducer(stats_config_, {}).value();
+
+  // The custom regexes extract the same tags as they do with std::regex, alongside the default
+  // regexes, which are screened together with them.
+  stats_config_.set_use_re2_for_tag_regexes(false);
+  auto std_regex_producer = TagProducerImpl::createTagProducer(stats_config_, {}).value();
+  for (absl::string_view stat_name :
+       {"cluster.backend.custom_3.value.upstream_rq_200", "cluster.backend.custom_10.value.rq",
+        "cluster.backend.upstream_rq_2xx", "http.ingress.downstream_rq_total",
+        "listener.127.0.0.1_80.http.ingress.downstream_rq_5xx"}) {
+    TagVector tags;
+    TagVector std_regex_tags;
+    EXPECT_EQ(std_regex_producer->produceTags(stat_name, std_regex_tags),
+              producer->produceTags(stat_name, tags))
+        << stat_name;
+    checkTags(std_regex_tags, tags);
+  }
+
+  TagVector tags;
+  EXPECT_EQ("cluster.custom_3.upstream_rq",
+            producer->produceTags("cluster.backend.custom_3.value.upstream_rq_200", tags));
+  checkTags(TagVector{{tag_name_values_.RESPONSE_CODE, "200"},
+                      {tag_name_values_.CLUSTER_NAME, "backend"},
+                      {"custom_3", "value"}},
+            tags);
+}
+
+TEST_F(TagProducerTest, InvalidRe2TagRegex) {
+  // Lookahead is valid for std::regex, but not for RE2.
+  addSpecifier("lookahead", "^cluster\\.((.+?)(?=\\.))");
+  EXPECT_TRUE(TagProducerImpl::createTagProducer(stats_config_, {}).status().ok());
+
+  stats_config_.set_use_re2_for_tag_regexes(true);
+  EXPECT_THAT(std::string(TagProducerImpl::createTagProducer(stats_config_, {}).status().message()),
+              testing::HasSubstr("Invalid regex '^cluster\\.((.+?)(?=\\.))'"));
+}
+
 TEST_F(TagProducerTest, Fixed) {
   const TagVector tag_config{{"my-tag", "fixed"}};
   auto producer(TagProducerImpl::createTagProducer(stats_config_, tag_config).value());
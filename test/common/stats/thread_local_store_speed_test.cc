@@ -6,6 +6,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
 #include "source/common/event/dispatcher_impl.h"
+#include "source/common/memory/stats.h"
 #include "source/common/stats/allocator_impl.h"
 #include "source/common/stats/stats_matcher_impl.h"
 #include "source/common/stats/symbol_table.h"
@@ -66,6 +67,10 @@ public:
     store_.initializeThreading(*dispatcher_, *tls_);
   }
 
+  void setCompactNames(bool compact) { store_.setCompactNames(compact); }
+
+  size_t numStats() const { return stat_names_.size(); }
+
   void initPrefixRejections(const std::string& prefix) {
     stats_config_.mutable_stats_matcher()->mutable_exclusion_list()->add_patterns()->set_prefix(
         prefix);
@@ -138,5 +143,26 @@ static void BM_StatsWithTlsAndRejectionsWithoutDot(benchmark::State& state) {
 }
 BENCHMARK(BM_StatsWithTlsAndRejectionsWithoutDot);
 
+// Reports the heap bytes taken by each stat created, with compact names if the
+// argument is 1. The sample stats' names are interned before measuring, so the
+// symbol table is not included. This needs a build with tcmalloc to report
+// anything.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_MemoryPerStat(benchmark::State& state) {
+  for (auto _ : state) { // NOLINT
+    state.PauseTiming();
+    Envoy::ThreadLocalStorePerf context;
+    context.setCompactNames(state.range(0) == 1);
+    const uint64_t start_bytes = Envoy::Memory::Stats::totalCurrentlyAllocated();
+    state.ResumeTiming();
+    context.accessCounters();
+    state.PauseTiming();
+    state.counters["bytes_per_stat"] =
+        static_cast<double>(Envoy::Memory::Stats::totalCurrentlyAllocated() - start_bytes) /
+        context.numStats();
+  }
+}
+BENCHMARK(BM_MemoryPerStat)->Arg(0)->Arg(1)->Iterations(1);
+
 // TODO(jmarantz): add multi-threaded variant of this test, that aggressively
 // looks up stats in multiple threads to try to trigger contention issues.
@@ -1640,6 +1640,31 @@ TEST_F(StatsThreadLocalStoreTestNoFixture, MemoryWithTlsRealSymbolTable) {
   EXPECT_MEMORY_LE(memory_test.consumedBytes(), 0.99 * million_);
 }
 
+// Compares the memory taken by stats with and without compact names.
+TEST_F(StatsThreadLocalStoreTestNoFixture, MemoryWithCompactNamesRealSymbolTable) {
+  // Create the stats once in the fixture's store, so that their symbols exist and neither
+  // measurement below includes them.
+  TestUtil::forEachSampleStat(
+      100, true, [this](absl::string_view name) { scope_.counterFromString(std::string(name)); });
+
+  auto measure = [this](bool compact) -> size_t {
+    AllocatorImpl alloc(symbol_table_);
+    ThreadLocalStoreImpl store(alloc);
+    envoy::config::metrics::v3::StatsConfig stats_config;
+    const TagVector tags_vector;
+    store.setTagProducer(TagProducerImpl::createTagProducer(stats_config, tags_vector).value());
+    store.setCompactNames(compact);
+    Memory::TestUtil::MemoryTest memory_test;
+    TestUtil::forEachSampleStat(100, true, [&store](absl::string_view name) {
+      store.rootScope()->counterFromString(std::string(name));
+    });
+    return memory_test.consumedBytes();
+  };
+  const size_t full_bytes = measure(false);
+  const size_t compact_bytes = measure(true);
+  EXPECT_MEMORY_LE(compact_bytes, full_bytes);
+}
+
 TEST_F(StatsThreadLocalStoreTest, ShuttingDown) {
   InSequence s;
   store_->initializeThreading(main_thread_dispatcher_, tls_);
@@ -1897,6 +1922,16 @@ TEST_F(HistogramTest, ParentHistogramBucketSummaryAndDetail) {
             parent_histogram->bucketSummary());
   EXPECT_THAT(parent_histogram->detailedTotalBuckets(), UnorderedElementsAre(Bucket{10, 1, 1}));
   EXPECT_THAT(parent_histogram->detailedIntervalBuckets(), UnorderedElementsAre(Bucket{10, 1, 1}));
+
+  std::vector<Bucket> buckets;
+  const ParentHistogram::BucketFn collect = [&buckets](const Bucket& bucket) {
+    buckets.push_back(bucket);
+  };
+  parent_histogram->forEachDetailedTotalBucket(collect);
+  EXPECT_THAT(buckets, UnorderedElementsAre(Bucket{10, 1, 1}));
+  buckets.clear();
+  parent_histogram->forEachDetailedIntervalBucket(collect);
+  EXPECT_THAT(buckets, UnorderedElementsAre(Bucket{10, 1, 1}));
 }
 
 TEST_F(HistogramTest, ForEachHistogram) {
@@ -2232,6 +2267,32 @@ TEST_F(HistogramThreadTest, MakeHistogramsAndRecordValues) {
               HasSubstr(absl::StrCat(" B25(0,0) B50(", NumThreads, ",", NumThreads, ") ")));
 }
 
+TEST_F(HistogramThreadTest, MergeOnThreads) {
+  store_->setHistogramMergeThreads(api().threadFactory(), 3);
+  // Enough histograms for every merge thread to get several batches.
+  constexpr uint32_t NumHistograms = 1000;
+  // The same merge threads serve every flush.
+  for (uint32_t flush = 1; flush <= 2; ++flush) {
+    foreachThread([this]() {
+      for (uint32_t i = 0; i < NumHistograms; ++i) {
+        Histogram& histogram =
+            scope_.histogramFromString(absl::StrCat("hist", i), Histogram::Unit::Unspecified);
+        histogram.recordValue(42);
+      }
+    });
+
+    mergeHistograms();
+
+    auto histograms = store_->histograms();
+    ASSERT_EQ(NumHistograms, histograms.size());
+    for (const ParentHistogramSharedPtr& hist : histograms) {
+      EXPECT_TRUE(hist->used());
+      EXPECT_THAT(hist->bucketSummary(), HasSubstr(absl::StrCat(" B25(0,0) B50(", NumThreads, ",",
+                                                                flush * NumThreads, ") ")));
+    }
+  }
+}
+
 TEST_F(HistogramThreadTest, ScopeOverlap) {
   // Creating two scopes with the same name gets you two distinct scope objects.
   ScopeSharedPtr scope1 = store_->createScope("scope.");
@@ -15,6 +15,7 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/application_protocol.h"
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/proxy_protocol_filter_state.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/transport_socket_options_impl.h"
@@ -827,6 +828,90 @@ TEST_P(TcpProxyTest, ReceiveBeforeConnectSetToFalse) {
   upstream_callbacks_->onUpstreamData(response, false);
 }
 
+// Splicing is skipped when the connections do not expose a passthrough socket, e.g. because they
+// use a transport socket other than raw_buffer, and the payload is proxied as usual.
+TEST_P(TcpProxyTest, SpliceDataFallsBackWithoutPassthroughSocket) {
+  auto config = defaultConfig();
+  config.set_splice_data(true);
+  setup(1, config);
+  EXPECT_CALL(filter_callbacks_.connection_, passthroughIoHandle())
+      .WillOnce(Return(OptRef<Network::IoHandle>()));
+  EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, createFileEvent_(_, _, _, _)).Times(0);
+  raiseEventUpstreamConnected(0);
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), false));
+  filter_->onData(buffer, false);
+  EXPECT_EQ(0U, config_->stats().downstream_cx_splice_total_.value());
+}
+
+#if defined(__linux__)
+TEST_P(TcpProxyTest, SpliceDataMovesPayloadBetweenSockets) {
+  int downstream_fds[2];
+  int upstream_fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, downstream_fds));
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, upstream_fds));
+  const int client_fd = downstream_fds[0];
+  const int server_fd = upstream_fds[1];
+  Network::IoSocketHandleImpl downstream_handle(downstream_fds[1]);
+  Network::IoSocketHandleImpl upstream_handle(upstream_fds[0]);
+
+  auto config = defaultConfig();
+  config.set_splice_data(true);
+  setup(1, config);
+  EXPECT_CALL(filter_callbacks_.connection_, passthroughIoHandle())
+      .WillOnce(Return(makeOptRef<Network::IoHandle>(downstream_handle)));
+  EXPECT_CALL(*upstream_connections_.at(0), passthroughIoHandle())
+      .WillOnce(Return(makeOptRef<Network::IoHandle>(upstream_handle)));
+  Event::FileReadyCb file_ready_cb;
+  EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, createFileEvent_(_, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](os_fd_t, Event::FileReadyCb cb, Event::FileTriggerType, uint32_t) {
+        file_ready_cb = cb;
+        return new NiceMock<Event::MockFileEvent>();
+      }));
+  // Both connections stay read disabled while the payload is spliced.
+  EXPECT_CALL(*upstream_connections_.at(0), readDisable(true));
+  raiseEventUpstreamConnected(0, /*expect_read_enable=*/false);
+  EXPECT_EQ(1U, config_->stats().downstream_cx_splice_total_.value());
+
+  // Downstream to upstream.
+  char buf[16];
+  ASSERT_EQ(5, ::write(client_fd, "hello", 5));
+  ASSERT_TRUE(file_ready_cb(Event::FileReadyType::Read).ok());
+  ASSERT_EQ(5, ::read(server_fd, buf, sizeof(buf)));
+  EXPECT_EQ("hello", absl::string_view(buf, 5));
+
+  // Upstream to downstream.
+  ASSERT_EQ(6, ::write(server_fd, "world!", 6));
+  ASSERT_TRUE(file_ready_cb(Event::FileReadyType::Read).ok());
+  ASSERT_EQ(6, ::read(client_fd, buf, sizeof(buf)));
+  EXPECT_EQ("world!", absl::string_view(buf, 6));
+
+  const StreamInfo::StreamInfo& stream_info = filter_callbacks_.connection_.streamInfo();
+  EXPECT_EQ(5U, stream_info.getDownstreamBytesMeter()->wireBytesReceived());
+  EXPECT_EQ(6U, stream_info.getDownstreamBytesMeter()->wireBytesSent());
+  EXPECT_EQ(5U, stream_info.getUpstreamBytesMeter()->wireBytesSent());
+  EXPECT_EQ(6U, stream_info.getUpstreamBytesMeter()->wireBytesReceived());
+  EXPECT_EQ(5U, config_->stats().downstream_cx_rx_bytes_total_.value());
+  EXPECT_EQ(6U, config_->stats().downstream_cx_tx_bytes_total_.value());
+
+  // A half close hands each socket back to its connection, which then reads the end of stream.
+  EXPECT_CALL(filter_callbacks_.connection_, readDisable(false));
+  ASSERT_EQ(0, ::shutdown(client_fd, SHUT_WR));
+  ASSERT_TRUE(file_ready_cb(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(*upstream_connections_.at(0), readDisable(false));
+  ASSERT_EQ(0, ::shutdown(server_fd, SHUT_WR));
+  ASSERT_TRUE(file_ready_cb(Event::FileReadyType::Read).ok());
+
+  filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
+  filter_.reset();
+  ::close(client_fd);
+  ::close(server_fd);
+}
+#endif
+
 TEST_P(TcpProxyTest, DownstreamDisconnectRemote) {
   setup(1);
 
@@ -283,7 +283,7 @@ TEST_P(StaticClusterTest, MergeStaticCdsClusterUpdates) {
   Cluster& cluster = cluster_manager_->activeClusters().find("cluster_1")->second;
 
   // Check we only know of the two endpoints from the recent update.
-  EXPECT_EQ(cluster.info()->endpointStats().membership_total_.value(), 2);
+  EXPECT_EQ(cluster.info()->endpointStats()->membership_total_.value(), 2);
   EXPECT_EQ(cluster.prioritySet().crossPriorityHostMap()->size(), 2);
   auto& host_sets_vector = cluster.prioritySet().hostSetsPerPriority();
   for (auto& host_set : host_sets_vector) {
@@ -364,7 +364,7 @@ TEST_P(StaticClusterTest, ActiveClusterGetsUpdated) {
   Cluster& cluster = cluster_manager_->activeClusters().find("cluster_1")->second;
 
   // Check we only know of the two endpoints from the recent update.
-  EXPECT_EQ(cluster.info()->endpointStats().membership_total_.value(), 2);
+  EXPECT_EQ(cluster.info()->endpointStats()->membership_total_.value(), 2);
   EXPECT_EQ(cluster.prioritySet().crossPriorityHostMap()->size(), 2);
   auto& host_sets_vector = cluster.prioritySet().hostSetsPerPriority();
   for (auto& host_set : host_sets_vector) {
@@ -501,7 +501,7 @@ TEST_P(EdsTest, ShouldMergeAddingHosts) {
                       cluster_manager_->getThreadLocalCluster("cluster_1"));
   EXPECT_EQ(readGauge("thread_local_cluster_manager.test_thread.clusters_inflated"), 1);
   Cluster& cluster = cluster_manager_->activeClusters().find("cluster_1")->second;
-  EXPECT_EQ(cluster.info()->endpointStats().membership_total_.value(), 10);
+  EXPECT_EQ(cluster.info()->endpointStats()->membership_total_.value(), 10);
   EXPECT_TRUE(hostsInHostsVector(cluster.prioritySet().hostSetsPerPriority()[0]->hosts(),
                                  {1000, 2000, 3000, 4000, 5000, 6000, 7000, 8000, 9000, 10000}));
 }
@@ -637,7 +637,7 @@ TEST_P(EdsTest, ShouldNotHaveRemovedHosts) {
                       cluster_manager_->getThreadLocalCluster("cluster_1"));
   EXPECT_EQ(readGauge("thread_local_cluster_manager.test_thread.clusters_inflated"), 1);
   Cluster& cluster = cluster_manager_->activeClusters().find("cluster_1")->second;
-  EXPECT_EQ(cluster.info()->endpointStats().membership_total_.value(), 2);
+  EXPECT_EQ(cluster.info()->endpointStats()->membership_total_.value(), 2);
   EXPECT_TRUE(
       hostsInHostsVector(cluster.prioritySet().hostSetsPerPriority()[0]->hosts(), {1000, 2000}));
 }
@@ -707,7 +707,7 @@ TEST_P(EdsTest, ShouldHaveHostThatWasAddedAfterRemoval) {
                       cluster_manager_->getThreadLocalCluster("cluster_1"));
   EXPECT_EQ(readGauge("thread_local_cluster_manager.test_thread.clusters_inflated"), 1);
   Cluster& cluster = cluster_manager_->activeClusters().find("cluster_1")->second;
-  EXPECT_EQ(cluster.info()->endpointStats().membership_total_.value(), 3);
+  EXPECT_EQ(cluster.info()->endpointStats()->membership_total_.value(), 3);
   EXPECT_TRUE(hostsInHostsVector(cluster.prioritySet().hostSetsPerPriority()[0]->hosts(),
                                  {1000, 2000, 3000}));
 }
@@ -175,6 +175,68 @@ TEST_F(EdfSchedulerTest, ManyPeekahead) {
   }
 }
 
+// Validate that removed entries are no longer picked, and that the other entries keep their order.
+TEST_F(EdfSchedulerTest, Remove) {
+  EdfScheduler<uint32_t> sched;
+  constexpr uint32_t num_entries = 8;
+  std::shared_ptr<uint32_t> entries[num_entries];
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(1, entries[i]);
+  }
+  sched.remove(entries[2]);
+  sched.remove(entries[5]);
+
+  for (uint32_t rounds = 0; rounds < 4; ++rounds) {
+    for (const uint32_t i : {0, 1, 3, 4, 6, 7}) {
+      auto p = sched.pickAndAdd([](const double&) { return 1; });
+      EXPECT_EQ(i, *p);
+    }
+  }
+}
+
+// Validate that a removed entry which was peeked is not picked.
+TEST_F(EdfSchedulerTest, RemovePeeked) {
+  EdfScheduler<uint32_t> sched;
+  auto first_entry = std::make_shared<uint32_t>(37);
+  auto second_entry = std::make_shared<uint32_t>(42);
+  sched.add(2, first_entry);
+  sched.add(1, second_entry);
+
+  EXPECT_EQ(*first_entry, *sched.peekAgain([](const double&) { return 1; }));
+  sched.remove(first_entry);
+  for (uint32_t rounds = 0; rounds < 4; ++rounds) {
+    EXPECT_EQ(*second_entry, *sched.pickAndAdd([](const double&) { return 1; }));
+  }
+}
+
+// Validate that an entry added after another one was removed is picked, even when it ends up at
+// the address of the removed entry.
+TEST_F(EdfSchedulerTest, RemoveThenAdd) {
+  EdfScheduler<uint32_t> sched;
+  constexpr uint32_t num_entries = 16;
+  std::shared_ptr<uint32_t> entries[num_entries];
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(1, entries[i]);
+  }
+  // Removing more than half of the entries compacts the queue.
+  for (uint32_t i = 0; i < 12; ++i) {
+    sched.remove(entries[i]);
+    entries[i].reset();
+  }
+  auto added_entry = std::make_shared<uint32_t>(100);
+  sched.add(1, added_entry);
+
+  std::vector<uint32_t> picks;
+  for (uint32_t i = 0; i < 10; ++i) {
+    picks.push_back(*sched.pickAndAdd([](const double&) { return 1; }));
+  }
+  EXPECT_EQ(std::vector<uint32_t>({12, 13, 14, 15, 100, 12, 13, 14, 15, 100}), picks);
+}
+
 // Validates that creating a scheduler using the createWithPicks (with 0 picks)
 // is equal to creating an empty scheduler and adding entries one after the other.
 TEST_F(EdfSchedulerTest, SchedulerWithZeroPicksEqualToEmptyWithAddedEntries) {
@@ -1,8 +1,10 @@
 #include "envoy/stats/stats.h"
 #include "envoy/upstream/upstream.h"
 
+#include "source/common/stats/deferred_creation.h"
 #include "source/common/upstream/resource_manager_impl.h"
 
+#include "test/common/stats/stat_test_utility.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/stats/mocks.h"
 
@@ -17,21 +19,29 @@ namespace Envoy {
 namespace Upstream {
 namespace {
 
-ClusterCircuitBreakersStats clusterCircuitBreakersStats(Stats::Store& store) {
-  return {
-      ALL_CLUSTER_CIRCUIT_BREAKERS_STATS(c, POOL_GAUGE(store), h, tr, GENERATE_STATNAME_STRUCT)};
+ClusterCircuitBreakersStats
+clusterCircuitBreakersStats(Stats::Store& store, const ClusterCircuitBreakersStatNames& stat_names,
+                            bool defer_creation = false) {
+  return {Stats::createDeferredCompatibleStats<ClusterCircuitBreakersOpenStats>(
+              store.rootScope(), stat_names, defer_creation),
+          store.gaugeFromString("remaining_cx", Stats::Gauge::ImportMode::Accumulate),
+          store.gaugeFromString("remaining_cx_pools", Stats::Gauge::ImportMode::Accumulate),
+          store.gaugeFromString("remaining_pending", Stats::Gauge::ImportMode::Accumulate),
+          store.gaugeFromString("remaining_retries", Stats::Gauge::ImportMode::Accumulate),
+          store.gaugeFromString("remaining_rq", Stats::Gauge::ImportMode::Accumulate)};
 }
 
 TEST(ResourceManagerImplTest, RuntimeResourceManager) {
   NiceMock<Runtime::MockLoader> runtime;
   NiceMock<Stats::MockGauge> gauge;
   NiceMock<Stats::MockStore> store;
+  ClusterCircuitBreakersStatNames stat_names(store.symbolTable());
 
   ON_CALL(store, gauge(_, _)).WillByDefault(ReturnRef(gauge));
 
   ResourceManagerImpl resource_manager(
       runtime, "circuit_breakers.runtime_resource_manager_test.default.", 0, 0, 0, 1, 0, 100,
-      clusterCircuitBreakersStats(store), absl::nullopt, absl::nullopt);
+      clusterCircuitBreakersStats(store, stat_names), absl::nullopt, absl::nullopt);
 
   EXPECT_CALL(
       runtime.snapshot_,
@@ -85,11 +95,13 @@ TEST(ResourceManagerImplTest, RuntimeResourceManager) {
 TEST(ResourceManagerImplTest, RemainingResourceGauges) {
   NiceMock<Runtime::MockLoader> runtime;
   Stats::IsolatedStoreImpl store;
+  ClusterCircuitBreakersStatNames stat_names(store.symbolTable());
 
-  auto stats = clusterCircuitBreakersStats(store);
-  ResourceManagerImpl resource_manager(runtime,
-                                       "circuit_breakers.runtime_resource_manager_test.default.", 1,
-                                       2, 1, 0, 3, 100, stats, absl::nullopt, absl::nullopt);
+  // The stats handed to the resource manager and the ones checked here share the store's gauges.
+  auto stats = clusterCircuitBreakersStats(store, stat_names);
+  ResourceManagerImpl resource_manager(
+      runtime, "circuit_breakers.runtime_resource_manager_test.default.", 1, 2, 1, 0, 3, 100,
+      clusterCircuitBreakersStats(store, stat_names), absl::nullopt, absl::nullopt);
 
   // Test remaining_cx_ gauge
   EXPECT_EQ(1U, resource_manager.connections().max());
@@ -150,12 +162,13 @@ TEST(ResourceManagerImplTest, RemainingResourceGauges) {
 TEST(ResourceManagerImplTest, RetryBudgetOverrideGauge) {
   NiceMock<Runtime::MockLoader> runtime;
   Stats::IsolatedStoreImpl store;
+  ClusterCircuitBreakersStatNames stat_names(store.symbolTable());
 
-  auto stats = clusterCircuitBreakersStats(store);
+  auto stats = clusterCircuitBreakersStats(store, stat_names);
 
   // Test retry budgets disable remaining_retries gauge (it should always be 0).
   ResourceManagerImpl rm(runtime, "circuit_breakers.runtime_resource_manager_test.default.", 1, 2,
-                         1, 0, 3, 100, stats, 20.0, 5);
+                         1, 0, 3, 100, clusterCircuitBreakersStats(store, stat_names), 20.0, 5);
 
   EXPECT_EQ(5U, rm.retries().max());
   EXPECT_EQ(0U, stats.remaining_retries_.value());
@@ -166,6 +179,48 @@ TEST(ResourceManagerImplTest, RetryBudgetOverrideGauge) {
   EXPECT_EQ(100u, rm.maxConnectionsPerHost());
   rm.retries().dec();
 }
+
+// Deferred "open" gauges are created when a circuit breaker first opens, and are reported as
+// uncreated until then.
+TEST(ResourceManagerImplTest, DeferredOpenGauges) {
+  NiceMock<Runtime::MockLoader> runtime;
+  Stats::TestUtil::TestStore store;
+  ClusterCircuitBreakersStatNames stat_names(store.symbolTable());
+
+  ResourceManagerImpl resource_manager(
+      runtime, "circuit_breakers.runtime_resource_manager_test.default.", 1, 2, 1, 0, 3, 100,
+      clusterCircuitBreakersStats(store, stat_names, true), absl::nullopt, absl::nullopt);
+
+  std::vector<std::string> uncreated;
+  auto collect_uncreated = [&]() {
+    uncreated.clear();
+    resource_manager.openStats().forEachUncreatedStatName(
+        [](Stats::StatName, Stats::StatName) { FAIL() << "unexpected counter"; },
+        [&](Stats::StatName, Stats::StatName name) {
+          uncreated.push_back(store.symbolTable().toString(name));
+        });
+  };
+  collect_uncreated();
+  EXPECT_THAT(uncreated, testing::UnorderedElementsAre("cx_open", "cx_pool_open", "rq_open",
+                                                       "rq_pending_open", "rq_retry_open"));
+
+  // Using a resource without reaching its limit leaves the gauges uncreated.
+  resource_manager.pendingRequests().inc();
+  resource_manager.pendingRequests().dec();
+  EXPECT_FALSE(resource_manager.openStats().isPresent());
+  EXPECT_FALSE(store.findGaugeByString("cx_open").has_value());
+
+  // Reaching the limit creates the gauges, and records the open circuit breaker.
+  resource_manager.connections().inc();
+  EXPECT_TRUE(resource_manager.openStats().isPresent());
+  EXPECT_EQ(1U, store.findGaugeByString("cx_open").value().get().value());
+  EXPECT_EQ(0U, store.findGaugeByString("rq_pending_open").value().get().value());
+  collect_uncreated();
+  EXPECT_TRUE(uncreated.empty());
+
+  resource_manager.connections().dec();
+  EXPECT_EQ(0U, store.findGaugeByString("cx_open").value().get().value());
+}
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
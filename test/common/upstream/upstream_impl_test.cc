@@ -993,8 +993,8 @@ TEST_P(StrictDnsClusterImplParamTest, HostUpdateWithDisabledACEndpoint) {
     EXPECT_FALSE(hosts[1]->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC));
 
     EXPECT_EQ(2UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-    EXPECT_EQ(2UL, cluster->info()->endpointStats().membership_healthy_.value());
-    EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+    EXPECT_EQ(2UL, cluster->info()->endpointStats()->membership_healthy_.value());
+    EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
   }
 
   // Re-resolve the DNS name with only one record, we should have 1 host.
@@ -1007,8 +1007,8 @@ TEST_P(StrictDnsClusterImplParamTest, HostUpdateWithDisabledACEndpoint) {
     EXPECT_FALSE(hosts[0]->healthFlagGet(Host::HealthFlag::PENDING_DYNAMIC_REMOVAL));
     EXPECT_FALSE(hosts[0]->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC));
     EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-    EXPECT_EQ(1UL, cluster->info()->endpointStats().membership_healthy_.value());
-    EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+    EXPECT_EQ(1UL, cluster->info()->endpointStats()->membership_healthy_.value());
+    EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
   }
 }
 
@@ -2830,7 +2830,7 @@ TEST_F(StaticClusterImplTest, OutlierDetector) {
   cluster->initialize([] { return absl::OkStatus(); });
 
   EXPECT_EQ(2UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(2UL, cluster->info()->endpointStats().membership_healthy_.value());
+  EXPECT_EQ(2UL, cluster->info()->endpointStats()->membership_healthy_.value());
 
   // Set a single host as having failed and fire outlier detector callbacks. This should result
   // in only a single healthy host.
@@ -2840,7 +2840,7 @@ TEST_F(StaticClusterImplTest, OutlierDetector) {
       Host::HealthFlag::FAILED_OUTLIER_CHECK);
   detector->runCallbacks(cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]);
   EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(1UL, cluster->info()->endpointStats().membership_healthy_.value());
+  EXPECT_EQ(1UL, cluster->info()->endpointStats()->membership_healthy_.value());
   EXPECT_NE(cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts()[0],
             cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]);
 
@@ -2849,7 +2849,7 @@ TEST_F(StaticClusterImplTest, OutlierDetector) {
       Host::HealthFlag::FAILED_OUTLIER_CHECK);
   detector->runCallbacks(cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]);
   EXPECT_EQ(2UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(2UL, cluster->info()->endpointStats().membership_healthy_.value());
+  EXPECT_EQ(2UL, cluster->info()->endpointStats()->membership_healthy_.value());
 }
 
 TEST_F(StaticClusterImplTest, HealthyStat) {
@@ -2893,8 +2893,8 @@ TEST_F(StaticClusterImplTest, HealthyStat) {
 
   EXPECT_EQ(2UL, cluster->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(0UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]->healthFlagClear(
       Host::HealthFlag::FAILED_ACTIVE_HC);
@@ -2910,46 +2910,46 @@ TEST_F(StaticClusterImplTest, HealthyStat) {
       Host::HealthFlag::FAILED_OUTLIER_CHECK);
   outlier_detector->runCallbacks(cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]);
   EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(1UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(1UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]->healthFlagSet(
       Host::HealthFlag::FAILED_ACTIVE_HC);
   health_checker->runCallbacks(cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0],
                                HealthTransition::Changed, HealthState::Unhealthy);
   EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(1UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(1UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]->healthFlagClear(
       Host::HealthFlag::FAILED_OUTLIER_CHECK);
   outlier_detector->runCallbacks(cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]);
   EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(1UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(1UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]->healthFlagClear(
       Host::HealthFlag::FAILED_ACTIVE_HC);
   health_checker->runCallbacks(cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0],
                                HealthTransition::Changed, HealthState::Healthy);
   EXPECT_EQ(2UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(2UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(2UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]->healthFlagSet(
       Host::HealthFlag::FAILED_OUTLIER_CHECK);
   outlier_detector->runCallbacks(cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[0]);
   EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(1UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(1UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[1]->healthFlagSet(
       Host::HealthFlag::FAILED_ACTIVE_HC);
   health_checker->runCallbacks(cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[1],
                                HealthTransition::Changed, HealthState::Unhealthy);
   EXPECT_EQ(0UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[1]->healthFlagSet(
       Host::HealthFlag::DEGRADED_ACTIVE_HC);
@@ -2959,8 +2959,8 @@ TEST_F(StaticClusterImplTest, HealthyStat) {
                                HealthTransition::Changed, HealthState::Healthy);
   EXPECT_EQ(0UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
   EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->degradedHosts().size());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(1UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(1UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   // Mark the endpoint as unhealthy. This should decrement the degraded stat.
   cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[1]->healthFlagSet(
@@ -2969,8 +2969,8 @@ TEST_F(StaticClusterImplTest, HealthyStat) {
                                HealthTransition::Changed, HealthState::Unhealthy);
   EXPECT_EQ(0UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
   EXPECT_EQ(0UL, cluster->prioritySet().hostSetsPerPriority()[0]->degradedHosts().size());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   // Go back to degraded.
   cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[1]->healthFlagClear(
@@ -2979,8 +2979,8 @@ TEST_F(StaticClusterImplTest, HealthyStat) {
                                HealthTransition::Changed, HealthState::Healthy);
   EXPECT_EQ(0UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
   EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->degradedHosts().size());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(1UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(1UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   // Then go healthy.
   cluster->prioritySet().hostSetsPerPriority()[0]->hosts()[1]->healthFlagClear(
@@ -2989,8 +2989,8 @@ TEST_F(StaticClusterImplTest, HealthyStat) {
                                HealthTransition::Changed, HealthState::Healthy);
   EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
   EXPECT_EQ(0UL, cluster->prioritySet().hostSetsPerPriority()[0]->degradedHosts().size());
-  EXPECT_EQ(1UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(1UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
 }
 
 TEST_F(StaticClusterImplTest, InitialHostsDisableHC) {
@@ -3044,8 +3044,8 @@ TEST_F(StaticClusterImplTest, InitialHostsDisableHC) {
   // The endpoint with disabled active health check is considered healthy.
   EXPECT_EQ(2UL, cluster->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(1UL, cluster->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(1UL, cluster->info()->endpointStats().membership_healthy_.value());
-  EXPECT_EQ(0UL, cluster->info()->endpointStats().membership_degraded_.value());
+  EXPECT_EQ(1UL, cluster->info()->endpointStats()->membership_healthy_.value());
+  EXPECT_EQ(0UL, cluster->info()->endpointStats()->membership_degraded_.value());
 
   // Perform a health check for the second host, and then the initialization is finished.
   EXPECT_CALL(initialized, ready());
@@ -4930,6 +4930,76 @@ TEST_P(ParametrizedClusterInfoImplTest, TestTrackTimeoutBudgets) {
             tb_stats.upstream_rq_timeout_budget_per_try_percent_used_.unit());
 }
 
+// With deferred creation, the optional histograms are only created when they are first used.
+TEST_P(ParametrizedClusterInfoImplTest, DeferredOptionalClusterStats) {
+  ON_CALL(server_context_.stats_config_, enableDeferredCreationStats())
+      .WillByDefault(Return(true));
+  const std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    lb_policy: ROUND_ROBIN
+    track_cluster_stats: { timeout_budgets : true, request_response_sizes : true }
+  )EOF";
+
+  auto cluster = makeCluster(yaml);
+  EXPECT_FALSE(
+      stats_.findHistogramByString("cluster.name.upstream_rq_timeout_budget_percent_used"));
+  EXPECT_FALSE(stats_.findHistogramByString("cluster.name.upstream_rq_headers_size"));
+  // Deferred stats are absent until created, rather than present with a zero value.
+  EXPECT_FALSE(stats_.findCounterByString("cluster.name.upstream_rq_total"));
+  EXPECT_FALSE(stats_.findCounterByString("cluster.name.update_attempt"));
+  EXPECT_FALSE(stats_.findGaugeByString("cluster.name.membership_total"));
+  EXPECT_FALSE(stats_.findCounterByString("cluster.name.lb_healthy_panic"));
+  EXPECT_FALSE(stats_.findGaugeByString("cluster.name.circuit_breakers.default.cx_open"));
+  // Every cluster warms, so the warming state gauge is always created.
+  EXPECT_TRUE(stats_.findGaugeByString("cluster.name.warming_state"));
+
+  // The uncreated stats are reported, relative to the cluster's scope, so admin can render them.
+  Stats::SymbolTable& symbol_table = stats_.symbolTable();
+  auto join = [&symbol_table](Stats::StatName prefix, Stats::StatName name) {
+    return prefix.empty() ? symbol_table.toString(name)
+                          : absl::StrCat(symbol_table.toString(prefix), ".",
+                                         symbol_table.toString(name));
+  };
+  std::vector<std::string> counters;
+  std::vector<std::string> gauges;
+  auto collect = [&]() {
+    counters.clear();
+    gauges.clear();
+    cluster->info()->forEachUncreatedStat(
+        [&](Stats::StatName prefix, Stats::StatName name) {
+          counters.push_back(join(prefix, name));
+        },
+        [&](Stats::StatName prefix, Stats::StatName name) {
+          gauges.push_back(join(prefix, name));
+        });
+  };
+  collect();
+  EXPECT_THAT(counters, testing::Contains("upstream_rq_total"));
+  EXPECT_THAT(counters, testing::Contains("update_attempt"));
+  EXPECT_THAT(counters, testing::Contains("lb_healthy_panic"));
+  EXPECT_THAT(gauges, testing::Contains("membership_total"));
+  EXPECT_THAT(gauges, testing::Contains("circuit_breakers.default.cx_open"));
+  EXPECT_THAT(gauges, testing::Contains("circuit_breakers.high.rq_retry_open"));
+
+  cluster->info()->lbStats()->lb_healthy_panic_.inc();
+  EXPECT_TRUE(stats_.findCounterByString("cluster.name.lb_healthy_panic"));
+  collect();
+  EXPECT_THAT(counters, testing::Not(testing::Contains("lb_healthy_panic")));
+
+  ASSERT_TRUE(cluster->info()->timeoutBudgetStats().has_value());
+  EXPECT_TRUE(
+      stats_.findHistogramByString("cluster.name.upstream_rq_timeout_budget_percent_used"));
+  EXPECT_EQ(1, stats_.findGaugeByString("cluster.name.ClusterTimeoutBudgetStats.initialized")
+                   ->get()
+                   .value());
+  EXPECT_FALSE(stats_.findHistogramByString("cluster.name.upstream_rq_headers_size"));
+
+  ASSERT_TRUE(cluster->info()->requestResponseSizeStats().has_value());
+  EXPECT_TRUE(stats_.findHistogramByString("cluster.name.upstream_rq_headers_size"));
+}
+
 TEST_P(ParametrizedClusterInfoImplTest, DEPRECATED_FEATURE_TEST(TestTrackTimeoutBudgetsOld)) {
   // Check that without the flag specified, the histogram is null.
   const std::string yaml_disabled = R"EOF(
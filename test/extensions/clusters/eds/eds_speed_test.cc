@@ -17,6 +17,7 @@
 #include "source/extensions/config_subscription/grpc/grpc_mux_impl.h"
 #include "source/extensions/config_subscription/grpc/grpc_subscription_impl.h"
 #include "source/extensions/config_subscription/grpc/xds_mux/grpc_mux_impl.h"
+#include "source/extensions/load_balancing_policies/round_robin/round_robin_lb.h"
 #include "source/server/transport_socket_config_impl.h"
 
 #include "test/benchmark/main.h"
@@ -147,6 +148,53 @@ public:
     // this is what we're actually testing:
     validation_visitor_.setSkipValidation(ignore_unknown_dynamic_fields);
 
+    deliverUpdate(cluster_load_assignment);
+    ASSERT(cluster_->prioritySet().hostSetsPerPriority()[1]->hostsPerLocality().get()[0].size() ==
+           num_hosts);
+  }
+
+  // Set up an EDS config with num_hosts weighted hosts, starting from the first_host'th one. An
+  // update with first_host one more than the previous update replaces a single host.
+  void rollingUpdateHelper(size_t num_hosts, size_t first_host) {
+    state_.PauseTiming();
+
+    envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+    cluster_load_assignment.set_cluster_name("fare");
+    auto* endpoints = cluster_load_assignment.add_endpoints();
+    auto* locality = endpoints->mutable_locality();
+    locality->set_region("region");
+    locality->set_zone("zone");
+    locality->set_sub_zone("sub_zone");
+    endpoints->mutable_load_balancing_weight()->set_value(1);
+
+    for (size_t i = first_host; i < first_host + num_hosts; ++i) {
+      auto* lb_endpoint = endpoints->add_lb_endpoints();
+      lb_endpoint->set_health_status(envoy::config::core::v3::HEALTHY);
+      lb_endpoint->mutable_load_balancing_weight()->set_value(1 + i % 3);
+      auto* socket_address =
+          lb_endpoint->mutable_endpoint()->mutable_address()->mutable_socket_address();
+      socket_address->set_address(fmt::format("10.0.{}.{}", i / 256 % 256, i % 256));
+      socket_address->set_port_value(1000 + i / 65536);
+    }
+    validation_visitor_.setSkipValidation(true);
+
+    deliverUpdate(cluster_load_assignment);
+    ASSERT(cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size() == num_hosts);
+  }
+
+  // Creates a round robin load balancer on the cluster's hosts, which is refreshed by each update
+  // the same way worker load balancers are.
+  void createLoadBalancer() {
+    lb_ = std::make_unique<RoundRobinLoadBalancer>(
+        cluster_->prioritySet(), nullptr, cluster_->info()->lbStats(),
+        server_context_.runtime_loader_, random_, 50,
+        envoy::extensions::load_balancing_policies::round_robin::v3::RoundRobin(),
+        server_context_.time_system_);
+  }
+
+  // Delivers an EDS update with the given assignment. Expects timing to be paused, and resumes it.
+  void deliverUpdate(
+      const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment) {
     auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
     response->set_type_url(type_url_);
     response->set_version_info(fmt::format("version-{}", version_++));
@@ -162,8 +210,6 @@ public:
           .grpcStreamForTest()
           .onReceiveMessage(std::move(response));
     }
-    ASSERT(cluster_->prioritySet().hostSetsPerPriority()[1]->hostsPerLocality().get()[0].size() ==
-           num_hosts);
   }
 
   NiceMock<Server::Configuration::MockServerFactoryContext> server_context_;
@@ -191,6 +237,7 @@ public:
   Config::GrpcMuxSharedPtr grpc_mux_;
   Config::GrpcSubscriptionImplPtr subscription_;
   NiceMock<AccessLog::MockAccessLogManager> access_log_manager_;
+  std::unique_ptr<RoundRobinLoadBalancer> lb_;
 };
 
 } // namespace Upstream
@@ -243,3 +290,29 @@ static void healthOnlyUpdate(State& state) {
 }
 
 BENCHMARK(healthOnlyUpdate)->Ranges({{1, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
+
+// Measures updates which each replace a single host of a weighted cluster with a load balancer,
+// with the load balancer schedulers updated in place or rebuilt. The initial update is included.
+static void rollingUpdate(State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  Envoy::TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.edf_lb_update_schedulers_in_place",
+                               state.range(1) ? "true" : "false"}});
+  constexpr size_t num_updates = 10;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    Envoy::Upstream::EdsSpeedTest speed_test(state, false);
+    uint32_t endpoints = skipExpensiveBenchmarks() ? 1 : state.range(0);
+
+    speed_test.rollingUpdateHelper(endpoints, 0);
+    state.PauseTiming();
+    speed_test.createLoadBalancer();
+    state.ResumeTiming();
+    for (size_t i = 1; i <= num_updates; ++i) {
+      speed_test.rollingUpdateHelper(endpoints, i);
+    }
+  }
+}
+
+BENCHMARK(rollingUpdate)->Ranges({{1000, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
@@ -156,14 +156,14 @@ protected:
                   TestUtility::makeDnsResponse({"127.0.0.1", "127.0.0.2"}));
 
     const auto previous_update_no_rebuild =
-        cluster_->info()->configUpdateStats().update_no_rebuild_.value();
+        cluster_->info()->configUpdateStats()->update_no_rebuild_.value();
 
     EXPECT_CALL(*resolve_timer_, enableTimer(std::chrono::milliseconds(4000), _));
     dns_callback_(Network::DnsResolver::ResolutionStatus::Completed, "",
                   TestUtility::makeDnsResponse({"127.0.0.1", "127.0.0.2"}));
 
     EXPECT_EQ(previous_update_no_rebuild + 1,
-              cluster_->info()->configUpdateStats().update_no_rebuild_.value());
+              cluster_->info()->configUpdateStats()->update_no_rebuild_.value());
 
     EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
     EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
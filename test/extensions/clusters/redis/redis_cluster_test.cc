@@ -822,7 +822,7 @@ TEST_F(RedisClusterTest, AddressAsHostname) {
   EXPECT_CALL(*cluster_callback_, onClusterSlotUpdate(_, _));
   expectClusterSlotResponse(singleSlotPrimaryReplica("primary.com", "replica.org", 22120));
   expectHealthyHosts(std::list<std::string>({"127.0.1.1:22120", "127.0.1.2:22120"}));
-  EXPECT_EQ(0U, cluster_->info()->configUpdateStats().update_failure_.value());
+  EXPECT_EQ(0U, cluster_->info()->configUpdateStats()->update_failure_.value());
 
   // 2. Single slot with just the primary hostname
   expectRedisResolve(true);
@@ -833,7 +833,7 @@ TEST_F(RedisClusterTest, AddressAsHostname) {
   EXPECT_CALL(*cluster_callback_, onClusterSlotUpdate(_, _));
   expectClusterSlotResponse(singleSlotPrimary("primary.com", 22120));
   expectHealthyHosts(std::list<std::string>({"127.0.1.1:22120"}));
-  EXPECT_EQ(0U, cluster_->info()->configUpdateStats().update_failure_.value());
+  EXPECT_EQ(0U, cluster_->info()->configUpdateStats()->update_failure_.value());
 
   // 2. Single slot with just the primary IP address and replica hostname
   expectRedisResolve();
@@ -844,7 +844,7 @@ TEST_F(RedisClusterTest, AddressAsHostname) {
   EXPECT_CALL(*cluster_callback_, onClusterSlotUpdate(_, _));
   expectClusterSlotResponse(singleSlotPrimaryReplica("127.0.1.1", "replica.org", 22120));
   expectHealthyHosts(std::list<std::string>({"127.0.1.1:22120", "127.0.1.2:22120"}));
-  EXPECT_EQ(0U, cluster_->info()->configUpdateStats().update_failure_.value());
+  EXPECT_EQ(0U, cluster_->info()->configUpdateStats()->update_failure_.value());
 }
 
 TEST_F(RedisClusterTest, AddressAsHostnameParallelResolution) {
@@ -879,7 +879,7 @@ TEST_F(RedisClusterTest, AddressAsHostnameParallelResolution) {
       "127.0.1.1:22120",
       "127.0.1.2:22120",
   }));
-  EXPECT_EQ(0U, cluster_->info()->configUpdateStats().update_failure_.value());
+  EXPECT_EQ(0U, cluster_->info()->configUpdateStats()->update_failure_.value());
 }
 
 TEST_F(RedisClusterTest, AddressAsHostnameFailure) {
@@ -912,7 +912,7 @@ TEST_F(RedisClusterTest, AddressAsHostnameFailure) {
   EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
   expectHealthyHosts(std::list<std::string>({"127.0.1.1:22120"}));
-  EXPECT_EQ(1UL, cluster_->info()->configUpdateStats().update_failure_.value());
+  EXPECT_EQ(1UL, cluster_->info()->configUpdateStats()->update_failure_.value());
 
   // 2. Primary resolution fails, so replica resolution is not even called.
   // Expect cluster slot update to be successful, with just one healthy host, and failure counter to
@@ -931,7 +931,7 @@ TEST_F(RedisClusterTest, AddressAsHostnameFailure) {
   // healthy hosts is same as before, but failure count increases by 1
   EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(1UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(2UL, cluster_->info()->configUpdateStats().update_failure_.value());
+  EXPECT_EQ(2UL, cluster_->info()->configUpdateStats()->update_failure_.value());
 }
 
 TEST_F(RedisClusterTest, AddressAsHostnamePrimaryEmptyDnsResponse) {
@@ -967,7 +967,7 @@ TEST_F(RedisClusterTest, AddressAsHostnamePrimaryEmptyDnsResponse) {
   expectClusterSlotResponse(singleSlotPrimaryReplica("primary.com", "replica.org", 22121));
   expectHealthyHosts(std::list<std::string>({"127.0.1.1:22120", "127.0.1.2:22120"}));
   // Empty DNS response.
-  EXPECT_EQ(1UL, cluster_->info()->configUpdateStats().update_empty_.value());
+  EXPECT_EQ(1UL, cluster_->info()->configUpdateStats()->update_empty_.value());
 }
 
 TEST_F(RedisClusterTest, AddressAsHostnameReplicaEmptyDnsResponse) {
@@ -994,7 +994,7 @@ TEST_F(RedisClusterTest, AddressAsHostnameReplicaEmptyDnsResponse) {
   // Only the primary host is healthy.
   expectHealthyHosts(std::list<std::string>({"127.0.1.1:22120"}));
   // Empty DNS response.
-  EXPECT_EQ(1U, cluster_->info()->configUpdateStats().update_empty_.value());
+  EXPECT_EQ(1U, cluster_->info()->configUpdateStats()->update_empty_.value());
 }
 
 TEST_F(RedisClusterTest, AddressAsHostnamePartialReplicaEmptyDnsResponse) {
@@ -1025,7 +1025,7 @@ TEST_F(RedisClusterTest, AddressAsHostnamePartialReplicaEmptyDnsResponse) {
   // Only the primary host and one replica are healthy.
   expectHealthyHosts(std::list<std::string>({"127.0.1.1:22120", "127.0.1.2:22120"}));
   // Empty DNS response.
-  EXPECT_EQ(1U, cluster_->info()->configUpdateStats().update_empty_.value());
+  EXPECT_EQ(1U, cluster_->info()->configUpdateStats()->update_empty_.value());
 }
 
 TEST_F(RedisClusterTest, DontWaitForDNSOnInit) {
@@ -1043,8 +1043,8 @@ TEST_F(RedisClusterTest, DontWaitForDNSOnInit) {
   });
 
   expectClusterSlotFailure();
-  EXPECT_EQ(1U, cluster_->info()->configUpdateStats().update_attempt_.value());
-  EXPECT_EQ(1U, cluster_->info()->configUpdateStats().update_failure_.value());
+  EXPECT_EQ(1U, cluster_->info()->configUpdateStats()->update_attempt_.value());
+  EXPECT_EQ(1U, cluster_->info()->configUpdateStats()->update_failure_.value());
 }
 
 TEST_F(RedisClusterTest, AddressAsHostnamePartialReplicaFailure) {
@@ -1096,7 +1096,7 @@ TEST_F(RedisClusterTest, EmptyDnsResponse) {
 
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(1U, cluster_->info()->configUpdateStats().update_empty_.value());
+  EXPECT_EQ(1U, cluster_->info()->configUpdateStats()->update_empty_.value());
 
   // Does not recreate the timer on subsequent DNS resolve calls.
   EXPECT_CALL(*dns_timer, enableTimer(_, _));
@@ -1105,7 +1105,7 @@ TEST_F(RedisClusterTest, EmptyDnsResponse) {
 
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(2U, cluster_->info()->configUpdateStats().update_empty_.value());
+  EXPECT_EQ(2U, cluster_->info()->configUpdateStats()->update_empty_.value());
 }
 
 TEST_F(RedisClusterTest, FailedDnsResponse) {
@@ -1124,7 +1124,7 @@ TEST_F(RedisClusterTest, FailedDnsResponse) {
 
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(0U, cluster_->info()->configUpdateStats().update_empty_.value());
+  EXPECT_EQ(0U, cluster_->info()->configUpdateStats()->update_empty_.value());
 
   // Does not recreate the timer on subsequent DNS resolve calls.
   EXPECT_CALL(*dns_timer, enableTimer(_, _));
@@ -1133,7 +1133,7 @@ TEST_F(RedisClusterTest, FailedDnsResponse) {
 
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
   EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->healthyHosts().size());
-  EXPECT_EQ(1U, cluster_->info()->configUpdateStats().update_empty_.value());
+  EXPECT_EQ(1U, cluster_->info()->configUpdateStats()->update_empty_.value());
 }
 
 TEST_F(RedisClusterTest, Basic) {
@@ -1182,8 +1182,8 @@ TEST_F(RedisClusterTest, RedisResolveFailure) {
 
   // Initialization will wait til the redis cluster succeed.
   expectClusterSlotFailure();
-  EXPECT_EQ(1U, cluster_->info()->configUpdateStats().update_attempt_.value());
-  EXPECT_EQ(1U, cluster_->info()->configUpdateStats().update_failure_.value());
+  EXPECT_EQ(1U, cluster_->info()->configUpdateStats()->update_attempt_.value());
+  EXPECT_EQ(1U, cluster_->info()->configUpdateStats()->update_failure_.value());
 
   expectRedisResolve(true);
   resolve_timer_->invokeCallback();
@@ -1198,8 +1198,8 @@ TEST_F(RedisClusterTest, RedisResolveFailure) {
   resolve_timer_->invokeCallback();
   expectClusterSlotFailure();
   expectHealthyHosts(std::list<std::string>({"127.0.0.1:22120", "127.0.0.2:22120"}));
-  EXPECT_EQ(3U, cluster_->info()->configUpdateStats().update_attempt_.value());
-  EXPECT_EQ(2U, cluster_->info()->configUpdateStats().update_failure_.value());
+  EXPECT_EQ(3U, cluster_->info()->configUpdateStats()->update_attempt_.value());
+  EXPECT_EQ(2U, cluster_->info()->configUpdateStats()->update_failure_.value());
 }
 
 TEST_F(RedisClusterTest, FactoryInitNotRedisClusterTypeFailure) {
@@ -1258,8 +1258,8 @@ TEST_F(RedisClusterTest, RedisErrorResponse) {
 
   EXPECT_CALL(*cluster_callback_, onClusterSlotUpdate(_, _)).Times(0);
   expectClusterSlotResponse(std::move(hello_world_response));
-  EXPECT_EQ(1U, cluster_->info()->configUpdateStats().update_attempt_.value());
-  EXPECT_EQ(1U, cluster_->info()->configUpdateStats().update_failure_.value());
+  EXPECT_EQ(1U, cluster_->info()->configUpdateStats()->update_attempt_.value());
+  EXPECT_EQ(1U, cluster_->info()->configUpdateStats()->update_failure_.value());
 
   expectRedisResolve();
   resolve_timer_->invokeCallback();
@@ -1284,9 +1284,9 @@ TEST_F(RedisClusterTest, RedisErrorResponse) {
     }
     expectClusterSlotResponse(createResponse(flags, no_replica));
     expectHealthyHosts(std::list<std::string>({"127.0.0.1:22120"}));
-    EXPECT_EQ(++update_attempt, cluster_->info()->configUpdateStats().update_attempt_.value());
+    EXPECT_EQ(++update_attempt, cluster_->info()->configUpdateStats()->update_attempt_.value());
     if (!flags.all()) {
-      EXPECT_EQ(++update_failure, cluster_->info()->configUpdateStats().update_failure_.value());
+      EXPECT_EQ(++update_failure, cluster_->info()->configUpdateStats()->update_failure_.value());
     }
   }
 }
@@ -1324,9 +1324,9 @@ TEST_F(RedisClusterTest, RedisReplicaErrorResponse) {
     }
     expectHealthyHosts(std::list<std::string>({"127.0.0.1:22120"}));
     expectClusterSlotResponse(createResponse(single_slot_primary, replica_flags));
-    EXPECT_EQ(++update_attempt, cluster_->info()->configUpdateStats().update_attempt_.value());
+    EXPECT_EQ(++update_attempt, cluster_->info()->configUpdateStats()->update_attempt_.value());
     if (!(replica_flags.all() || replica_flags.none())) {
-      EXPECT_EQ(++update_failure, cluster_->info()->configUpdateStats().update_failure_.value());
+      EXPECT_EQ(++update_failure, cluster_->info()->configUpdateStats()->update_failure_.value());
     }
   }
 }
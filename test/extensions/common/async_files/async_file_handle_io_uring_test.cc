@@ -0,0 +1,198 @@
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "envoy/extensions/common/async_files/v3/async_file_manager.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/common/singleton/manager_impl.h"
+#include "source/extensions/common/async_files/async_file_handle.h"
+#include "source/extensions/common/async_files/async_file_manager.h"
+#include "source/extensions/common/async_files/async_file_manager_factory.h"
+
+#include "test/test_common/status_utility.h"
+#include "test/test_common/utility.h"
+
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+namespace {
+
+using StatusHelpers::IsOkAndHolds;
+using ::testing::HasSubstr;
+
+class AsyncFileHandleIoUringTest : public testing::Test {
+public:
+  void SetUp() override {
+    if (!Io::isIoUringSupported()) {
+      GTEST_SKIP() << "io_uring is not supported";
+    }
+    envoy::extensions::common::async_files::v3::AsyncFileManagerConfig config;
+    config.mutable_io_uring()->set_io_uring_size(4);
+    config.mutable_io_uring()->mutable_thread_pool()->set_thread_count(1);
+    manager_ = factory_->getAsyncFileManager(config);
+  }
+
+  void resolveFileActions() {
+    manager_->waitForIdle();
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+  }
+  void close(AsyncFileHandle& handle) {
+    absl::Status close_result = absl::InternalError("not set");
+    EXPECT_OK(
+        handle->close(dispatcher_.get(), [&](absl::Status status) { close_result = status; }));
+    resolveFileActions();
+    EXPECT_OK(close_result);
+  }
+  AsyncFileHandle createAnonymousFile() {
+    AsyncFileHandle create_result;
+    manager_->createAnonymousFile(
+        dispatcher_.get(), tmpdir_,
+        [&](absl::StatusOr<AsyncFileHandle> result) { create_result = result.value(); });
+    resolveFileActions();
+    return create_result;
+  }
+  absl::StatusOr<size_t> write(AsyncFileHandle& handle, Buffer::Instance& contents, off_t offset) {
+    absl::StatusOr<size_t> write_status = absl::InternalError("not set");
+    EXPECT_OK(handle->write(dispatcher_.get(), contents, offset,
+                            [&](absl::StatusOr<size_t> status) { write_status = status; }));
+    resolveFileActions();
+    return write_status;
+  }
+  absl::StatusOr<Buffer::InstancePtr> read(AsyncFileHandle& handle, off_t offset, size_t length) {
+    absl::StatusOr<Buffer::InstancePtr> read_status = absl::InternalError("not set");
+    EXPECT_OK(handle->read(
+        dispatcher_.get(), offset, length,
+        [&](absl::StatusOr<Buffer::InstancePtr> status) { read_status = std::move(status); }));
+    resolveFileActions();
+    return read_status;
+  }
+
+  const char* test_tmpdir = std::getenv("TEST_TMPDIR");
+  std::string tmpdir_ = test_tmpdir ? test_tmpdir : "/tmp";
+
+  std::unique_ptr<Singleton::ManagerImpl> singleton_manager_ =
+      std::make_unique<Singleton::ManagerImpl>();
+  std::shared_ptr<AsyncFileManagerFactory> factory_ =
+      AsyncFileManagerFactory::singleton(singleton_manager_.get());
+  std::shared_ptr<AsyncFileManager> manager_;
+  Api::ApiPtr api_ = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher_ = api_->allocateDispatcher("test_thread");
+};
+
+TEST_F(AsyncFileHandleIoUringTest, DescribeIncludesIoUringSize) {
+  EXPECT_THAT(manager_->describe(), HasSubstr("io_uring_size = 4"));
+}
+
+TEST_F(AsyncFileHandleIoUringTest, WriteReadClose) {
+  auto handle = createAnonymousFile();
+  Buffer::OwnedImpl hello("hello");
+  EXPECT_THAT(write(handle, hello, 0), IsOkAndHolds(5U));
+  Buffer::OwnedImpl two_chars("p!");
+  EXPECT_THAT(write(handle, two_chars, 3), IsOkAndHolds(2U));
+  auto read_status = read(handle, 0, 5);
+  ASSERT_OK(read_status);
+  EXPECT_THAT(*read_status.value(), BufferStringEqual("help!"));
+  auto second_read_status = read(handle, 2, 3);
+  ASSERT_OK(second_read_status);
+  EXPECT_THAT(*second_read_status.value(), BufferStringEqual("lp!"));
+  close(handle);
+}
+
+TEST_F(AsyncFileHandleIoUringTest, ReadPastEndOfFileReturnsPartialResult) {
+  auto handle = createAnonymousFile();
+  Buffer::OwnedImpl hello("hello");
+  EXPECT_THAT(write(handle, hello, 0), IsOkAndHolds(5U));
+  auto read_status = read(handle, 3, 100);
+  ASSERT_OK(read_status);
+  EXPECT_THAT(*read_status.value(), BufferStringEqual("lo"));
+  close(handle);
+}
+
+TEST_F(AsyncFileHandleIoUringTest, WriteWithMoreSlicesThanOneWritevAccepts) {
+  auto handle = createAnonymousFile();
+  Buffer::OwnedImpl contents;
+  std::string expected;
+  for (int i = 0; i < 3000; i++) {
+    const std::string piece = absl::StrCat(i, ",");
+    // Separate slices, so that the write needs more than one writev.
+    contents.appendSliceForTest(piece);
+    expected += piece;
+  }
+  ASSERT_GT(contents.getRawSlices().size(), static_cast<size_t>(IOV_MAX));
+  EXPECT_THAT(write(handle, contents, 0), IsOkAndHolds(expected.size()));
+  auto read_status = read(handle, 0, expected.size());
+  ASSERT_OK(read_status);
+  EXPECT_EQ(read_status.value()->toString(), expected);
+  close(handle);
+}
+
+TEST_F(AsyncFileHandleIoUringTest, MoreOperationsInFlightThanRingEntries) {
+  auto handle = createAnonymousFile();
+  Buffer::OwnedImpl hello("hello");
+  EXPECT_THAT(write(handle, hello, 0), IsOkAndHolds(5U));
+  int completed = 0;
+  for (int i = 0; i < 20; i++) {
+    EXPECT_OK(handle->read(dispatcher_.get(), i % 5, 1,
+                           [&completed](absl::StatusOr<Buffer::InstancePtr> status) {
+                             EXPECT_OK(status);
+                             completed++;
+                           }));
+  }
+  resolveFileActions();
+  EXPECT_EQ(completed, 20);
+  close(handle);
+}
+
+TEST_F(AsyncFileHandleIoUringTest, CancelPreventsCallback) {
+  auto handle = createAnonymousFile();
+  bool called = false;
+  auto cancel = handle->read(dispatcher_.get(), 0, 5,
+                             [&called](absl::StatusOr<Buffer::InstancePtr>) { called = true; });
+  ASSERT_OK(cancel);
+  std::move(cancel.value())();
+  resolveFileActions();
+  EXPECT_FALSE(called);
+  close(handle);
+}
+
+TEST_F(AsyncFileHandleIoUringTest, ReadAfterCloseFails) {
+  auto handle = createAnonymousFile();
+  Buffer::OwnedImpl hello("hello");
+  EXPECT_THAT(write(handle, hello, 0), IsOkAndHolds(5U));
+  close(handle);
+  EXPECT_EQ(absl::StatusCode::kFailedPrecondition,
+            handle->read(dispatcher_.get(), 0, 5, [](absl::StatusOr<Buffer::InstancePtr>) {})
+                .status()
+                .code());
+}
+
+TEST_F(AsyncFileHandleIoUringTest, DuplicatedHandleUsesIoUring) {
+  auto handle = createAnonymousFile();
+  Buffer::OwnedImpl hello("hello");
+  EXPECT_THAT(write(handle, hello, 0), IsOkAndHolds(5U));
+  AsyncFileHandle duplicate;
+  EXPECT_OK(handle->duplicate(dispatcher_.get(), [&](absl::StatusOr<AsyncFileHandle> result) {
+    duplicate = std::move(result.value());
+  }));
+  resolveFileActions();
+  ASSERT_NE(duplicate, nullptr);
+  close(handle);
+  auto read_status = read(duplicate, 0, 5);
+  ASSERT_OK(read_status);
+  EXPECT_THAT(*read_status.value(), BufferStringEqual("hello"));
+  close(duplicate);
+}
+
+} // namespace
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,126 @@
+// Compares AsyncFileManagerThreadPool and AsyncFileManagerIoUring writing and reading a file in
+// the test's temporary directory, with a configurable number of operations in flight.
+
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/common/async_files/v3/async_file_manager.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/common/singleton/manager_impl.h"
+#include "source/extensions/common/async_files/async_file_handle.h"
+#include "source/extensions/common/async_files/async_file_manager.h"
+#include "source/extensions/common/async_files/async_file_manager_factory.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Common {
+namespace AsyncFiles {
+namespace {
+
+constexpr size_t ChunkSize = 64 * 1024;
+constexpr size_t ChunkCount = 64;
+
+class AsyncFileManagerSpeedTest {
+public:
+  explicit AsyncFileManagerSpeedTest(bool io_uring) {
+    envoy::extensions::common::async_files::v3::AsyncFileManagerConfig config;
+    if (io_uring) {
+      config.mutable_io_uring()->mutable_thread_pool()->set_thread_count(4);
+    } else {
+      config.mutable_thread_pool()->set_thread_count(4);
+    }
+    manager_ = factory_->getAsyncFileManager(config);
+    manager_->createAnonymousFile(dispatcher_.get(), tmpdir_,
+                                  [this](absl::StatusOr<AsyncFileHandle> result) {
+                                    RELEASE_ASSERT(result.ok(), result.status().ToString());
+                                    handle_ = std::move(result.value());
+                                  });
+    resolveFileActions();
+  }
+
+  ~AsyncFileManagerSpeedTest() {
+    auto cancel = handle_->close(dispatcher_.get(), [](absl::Status) {});
+    RELEASE_ASSERT(cancel.ok(), cancel.status().ToString());
+    resolveFileActions();
+  }
+
+  // Writes ChunkCount chunks then reads them back, keeping up to `depth` operations in flight.
+  void writeThenRead(size_t depth) {
+    const std::string chunk(ChunkSize, 'a');
+    for (size_t start = 0; start < ChunkCount; start += depth) {
+      for (size_t i = start; i < std::min(start + depth, ChunkCount); i++) {
+        Buffer::OwnedImpl contents(chunk);
+        auto cancel = handle_->write(dispatcher_.get(), contents, i * ChunkSize,
+                                     [](absl::StatusOr<size_t> result) {
+                                       RELEASE_ASSERT(result.ok() && result.value() == ChunkSize,
+                                                      "write failed");
+                                     });
+        RELEASE_ASSERT(cancel.ok(), cancel.status().ToString());
+      }
+      resolveFileActions();
+    }
+    for (size_t start = 0; start < ChunkCount; start += depth) {
+      for (size_t i = start; i < std::min(start + depth, ChunkCount); i++) {
+        auto cancel = handle_->read(dispatcher_.get(), i * ChunkSize, ChunkSize,
+                                    [](absl::StatusOr<Buffer::InstancePtr> result) {
+                                      RELEASE_ASSERT(result.ok() &&
+                                                         result.value()->length() == ChunkSize,
+                                                     "read failed");
+                                    });
+        RELEASE_ASSERT(cancel.ok(), cancel.status().ToString());
+      }
+      resolveFileActions();
+    }
+  }
+
+private:
+  void resolveFileActions() {
+    manager_->waitForIdle();
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+
+  const char* test_tmpdir_ = std::getenv("TEST_TMPDIR");
+  const std::string tmpdir_ = test_tmpdir_ ? test_tmpdir_ : "/tmp";
+  Singleton::ManagerImpl singleton_manager_;
+  std::shared_ptr<AsyncFileManagerFactory> factory_ =
+      AsyncFileManagerFactory::singleton(&singleton_manager_);
+  std::shared_ptr<AsyncFileManager> manager_;
+  Api::ApiPtr api_ = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher_ = api_->allocateDispatcher("test_thread");
+  AsyncFileHandle handle_;
+};
+
+void runWriteThenRead(benchmark::State& state, bool io_uring) {
+  AsyncFileManagerSpeedTest test(io_uring);
+  for (auto _ : state) { // NOLINT
+    test.writeThenRead(state.range(0));
+  }
+  state.SetBytesProcessed(state.iterations() * ChunkCount * ChunkSize * 2);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_ThreadPoolWriteThenRead(benchmark::State& state) { runWriteThenRead(state, false); }
+BENCHMARK(BM_ThreadPoolWriteThenRead)->Arg(1)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+void BM_IoUringWriteThenRead(benchmark::State& state) {
+  if (!Io::isIoUringSupported()) {
+    state.SkipWithError("io_uring is not supported");
+    return;
+  }
+  runWriteThenRead(state, true);
+}
+BENCHMARK(BM_IoUringWriteThenRead)->Arg(1)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace AsyncFiles
+} // namespace Common
+} // namespace Extensions
+} // namespace Envoy
@@ -799,6 +799,47 @@ TEST_F(HttpConnectionManagerConfigTest, MaxRequestHeadersKbDefault) {
   EXPECT_EQ(60, config.maxRequestHeadersKb());
 }
 
+// The arena's initial block is capped at what the filter wrappers take.
+TEST_F(HttpConnectionManagerConfigTest, PerStreamArenaBytesCappedToFilterWrappers) {
+  const std::string yaml_string = R"EOF(
+  stat_prefix: ingress_http
+  per_stream_arena_bytes: 1048576
+  route_config:
+    name: local_route
+  http_filters:
+  - name: envoy.filters.http.router
+    typed_config:
+      "@type": type.googleapis.com/envoy.extensions.filters.http.router.v3.Router
+  )EOF";
+
+  HttpConnectionManagerConfig config(parseHttpConnectionManagerFromYaml(yaml_string), context_,
+                                     date_provider_, route_config_provider_manager_,
+                                     &scoped_routes_config_provider_manager_, tracer_manager_,
+                                     filter_config_provider_manager_, creation_status_);
+  ASSERT_TRUE(creation_status_.ok());
+  EXPECT_EQ(Http::FilterManager::arenaBytesPerFilter(), config.perStreamArenaBytes());
+}
+
+TEST_F(HttpConnectionManagerConfigTest, PerStreamArenaBytesBelowCap) {
+  const std::string yaml_string = R"EOF(
+  stat_prefix: ingress_http
+  per_stream_arena_bytes: 16
+  route_config:
+    name: local_route
+  http_filters:
+  - name: envoy.filters.http.router
+    typed_config:
+      "@type": type.googleapis.com/envoy.extensions.filters.http.router.v3.Router
+  )EOF";
+
+  HttpConnectionManagerConfig config(parseHttpConnectionManagerFromYaml(yaml_string), context_,
+                                     date_provider_, route_config_provider_manager_,
+                                     &scoped_routes_config_provider_manager_, tracer_manager_,
+                                     filter_config_provider_manager_, creation_status_);
+  ASSERT_TRUE(creation_status_.ok());
+  EXPECT_EQ(16, config.perStreamArenaBytes());
+}
+
 TEST_F(HttpConnectionManagerConfigTest, MaxRequestHeadersKbConfigured) {
   const std::string yaml_string = R"EOF(
   stat_prefix: ingress_http
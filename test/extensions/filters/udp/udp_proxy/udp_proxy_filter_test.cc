@@ -19,6 +19,7 @@
 #include "test/extensions/filters/udp/udp_proxy/session_filters/psc_setter.pb.h"
 #include "test/mocks/api/mocks.h"
 #include "test/mocks/http/stream_encoder.h"
+#include "test/mocks/network/mocks.h"
 #include "test/mocks/network/socket.h"
 #include "test/mocks/server/factory_context.h"
 #include "test/mocks/server/listener_factory_context.h"
@@ -28,6 +29,7 @@
 #include "test/mocks/upstream/host.h"
 #include "test/mocks/upstream/load_balancer_context.h"
 #include "test/mocks/upstream/thread_local_cluster.h"
+#include "test/test_common/registry.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 
 #include "gmock/gmock.h"
@@ -93,6 +95,27 @@ public:
         PerPacketLoadBalancingUdpProxyFilter(callbacks, config) {}
 };
 
+// Hands out a single preset writer, so that tests can set expectations on it.
+class TestUdpPacketWriterFactoryFactory : public Network::UdpPacketWriterFactoryFactory {
+public:
+  Network::UdpPacketWriterFactoryPtr
+  createUdpPacketWriterFactory(const envoy::config::core::v3::TypedExtensionConfig&) override {
+    auto factory = std::make_unique<NiceMock<Network::MockUdpPacketWriterFactory>>();
+    ON_CALL(*factory, createUdpPacketWriter(_, _))
+        .WillByDefault(Invoke([this](Network::IoHandle&, Stats::Scope&) {
+          return Network::UdpPacketWriterPtr{std::move(writer_)};
+        }));
+    return factory;
+  }
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ProtobufWkt::Struct>();
+  }
+  std::string name() const override { return "envoy.udp_packet_writer.test"; }
+
+  std::unique_ptr<NiceMock<Network::MockUdpPacketWriter>> writer_ =
+      std::make_unique<NiceMock<Network::MockUdpPacketWriter>>();
+};
+
 Api::IoCallUint64Result makeNoError(uint64_t rc) {
   auto no_error = Api::ioCallUint64ResultNoError();
   no_error.return_value_ = rc;
@@ -1104,6 +1127,68 @@ matcher:
   EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
 }
 
+// Make sure that upstream datagrams go through a batch packet writer, which is flushed once at the
+// end of the event loop iteration.
+TEST_F(UdpProxyFilterTest, BatchUpstreamPacketWriter) {
+  TestUdpPacketWriterFactoryFactory writer_factory;
+  Registry::InjectFactory<Network::UdpPacketWriterFactoryFactory> registered(writer_factory);
+  Network::MockUdpPacketWriter* writer = writer_factory.writer_.get();
+  ON_CALL(*writer, isBatchMode()).WillByDefault(Return(true));
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+upstream_packet_writer_config:
+  name: envoy.udp_packet_writer.test
+  typed_config:
+    '@type': type.googleapis.com/google.protobuf.Struct
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  auto* flush_upstream_writes =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(_, _)).Times(2);
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, sendmsg(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(*writer, writePacket(_, nullptr, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([this](const Buffer::Instance& buffer, const Network::Address::Ip*,
+                                    const Network::Address::Instance& peer_address) {
+        EXPECT_EQ(peer_address, *upstream_address_);
+        return makeNoError(buffer.length());
+      }));
+  EXPECT_CALL(*flush_upstream_writes, scheduleCallbackCurrentIteration());
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2");
+  EXPECT_EQ(2, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_datagrams")
+                   ->value());
+
+  EXPECT_CALL(*writer, flush()).WillOnce(Invoke([]() { return makeNoError(11); }));
+  flush_upstream_writes->invokeCallback();
+
+  // A datagram written after the flush schedules another one, which is done when the session is
+  // destroyed before the end of the iteration.
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(_, _));
+  EXPECT_CALL(*writer, writePacket(_, nullptr, _))
+      .WillOnce(Invoke([](const Buffer::Instance& buffer, const Network::Address::Ip*,
+                          const Network::Address::Instance&) {
+        return makeNoError(buffer.length());
+      }));
+  EXPECT_CALL(*flush_upstream_writes, scheduleCallbackCurrentIteration());
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello3");
+  EXPECT_CALL(*writer, flush()).WillOnce(Invoke([]() { return makeNoError(6); }));
+  filter_.reset();
+}
+
 // Make sure socket option is set correctly if use_original_src_ip is set.
 TEST_F(UdpProxyFilterTest, SocketOptionForUseOriginalSrcIp) {
   if (!isTransparentSocketOptionsSupported()) {
@@ -2,11 +2,13 @@
 #include "envoy/registry/registry.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/header_map_impl.h"
 #include "source/extensions/filters/http/cache/cache_entry_utils.h"
 #include "source/extensions/filters/http/cache/cache_headers_utils.h"
 #include "source/extensions/http/cache/simple_http_cache/simple_http_cache.h"
 
 #include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
+#include "test/mocks/http/mocks.h"
 #include "test/mocks/server/factory_context.h"
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
@@ -34,6 +36,105 @@ INSTANTIATE_TEST_SUITE_P(SimpleHttpCacheTest, HttpCacheImplementationTest,
                            return "SimpleHttpCache";
                          });
 
+class SimpleHttpCacheLimitsTest : public testing::Test {
+protected:
+  SimpleHttpCacheLimitsTest()
+      : vary_allow_list_(Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher>(),
+                         factory_context_) {
+    request_headers_.setMethod("GET");
+    request_headers_.setHost("example.com");
+    request_headers_.setScheme("https");
+  }
+
+  LookupRequest makeLookupRequest(absl::string_view path) {
+    request_headers_.setPath(path);
+    return {request_headers_, time_system_.systemTime(), vary_allow_list_};
+  }
+
+  bool insert(SimpleHttpCache& cache, absl::string_view path, std::string body) {
+    return cache.insert(makeLookupRequest(path).key(),
+                        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers_),
+                        ResponseMetadata{time_system_.systemTime()}, std::move(body), nullptr);
+  }
+
+  testing::NiceMock<Server::Configuration::MockServerFactoryContext> factory_context_;
+  Event::SimulatedTimeSystem time_system_;
+  VaryAllowList vary_allow_list_;
+  Http::TestRequestHeaderMapImpl request_headers_;
+  Http::TestResponseHeaderMapImpl response_headers_{{":status", "200"},
+                                                    {"cache-control", "public,max-age=3600"}};
+};
+
+TEST_F(SimpleHttpCacheLimitsTest, EntryCountIsBounded) {
+  SimpleHttpCacheConfig config;
+  config.mutable_max_cache_entry_count()->set_value(32);
+  SimpleHttpCache cache(config);
+
+  for (int i = 0; i < 1000; ++i) {
+    const std::string path = absl::StrCat("/", i);
+    EXPECT_TRUE(insert(cache, path, "body"));
+    // The entry just inserted is never the one evicted to make room for it.
+    EXPECT_NE(cache.lookup(makeLookupRequest(path)).response_headers_, nullptr);
+  }
+  EXPECT_LE(cache.entryCount(), 32U);
+  EXPECT_GT(cache.entryCount(), 0U);
+}
+
+TEST_F(SimpleHttpCacheLimitsTest, ByteSizeIsBounded) {
+  SimpleHttpCacheConfig config;
+  config.mutable_max_cache_size_bytes()->set_value(16 * 1024);
+  SimpleHttpCache cache(config);
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(insert(cache, absl::StrCat("/", i), std::string(100, 'a')));
+  }
+  EXPECT_LE(cache.byteSize(), 16 * 1024U);
+  EXPECT_GT(cache.entryCount(), 0U);
+
+  // A response larger than the share of a shard is not cached at all.
+  EXPECT_FALSE(insert(cache, "/large", std::string(2048, 'a')));
+  EXPECT_EQ(cache.lookup(makeLookupRequest("/large")).response_headers_, nullptr);
+}
+
+TEST_F(SimpleHttpCacheLimitsTest, ReplacingEntryUpdatesByteSize) {
+  SimpleHttpCache cache;
+  EXPECT_TRUE(insert(cache, "/a", std::string(100, 'a')));
+  const uint64_t size = cache.byteSize();
+  EXPECT_TRUE(insert(cache, "/a", std::string(200, 'a')));
+  EXPECT_EQ(cache.byteSize(), size + 100);
+  EXPECT_EQ(cache.entryCount(), 1U);
+}
+
+TEST_F(SimpleHttpCacheLimitsTest, UpdateGrowingEntryPastLimitEvictsIt) {
+  SimpleHttpCacheConfig config;
+  config.mutable_max_cache_size_bytes()->set_value(16 * 1024);
+  SimpleHttpCache cache(config);
+  EXPECT_TRUE(insert(cache, "/a", std::string(900, 'a')));
+
+  // The update pushes the entry past the 1KiB share of its shard, so it has to go.
+  testing::NiceMock<Http::MockStreamDecoderFilterCallbacks> callbacks;
+  LookupContextPtr lookup_context = cache.makeLookupContext(makeLookupRequest("/a"), callbacks);
+  Http::TestResponseHeaderMapImpl response_headers{{"x-padding", std::string(200, 'b')}};
+  absl::optional<bool> updated;
+  cache.updateHeaders(*lookup_context, response_headers,
+                      ResponseMetadata{time_system_.systemTime()},
+                      [&updated](bool result) { updated = result; });
+  EXPECT_EQ(updated, false);
+  EXPECT_EQ(cache.lookup(makeLookupRequest("/a")).response_headers_, nullptr);
+  EXPECT_EQ(cache.entryCount(), 0U);
+  EXPECT_EQ(cache.byteSize(), 0U);
+}
+
+TEST_F(SimpleHttpCacheLimitsTest, LookupsShareBody) {
+  SimpleHttpCache cache;
+  EXPECT_TRUE(insert(cache, "/a", "body"));
+  auto first = cache.lookup(makeLookupRequest("/a"));
+  auto second = cache.lookup(makeLookupRequest("/a"));
+  ASSERT_NE(first.body_, nullptr);
+  EXPECT_EQ(*first.body_, "body");
+  EXPECT_EQ(first.body_.get(), second.body_.get());
+}
+
 TEST(Registration, GetFactory) {
   HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
       "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
@@ -45,6 +146,24 @@ TEST(Registration, GetFactory) {
             "envoy.extensions.http.cache.simple");
 }
 
+TEST(Registration, EqualConfigsShareCache) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.simple_http_cache.v3.SimpleHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  SimpleHttpCacheConfig simple_config;
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  config.mutable_typed_config()->PackFrom(simple_config);
+  std::shared_ptr<HttpCache> unbounded = factory->getCache(config, factory_context);
+  EXPECT_EQ(factory->getCache(config, factory_context), unbounded);
+
+  simple_config.mutable_max_cache_entry_count()->set_value(100);
+  config.mutable_typed_config()->PackFrom(simple_config);
+  std::shared_ptr<HttpCache> bounded = factory->getCache(config, factory_context);
+  EXPECT_NE(bounded, unbounded);
+  EXPECT_EQ(factory->getCache(config, factory_context), bounded);
+}
+
 } // namespace
 } // namespace Cache
 } // namespace HttpFilters
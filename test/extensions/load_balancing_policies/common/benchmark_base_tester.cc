@@ -36,5 +36,15 @@ BaseTester::BaseTester(uint64_t num_hosts, uint32_t weighted_subset_percent, uin
       random_.random(), absl::nullopt);
 }
 
+void BaseTester::updateHosts(const HostVector& hosts, const HostVector& hosts_added,
+                             const HostVector& hosts_removed) {
+  Upstream::HostVectorConstSharedPtr updated_hosts = std::make_shared<Upstream::HostVector>(hosts);
+  Upstream::HostsPerLocalityConstSharedPtr hosts_per_locality =
+      Upstream::makeHostsPerLocality({hosts});
+  priority_set_.updateHosts(
+      0, Upstream::HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {}, hosts_added,
+      hosts_removed, random_.random(), absl::nullopt);
+}
+
 } // namespace Upstream
 } // namespace Envoy
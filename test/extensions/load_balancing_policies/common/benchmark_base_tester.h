@@ -6,6 +6,7 @@
 
 #include "source/common/common/random_generator.h"
 #include "source/common/memory/stats.h"
+#include "source/common/stats/deferred_creation.h"
 #include "source/common/upstream/upstream_impl.h"
 
 #include "test/common/upstream/utility.h"
@@ -25,6 +26,10 @@ public:
   BaseTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
              bool attach_metadata = false);
 
+  // Replace the hosts of priority 0, notifying the load balancers of the given delta.
+  void updateHosts(const HostVector& hosts, const HostVector& hosts_added,
+                   const HostVector& hosts_removed);
+
   Envoy::Thread::MutexBasicLockable lock_;
   // Reduce default log level to warn while running this benchmark to avoid problems due to
   // excessive debug logging in upstream_impl.cc
@@ -40,7 +45,9 @@ public:
   Stats::IsolatedStoreImpl stats_store_;
   Stats::Scope& stats_scope_{*stats_store_.rootScope()};
   Upstream::ClusterLbStatNames stat_names_{stats_store_.symbolTable()};
-  Upstream::ClusterLbStats stats_{stat_names_, stats_scope_};
+  Upstream::DeferredCreationCompatibleClusterLbStats stats_{
+      Stats::createDeferredCompatibleStats<Upstream::ClusterLbStats>(stats_store_.rootScope(),
+                                                                     stat_names_, false)};
   NiceMock<Runtime::MockLoader> runtime_;
   Random::RandomGeneratorImpl random_;
   std::shared_ptr<Upstream::MockClusterInfo> info_{new NiceMock<Upstream::MockClusterInfo>()};
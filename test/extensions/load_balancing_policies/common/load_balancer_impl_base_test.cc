@@ -13,8 +13,8 @@ using testing::ReturnRef;
 
 class TestLb : public LoadBalancerBase {
 public:
-  TestLb(const PrioritySet& priority_set, ClusterLbStats& lb_stats, Runtime::Loader& runtime,
-         Random::RandomGenerator& random,
+  TestLb(const PrioritySet& priority_set, DeferredCreationCompatibleClusterLbStats& lb_stats,
+         Runtime::Loader& runtime, Random::RandomGenerator& random,
          const envoy::config::cluster::v3::Cluster::CommonLbConfig& common_config)
       : LoadBalancerBase(priority_set, lb_stats, runtime, random,
                          PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(
@@ -565,9 +565,9 @@ TEST_P(LoadBalancerBaseTest, BoundaryConditions) {
 
 class TestZoneAwareLb : public ZoneAwareLoadBalancerBase {
 public:
-  TestZoneAwareLb(const PrioritySet& priority_set, ClusterLbStats& lb_stats,
-                  Runtime::Loader& runtime, Random::RandomGenerator& random,
-                  uint32_t healthy_panic_threshold,
+  TestZoneAwareLb(const PrioritySet& priority_set,
+                  DeferredCreationCompatibleClusterLbStats& lb_stats, Runtime::Loader& runtime,
+                  Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
                   absl::optional<LocalityLbConfig> locality_config)
       : ZoneAwareLoadBalancerBase(priority_set, nullptr, lb_stats, runtime, random,
                                   healthy_panic_threshold, locality_config) {}
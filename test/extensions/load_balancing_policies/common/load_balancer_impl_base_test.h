@@ -15,6 +15,7 @@
 
 #include "source/common/common/random_generator.h"
 #include "source/common/network/utility.h"
+#include "source/common/stats/deferred_creation.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
@@ -51,7 +52,8 @@ public:
 
 class TestZoneAwareLoadBalancer : public ZoneAwareLoadBalancerBase {
 public:
-  TestZoneAwareLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& lb_stats,
+  TestZoneAwareLoadBalancer(const PrioritySet& priority_set,
+                            DeferredCreationCompatibleClusterLbStats& lb_stats,
                             Runtime::Loader& runtime, Random::RandomGenerator& random,
                             uint32_t healthy_panic_threshold,
                             absl::optional<LocalityLbConfig> locality_config)
@@ -79,11 +81,13 @@ protected:
   }
 
   LoadBalancerTestBase()
-      : stat_names_(stats_store_.symbolTable()), stats_(stat_names_, *stats_store_.rootScope()) {}
+      : stat_names_(stats_store_.symbolTable()),
+        stats_(Stats::createDeferredCompatibleStats<ClusterLbStats>(stats_store_.rootScope(),
+                                                                    stat_names_, false)) {}
 
   Stats::IsolatedStoreImpl stats_store_;
   ClusterLbStatNames stat_names_;
-  ClusterLbStats stats_;
+  DeferredCreationCompatibleClusterLbStats stats_;
   NiceMock<Runtime::MockLoader> runtime_;
   NiceMock<Random::MockRandomGenerator> random_;
   NiceMock<MockPrioritySet> priority_set_;
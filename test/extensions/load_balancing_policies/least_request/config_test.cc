@@ -2,6 +2,7 @@
 
 #include "source/extensions/load_balancing_policies/least_request/config.h"
 
+#include "test/common/upstream/utility.h"
 #include "test/mocks/server/factory_context.h"
 #include "test/mocks/upstream/cluster_info.h"
 #include "test/mocks/upstream/priority_set.h"
@@ -43,6 +44,41 @@ TEST(LeastRequestConfigTest, ValidateFail) {
   EXPECT_NE(nullptr, thread_local_lb);
 }
 
+TEST(LeastRequestConfigTest, OrcaUtilizationAddsLbPolicyDataToHosts) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  auto cluster_info = std::make_shared<NiceMock<Upstream::MockClusterInfo>>();
+  NiceMock<Upstream::MockPrioritySet> main_thread_priority_set;
+  NiceMock<Upstream::MockPrioritySet> thread_local_priority_set;
+
+  auto& host_set = *main_thread_priority_set.getMockHostSet(0);
+  host_set.hosts_ = {Upstream::makeTestHost(cluster_info, "tcp://127.0.0.1:80")};
+
+  LeastRequestLbProto config_msg;
+  config_msg.mutable_orca_utilization()->add_metric_names_for_computing_utilization(
+      "named_metrics.foo");
+
+  auto& factory = Config::Utility::getAndCheckFactoryByName<Upstream::TypedLoadBalancerFactory>(
+      "envoy.load_balancing_policies.least_request");
+  auto lb_config = factory.loadConfig(context, config_msg).value();
+  auto thread_aware_lb =
+      factory.create(*lb_config, *cluster_info, main_thread_priority_set, context.runtime_loader_,
+                     context.api_.random_, context.time_system_);
+  ASSERT_TRUE(thread_aware_lb->initialize().ok());
+  EXPECT_TRUE(host_set.hosts_[0]->typedLbPolicyData<Upstream::LeastRequestHostLbPolicyData>()
+                  .has_value());
+
+  // Hosts added later get lb policy data as well.
+  Upstream::HostVector hosts_added{Upstream::makeTestHost(cluster_info, "tcp://127.0.0.1:81")};
+  host_set.hosts_.push_back(hosts_added[0]);
+  host_set.runCallbacks(hosts_added, {});
+  EXPECT_TRUE(host_set.hosts_[1]->typedLbPolicyData<Upstream::LeastRequestHostLbPolicyData>()
+                  .has_value());
+
+  auto thread_local_lb =
+      thread_aware_lb->factory()->create({thread_local_priority_set, nullptr});
+  EXPECT_NE(nullptr, thread_local_lb);
+}
+
 } // namespace
 } // namespace LeastRequest
 } // namespace LoadBalancingPolices
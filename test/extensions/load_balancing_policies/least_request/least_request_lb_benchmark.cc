@@ -1,8 +1,13 @@
+#include <deque>
+
+#include "source/common/common/utility.h"
 #include "source/extensions/load_balancing_policies/least_request/least_request_lb.h"
 
 #include "test/benchmark/main.h"
 #include "test/extensions/load_balancing_policies/common/benchmark_base_tester.h"
 
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Upstream {
 namespace {
@@ -62,6 +67,70 @@ BENCHMARK(benchmarkLeastRequestLoadBalancerChooseHost)
     ->Args({100, 100, 1000000})
     ->Unit(::benchmark::kMillisecond);
 
+// The hosts shared by all threads of benchmarkLeastRequestLoadBalancerChooseHostMultiThreaded.
+// Load balancers register callbacks on the shared priority set, so they are created and destroyed
+// under the mutex.
+std::unique_ptr<BaseTester> shared_tester;
+ABSL_CONST_INIT absl::Mutex shared_tester_mutex(absl::kConstInit);
+
+void setUpSharedTester(const ::benchmark::State& state) {
+  shared_tester = std::make_unique<BaseTester>(state.range(0));
+}
+
+void tearDownSharedTester(const ::benchmark::State&) { shared_tester.reset(); }
+
+// Each thread simulates a worker with its own load balancer over the same hosts. Every pick starts
+// a request on the chosen host and finishes the oldest outstanding request of the thread, so the
+// active request counters of the hosts are written by all threads concurrently.
+//
+// This only measures contention when run with --compilation_mode=opt on a machine with at least 64
+// cores. Worker local active requests stay work in progress until it shows an improvement there.
+void benchmarkLeastRequestLoadBalancerChooseHostMultiThreaded(::benchmark::State& state) {
+  const bool worker_local_active_requests = state.range(1) != 0;
+  constexpr size_t max_outstanding_requests = 16;
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  if (worker_local_active_requests) {
+    lr_lb_config.mutable_worker_local_active_requests();
+  }
+  // The simulated time system serializes all threads on a mutex.
+  RealTimeSource time_source;
+  std::unique_ptr<LeastRequestLoadBalancer> lb;
+  {
+    absl::MutexLock lock(&shared_tester_mutex);
+    lb = std::make_unique<LeastRequestLoadBalancer>(
+        shared_tester->priority_set_, nullptr, shared_tester->stats_, shared_tester->runtime_,
+        shared_tester->random_, 50, lr_lb_config, time_source);
+  }
+
+  std::deque<HostConstSharedPtr> outstanding_requests;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    HostConstSharedPtr host = lb->chooseHost(nullptr).host;
+    host->stats().rq_active_.inc();
+    outstanding_requests.push_back(std::move(host));
+    if (outstanding_requests.size() > max_outstanding_requests) {
+      outstanding_requests.front()->stats().rq_active_.dec();
+      outstanding_requests.pop_front();
+    }
+  }
+
+  for (const HostConstSharedPtr& host : outstanding_requests) {
+    host->stats().rq_active_.dec();
+  }
+  absl::MutexLock lock(&shared_tester_mutex);
+  lb.reset();
+}
+BENCHMARK(benchmarkLeastRequestLoadBalancerChooseHostMultiThreaded)
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Args({1000, 0})
+    ->Args({1000, 1})
+    ->Setup(setUpSharedTester)
+    ->Teardown(tearDownSharedTester)
+    ->Threads(32)
+    ->Threads(64)
+    ->UseRealTime();
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -1,4 +1,5 @@
 #include "source/common/common/random_generator.h"
+#include "source/common/stats/deferred_creation.h"
 #include "source/extensions/load_balancing_policies/least_request/least_request_lb.h"
 
 #include "test/common/upstream/utility.h"
@@ -78,7 +79,9 @@ void leastRequestLBWeightTest(LRLBTestParams params) {
 
   Stats::IsolatedStoreImpl stats_store;
   ClusterLbStatNames stat_names(stats_store.symbolTable());
-  ClusterLbStats lb_stats{stat_names, *stats_store.rootScope()};
+  DeferredCreationCompatibleClusterLbStats lb_stats{
+      Stats::createDeferredCompatibleStats<ClusterLbStats>(stats_store.rootScope(), stat_names,
+                                                           false)};
   NiceMock<Runtime::MockLoader> runtime;
   auto time_source = std::make_unique<NiceMock<MockTimeSystem>>();
   LeastRequestLoadBalancer lb_{
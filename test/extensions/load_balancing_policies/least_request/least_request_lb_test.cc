@@ -10,6 +10,9 @@ namespace Envoy {
 namespace Upstream {
 namespace {
 
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
 using testing::Return;
 
 class LeastRequestLoadBalancerTest : public LoadBalancerTestBase {
@@ -557,6 +560,145 @@ TEST_P(LeastRequestLoadBalancerTest, SlowStartWithActiveHC) {
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_2.chooseHost(nullptr).host);
 }
 
+TEST_P(LeastRequestLoadBalancerTest, WorkerLocalActiveRequests) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                              makeTestHost(info_, "tcp://127.0.0.1:81")};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(1);
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.mutable_worker_local_active_requests()->mutable_refresh_interval()->set_seconds(1);
+  LeastRequestLoadBalancer lb{priority_set_, nullptr, stats_,       runtime_,
+                              random_,       50,      lr_lb_config, simTime()};
+
+  // The second host has fewer active requests, and the pick is added to its local estimate.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb.chooseHost(nullptr).host);
+
+  // Both hosts are estimated to have 1 active request, so the first sampled host is kept.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb.chooseHost(nullptr).host);
+
+  // Requests routed by other workers are not seen until the next refresh.
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(1);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(10);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb.chooseHost(nullptr).host);
+
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb.chooseHost(nullptr).host);
+
+  // Membership updates refresh the estimates as well.
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(20);
+  hostSet().runCallbacks({}, {});
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb.chooseHost(nullptr).host);
+}
+
+// Each host's estimate is refreshed on its own schedule, when it is sampled.
+TEST_P(LeastRequestLoadBalancerTest, WorkerLocalActiveRequestsRefreshPerHost) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                              makeTestHost(info_, "tcp://127.0.0.1:81"),
+                              makeTestHost(info_, "tcp://127.0.0.1:82")};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.mutable_worker_local_active_requests()->mutable_refresh_interval()->set_seconds(1);
+  LeastRequestLoadBalancer lb{priority_set_, nullptr, stats_,       runtime_,
+                              random_,       50,      lr_lb_config, simTime()};
+
+  // Samples the first and second hosts, which read their counters now.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb.chooseHost(nullptr).host);
+
+  // The third host is sampled for the first time and reads its counter. The second host keeps
+  // its estimate of 0.
+  simTime().advanceTimeWait(std::chrono::milliseconds(500));
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(5);
+  hostSet().healthy_hosts_[2]->stats().rq_active_.set(5);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(2)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb.chooseHost(nullptr).host);
+
+  // Only the second host's estimate is due: it reads 3 while the third host still has 5.
+  simTime().advanceTimeWait(std::chrono::milliseconds(500));
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(3);
+  hostSet().healthy_hosts_[2]->stats().rq_active_.set(0);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(2));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb.chooseHost(nullptr).host);
+}
+
+// Hosts rejected by the retry host predicate are not added to the local estimates.
+TEST_P(LeastRequestLoadBalancerTest, WorkerLocalActiveRequestsWithHostPredicate) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                              makeTestHost(info_, "tcp://127.0.0.1:81")};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.mutable_worker_local_active_requests()->mutable_refresh_interval()->set_seconds(1);
+  LeastRequestLoadBalancer lb{priority_set_, nullptr, stats_,       runtime_,
+                              random_,       50,      lr_lb_config, simTime()};
+
+  NiceMock<MockLoadBalancerContext> context;
+  EXPECT_CALL(context, hostSelectionRetryCount()).WillRepeatedly(Return(1));
+  EXPECT_CALL(context, shouldSelectAnotherHost(_))
+      .WillRepeatedly(Invoke([&](const Host& host) -> bool {
+        return &host == hostSet().healthy_hosts_[0].get();
+      }));
+
+  // The first attempt picks the first host, which is rejected. The second attempt picks the
+  // second host, which is the only one counted.
+  EXPECT_CALL(random_, random())
+      .WillOnce(Return(0))
+      .WillOnce(Return(0))
+      .WillOnce(Return(0))
+      .WillOnce(Return(0))
+      .WillOnce(Return(1))
+      .WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb.chooseHost(&context).host);
+
+  // The second host is estimated to have 1 active request and the first host none.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb.chooseHost(nullptr).host);
+}
+
+TEST_P(LeastRequestLoadBalancerTest, OrcaUtilization) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
+                              makeTestHost(info_, "tcp://127.0.0.1:81")};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({}, {}); // Trigger callbacks. The added/removed lists are not relevant.
+  hostSet().healthy_hosts_[0]->stats().rq_active_.set(2);
+  hostSet().healthy_hosts_[1]->stats().rq_active_.set(1);
+
+  envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  lr_lb_config.mutable_orca_utilization()->add_metric_names_for_computing_utilization(
+      "named_metrics.foo");
+  LeastRequestLoadBalancer lb{priority_set_, nullptr, stats_,       runtime_,
+                              random_,       50,      lr_lb_config, simTime()};
+
+  auto metric_names = std::make_shared<const Orca::LrsReportMetricNames>(
+      Orca::LrsReportMetricNames{"named_metrics.foo"});
+  for (const auto& host : hostSet().hosts_) {
+    host->setLbPolicyData(std::make_unique<LeastRequestHostLbPolicyData>(metric_names));
+  }
+
+  // Without reported utilization the host with fewer active requests is picked.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb.chooseHost(nullptr).host);
+
+  // (1 + 1) * (1 + 0.9) = 3.8 is more than (2 + 1) * (1 + 0.2) = 3.6.
+  OrcaLoadReport report;
+  report.set_cpu_utilization(0.9);
+  ASSERT_TRUE(hostSet().healthy_hosts_[1]->lbPolicyData()->onOrcaLoadReport(report).ok());
+  report.mutable_named_metrics()->insert({"foo", 0.2});
+  ASSERT_TRUE(hostSet().healthy_hosts_[0]->lbPolicyData()->onOrcaLoadReport(report).ok());
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb.chooseHost(nullptr).host);
+}
+
 INSTANTIATE_TEST_SUITE_P(PrimaryOrFailoverAndLegacyOrNew, LeastRequestLoadBalancerTest,
                          ::testing::Values(LoadBalancerTestParam{true},
                                            LoadBalancerTestParam{false}));
@@ -9,9 +9,11 @@ namespace {
 
 class MaglevTester : public BaseTester {
 public:
-  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0)
+  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
+               uint64_t table_size = MaglevTable::DefaultTableSize)
       : BaseTester(num_hosts, weighted_subset_percent, weight) {
     envoy::extensions::load_balancing_policies::maglev::v3::Maglev config;
+    config.mutable_table_size()->set_value(table_size);
     maglev_lb_ = std::make_unique<MaglevLoadBalancer>(priority_set_, stats_, stats_scope_, runtime_,
                                                       random_, 50, config, hash_policy_);
   }
@@ -181,6 +183,30 @@ BENCHMARK(benchmarkMaglevLoadBalancerWeighted)
     ->Args({500, 95, 75, 25, 10000})
     ->Unit(::benchmark::kMillisecond);
 
+void benchmarkMaglevLoadBalancerHostChurn(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t table_size = state.range(1);
+
+  MaglevTester tester(num_hosts, 0, 0, table_size);
+  ASSERT_TRUE(tester.maglev_lb_->initialize().ok());
+  HostVector hosts = tester.priority_set_.hostSetsPerPriority()[0]->hosts();
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    // Remove a host and add it back, which rebuilds the table twice.
+    const HostSharedPtr host = hosts.back();
+    hosts.pop_back();
+    tester.updateHosts(hosts, {}, {host});
+    hosts.push_back(host);
+    tester.updateHosts(hosts, {host}, {});
+  }
+}
+BENCHMARK(benchmarkMaglevLoadBalancerHostChurn)
+    ->Args({500, 65537})
+    ->Args({2000, 65537})
+    ->Args({5000, 65537})
+    ->Args({5000, 655373})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -1,4 +1,5 @@
 #include "source/common/common/random_generator.h"
+#include "source/common/stats/deferred_creation.h"
 #include "source/extensions/load_balancing_policies/random/random_lb.h"
 
 #include "test/common/upstream/utility.h"
@@ -35,7 +36,9 @@ static HostSharedPtr newTestHost(Upstream::ClusterInfoConstSharedPtr cluster,
 class DISABLED_SimulationTest : public testing::Test { // NOLINT(readability-identifier-naming)
 public:
   DISABLED_SimulationTest()
-      : stat_names_(stats_store_.symbolTable()), stats_(stat_names_, *stats_store_.rootScope()) {
+      : stat_names_(stats_store_.symbolTable()),
+        stats_(Stats::createDeferredCompatibleStats<ClusterLbStats>(stats_store_.rootScope(),
+                                                                    stat_names_, false)) {
     ON_CALL(runtime_.snapshot_, getInteger("upstream.healthy_panic_threshold", 50U))
         .WillByDefault(Return(50U));
     ON_CALL(runtime_.snapshot_, featureEnabled("upstream.zone_routing.enabled", 100))
@@ -176,7 +179,7 @@ public:
   Random::RandomGeneratorImpl random_;
   Stats::IsolatedStoreImpl stats_store_;
   ClusterLbStatNames stat_names_;
-  ClusterLbStats stats_;
+  DeferredCreationCompatibleClusterLbStats stats_;
 };
 
 TEST_F(DISABLED_SimulationTest, StrictlyEqualDistribution) {
@@ -2,6 +2,7 @@
 
 #include "test/benchmark/main.h"
 #include "test/extensions/load_balancing_policies/common/benchmark_base_tester.h"
+#include "test/test_common/test_runtime.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -87,6 +88,35 @@ BENCHMARK(benchmarkRingHashLoadBalancerChooseHost)
     ->Args({500, 256000, 100000})
     ->Unit(::benchmark::kMillisecond);
 
+void benchmarkRingHashLoadBalancerChooseHostLargeRing(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t min_ring_size = state.range(1);
+
+  if (benchmark::skipExpensiveBenchmarks() && min_ring_size > 65536) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  RingHashTester tester(num_hosts, min_ring_size);
+  const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+  ASSERT_TRUE(tester.ring_hash_lb_->initialize().ok());
+  state.counters["memory"] = Memory::Stats::totalCurrentlyAllocated() - start_mem;
+  LoadBalancerPtr lb = tester.ring_hash_lb_->factory()->create(tester.lb_params_);
+  TestLoadBalancerContext context;
+
+  // Only time the lookups: the keys are spread over the whole ring, so that most of them miss the
+  // CPU caches for rings of millions of entries.
+  uint64_t i = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.hash_policy_->hash_key_ = hashInt(i++);
+    ::benchmark::DoNotOptimize(lb->chooseHost(&context).host);
+  }
+}
+BENCHMARK(benchmarkRingHashLoadBalancerChooseHostLargeRing)
+    ->Args({500, 65536})
+    ->Args({500, 1048576})
+    ->Args({2000, 4194304});
+
 void benchmarkRingHashLoadBalancerHostLoss(::benchmark::State& state) {
   const uint64_t num_hosts = state.range(0);
   const uint64_t min_ring_size = state.range(1);
@@ -141,6 +171,40 @@ BENCHMARK(benchmarkRingHashLoadBalancerHostLoss)
     ->Args({500, 256000, 3, 10000})
     ->Unit(::benchmark::kMillisecond);
 
+void benchmarkRingHashLoadBalancerHostChurn(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t min_ring_size = state.range(1);
+
+  if (benchmark::skipExpensiveBenchmarks() && min_ring_size > 65536) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.ring_hash_incremental_rebuild",
+                               state.range(2) ? "true" : "false"}});
+  RingHashTester tester(num_hosts, min_ring_size);
+  ASSERT_TRUE(tester.ring_hash_lb_->initialize().ok());
+  HostVector hosts = tester.priority_set_.hostSetsPerPriority()[0]->hosts();
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    // Remove a host and add it back, which rebuilds the ring twice.
+    const HostSharedPtr host = hosts.back();
+    hosts.pop_back();
+    tester.updateHosts(hosts, {}, {host});
+    hosts.push_back(host);
+    tester.updateHosts(hosts, {host}, {});
+  }
+}
+BENCHMARK(benchmarkRingHashLoadBalancerHostChurn)
+    ->Args({500, 65536, false})
+    ->Args({500, 65536, true})
+    ->Args({500, 256000, false})
+    ->Args({500, 256000, true})
+    ->Args({5000, 1048576, false})
+    ->Args({5000, 1048576, true})
+    ->Unit(::benchmark::kMillisecond);
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
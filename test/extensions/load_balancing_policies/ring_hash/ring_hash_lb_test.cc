@@ -1,12 +1,16 @@
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/router/router.h"
 
 #include "source/common/network/utility.h"
+#include "source/common/stats/deferred_creation.h"
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/load_balancing_policies/ring_hash/ring_hash_lb.h"
 
@@ -60,7 +64,9 @@ class RingHashLoadBalancerTest : public Event::TestUsingSimulatedTime,
                                  public testing::TestWithParam<bool> {
 public:
   RingHashLoadBalancerTest()
-      : stat_names_(stats_store_.symbolTable()), stats_(stat_names_, *stats_store_.rootScope()) {}
+      : stat_names_(stats_store_.symbolTable()),
+        stats_(Stats::createDeferredCompatibleStats<ClusterLbStats>(stats_store_.rootScope(),
+                                                                    stat_names_, false)) {}
 
   void init(bool locality_weighted_balancing = false) {
     if (locality_weighted_balancing) {
@@ -92,7 +98,7 @@ public:
   std::shared_ptr<MockClusterInfo> info_{new NiceMock<MockClusterInfo>()};
   Stats::IsolatedStoreImpl stats_store_;
   ClusterLbStatNames stat_names_;
-  ClusterLbStats stats_;
+  DeferredCreationCompatibleClusterLbStats stats_;
   envoy::extensions::load_balancing_policies::ring_hash::v3::RingHash config_;
   NiceMock<Server::Configuration::MockServerFactoryContext> context_;
   std::unique_ptr<RingHashLoadBalancer> lb_;
@@ -217,7 +223,7 @@ TEST_P(RingHashLoadBalancerTest, Basic) {
     EXPECT_CALL(context_.api_.random_, random()).WillOnce(Return(16117243373044804880UL));
     EXPECT_EQ(hostSet().hosts_[0], lb->chooseHost(nullptr).host);
   }
-  EXPECT_EQ(0UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(0UL, stats_->lb_healthy_panic_.value());
 
   hostSet().healthy_hosts_.clear();
   hostSet().runCallbacks({}, {});
@@ -226,7 +232,7 @@ TEST_P(RingHashLoadBalancerTest, Basic) {
     TestLoadBalancerContext context(0);
     EXPECT_EQ(hostSet().hosts_[4], lb->chooseHost(&context).host);
   }
-  EXPECT_EQ(1UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(1UL, stats_->lb_healthy_panic_.value());
 }
 
 // Ensure if all the hosts with priority 0 unhealthy, the next priority hosts are used.
@@ -319,7 +325,7 @@ TEST_P(RingHashLoadBalancerTest, BasicWithMurmur2) {
     EXPECT_CALL(context_.api_.random_, random()).WillOnce(Return(10150910876324007730UL));
     EXPECT_EQ(hostSet().hosts_[2], lb->chooseHost(nullptr).host);
   }
-  EXPECT_EQ(0UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(0UL, stats_->lb_healthy_panic_.value());
 }
 
 // Test bounded load. This test only ensures that the
@@ -381,7 +387,7 @@ TEST_P(RingHashLoadBalancerTest, BasicWithDoundedLoad) {
     EXPECT_EQ(hostSet().hosts_[3], lb->chooseHost(&context).host);
   }
   { EXPECT_EQ(hostSet().hosts_[5], lb->chooseHost(nullptr).host); }
-  EXPECT_EQ(0UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(0UL, stats_->lb_healthy_panic_.value());
 
   hostSet().healthy_hosts_.clear();
   hostSet().runCallbacks({}, {});
@@ -390,7 +396,7 @@ TEST_P(RingHashLoadBalancerTest, BasicWithDoundedLoad) {
     TestLoadBalancerContext context(0);
     EXPECT_EQ(hostSet().hosts_[5], lb->chooseHost(&context).host);
   }
-  EXPECT_EQ(1UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(1UL, stats_->lb_healthy_panic_.value());
 }
 
 // Expect reasonable results with hostname.
@@ -450,7 +456,7 @@ TEST_P(RingHashLoadBalancerTest, BasicWithHostname) {
     EXPECT_EQ(hostSet().hosts_[3], lb->chooseHost(&context).host);
   }
   { EXPECT_EQ(hostSet().hosts_[5], lb->chooseHost(nullptr).host); }
-  EXPECT_EQ(0UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(0UL, stats_->lb_healthy_panic_.value());
 
   hostSet().healthy_hosts_.clear();
   hostSet().runCallbacks({}, {});
@@ -459,7 +465,7 @@ TEST_P(RingHashLoadBalancerTest, BasicWithHostname) {
     TestLoadBalancerContext context(0);
     EXPECT_EQ(hostSet().hosts_[5], lb->chooseHost(&context).host);
   }
-  EXPECT_EQ(1UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(1UL, stats_->lb_healthy_panic_.value());
 }
 
 // Expect reasonable results with metadata hash_key.
@@ -519,7 +525,7 @@ TEST_P(RingHashLoadBalancerTest, BasicWithMetadataHashKey) {
     EXPECT_EQ(hostSet().hosts_[3], lb->chooseHost(&context).host);
   }
   { EXPECT_EQ(hostSet().hosts_[5], lb->chooseHost(nullptr).host); }
-  EXPECT_EQ(0UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(0UL, stats_->lb_healthy_panic_.value());
 
   hostSet().healthy_hosts_.clear();
   hostSet().runCallbacks({}, {});
@@ -528,7 +534,7 @@ TEST_P(RingHashLoadBalancerTest, BasicWithMetadataHashKey) {
     TestLoadBalancerContext context(0);
     EXPECT_EQ(hostSet().hosts_[5], lb->chooseHost(&context).host);
   }
-  EXPECT_EQ(1UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(1UL, stats_->lb_healthy_panic_.value());
 }
 
 TEST_P(RingHashLoadBalancerTest, RingHashLbWithHashPolicy) {
@@ -1110,6 +1116,149 @@ TEST_P(RingHashLoadBalancerTest, LopsidedWeightSmallScale) {
   }
 }
 
+// Given a sequence of small membership and weight changes, expect the incrementally maintained ring
+// to make the same choices as a ring built from scratch for the same hosts.
+TEST_P(RingHashLoadBalancerTest, IncrementalRebuildMatchesFullRebuild) {
+  for (uint32_t i = 0; i < 64; ++i) {
+    hostSet().hosts_.push_back(
+        makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 1000 + i), 1 + i % 3));
+  }
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+
+  config_.mutable_minimum_ring_size()->set_value(4096);
+  init();
+
+  const auto expect_matches_full_rebuild = [this]() {
+    absl::Status creation_status;
+    TypedRingHashLbConfig typed_config(config_, context_.regex_engine_, creation_status);
+    ASSERT(creation_status.ok());
+    RingHashLoadBalancer full_lb(priority_set_, stats_, *stats_store_.rootScope(),
+                                 context_.runtime_loader_, context_.api_.random_, 50,
+                                 typed_config.lb_config_, typed_config.hash_policy_);
+    ASSERT_TRUE(full_lb.initialize().ok());
+
+    LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+    LoadBalancerPtr full = full_lb.factory()->create(lb_params_);
+    for (uint64_t i = 0; i < 8192; ++i) {
+      TestLoadBalancerContext context(i * (std::numeric_limits<uint64_t>::max() / 8191));
+      EXPECT_EQ(full->chooseHost(&context).host, lb->chooseHost(&context).host);
+    }
+  };
+
+  // Remove a host.
+  hostSet().hosts_.erase(hostSet().hosts_.begin() + 10);
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  expect_matches_full_rebuild();
+
+  // Add a host in the middle of the host list.
+  hostSet().hosts_.insert(hostSet().hosts_.begin() + 20,
+                          makeTestHost(info_, "tcp://127.0.0.1:2000", 2));
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  expect_matches_full_rebuild();
+
+  // Replace a host with a new host object for the same address.
+  hostSet().hosts_[5] = makeTestHost(info_, "tcp://127.0.0.1:1005", 3);
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  expect_matches_full_rebuild();
+
+  // Change the weight of a host.
+  hostSet().hosts_[30]->weight(5);
+  hostSet().runCallbacks({}, {});
+  expect_matches_full_rebuild();
+
+  // Mark a host unhealthy.
+  hostSet().healthy_hosts_.erase(hostSet().healthy_hosts_.begin());
+  hostSet().runCallbacks({}, {});
+  expect_matches_full_rebuild();
+}
+
+// Checks the lookup on the split hashes against std::lower_bound on the full 64-bit hashes, which
+// is how the ring was searched before its hashes were split into upper and lower halves.
+void expectFindRingIndexMatchesLowerBound(std::vector<uint64_t> hashes,
+                                          const std::vector<uint64_t>& queries) {
+  std::sort(hashes.begin(), hashes.end());
+  std::vector<uint32_t> high_bits;
+  std::vector<uint32_t> low_bits;
+  for (const uint64_t hash : hashes) {
+    high_bits.push_back(static_cast<uint32_t>(hash >> 32));
+    low_bits.push_back(static_cast<uint32_t>(hash));
+  }
+  for (const uint64_t query : queries) {
+    auto it = std::lower_bound(hashes.begin(), hashes.end(), query);
+    const size_t expected = it == hashes.end() ? 0 : it - hashes.begin();
+    EXPECT_EQ(expected, RingHashLoadBalancer::findRingIndex(high_bits, low_bits, query))
+        << "query " << query << " on a ring of " << hashes.size();
+  }
+}
+
+// Queries each hash in the ring and its neighbours, plus both ends of the hash space.
+std::vector<uint64_t> boundaryQueries(const std::vector<uint64_t>& hashes) {
+  std::vector<uint64_t> queries{0, 1, std::numeric_limits<uint64_t>::max()};
+  for (const uint64_t hash : hashes) {
+    queries.push_back(hash - 1);
+    queries.push_back(hash);
+    queries.push_back(hash + 1);
+  }
+  return queries;
+}
+
+TEST(RingHashFindRingIndexTest, EqualUpperHalves) {
+  const uint64_t upper = uint64_t(7) << 32;
+  const uint64_t next_upper = uint64_t(8) << 32;
+  const std::vector<uint64_t> hashes{uint64_t(1) << 32, upper | 5,          upper | 16,
+                                     upper | 32,        upper | 0xffffffff, next_upper | 3};
+  std::vector<uint64_t> queries = boundaryQueries(hashes);
+  queries.push_back(upper);
+  queries.push_back(upper | 0x80000000);
+  expectFindRingIndexMatchesLowerBound(hashes, queries);
+
+  // Every entry shares the upper half.
+  expectFindRingIndexMatchesLowerBound({upper | 1, upper | 2, upper | 3},
+                                       boundaryQueries({upper | 1, upper | 2, upper | 3}));
+}
+
+TEST(RingHashFindRingIndexTest, HashesAtZero) {
+  expectFindRingIndexMatchesLowerBound({0}, boundaryQueries({0}));
+  expectFindRingIndexMatchesLowerBound({0, 0, 10}, boundaryQueries({0, 10}));
+  expectFindRingIndexMatchesLowerBound({0, 1, uint64_t(1) << 32},
+                                       boundaryQueries({0, 1, uint64_t(1) << 32}));
+}
+
+TEST(RingHashFindRingIndexTest, HashesAboveLastEntry) {
+  const std::vector<uint64_t> hashes{100, 200, uint64_t(5) << 32};
+  expectFindRingIndexMatchesLowerBound(
+      hashes, {(uint64_t(5) << 32) + 1, uint64_t(6) << 32, std::numeric_limits<uint64_t>::max()});
+  // A ring ending at the largest hash never wraps.
+  expectFindRingIndexMatchesLowerBound({1, std::numeric_limits<uint64_t>::max()},
+                                       boundaryQueries({1, std::numeric_limits<uint64_t>::max()}));
+}
+
+TEST(RingHashFindRingIndexTest, DuplicateEntries) {
+  const uint64_t upper = uint64_t(3) << 32;
+  const std::vector<uint64_t> hashes{5, 5, 5, upper | 9, upper | 9, upper | 12, upper | 12};
+  expectFindRingIndexMatchesLowerBound(hashes, boundaryQueries(hashes));
+}
+
+TEST(RingHashFindRingIndexTest, RandomRings) {
+  std::mt19937_64 random(42);
+  for (size_t ring_size = 1; ring_size <= 70; ++ring_size) {
+    // Draw the upper halves from a small range so that many entries share them.
+    std::vector<uint64_t> hashes;
+    for (size_t i = 0; i < ring_size; ++i) {
+      hashes.push_back(((random() % 8) << 32) | (random() % 16));
+    }
+    std::vector<uint64_t> queries = boundaryQueries(hashes);
+    for (size_t i = 0; i < 64; ++i) {
+      queries.push_back(((random() % 10) << 32) | (random() % 20));
+    }
+    expectFindRingIndexMatchesLowerBound(hashes, queries);
+  }
+}
+
 TEST(TypedRingHashLbConfigTest, TypedRingHashLbConfigTest) {
   {
     envoy::config::cluster::v3::Cluster::RingHashLbConfig legacy;
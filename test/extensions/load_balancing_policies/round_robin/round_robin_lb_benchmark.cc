@@ -7,6 +7,8 @@ namespace Envoy {
 namespace Upstream {
 namespace {
 
+using testing::Return;
+
 class RoundRobinTester : public BaseTester {
 public:
   RoundRobinTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0)
@@ -68,6 +70,107 @@ BENCHMARK(benchmarkRoundRobinLoadBalancerBuild)
     ->Args({50000, 100, 50})
     ->Unit(::benchmark::kMillisecond);
 
+class ZoneAwareTester : public BaseTester {
+public:
+  // Spreads hosts_per_locality upstream hosts over each of num_localities zones. The local cluster
+  // has one host in each zone plus a second one in the local zone, so that the local zone can not
+  // take all of the traffic and the residual is spread across all other zones.
+  ZoneAwareTester(uint32_t num_localities, uint32_t hosts_per_locality) : BaseTester(0) {
+    std::vector<HostVector> upstream_localities(num_localities);
+    std::vector<HostVector> local_localities(num_localities);
+    for (uint32_t i = 0; i < num_localities; ++i) {
+      envoy::config::core::v3::Locality locality;
+      locality.set_zone(fmt::format("zone-{}", i));
+      for (uint32_t j = 0; j < hosts_per_locality; ++j) {
+        const uint32_t n = i * hosts_per_locality + j;
+        upstream_localities[i].push_back(makeTestHost(
+            info_, fmt::format("tcp://10.0.{}.{}:6379", n / 256, n % 256), locality));
+        hosts_.push_back(upstream_localities[i].back());
+      }
+      local_localities[i].push_back(
+          makeTestHost(info_, fmt::format("tcp://10.1.{}.{}:6379", i / 256, i % 256), locality));
+    }
+    local_localities[0].push_back(
+        makeTestHost(info_, "tcp://10.2.0.0:6379", local_localities[0][0]->locality()));
+
+    HostVector local_hosts;
+    for (const HostVector& locality_hosts : local_localities) {
+      local_hosts.insert(local_hosts.end(), locality_hosts.begin(), locality_hosts.end());
+    }
+    local_priority_set_.updateHosts(
+        0,
+        HostSetImpl::partitionHosts(std::make_shared<HostVector>(local_hosts),
+                                    makeHostsPerLocality(std::move(local_localities))),
+        {}, local_hosts, {}, random_.random(), absl::nullopt);
+
+    hosts_per_locality_ = makeHostsPerLocality(std::move(upstream_localities));
+    priority_set_.updateHosts(
+        0,
+        HostSetImpl::partitionHosts(std::make_shared<HostVector>(hosts_), hosts_per_locality_),
+        {}, hosts_, {}, random_.random(), absl::nullopt);
+
+    ON_CALL(runtime_.snapshot_, featureEnabled("upstream.zone_routing.enabled", 100))
+        .WillByDefault(Return(true));
+    envoy::extensions::load_balancing_policies::round_robin::v3::RoundRobin config;
+    lb_ = std::make_unique<RoundRobinLoadBalancer>(priority_set_, &local_priority_set_, stats_,
+                                                   runtime_, random_, 50, config, simTime());
+  }
+
+  // Changes the health of a host and notifies the load balancer, without a membership change.
+  void setHealthy(uint32_t index, bool healthy) {
+    if (healthy) {
+      hosts_[index]->healthFlagClear(Host::HealthFlag::FAILED_ACTIVE_HC);
+    } else {
+      hosts_[index]->healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+    }
+    priority_set_.updateHosts(
+        0,
+        HostSetImpl::partitionHosts(std::make_shared<HostVector>(hosts_), hosts_per_locality_),
+        {}, {}, {}, random_.random(), absl::nullopt);
+  }
+
+  HostVector hosts_;
+  HostsPerLocalityConstSharedPtr hosts_per_locality_;
+  std::unique_ptr<RoundRobinLoadBalancer> lb_;
+};
+
+void benchmarkRoundRobinLoadBalancerZoneAwareHealthChange(::benchmark::State& state) {
+  const uint64_t num_localities = state.range(0);
+  const uint64_t hosts_per_locality = state.range(1);
+
+  ZoneAwareTester tester(num_localities, hosts_per_locality);
+  const uint64_t num_hosts = num_localities * hosts_per_locality;
+  uint64_t i = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    const uint32_t index = i++ % num_hosts;
+    tester.setHealthy(index, false);
+    tester.setHealthy(index, true);
+  }
+  state.counters["zone_structure_updates"] = tester.stats_->lb_recalculate_zone_structures_.value();
+}
+BENCHMARK(benchmarkRoundRobinLoadBalancerZoneAwareHealthChange)
+    ->Args({3, 10})
+    ->Args({50, 4})
+    ->Args({250, 4})
+    ->Args({1000, 2})
+    ->Unit(::benchmark::kMicrosecond);
+
+void benchmarkRoundRobinLoadBalancerZoneAwareChooseHost(::benchmark::State& state) {
+  const uint64_t num_localities = state.range(0);
+  const uint64_t hosts_per_locality = state.range(1);
+
+  ZoneAwareTester tester(num_localities, hosts_per_locality);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    ::benchmark::DoNotOptimize(tester.lb_->chooseHost(nullptr).host);
+  }
+  state.counters["cross_zone"] = tester.stats_->lb_zone_routing_cross_zone_.value();
+}
+BENCHMARK(benchmarkRoundRobinLoadBalancerZoneAwareChooseHost)
+    ->Args({3, 10})
+    ->Args({50, 4})
+    ->Args({250, 4})
+    ->Args({1000, 2});
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -500,6 +500,66 @@ TEST_P(RoundRobinLoadBalancerTest, WeightedInitializationPicksAllHosts) {
   }
 }
 
+// Validate that membership updates of a large weighted host set are applied to the schedule:
+// removed hosts are no longer picked, and added hosts get their share of the picks.
+TEST_P(RoundRobinLoadBalancerTest, WeightedMembershipUpdate) {
+  for (uint32_t i = 0; i < 128; ++i) {
+    hostSet().healthy_hosts_.push_back(
+        makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 1000 + i), i % 2 + 1));
+  }
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  init(false);
+  for (uint32_t i = 0; i < 100; ++i) {
+    lb_->chooseHost(nullptr);
+  }
+
+  // Remove a host of weight 2 and add one of weight 4.
+  const HostSharedPtr removed_host = hostSet().healthy_hosts_[3];
+  const HostSharedPtr added_host = makeTestHost(info_, "tcp://127.0.0.1:2000", 4);
+  hostSet().healthy_hosts_.erase(hostSet().healthy_hosts_.begin() + 3);
+  hostSet().healthy_hosts_.push_back(added_host);
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({added_host}, {removed_host});
+
+  // The weights add up to 194, so over 10 rounds each host is picked about 10 times its weight.
+  absl::flat_hash_map<HostConstSharedPtr, uint32_t> pick_count;
+  for (uint32_t i = 0; i < 1940; ++i) {
+    pick_count[lb_->chooseHost(nullptr).host]++;
+  }
+  EXPECT_FALSE(pick_count.contains(removed_host));
+  for (const HostSharedPtr& host : hostSet().healthy_hosts_) {
+    EXPECT_NEAR(pick_count[host], 10 * host->weight(), 1) << host->address()->asString();
+  }
+}
+
+// Validate that a host which stops being healthy in the same update that adds and removes hosts is
+// no longer picked.
+TEST_P(RoundRobinLoadBalancerTest, WeightedMembershipUpdateWithHealthChange) {
+  for (uint32_t i = 0; i < 128; ++i) {
+    hostSet().healthy_hosts_.push_back(
+        makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 1000 + i), i % 2 + 1));
+  }
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  init(false);
+  for (uint32_t i = 0; i < 100; ++i) {
+    lb_->chooseHost(nullptr);
+  }
+
+  const HostSharedPtr unhealthy_host = hostSet().healthy_hosts_[5];
+  const HostSharedPtr added_host = makeTestHost(info_, "tcp://127.0.0.1:2000", 2);
+  hostSet().hosts_.push_back(added_host);
+  hostSet().healthy_hosts_.erase(hostSet().healthy_hosts_.begin() + 5);
+  hostSet().healthy_hosts_.push_back(added_host);
+  hostSet().runCallbacks({added_host}, {});
+
+  absl::flat_hash_map<HostConstSharedPtr, uint32_t> pick_count;
+  for (uint32_t i = 0; i < 1920; ++i) {
+    pick_count[lb_->chooseHost(nullptr).host]++;
+  }
+  EXPECT_FALSE(pick_count.contains(unhealthy_host));
+  EXPECT_NEAR(pick_count[added_host], 20, 1);
+}
+
 TEST_P(RoundRobinLoadBalancerTest, MaxUnhealthyPanic) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80"),
                               makeTestHost(info_, "tcp://127.0.0.1:81")};
@@ -522,7 +582,7 @@ TEST_P(RoundRobinLoadBalancerTest, MaxUnhealthyPanic) {
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
 
-  EXPECT_EQ(3UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(3UL, stats_->lb_healthy_panic_.value());
 }
 
 // Test that no hosts are selected when fail_traffic_on_panic is enabled.
@@ -549,7 +609,7 @@ TEST_P(RoundRobinLoadBalancerTest, MaxUnhealthyPanicDisableOnPanic) {
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
 
-  EXPECT_EQ(1UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(1UL, stats_->lb_healthy_panic_.value());
 }
 
 // Ensure if the panic threshold is 0%, panic mode is disabled.
@@ -563,7 +623,7 @@ TEST_P(RoundRobinLoadBalancerTest, DisablePanicMode) {
   EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.healthy_panic_threshold", 50))
       .WillRepeatedly(Return(0));
   EXPECT_EQ(nullptr, lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(0UL, stats_.lb_healthy_panic_.value());
+  EXPECT_EQ(0UL, stats_->lb_healthy_panic_.value());
 }
 
 // Test of host set selection with host filter
@@ -663,9 +723,9 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareSmallCluster) {
 
   if (&hostSet() == &host_set_) {
     // Cluster size is computed once at zone aware struct regeneration point.
-    EXPECT_EQ(1U, stats_.lb_zone_cluster_too_small_.value());
+    EXPECT_EQ(1U, stats_->lb_zone_cluster_too_small_.value());
   } else {
-    EXPECT_EQ(0U, stats_.lb_zone_cluster_too_small_.value());
+    EXPECT_EQ(0U, stats_->lb_zone_cluster_too_small_.value());
     return;
   }
   EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.zone_routing.min_cluster_size", 7))
@@ -731,9 +791,9 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareZonesMismatched) {
 
   // Expect zone-aware routing direct mode when in zone A
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_all_directly_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_all_directly_.value());
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(2U, stats_.lb_zone_routing_all_directly_.value());
+  EXPECT_EQ(2U, stats_->lb_zone_routing_all_directly_.value());
 
   // Upstream and local hosts when in zone B (no local upstream in B)
   HostsPerLocalitySharedPtr upstream_hosts_per_locality_b =
@@ -751,10 +811,10 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareZonesMismatched) {
   // Since zone A has no residual, we should always pick an upstream from zone C.
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(0));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(4999));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(2U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(2U, stats_->lb_zone_routing_cross_zone_.value());
 }
 
 TEST_P(RoundRobinLoadBalancerTest, ZoneAwareResidualsMismatched) {
@@ -865,38 +925,116 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareResidualsMismatched) {
   // Residual mode traffic will go directly to the upstream in A 37.5% (3/8) of the time
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_sampled_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_sampled_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(3749));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(2U, stats_.lb_zone_routing_sampled_.value());
+  EXPECT_EQ(2U, stats_->lb_zone_routing_sampled_.value());
 
   // The other 5/8 of the time, traffic will go to cross-zone upstreams with residual capacity
   // Zone B has no upstream hosts
   // Zone C has a residual capacity of 20.83% (20.84% with rounding error): sampled value 0-2083
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(3750)).WillOnce(Return(0));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(3750)).WillOnce(Return(2083));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][1], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(2U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(2U, stats_->lb_zone_routing_cross_zone_.value());
   // Zone D has a residual capacity of 20.83% (20.84% with rounding error): sampled value
   // 2084-4167
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(9999)).WillOnce(Return(2084));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(3U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(3U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(9999)).WillOnce(Return(4167));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][1], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(4U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(4U, stats_->lb_zone_routing_cross_zone_.value());
   // Zone E has a residual capacity of 12.5%: sampled value 4168-5417
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(9999)).WillOnce(Return(4168));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[3][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(5U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(5U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(9999)).WillOnce(Return(5417));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[3][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(6U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(6U, stats_->lb_zone_routing_cross_zone_.value());
   // At sampled value 5418, we loop back to the beginning of the vector and select zone C again
 }
 
+TEST_P(RoundRobinLoadBalancerTest, ZoneAwareResidualsUpstreamHealthChange) {
+  if (&hostSet() == &failover_host_set_) { // P = 1 does not support zone-aware routing.
+    return;
+  }
+
+  // Setup is:
+  // L = local envoy
+  // U = upstream host
+  //
+  // Zone A: 2L, 1U
+  // Zone B: 1L, 1U
+  // Zone C: 1L, 2U, one of which later becomes unhealthy.
+  envoy::config::core::v3::Locality zone_a;
+  zone_a.set_zone("A");
+  envoy::config::core::v3::Locality zone_b;
+  zone_b.set_zone("B");
+  envoy::config::core::v3::Locality zone_c;
+  zone_c.set_zone("C");
+
+  HostVectorSharedPtr hosts(new HostVector({makeTestHost(info_, "tcp://127.0.0.1:80", zone_a),
+                                            makeTestHost(info_, "tcp://127.0.0.1:81", zone_b),
+                                            makeTestHost(info_, "tcp://127.0.0.1:82", zone_c),
+                                            makeTestHost(info_, "tcp://127.0.0.1:83", zone_c)}));
+  HostsPerLocalitySharedPtr upstream_hosts_per_locality =
+      makeHostsPerLocality({{(*hosts)[0]}, {(*hosts)[1]}, {(*hosts)[2], (*hosts)[3]}});
+  HostVectorSharedPtr local_hosts(new HostVector(
+      {makeTestHost(info_, "tcp://127.0.0.1:0", zone_a),
+       makeTestHost(info_, "tcp://127.0.0.1:1", zone_a),
+       makeTestHost(info_, "tcp://127.0.0.1:2", zone_b),
+       makeTestHost(info_, "tcp://127.0.0.1:3", zone_c)}));
+  HostsPerLocalitySharedPtr local_hosts_per_locality = makeHostsPerLocality(
+      {{(*local_hosts)[0], (*local_hosts)[1]}, {(*local_hosts)[2]}, {(*local_hosts)[3]}});
+
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.healthy_panic_threshold", 50))
+      .WillRepeatedly(Return(50));
+  EXPECT_CALL(runtime_.snapshot_, featureEnabled("upstream.zone_routing.enabled", 100))
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.zone_routing.min_cluster_size", 6))
+      .WillRepeatedly(Return(2));
+
+  hostSet().healthy_hosts_ = *hosts;
+  hostSet().hosts_ = *hosts;
+  hostSet().healthy_hosts_per_locality_ = upstream_hosts_per_locality;
+  init(true);
+  updateHosts(local_hosts, local_hosts_per_locality);
+
+  // Zone A can take 25 / 50 = 50% of the local traffic. Zone B has no residual capacity, and zone
+  // C has 50% - 25% = 25%, so all cross zone traffic goes to zone C.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(4999));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(5000)).WillOnce(Return(0));
+  EXPECT_EQ("C", lb_->chooseHost(nullptr).host->locality().zone());
+
+  // A host in zone C becomes unhealthy, and only the upstream callbacks run. Every zone now has
+  // 33.33% of the upstream hosts. Zone A can take 33.33 / 50 = 66.66% of the local traffic, and
+  // zones B and C both have a residual capacity of 33.33% - 25% = 8.33%.
+  hostSet().healthy_hosts_ = {(*hosts)[0], (*hosts)[1], (*hosts)[2]};
+  hostSet().healthy_hosts_per_locality_ =
+      makeHostsPerLocality({{(*hosts)[0]}, {(*hosts)[1]}, {(*hosts)[2]}});
+  hostSet().runCallbacks({}, {});
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(6665));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(6666)).WillOnce(Return(832));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][0], lb_->chooseHost(nullptr).host);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(6666)).WillOnce(Return(833));
+  EXPECT_EQ("C", lb_->chooseHost(nullptr).host->locality().zone());
+
+  // Once a local host in zone A goes away, zone A can take all of the local traffic.
+  local_hosts = std::make_shared<HostVector>(
+      HostVector{(*local_hosts)[0], (*local_hosts)[2], (*local_hosts)[3]});
+  updateHosts(local_hosts, makeHostsPerLocality(
+                               {{(*local_hosts)[0]}, {(*local_hosts)[1]}, {(*local_hosts)[2]}}));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(1U, stats_->lb_zone_routing_all_directly_.value());
+}
+
 TEST_P(RoundRobinLoadBalancerTest, ZoneAwareDifferentZoneSize) {
   if (&hostSet() == &failover_host_set_) { // P = 1 does not support zone-aware routing.
     return;
@@ -951,19 +1089,19 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareDifferentZoneSize) {
   // 2/3 of the time we should get the host in zone B
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_sampled_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_sampled_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(6665));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(2U, stats_.lb_zone_routing_sampled_.value());
+  EXPECT_EQ(2U, stats_->lb_zone_routing_sampled_.value());
 
   // 1/3 of the time we should sample the residuals across zones
   // The only upstream zone with residual capacity is zone C
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(6666)).WillOnce(Return(0));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(9999)).WillOnce(Return(3333));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(2U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(2U, stats_->lb_zone_routing_cross_zone_.value());
 }
 
 TEST_P(RoundRobinLoadBalancerTest, ZoneAwareRoutingLargeZoneSwitchOnOff) {
@@ -1001,9 +1139,9 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareRoutingLargeZoneSwitchOnOff) {
 
   // There is only one host in the given zone for zone aware routing.
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_all_directly_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_all_directly_.value());
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(2U, stats_.lb_zone_routing_all_directly_.value());
+  EXPECT_EQ(2U, stats_->lb_zone_routing_all_directly_.value());
 
   // Disable runtime global zone routing.
   EXPECT_CALL(runtime_.snapshot_, featureEnabled("upstream.zone_routing.enabled", 100))
@@ -1062,12 +1200,12 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareRoutingSmallZone) {
   // There is only one host in the given zone for zone aware routing.
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(100));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_sampled_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_sampled_.value());
 
   // Force request out of small zone.
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(9999)).WillOnce(Return(2));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_cross_zone_.value());
 }
 
 TEST_P(RoundRobinLoadBalancerTest, ZoneAwareNoMatchingZones) {
@@ -1123,22 +1261,22 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareNoMatchingZones) {
 
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(3332));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(3333));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(2U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(2U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(6665));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(3U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(3U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(6666));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(4U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(4U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random())
       .WillOnce(Return(0))
       .WillOnce(Return(0))
       .WillOnce(Return(9998)); // Rounding error: 3333 * 3 = 9999 != 10000
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(5U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(5U, stats_->lb_zone_routing_cross_zone_.value());
 }
 
 TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareNotEnoughLocalZones) {
@@ -1182,9 +1320,9 @@ TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareNotEnoughLocalZones) {
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
   EXPECT_CALL(random_, random()).WillOnce(Return(0));
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(0U, stats_.lb_zone_routing_all_directly_.value());
-  EXPECT_EQ(0U, stats_.lb_zone_routing_sampled_.value());
-  EXPECT_EQ(0U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(0U, stats_->lb_zone_routing_all_directly_.value());
+  EXPECT_EQ(0U, stats_->lb_zone_routing_sampled_.value());
+  EXPECT_EQ(0U, stats_->lb_zone_routing_cross_zone_.value());
 }
 
 TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareNotEnoughUpstreamZones) {
@@ -1228,9 +1366,9 @@ TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareNotEnoughUpstreamZones) {
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
   EXPECT_CALL(random_, random()).WillOnce(Return(0));
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(0U, stats_.lb_zone_routing_all_directly_.value());
-  EXPECT_EQ(0U, stats_.lb_zone_routing_sampled_.value());
-  EXPECT_EQ(0U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(0U, stats_->lb_zone_routing_all_directly_.value());
+  EXPECT_EQ(0U, stats_->lb_zone_routing_sampled_.value());
+  EXPECT_EQ(0U, stats_->lb_zone_routing_cross_zone_.value());
 }
 
 TEST_P(RoundRobinLoadBalancerTest, ZoneAwareForceLocalityDirect) {
@@ -1291,8 +1429,8 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareForceLocalityDirect) {
 
   // Expect zone-aware routing residual mode due to zone c upstream host
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(0U, stats_.lb_zone_routing_all_directly_.value());
-  EXPECT_EQ(1U, stats_.lb_zone_routing_sampled_.value());
+  EXPECT_EQ(0U, stats_->lb_zone_routing_all_directly_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_sampled_.value());
 
   round_robin_lb_config_.mutable_locality_lb_config()
       ->mutable_zone_aware_lb_config()
@@ -1306,8 +1444,8 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareForceLocalityDirect) {
   // Expect zone-aware routing residual mode when force_local_zone_min_size is
   // not met (only 1 host in upstream zone)
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(0U, stats_.lb_zone_routing_all_directly_.value());
-  EXPECT_EQ(2U, stats_.lb_zone_routing_sampled_.value());
+  EXPECT_EQ(0U, stats_->lb_zone_routing_all_directly_.value());
+  EXPECT_EQ(2U, stats_->lb_zone_routing_sampled_.value());
   round_robin_lb_config_.mutable_locality_lb_config()
       ->mutable_zone_aware_lb_config()
       ->mutable_force_local_zone()
@@ -1320,13 +1458,13 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareForceLocalityDirect) {
   // Expect zone-aware routing direct mode when force_local_zone is enabled
   // and force_local_zone_min_size is met.
   // Also expect that upstream host in zone c is never selected.
-  uint64_t direct_counter = stats_.lb_zone_routing_all_directly_.value();
+  uint64_t direct_counter = stats_->lb_zone_routing_all_directly_.value();
   for (int i = 0; i < 10; ++i) {
     HostConstSharedPtr selected_host = lb_->chooseHost(nullptr).host;
     EXPECT_NE(selected_host->locality().zone(), "C")
         << "Upstream in zone C should not receive any requests.";
     ++direct_counter;
-    EXPECT_EQ(stats_.lb_zone_routing_all_directly_.value(), direct_counter)
+    EXPECT_EQ(stats_->lb_zone_routing_all_directly_.value(), direct_counter)
         << "LocalityDirect counter was not incremented" << i;
   }
 }
@@ -1412,44 +1550,44 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareEmptyLocalities) {
 
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(0));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(832));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][1], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(2U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(2U, stats_->lb_zone_routing_cross_zone_.value());
 
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(833));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[3][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(3U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(3U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random())
       .WillOnce(Return(0))
       .WillOnce(Return(0))
       .WillOnce(Return(2498)); // rounding error
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[3][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(4U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(4U, stats_->lb_zone_routing_cross_zone_.value());
 
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(2499));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[4][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(5U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(5U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(3331));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[4][1], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(6U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(6U, stats_->lb_zone_routing_cross_zone_.value());
 
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(3332));
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[6][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(7U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(7U, stats_->lb_zone_routing_cross_zone_.value());
   EXPECT_CALL(random_, random())
       .WillOnce(Return(0))
       .WillOnce(Return(0))
       .WillOnce(Return(4997)); // rounding error
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[6][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(8U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(8U, stats_->lb_zone_routing_cross_zone_.value());
 
   EXPECT_CALL(random_, random())
       .WillOnce(Return(0))
       .WillOnce(Return(0))
       .WillOnce(Return(4998)); // wrap around
   EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(9U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(9U, stats_->lb_zone_routing_cross_zone_.value());
 }
 
 TEST_P(RoundRobinLoadBalancerTest, LowPrecisionForDistribution) {
@@ -1520,7 +1658,7 @@ TEST_P(RoundRobinLoadBalancerTest, LowPrecisionForDistribution) {
   // Force request out of small zone and to randomly select zone.
   EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(9999)).WillOnce(Return(2));
   lb_->chooseHost(nullptr);
-  EXPECT_EQ(1U, stats_.lb_zone_no_capacity_left_.value());
+  EXPECT_EQ(1U, stats_->lb_zone_no_capacity_left_.value());
 }
 
 TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareRoutingOneZone) {
@@ -1600,8 +1738,8 @@ TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareRoutingLocalEmpty) {
 
   // Local cluster is not OK, we'll do regular routing.
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(0U, stats_.lb_healthy_panic_.value());
-  EXPECT_EQ(1U, stats_.lb_local_cluster_not_ok_.value());
+  EXPECT_EQ(0U, stats_->lb_healthy_panic_.value());
+  EXPECT_EQ(1U, stats_->lb_local_cluster_not_ok_.value());
 }
 
 TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareRoutingLocalEmptyFailTrafficOnPanic) {
@@ -1649,8 +1787,8 @@ TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareRoutingLocalEmptyFailTrafficOnPani
   // Local cluster is not OK, we'll do regular routing (and select no host, since we're in global
   // panic).
   EXPECT_EQ(nullptr, lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(0U, stats_.lb_healthy_panic_.value());
-  EXPECT_EQ(1U, stats_.lb_local_cluster_not_ok_.value());
+  EXPECT_EQ(0U, stats_->lb_healthy_panic_.value());
+  EXPECT_EQ(1U, stats_->lb_local_cluster_not_ok_.value());
 }
 
 // Validate that if we have healthy host lists >= 2, but there is no local
@@ -1682,8 +1820,8 @@ TEST_P(RoundRobinLoadBalancerTest, NoZoneAwareRoutingNoLocalLocality) {
 
   // Local cluster is not OK, we'll do regular routing.
   EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(0U, stats_.lb_healthy_panic_.value());
-  EXPECT_EQ(1U, stats_.lb_local_cluster_not_ok_.value());
+  EXPECT_EQ(0U, stats_->lb_healthy_panic_.value());
+  EXPECT_EQ(1U, stats_->lb_local_cluster_not_ok_.value());
 }
 
 INSTANTIATE_TEST_SUITE_P(PrimaryOrFailoverAndLegacyOrNew, RoundRobinLoadBalancerTest,
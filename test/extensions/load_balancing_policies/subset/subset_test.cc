@@ -13,6 +13,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/config/metadata.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
+#include "source/common/stats/deferred_creation.h"
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/load_balancing_policies/subset/config.h"
 
@@ -326,7 +327,8 @@ class SubsetLoadBalancerTest : public Event::TestUsingSimulatedTime,
 public:
   SubsetLoadBalancerTest()
       : scope_(stats_store_.createScope("testprefix")), stat_names_(stats_store_.symbolTable()),
-        stats_(stat_names_, *stats_store_.rootScope()) {}
+        stats_(Stats::createDeferredCompatibleStats<ClusterLbStats>(stats_store_.rootScope(),
+                                                                    stat_names_, false)) {}
 
   using HostMetadata = std::map<std::string, std::string>;
   using HostListMetadata = std::map<std::string, std::vector<std::string>>;
@@ -730,7 +732,7 @@ public:
   Stats::IsolatedStoreImpl stats_store_;
   Stats::ScopeSharedPtr scope_;
   ClusterLbStatNames stat_names_;
-  ClusterLbStats stats_;
+  DeferredCreationCompatibleClusterLbStats stats_;
   PrioritySetImpl local_priority_set_;
   HostVectorSharedPtr local_hosts_;
   HostsPerLocalitySharedPtr local_hosts_per_locality_;
@@ -744,8 +746,8 @@ TEST_F(SubsetLoadBalancerTest, NoFallback) {
   init();
 
   EXPECT_EQ(nullptr, lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(0U, stats_.lb_subsets_fallback_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_selected_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_fallback_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_selected_.value());
 
   EXPECT_EQ(nullptr, lb_->peekAnotherHost(nullptr));
   EXPECT_FALSE(lb_->lifetimeCallbacks().has_value());
@@ -782,8 +784,8 @@ TEST_F(SubsetLoadBalancerTest, FallbackAnyEndpoint) {
   init();
 
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_subsets_fallback_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_selected_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_fallback_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_selected_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, FallbackAnyEndpointAfterUpdate) {
@@ -814,8 +816,8 @@ TEST_F(SubsetLoadBalancerTest, FallbackDefaultSubset) {
   });
 
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(1U, stats_.lb_subsets_fallback_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_selected_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_fallback_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_selected_.value());
 }
 
 TEST_F(SubsetLoadBalancerTest, FallbackPanicMode) {
@@ -833,9 +835,9 @@ TEST_F(SubsetLoadBalancerTest, FallbackPanicMode) {
   });
 
   EXPECT_TRUE(lb_->chooseHost(nullptr).host != nullptr);
-  EXPECT_EQ(1U, stats_.lb_subsets_fallback_panic_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_fallback_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_selected_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_fallback_panic_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_fallback_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_selected_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, FallbackPanicModeWithUpdates) {
@@ -891,8 +893,8 @@ TEST_F(SubsetLoadBalancerTest, FallbackEmptyDefaultSubsetConvertsToAnyEndpoint)
 
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(nullptr).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(nullptr).host);
-  EXPECT_EQ(2U, stats_.lb_subsets_fallback_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_selected_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_fallback_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_selected_.value());
 }
 
 TEST_F(SubsetLoadBalancerTest, FallbackOnUnknownMetadata) {
@@ -932,8 +934,8 @@ TEST_F(SubsetLoadBalancerTest, BalancesSubset) {
   EXPECT_EQ(host_set_.hosts_[2], lb_->chooseHost(&context_11).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[3], lb_->chooseHost(&context_11).host);
-  EXPECT_EQ(0U, stats_.lb_subsets_fallback_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_selected_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_fallback_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_selected_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, BalancesSubsetAfterUpdate) {
@@ -960,7 +962,7 @@ TEST_P(SubsetLoadBalancerTest, BalancesSubsetAfterUpdate) {
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[2], lb_->chooseHost(&context_11).host);
   EXPECT_EQ(host_set_.hosts_[3], lb_->chooseHost(&context_11).host);
-  EXPECT_EQ(2U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_created_.value());
 
   modifyHosts({makeHost("tcp://127.0.0.1:8000", {{"version", "1.2"}}),
                makeHost("tcp://127.0.0.1:8001", {{"version", "1.0"}})},
@@ -972,8 +974,8 @@ TEST_P(SubsetLoadBalancerTest, BalancesSubsetAfterUpdate) {
   EXPECT_EQ(host_set_.hosts_[3], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_11).host);
   EXPECT_EQ(host_set_.hosts_[2], lb_->chooseHost(&context_12).host);
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_created_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, ListAsAnyEnabled) {
@@ -1163,9 +1165,9 @@ TEST_P(SubsetLoadBalancerTest, OnlyMetadataChanged) {
   // Add hosts initial hosts.
   init({{"tcp://127.0.0.1:8000", {{"version", "1.2"}}},
         {"tcp://127.0.0.1:8001", {{"version", "1.0"}, {"default", "true"}}}});
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_removed_.value());
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_12).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_default).host);
@@ -1177,9 +1179,9 @@ TEST_P(SubsetLoadBalancerTest, OnlyMetadataChanged) {
 
   host_set_.runCallbacks({}, {});
 
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_removed_.value());
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_12).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_default).host);
@@ -1191,9 +1193,9 @@ TEST_P(SubsetLoadBalancerTest, OnlyMetadataChanged) {
   // No hosts added nor removed, so we bypass modifyHosts().
   host_set_.runCallbacks({}, {});
 
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_removed_.value());
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_13).host);
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_12).host);
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_default).host);
@@ -1204,9 +1206,9 @@ TEST_P(SubsetLoadBalancerTest, OnlyMetadataChanged) {
 
   host_set_.runCallbacks({}, {});
 
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(5U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(2U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(5U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_removed_.value());
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_12).host);
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_default).host);
@@ -1218,9 +1220,9 @@ TEST_P(SubsetLoadBalancerTest, OnlyMetadataChanged) {
 
   host_set_.runCallbacks({}, {});
 
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(5U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(2U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(5U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_removed_.value());
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_12).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_default).host);
@@ -1235,43 +1237,43 @@ TEST_P(SubsetLoadBalancerTest, EmptySubsetsPurged) {
   // Simple add and remove.
   init({{"tcp://127.0.0.1:8000", {{"version", "1.2"}}},
         {"tcp://127.0.0.1:8001", {{"version", "1.0"}, {"stage", "prod"}}}});
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_removed_.value());
 
   host_set_.hosts_[0]->metadata(buildMetadataWithStage("1.3"));
   host_set_.runCallbacks({}, {});
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_removed_.value());
 
   // Move host that was in the version + stage subset into a new version only subset.
   host_set_.hosts_[1]->metadata(buildMetadataWithStage("1.4"));
   host_set_.runCallbacks({}, {});
-  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(5U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(3U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(5U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_removed_.value());
 
   // Create a new version + stage subset.
   host_set_.hosts_[1]->metadata(buildMetadataWithStage("1.5", "devel"));
   host_set_.runCallbacks({}, {});
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(7U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(7U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_removed_.value());
 
   // Now move it back to its original version + stage subset.
   host_set_.hosts_[1]->metadata(buildMetadataWithStage("1.0", "prod"));
   host_set_.runCallbacks({}, {});
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(9U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(6U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(9U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(6U, stats_->lb_subsets_removed_.value());
 
   // Finally, remove the original version + stage subset again.
   host_set_.hosts_[1]->metadata(buildMetadataWithStage("1.6"));
   host_set_.runCallbacks({}, {});
-  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(10U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(8U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(10U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(8U, stats_->lb_subsets_removed_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, EmptySubsetsPurgedCollapsed) {
@@ -1282,30 +1284,30 @@ TEST_P(SubsetLoadBalancerTest, EmptySubsetsPurgedCollapsed) {
   // Init subsets.
   init({{"tcp://127.0.0.1:8000", {{"version", "1.2"}}},
         {"tcp://127.0.0.1:8001", {{"version", "1.0"}, {"stage", "prod"}}}});
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_removed_.value());
 
   // Get rid of 1.0.
   host_set_.hosts_[1]->metadata(buildMetadataWithStage("1.2", "prod"));
   host_set_.runCallbacks({}, {});
-  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(2U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_removed_.value());
 
   // Get rid of stage prod.
   host_set_.hosts_[1]->metadata(buildMetadataWithStage("1.2"));
   host_set_.runCallbacks({}, {});
-  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(3U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_removed_.value());
 
   // Add stage prod back.
   host_set_.hosts_[1]->metadata(buildMetadataWithStage("1.2", "prod"));
   host_set_.runCallbacks({}, {});
-  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(5U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(3U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(5U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_removed_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, EmptySubsetsPurgedVersionChanged) {
@@ -1316,24 +1318,24 @@ TEST_P(SubsetLoadBalancerTest, EmptySubsetsPurgedVersionChanged) {
   // Init subsets.
   init({{"tcp://127.0.0.1:8000", {{"version", "1.2"}}},
         {"tcp://127.0.0.1:8001", {{"version", "1.0"}, {"stage", "prod"}}}});
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_removed_.value());
 
   // Get rid of 1.0.
   host_set_.hosts_[1]->metadata(buildMetadataWithStage("1.2", "prod"));
   host_set_.runCallbacks({}, {});
-  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(2U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_removed_.value());
 
   // Change versions.
   host_set_.hosts_[0]->metadata(buildMetadataWithStage("1.3"));
   host_set_.hosts_[1]->metadata(buildMetadataWithStage("1.4", "prod"));
   host_set_.runCallbacks({}, {});
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(7U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(7U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_removed_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, MetadataChangedHostsAddedRemoved) {
@@ -1360,9 +1362,9 @@ TEST_P(SubsetLoadBalancerTest, MetadataChangedHostsAddedRemoved) {
   // Add hosts initial hosts.
   init({{"tcp://127.0.0.1:8000", {{"version", "1.2"}}},
         {"tcp://127.0.0.1:8001", {{"version", "1.0"}, {"default", "true"}}}});
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_removed_.value());
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_12).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_default).host);
@@ -1375,9 +1377,9 @@ TEST_P(SubsetLoadBalancerTest, MetadataChangedHostsAddedRemoved) {
   // Add a new host.
   modifyHosts({makeHost("tcp://127.0.0.1:8002", {{"version", "1.3"}})}, {});
 
-  EXPECT_EQ(4U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_removed_.value());
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_12).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_default).host);
@@ -1389,9 +1391,9 @@ TEST_P(SubsetLoadBalancerTest, MetadataChangedHostsAddedRemoved) {
 
   modifyHosts({}, {host_set_.hosts_[2]});
 
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_removed_.value());
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_12).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_default).host);
@@ -1404,9 +1406,9 @@ TEST_P(SubsetLoadBalancerTest, MetadataChangedHostsAddedRemoved) {
 
   modifyHosts({makeHost("tcp://127.0.0.1:8003", {{"version", "1.4"}})}, {host_set_.hosts_[1]});
 
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(5U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(2U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(5U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_removed_.value());
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_12).host);
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_default).host);
@@ -1419,9 +1421,9 @@ TEST_P(SubsetLoadBalancerTest, MetadataChangedHostsAddedRemoved) {
 
   host_set_.runCallbacks({}, {});
 
-  EXPECT_EQ(3U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(5U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(2U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(3U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(5U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_removed_.value());
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_12).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_default).host);
@@ -1448,20 +1450,20 @@ TEST_P(SubsetLoadBalancerTest, UpdateRemovingLastSubsetHost) {
 
   TestLoadBalancerContext context({{"version", "1.0"}});
   EXPECT_EQ(host_v10, lb_->chooseHost(&context).host);
-  EXPECT_EQ(1U, stats_.lb_subsets_selected_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_fallback_.value());
-  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(2U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_selected_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_fallback_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_created_.value());
 
   modifyHosts({}, {host_v10});
 
   // fallback to any endpoint
   EXPECT_EQ(host_v11, lb_->chooseHost(&context).host);
-  EXPECT_EQ(1U, stats_.lb_subsets_selected_.value());
-  EXPECT_EQ(1U, stats_.lb_subsets_fallback_.value());
-  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(2U, stats_.lb_subsets_created_.value());
-  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_selected_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_fallback_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(2U, stats_->lb_subsets_created_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_removed_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, UpdateRemovingUnknownHost) {
@@ -2493,13 +2495,13 @@ TEST_P(SubsetLoadBalancerTest, GaugesUpdatedOnDestroy) {
       {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
   });
 
-  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(0U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_removed_.value());
 
   lb_ = nullptr;
 
-  EXPECT_EQ(0U, stats_.lb_subsets_active_.value());
-  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_active_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_removed_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, SubsetSelectorNoFallbackPerSelector) {
@@ -2528,8 +2530,8 @@ TEST_P(SubsetLoadBalancerTest, SubsetSelectorNoFallbackPerSelector) {
   EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
   EXPECT_EQ(host_set_.hosts_[3], lb_->chooseHost(&context_11).host);
   EXPECT_EQ(nullptr, lb_->chooseHost(&context_12).host);
-  EXPECT_EQ(0U, stats_.lb_subsets_fallback_.value());
-  EXPECT_EQ(4U, stats_.lb_subsets_selected_.value());
+  EXPECT_EQ(0U, stats_->lb_subsets_fallback_.value());
+  EXPECT_EQ(4U, stats_->lb_subsets_selected_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, FallbackNotDefinedForIntermediateSelector) {
@@ -2904,7 +2906,7 @@ TEST_P(SubsetLoadBalancerTest, KeysSubsetFallbackToNotExistingSelector) {
   TestLoadBalancerContext context_nx({{"version", "1.0"}, {"stage", "test"}});
 
   EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_nx).host);
-  EXPECT_EQ(1U, stats_.lb_subsets_fallback_.value());
+  EXPECT_EQ(1U, stats_->lb_subsets_fallback_.value());
 }
 
 TEST_P(SubsetLoadBalancerTest, MetadataFallbackList) {
@@ -9,7 +9,7 @@
 #include "test/test_common/simulated_time_system.h"
 
 using testing::_;
-using testing::ByMove;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
 using testing::ReturnRef;
@@ -53,6 +53,17 @@ public:
     return std::make_shared<OtlpOptions>(sink_config, resource);
   }
 
+  const OtlpOptionsSharedPtr exponentialOtlpOptions(bool report_histograms_as_deltas,
+                                                    absl::optional<uint32_t> max_buckets) {
+    envoy::extensions::stat_sinks::open_telemetry::v3::SinkConfig sink_config;
+    sink_config.set_report_histograms_as_deltas(report_histograms_as_deltas);
+    auto* exponential_histogram = sink_config.mutable_exponential_histogram();
+    if (max_buckets.has_value()) {
+      exponential_histogram->mutable_max_buckets()->set_value(max_buckets.value());
+    }
+    return std::make_shared<OtlpOptions>(sink_config, Tracers::OpenTelemetry::Resource());
+  }
+
   std::string getTagExtractedName(const std::string name) { return name + "-tagged"; }
 
   void addCounterToSnapshot(const std::string& name, uint64_t delta, uint64_t value,
@@ -139,6 +150,36 @@ public:
     snapshot_.histograms_.push_back(*histogram_storage_.back());
   }
 
+  // Adds a histogram whose detailed buckets are the given circllhist bins.
+  void addBinnedHistogramToSnapshot(
+      const std::string& name, const std::vector<Stats::ParentHistogram::Bucket>& bins,
+      bool is_delta = false, Stats::Histogram::Unit unit = Stats::Histogram::Unit::Unspecified) {
+    auto histogram = std::make_unique<NiceMock<Stats::MockParentHistogram>>();
+
+    histogram_t* hist = hist_alloc();
+    for (const auto& bin : bins) {
+      hist_insert(hist, bin.lower_bound_, bin.count_);
+    }
+    histogram_ptrs_.push_back(hist);
+    hist_stats_.push_back(std::make_unique<Stats::HistogramStatisticsImpl>(hist));
+
+    if (is_delta) {
+      ON_CALL(*histogram, intervalStatistics()).WillByDefault(ReturnRef(*hist_stats_.back()));
+      ON_CALL(*histogram, detailedIntervalBuckets()).WillByDefault(Return(bins));
+    } else {
+      ON_CALL(*histogram, cumulativeStatistics()).WillByDefault(ReturnRef(*hist_stats_.back()));
+      ON_CALL(*histogram, detailedTotalBuckets()).WillByDefault(Return(bins));
+    }
+
+    histogram_storage_.emplace_back(std::move(histogram));
+    histogram_storage_.back()->name_ = name;
+    histogram_storage_.back()->setTagExtractedName(getTagExtractedName(name));
+    histogram_storage_.back()->unit_ = unit;
+    histogram_storage_.back()->setTags({{"hist_key", "hist_val"}});
+
+    snapshot_.histograms_.push_back(*histogram_storage_.back());
+  }
+
   long long int expected_time_ns_;
   std::vector<histogram_t*> histogram_ptrs_;
   std::vector<std::unique_ptr<Stats::HistogramStatisticsImpl>> hist_stats_;
@@ -161,7 +202,7 @@ public:
 
 TEST_F(OpenTelemetryGrpcMetricsExporterImplTest, SendExportRequest) {
   EXPECT_CALL(*async_client_, sendRaw(_, _, _, _, _, _));
-  exporter_->send(std::make_unique<MetricsExportRequest>());
+  exporter_->send(MetricsExportRequest());
 }
 
 TEST_F(OpenTelemetryGrpcMetricsExporterImplTest, PartialSuccess) {
@@ -436,6 +477,79 @@ TEST_F(OtlpMetricsFlusherTests, DeltaHistogramMetric) {
   expectHistogram(metricAt(1, metrics), getTagExtractedName("test_histogram2"), true);
 }
 
+TEST_F(OtlpMetricsFlusherTests, CumulativeExponentialHistogramMetric) {
+  OtlpMetricsFlusherImpl flusher(exponentialOtlpOptions(false, absl::nullopt));
+
+  // Bin midpoints are 1.05 and 10.5, at indexes 4 and 217 for scale 6. That spans more than the
+  // default 160 buckets, so the scale is lowered once.
+  addBinnedHistogramToSnapshot("test_histogram", {{0, 0, 2}, {1.0, 0.1, 3}, {10, 1, 1}});
+
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 1);
+  const auto& metric = metricAt(0, metrics);
+  EXPECT_EQ(getTagExtractedName("test_histogram"), metric.name());
+  EXPECT_FALSE(metric.has_histogram());
+  EXPECT_TRUE(metric.has_exponential_histogram());
+  EXPECT_EQ(AggregationTemporality::AGGREGATION_TEMPORALITY_CUMULATIVE,
+            metric.exponential_histogram().aggregation_temporality());
+  EXPECT_EQ(1, metric.exponential_histogram().data_points().size());
+
+  const auto& data_point = metric.exponential_histogram().data_points()[0];
+  EXPECT_EQ(expected_time_ns_, data_point.time_unix_nano());
+  expectAttributes(data_point.attributes(), "hist_key", "hist_val");
+  EXPECT_EQ(6, data_point.count());
+  EXPECT_EQ(5, data_point.scale());
+  EXPECT_EQ(2, data_point.zero_count());
+  EXPECT_EQ(2, data_point.positive().offset());
+  ASSERT_EQ(107, data_point.positive().bucket_counts().size());
+  EXPECT_EQ(3, data_point.positive().bucket_counts()[0]);
+  EXPECT_EQ(1, data_point.positive().bucket_counts()[106]);
+  uint64_t total = 0;
+  for (uint64_t count : data_point.positive().bucket_counts()) {
+    total += count;
+  }
+  EXPECT_EQ(4, total);
+  EXPECT_EQ(0, data_point.negative().bucket_counts().size());
+}
+
+TEST_F(OtlpMetricsFlusherTests, ExponentialHistogramDownscalesToMaxBuckets) {
+  OtlpMetricsFlusherImpl flusher(exponentialOtlpOptions(false, 2));
+
+  addBinnedHistogramToSnapshot("test_histogram", {{1.0, 0.1, 3}, {10, 1, 1}});
+
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 1);
+  const auto& data_point = metricAt(0, metrics).exponential_histogram().data_points()[0];
+  // At scale -1 the buckets are (1, 4] and (4, 16].
+  EXPECT_EQ(-1, data_point.scale());
+  EXPECT_EQ(0, data_point.zero_count());
+  EXPECT_EQ(0, data_point.positive().offset());
+  ASSERT_EQ(2, data_point.positive().bucket_counts().size());
+  EXPECT_EQ(3, data_point.positive().bucket_counts()[0]);
+  EXPECT_EQ(1, data_point.positive().bucket_counts()[1]);
+}
+
+TEST_F(OtlpMetricsFlusherTests, DeltaPercentExponentialHistogramMetric) {
+  OtlpMetricsFlusherImpl flusher(exponentialOtlpOptions(true, absl::nullopt));
+
+  // Percent values are scaled down, so the midpoints are 0.255 and 0.505.
+  addBinnedHistogramToSnapshot("test_histogram", {{250000, 10000, 2}, {500000, 10000, 1}}, true,
+                               Stats::Histogram::Unit::Percent);
+
+  MetricsExportRequestSharedPtr metrics = flusher.flush(snapshot_);
+  expectMetricsCount(metrics, 1);
+  const auto& metric = metricAt(0, metrics);
+  EXPECT_EQ(AggregationTemporality::AGGREGATION_TEMPORALITY_DELTA,
+            metric.exponential_histogram().aggregation_temporality());
+  const auto& data_point = metric.exponential_histogram().data_points()[0];
+  EXPECT_EQ(3, data_point.count());
+  EXPECT_EQ(6, data_point.scale());
+  EXPECT_EQ(-127, data_point.positive().offset());
+  ASSERT_EQ(64, data_point.positive().bucket_counts().size());
+  EXPECT_EQ(2, data_point.positive().bucket_counts()[0]);
+  EXPECT_EQ(1, data_point.positive().bucket_counts()[63]);
+}
+
 TEST_F(OtlpMetricsFlusherTests, SetResourceAttributes) {
   OtlpMetricsFlusherImpl flusher(
       otlpOptions(true, false, true, true, "", {{"key_foo", "val_foo"}}));
@@ -452,14 +566,14 @@ TEST_F(OtlpMetricsFlusherTests, SetResourceAttributes) {
 
 class MockOpenTelemetryGrpcMetricsExporter : public OpenTelemetryGrpcMetricsExporter {
 public:
-  MOCK_METHOD(void, send, (MetricsExportRequestPtr&&));
+  MOCK_METHOD(void, send, (const MetricsExportRequest&));
   MOCK_METHOD(void, onSuccess, (Grpc::ResponsePtr<MetricsExportResponse>&&, Tracing::Span&));
   MOCK_METHOD(void, onFailure, (Grpc::Status::GrpcStatus, const std::string&, Tracing::Span&));
 };
 
 class MockOtlpMetricsFlusher : public OtlpMetricsFlusher {
 public:
-  MOCK_METHOD(MetricsExportRequestPtr, flush, (Stats::MetricSnapshot&), (const));
+  MOCK_METHOD(void, flush, (Stats::MetricSnapshot&, MetricsExportRequest&), (const));
 };
 
 class OpenTelemetryGrpcSinkTests : public OpenTelemetryStatsSinkTests {
@@ -473,14 +587,37 @@ public:
 };
 
 TEST_F(OpenTelemetryGrpcSinkTests, BasicFlow) {
-  MetricsExportRequestPtr request = std::make_unique<MetricsExportRequest>();
-  EXPECT_CALL(*flusher_, flush(_)).WillOnce(Return(ByMove(std::move(request))));
+  EXPECT_CALL(*flusher_, flush(_, _));
   EXPECT_CALL(*exporter_, send(_));
 
   OpenTelemetryGrpcSink sink(flusher_, exporter_);
   sink.flush(snapshot_);
 }
 
+// Each flush builds a fresh arena-allocated request, so nothing leaks from one flush to the next
+// while the arena's initial block is reused.
+TEST_F(OpenTelemetryGrpcSinkTests, ArenaAllocatedRequestPerFlush) {
+  EXPECT_CALL(*flusher_, flush(_, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([](Stats::MetricSnapshot&, MetricsExportRequest& request) {
+        EXPECT_NE(nullptr, request.GetArena());
+        EXPECT_EQ(0, request.resource_metrics().size());
+        request.add_resource_metrics()->add_scope_metrics()->add_metrics()->set_name(
+            std::string(1024, 'a'));
+      }));
+  EXPECT_CALL(*exporter_, send(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([](const MetricsExportRequest& request) {
+        ASSERT_EQ(1, request.resource_metrics().size());
+        EXPECT_EQ(std::string(1024, 'a'),
+                  request.resource_metrics()[0].scope_metrics()[0].metrics()[0].name());
+      }));
+
+  OpenTelemetryGrpcSink sink(flusher_, exporter_);
+  sink.flush(snapshot_);
+  sink.flush(snapshot_);
+}
+
 } // namespace
 } // namespace OpenTelemetry
 } // namespace StatSinks
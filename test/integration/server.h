@@ -384,6 +384,9 @@ public:
   void initializeThreading(Event::Dispatcher&, ThreadLocal::Instance&) override {}
   void shutdownThreading() override {}
   void mergeHistograms(PostMergeCb cb) override { merge_cb_ = cb; }
+  void setHistogramMergeThreads(Thread::ThreadFactory&, uint32_t) override {}
+  void setCounterSharding(uint32_t, StatsMatcherPtr&&) override {}
+  void setCompactNames(bool) override {}
 
   void runMergeCallback() { merge_cb_(); }
 
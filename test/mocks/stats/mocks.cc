@@ -30,6 +30,7 @@ MockGauge::MockGauge() : used_(false), value_(0), import_mode_(ImportMode::Accum
   ON_CALL(*this, hidden()).WillByDefault(ReturnPointee(&hidden_));
   ON_CALL(*this, value()).WillByDefault(ReturnPointee(&value_));
   ON_CALL(*this, importMode()).WillByDefault(ReturnPointee(&import_mode_));
+  ON_CALL(*this, latchChanged()).WillByDefault(Return(true));
 }
 MockGauge::~MockGauge() = default;
 
@@ -61,6 +62,17 @@ MockParentHistogram::MockParentHistogram() {
   }));
   ON_CALL(*this, intervalStatistics()).WillByDefault(ReturnRef(*histogram_stats_));
   ON_CALL(*this, cumulativeStatistics()).WillByDefault(ReturnRef(*histogram_stats_));
+  ON_CALL(*this, forEachDetailedTotalBucket(_)).WillByDefault(Invoke([this](const BucketFn& fn) {
+    for (const Bucket& bucket : detailedTotalBuckets()) {
+      fn(bucket);
+    }
+  }));
+  ON_CALL(*this, forEachDetailedIntervalBucket(_))
+      .WillByDefault(Invoke([this](const BucketFn& fn) {
+        for (const Bucket& bucket : detailedIntervalBuckets()) {
+          fn(bucket);
+        }
+      }));
 }
 MockParentHistogram::~MockParentHistogram() = default;
 
@@ -75,7 +87,7 @@ MockMetricSnapshot::MockMetricSnapshot() {
 
 MockMetricSnapshot::~MockMetricSnapshot() = default;
 
-MockSink::MockSink() = default;
+MockSink::MockSink() { ON_CALL(*this, acceptsDeltaSnapshots()).WillByDefault(Return(false)); }
 MockSink::~MockSink() = default;
 
 MockSinkPredicates::MockSinkPredicates() = default;
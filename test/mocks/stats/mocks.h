@@ -163,6 +163,7 @@ public:
   MOCK_METHOD(void, set, (uint64_t value));
   MOCK_METHOD(void, setParentValue, (uint64_t parent_value));
   MOCK_METHOD(void, sub, (uint64_t amount));
+  MOCK_METHOD(bool, latchChanged, ());
   MOCK_METHOD(void, mergeImportMode, (ImportMode));
   MOCK_METHOD(bool, used, (), (const));
   MOCK_METHOD(void, markUnused, ());
@@ -217,6 +218,8 @@ public:
   MOCK_METHOD(const HistogramStatistics&, intervalStatistics, (), (const));
   MOCK_METHOD(std::vector<Bucket>, detailedTotalBuckets, (), (const));
   MOCK_METHOD(std::vector<Bucket>, detailedIntervalBuckets, (), (const));
+  MOCK_METHOD(void, forEachDetailedTotalBucket, (const BucketFn&), (const));
+  MOCK_METHOD(void, forEachDetailedIntervalBucket, (const BucketFn&), (const));
 
   // RefcountInterface
   void incRefCount() override { refcount_helper_.incRefCount(); }
@@ -278,6 +281,7 @@ public:
 
   MOCK_METHOD(void, flush, (MetricSnapshot & snapshot));
   MOCK_METHOD(void, onHistogramComplete, (const Histogram& histogram, uint64_t value));
+  MOCK_METHOD(bool, acceptsDeltaSnapshots, (), (const));
 };
 
 class MockSinkPredicates : public SinkPredicates {
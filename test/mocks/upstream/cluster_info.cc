@@ -11,6 +11,7 @@
 #include "source/common/http/utility.h"
 #include "source/common/network/raw_buffer_socket.h"
 #include "source/common/router/upstream_codec_filter.h"
+#include "source/common/stats/deferred_creation.h"
 #include "source/common/upstream/upstream_impl.h"
 
 using testing::_;
@@ -54,9 +55,12 @@ MockClusterInfo::MockClusterInfo()
       cluster_timeout_budget_stat_names_(stats_store_.symbolTable()),
       traffic_stats_(
           ClusterInfoImpl::generateStats(stats_store_.rootScope(), traffic_stat_names_, false)),
-      config_update_stats_(config_update_stats_names_, *stats_store_.rootScope()),
-      lb_stats_(lb_stat_names_, *stats_store_.rootScope()),
-      endpoint_stats_(endpoint_stat_names_, *stats_store_.rootScope()),
+      config_update_stats_(Stats::createDeferredCompatibleStats<ClusterConfigUpdateStats>(
+          stats_store_.rootScope(), config_update_stats_names_, false)),
+      lb_stats_(Stats::createDeferredCompatibleStats<ClusterLbStats>(stats_store_.rootScope(),
+                                                                     lb_stat_names_, false)),
+      endpoint_stats_(Stats::createDeferredCompatibleStats<ClusterEndpointStats>(
+          stats_store_.rootScope(), endpoint_stat_names_, false)),
       transport_socket_matcher_(new NiceMock<Upstream::MockTransportSocketMatcher>()),
       load_report_stats_(ClusterInfoImpl::generateLoadReportStats(
           *load_report_stats_store_.rootScope(), cluster_load_report_stat_names_)),
@@ -67,12 +71,12 @@ MockClusterInfo::MockClusterInfo()
       timeout_budget_stats_(
           std::make_unique<ClusterTimeoutBudgetStats>(ClusterInfoImpl::generateTimeoutBudgetStats(
               *timeout_budget_stats_store_.rootScope(), cluster_timeout_budget_stat_names_))),
-      circuit_breakers_stats_(ClusterInfoImpl::generateCircuitBreakersStats(
-          *stats_store_.rootScope(), cluster_circuit_breakers_stat_names_.default_, true,
-          cluster_circuit_breakers_stat_names_)),
+      circuit_breakers_prefix_("circuit_breakers.default", stats_store_.symbolTable()),
+      circuit_breakers_stats_(cluster_circuit_breakers_stat_names_, *stats_store_.rootScope(),
+                              circuit_breakers_prefix_.statName()),
       resource_manager_(new Upstream::ResourceManagerImpl(
           runtime_, "fake_key", 1, 1024, 1024, 1, std::numeric_limits<uint64_t>::max(),
-          std::numeric_limits<uint64_t>::max(), circuit_breakers_stats_, absl::nullopt,
+          std::numeric_limits<uint64_t>::max(), circuitBreakersStats(), absl::nullopt,
           absl::nullopt)),
       upstream_local_address_selector_(
           std::make_shared<NiceMock<MockUpstreamLocalAddressSelector>>(source_address_)),
@@ -112,6 +116,7 @@ MockClusterInfo::MockClusterInfo()
   ON_CALL(*this, trafficStats()).WillByDefault(ReturnRef(traffic_stats_));
   ON_CALL(*this, lbStats()).WillByDefault(ReturnRef(lb_stats_));
   ON_CALL(*this, configUpdateStats()).WillByDefault(ReturnRef(config_update_stats_));
+  ON_CALL(*this, warmingState()).WillByDefault(ReturnRef(config_update_stats_->warming_state_));
   ON_CALL(*this, endpointStats()).WillByDefault(ReturnRef(endpoint_stats_));
   ON_CALL(*this, statsScope()).WillByDefault(ReturnRef(*stats_store_.rootScope()));
   // TODO(incfly): The following is a hack because it's not possible to directly embed
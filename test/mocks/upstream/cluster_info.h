@@ -86,7 +86,7 @@ public:
                             uint64_t conn_pool, uint64_t conn_per_host = 100) {
     resource_manager_ = std::make_unique<ResourceManagerImpl>(
         runtime_, name_, cx, rq_pending, rq, rq_retry, conn_pool, conn_per_host,
-        circuit_breakers_stats_, absl::nullopt, absl::nullopt);
+        circuitBreakersStats(), absl::nullopt, absl::nullopt);
   }
 
   void resetResourceManagerWithRetryBudget(uint64_t cx, uint64_t rq_pending, uint64_t rq,
@@ -95,7 +95,14 @@ public:
                                            uint64_t conn_per_host = 100) {
     resource_manager_ = std::make_unique<ResourceManagerImpl>(
         runtime_, name_, cx, rq_pending, rq, rq_retry, conn_pool, conn_per_host,
-        circuit_breakers_stats_, budget_percent, min_retry_concurrency);
+        circuitBreakersStats(), budget_percent, min_retry_concurrency);
+  }
+
+  // The returned stats are not deferred, so they share their gauges with circuit_breakers_stats_.
+  ClusterCircuitBreakersStats circuitBreakersStats() {
+    return ClusterInfoImpl::generateCircuitBreakersStats(
+        stats_store_.rootScope(), circuit_breakers_prefix_.statName(), true,
+        cluster_circuit_breakers_stat_names_, false);
   }
 
   // Upstream::ClusterInfo
@@ -136,9 +143,15 @@ public:
   MOCK_METHOD(ResourceManager&, resourceManager, (ResourcePriority priority), (const));
   MOCK_METHOD(TransportSocketMatcher&, transportSocketMatcher, (), (const));
   MOCK_METHOD(DeferredCreationCompatibleClusterTrafficStats&, trafficStats, (), (const));
-  MOCK_METHOD(ClusterLbStats&, lbStats, (), (const));
-  MOCK_METHOD(ClusterEndpointStats&, endpointStats, (), (const));
-  MOCK_METHOD(ClusterConfigUpdateStats&, configUpdateStats, (), (const));
+  MOCK_METHOD(DeferredCreationCompatibleClusterLbStats&, lbStats, (), (const));
+  MOCK_METHOD(DeferredCreationCompatibleClusterEndpointStats&, endpointStats, (), (const));
+  MOCK_METHOD(DeferredCreationCompatibleClusterConfigUpdateStats&, configUpdateStats, (),
+              (const));
+  MOCK_METHOD(Stats::Gauge&, warmingState, (), (const));
+  MOCK_METHOD(void, forEachUncreatedStat,
+              (const Stats::DeferredStatNameFn& counter_fn,
+               const Stats::DeferredStatNameFn& gauge_fn),
+              (const));
   MOCK_METHOD(Stats::Scope&, statsScope, (), (const));
   MOCK_METHOD(ClusterLoadReportStats&, loadReportStats, (), (const));
   MOCK_METHOD(ClusterRequestResponseSizeStatsOptRef, requestResponseSizeStats, (), (const));
@@ -199,9 +212,9 @@ public:
   ClusterRequestResponseSizeStatNames cluster_request_response_size_stat_names_;
   ClusterTimeoutBudgetStatNames cluster_timeout_budget_stat_names_;
   mutable DeferredCreationCompatibleClusterTrafficStats traffic_stats_;
-  ClusterConfigUpdateStats config_update_stats_;
-  ClusterLbStats lb_stats_;
-  ClusterEndpointStats endpoint_stats_;
+  mutable DeferredCreationCompatibleClusterConfigUpdateStats config_update_stats_;
+  mutable DeferredCreationCompatibleClusterLbStats lb_stats_;
+  mutable DeferredCreationCompatibleClusterEndpointStats endpoint_stats_;
   Upstream::TransportSocketMatcherPtr transport_socket_matcher_;
   NiceMock<Stats::MockIsolatedStatsStore> load_report_stats_store_;
   ClusterLoadReportStats load_report_stats_;
@@ -209,7 +222,8 @@ public:
   ClusterRequestResponseSizeStatsPtr request_response_size_stats_;
   NiceMock<Stats::MockIsolatedStatsStore> timeout_budget_stats_store_;
   ClusterTimeoutBudgetStatsPtr timeout_budget_stats_;
-  ClusterCircuitBreakersStats circuit_breakers_stats_;
+  Stats::StatNameManagedStorage circuit_breakers_prefix_;
+  ClusterCircuitBreakersOpenStats circuit_breakers_stats_;
   NiceMock<Runtime::MockLoader> runtime_;
   std::unique_ptr<Upstream::ResourceManager> resource_manager_;
   Network::Address::InstanceConstSharedPtr source_address_;
@@ -12,6 +12,8 @@
 #include "test/test_common/stats_utility.h"
 #include "test/test_common/utility.h"
 
+using testing::_;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::ReturnRef;
 
@@ -1025,5 +1027,57 @@ envoy_cluster_endpoint_c1{a_tag_name="a.tag-value",envoy_cluster_name="test_1",e
   }
 }
 
+// Deferred cluster stats which were not created yet are rendered as zero, within the group of the
+// created stats sharing their name if there is one.
+TEST_F(PrometheusStatsFormatterTest, OutputWithUncreatedClusterStats) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  addCounter("cluster.upstream_rq_total", {{makeStat("envoy.cluster_name"), makeStat("aaa")}});
+  counters_.back()->add(5);
+
+  auto& cluster = endpoints_helper_->makeCluster("bbb", 0);
+  Stats::ScopeSharedPtr cluster_scope = cluster.info_->stats_store_.createScope("cluster.bbb");
+  ON_CALL(*cluster.info_, statsScope()).WillByDefault(ReturnRef(*cluster_scope));
+  Stats::StatNamePool cluster_pool(cluster.info_->stats_store_.symbolTable());
+  ON_CALL(*cluster.info_, forEachUncreatedStat(_, _))
+      .WillByDefault(Invoke([&](const Stats::DeferredStatNameFn& counter_fn,
+                                const Stats::DeferredStatNameFn& gauge_fn) {
+        counter_fn(Stats::StatName(), cluster_pool.add("upstream_rq_total"));
+        counter_fn(Stats::StatName(), cluster_pool.add("lb_healthy_panic"));
+        gauge_fn(cluster_pool.add("circuit_breakers.default"), cluster_pool.add("cx_open"));
+      }));
+
+  {
+    Buffer::OwnedImpl response;
+    const uint64_t size = PrometheusStatsFormatter::statsAsPrometheus(
+        counters_, gauges_, histograms_, textReadouts_, endpoints_helper_->cm_, response,
+        StatsParams(), custom_namespaces);
+    EXPECT_EQ(3UL, size);
+    const std::string expected_output = R"EOF(# TYPE envoy_cluster_upstream_rq_total counter
+envoy_cluster_upstream_rq_total{envoy_cluster_name="bbb"} 0
+envoy_cluster_upstream_rq_total{envoy_cluster_name="aaa"} 5
+# TYPE envoy_cluster_lb_healthy_panic counter
+envoy_cluster_lb_healthy_panic{envoy_cluster_name="bbb"} 0
+# TYPE envoy_cluster_circuit_breakers_default_cx_open gauge
+envoy_cluster_circuit_breakers_default_cx_open{envoy_cluster_name="bbb"} 0
+)EOF";
+    EXPECT_EQ(expected_output, response.toString());
+  }
+
+  // Stats which were never created were never used either.
+  {
+    Buffer::OwnedImpl response;
+    StatsParams params;
+    ASSERT_EQ(Http::Code::OK, params.parse("/stats?usedonly", response));
+    const uint64_t size = PrometheusStatsFormatter::statsAsPrometheus(
+        counters_, gauges_, histograms_, textReadouts_, endpoints_helper_->cm_, response, params,
+        custom_namespaces);
+    EXPECT_EQ(1UL, size);
+    EXPECT_EQ(R"EOF(# TYPE envoy_cluster_upstream_rq_total counter
+envoy_cluster_upstream_rq_total{envoy_cluster_name="aaa"} 5
+)EOF",
+              response.toString());
+  }
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -211,8 +211,33 @@ public:
     return count;
   }
 
+  /**
+   * Streams a Prometheus request against the stats saved in store_, draining each chunk.
+   *
+   * @param max_chunk set to the size of the largest chunk.
+   * @return the total size of the output.
+   */
+  uint64_t handlerPrometheusChunks(const StatsParams& params, uint64_t& max_chunk) {
+    PrometheusStatsRequest request(*store_, params, cm_, custom_namespaces_, name_cache_);
+    auto response_headers = Http::ResponseHeaderMapImpl::create();
+    request.start(*response_headers);
+    Buffer::OwnedImpl data;
+    uint64_t count = 0;
+    max_chunk = 0;
+    bool more = true;
+    do {
+      more = request.nextChunk(data);
+      count += data.length();
+      max_chunk = std::max(max_chunk, data.length());
+      data.drain(data.length());
+    } while (more);
+    return count;
+  }
+
   std::vector<Stats::ScopeSharedPtr> scopes_;
   Envoy::Stats::CustomStatNamespacesImpl custom_namespaces_;
+  PrometheusNameCacheSharedPtr name_cache_{
+      std::make_shared<PrometheusNameCache>(store_->symbolTable())};
   FastMockClusterManager cm_;
   bool endpoint_stats_initialized_{false};
 };
@@ -382,6 +407,31 @@ BENCHMARK_CAPTURE(BM_AllCountersPrometheus, per_endpoint_stats_disabled, false)
 BENCHMARK_CAPTURE(BM_AllCountersPrometheus, per_endpoint_stats_enabled, true)
     ->Unit(benchmark::kMillisecond);
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusChunked(benchmark::State& state, bool per_endpoint_stats) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext(per_endpoint_stats);
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus&type=Counters", response);
+
+  uint64_t count;
+  uint64_t max_chunk;
+  for (auto _ : state) { // NOLINT
+    count = test_context.handlerPrometheusChunks(params, max_chunk);
+    RELEASE_ASSERT(count > 250 * 1000 * 1000, "expected count > 250M");
+    // A chunk ends after the first line at or beyond the chunk size.
+    RELEASE_ASSERT(max_chunk < Envoy::Server::PrometheusStatsRequest::DefaultChunkSize + 10000,
+                   "expected bounded chunks");
+  }
+
+  auto label = absl::StrCat("output per iteration: ", count, "; max chunk: ", max_chunk);
+  state.SetLabel(label);
+}
+BENCHMARK_CAPTURE(BM_AllCountersPrometheusChunked, per_endpoint_stats_disabled, false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AllCountersPrometheusChunked, per_endpoint_stats_enabled, true)
+    ->Unit(benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_UsedCountersPrometheus(benchmark::State& state, bool per_endpoint_stats) {
   Envoy::Server::StatsHandlerTest& test_context = testContext(per_endpoint_stats);
@@ -19,6 +19,7 @@
 using testing::Combine;
 using testing::HasSubstr;
 using testing::InSequence;
+using testing::Not;
 using testing::Ref;
 using testing::Return;
 using testing::ReturnRef;
@@ -1573,5 +1574,76 @@ envoy_control_plane_identifier{cluster="c1",text_value="cp-1"} 0
   EXPECT_THAT(expected_response, code_response.second);
 }
 
+class StatsHandlerPrometheusStreamingTest : public StatsHandlerPrometheusTest,
+                                            public testing::Test {
+public:
+  // Renders the stats with a PrometheusStatsRequest, counting the chunks.
+  std::string renderInChunks(uint64_t chunk_size, uint32_t& num_chunks,
+                             absl::string_view url = "/stats?format=prometheus&text_readouts") {
+    StatsParams params;
+    Buffer::OwnedImpl parse_response;
+    EXPECT_EQ(Http::Code::OK, params.parse(url, parse_response));
+    PrometheusStatsRequest request(*store_, params, endpoints_helper_.cm_, custom_namespaces_,
+                                   name_cache_);
+    request.setChunkSize(chunk_size);
+    Http::TestResponseHeaderMapImpl response_headers;
+    EXPECT_EQ(Http::Code::OK, request.start(response_headers));
+    std::string output;
+    Buffer::OwnedImpl data;
+    num_chunks = 0;
+    bool more;
+    do {
+      more = request.nextChunk(data);
+      ++num_chunks;
+      output += data.toString();
+      data.drain(data.length());
+    } while (more);
+    return output;
+  }
+
+  PrometheusNameCacheSharedPtr name_cache_{
+      std::make_shared<PrometheusNameCache>(symbol_table_)};
+};
+
+TEST_F(StatsHandlerPrometheusStreamingTest, ChunksMatchBufferedOutput) {
+  createTestStats();
+  for (uint32_t i = 0; i < 20; ++i) {
+    store_->rootScope()->counterFromString(absl::StrCat("counter", i % 4, ".x", i)).add(i);
+  }
+
+  StatsParams params;
+  Buffer::OwnedImpl buffered;
+  EXPECT_EQ(Http::Code::OK, params.parse("/stats?format=prometheus&text_readouts", buffered));
+  StatsHandler::prometheusRender(*store_, custom_namespaces_, endpoints_helper_.cm_, params,
+                                 buffered);
+
+  uint32_t num_chunks;
+  EXPECT_EQ(buffered.toString(), renderInChunks(PrometheusStatsRequest::DefaultChunkSize,
+                                                num_chunks));
+  EXPECT_EQ(1U, num_chunks);
+  EXPECT_EQ(buffered.toString(), renderInChunks(50, num_chunks));
+  EXPECT_LT(10U, num_chunks);
+}
+
+TEST_F(StatsHandlerPrometheusStreamingTest, NameCacheDropsUnusedNames) {
+  createTestStats();
+  store_->rootScope()->counterFromString("scope.requests").inc();
+
+  uint32_t num_chunks;
+  const std::string first_scrape = renderInChunks(1000, num_chunks);
+  EXPECT_THAT(first_scrape, HasSubstr("envoy_scope_requests{} 1\n"));
+  // Metric names for the 3 groups plus scope.requests, and the "cluster" tag name.
+  EXPECT_EQ(5U, name_cache_->size());
+
+  // A second scrape reuses the cached names.
+  EXPECT_EQ(first_scrape, renderInChunks(1000, num_chunks));
+  EXPECT_EQ(5U, name_cache_->size());
+
+  // Names the last scrape did not render are dropped.
+  EXPECT_THAT(renderInChunks(1000, num_chunks, "/stats?format=prometheus&filter=cluster"),
+              Not(HasSubstr("scope_requests")));
+  EXPECT_EQ(3U, name_cache_->size());
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -13,7 +13,10 @@
 
 #include "gtest/gtest.h"
 
+using testing::_;
+using testing::Invoke;
 using testing::NiceMock;
+using testing::ReturnRef;
 using testing::StartsWith;
 
 namespace Envoy {
@@ -152,6 +155,30 @@ TEST_F(StatsRequestTest, OneHostGauge) {
   EXPECT_EQ(0, iterateChunks(*makeRequest(false, StatsFormat::Text, StatsType::TextReadouts)));
 }
 
+TEST_F(StatsRequestTest, OneUncreatedClusterCounter) {
+  auto& cluster = endpoints_helper_.makeCluster("mycluster", 0);
+  Stats::ScopeSharedPtr scope = store_.createScope("cluster.mycluster");
+  ON_CALL(*cluster.info_, statsScope()).WillByDefault(ReturnRef(*scope));
+  Stats::StatName name = makeStatName("lb_healthy_panic");
+  ON_CALL(*cluster.info_, forEachUncreatedStat(_, _))
+      .WillByDefault(Invoke([&](const Stats::DeferredStatNameFn& counter_fn,
+                                const Stats::DeferredStatNameFn&) {
+        counter_fn(Stats::StatName(), name);
+      }));
+  EXPECT_EQ("cluster.mycluster.lb_healthy_panic: 0\n",
+            response(*makeRequest(false, StatsFormat::Text, StatsType::All)));
+  EXPECT_EQ(1, iterateChunks(*makeRequest(false, StatsFormat::Text, StatsType::Counters)));
+  EXPECT_EQ(0, iterateChunks(*makeRequest(false, StatsFormat::Text, StatsType::Gauges)));
+
+  // Uncreated stats are never used.
+  EXPECT_EQ(0, iterateChunks(*makeRequest(true, StatsFormat::Text, StatsType::All)));
+
+  // Once created, the stat is rendered as any other.
+  scope->counterFromStatName(name).add(2);
+  EXPECT_EQ("cluster.mycluster.lb_healthy_panic: 2\n",
+            response(*makeRequest(false, StatsFormat::Text, StatsType::All)));
+}
+
 TEST_F(StatsRequestTest, OneScope) {
   Stats::ScopeSharedPtr scope = store_.createScope("foo");
   EXPECT_EQ(0, iterateChunks(*makeRequest(false, StatsFormat::Text, StatsType::All)));
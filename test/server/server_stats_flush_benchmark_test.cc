@@ -4,10 +4,12 @@
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
 
+#include "source/common/event/libevent.h"
 #include "source/common/stats/thread_local_store.h"
 #include "source/server/server.h"
 
 #include "test/benchmark/main.h"
+#include "test/common/stats/real_thread_test_base.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/test_common/simulated_time_system.h"
@@ -118,10 +120,64 @@ static void bmFlushToSinksWithPredicatesSet(::benchmark::State& state) {
   speed_test.test(state);
 }
 
+// Measures ThreadLocalStoreImpl::mergeHistograms, which precedes each flush to sinks, with each
+// histogram recorded on every worker.
+class HistogramMergeSpeedTest : public Stats::ThreadLocalRealThreadsMixin {
+public:
+  static constexpr uint32_t NumWorkers = 8;
+
+  HistogramMergeSpeedTest(size_t num_histograms, uint32_t num_merge_threads)
+      : ThreadLocalRealThreadsMixin(NumWorkers) {
+    store_->setHistogramMergeThreads(api().threadFactory(), num_merge_threads);
+    runOnMainBlocking([this, num_histograms]() {
+      for (uint64_t idx = 0; idx < num_histograms; ++idx) {
+        histograms_.push_back(&scope_.histogramFromString(absl::StrCat("histogram.", idx),
+                                                          Stats::Histogram::Unit::Unspecified));
+      }
+    });
+  }
+
+  void test(::benchmark::State& state) {
+    for (auto _ : state) {
+      UNREFERENCED_PARAMETER(_);
+      state.PauseTiming();
+      runOnAllWorkersBlocking([this]() {
+        for (uint64_t idx = 0; idx < histograms_.size(); ++idx) {
+          histograms_[idx]->recordValue(idx);
+        }
+      });
+      state.ResumeTiming();
+
+      BlockingBarrier blocking_barrier(1);
+      runOnMainBlocking([this, &blocking_barrier]() {
+        store_->mergeHistograms(blocking_barrier.decrementCountFn());
+      });
+    }
+  }
+
+private:
+  std::vector<Stats::Histogram*> histograms_;
+};
+
+static void bmMergeHistograms(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  Event::Libevent::Global::initialize();
+  HistogramMergeSpeedTest speed_test(state.range(0), state.range(1));
+  speed_test.test(state);
+}
+
 BENCHMARK(bmFlushToSinks)->Unit(::benchmark::kMillisecond)->RangeMultiplier(10)->Range(10, 1000000);
 BENCHMARK(bmFlushToSinksWithPredicatesSet)
     ->Unit(::benchmark::kMillisecond)
     ->RangeMultiplier(10)
     ->Range(10, 1000000);
+BENCHMARK(bmMergeHistograms)
+    ->Unit(::benchmark::kMillisecond)
+    ->ArgsProduct({{10, 10000, 100000}, {0, 2, 4}});
 
 } // namespace Envoy
@@ -164,6 +164,94 @@ TEST(ServerInstanceUtil, flushImportModeUninitializedGauges) {
   InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
 }
 
+TEST(ServerInstanceUtil, flushDeltaSnapshot) {
+  NiceMock<Upstream::MockClusterManager> cm;
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& changed_counter = store.counter("changed_counter");
+  Stats::Counter& unchanged_counter = store.counter("unchanged_counter");
+  Stats::Gauge& changed_gauge = store.gauge("changed_gauge", Stats::Gauge::ImportMode::Accumulate);
+  Stats::Gauge& unchanged_gauge =
+      store.gauge("unchanged_gauge", Stats::Gauge::ImportMode::Accumulate);
+  unchanged_counter.inc();
+  unchanged_gauge.set(1);
+  store.textReadout("text").set("is important");
+
+  std::list<Stats::SinkPtr> sinks;
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  Stats::MockSink* full_sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(full_sink);
+  Stats::MockSink* delta_sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(delta_sink);
+  EXPECT_CALL(*full_sink, acceptsDeltaSnapshots()).WillRepeatedly(Return(false));
+  EXPECT_CALL(*delta_sink, acceptsDeltaSnapshots()).WillRepeatedly(Return(true));
+
+  changed_counter.inc();
+  changed_gauge.set(5);
+  EXPECT_CALL(*full_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+    EXPECT_EQ(snapshot.textReadouts().size(), 1);
+  }));
+  EXPECT_CALL(*delta_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "changed_counter");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 1);
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "changed_gauge");
+    EXPECT_EQ(snapshot.textReadouts().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, true);
+
+  // A full flush goes to every sink, and still latches the gauges.
+  changed_gauge.set(6);
+  EXPECT_CALL(*full_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+  }));
+  EXPECT_CALL(*delta_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  EXPECT_CALL(*full_sink, flush(_));
+  EXPECT_CALL(*delta_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+    EXPECT_TRUE(snapshot.gauges().empty());
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, true);
+}
+
+TEST(ServerInstanceUtil, flushDeltaSnapshotOnlyToDeltaSinks) {
+  NiceMock<Upstream::MockClusterManager> cm;
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& changed_counter = store.counter("changed_counter");
+  Stats::Counter& unchanged_counter = store.counter("unchanged_counter");
+  unchanged_counter.inc();
+
+  std::list<Stats::SinkPtr> sinks;
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  // Without a sink for the full snapshot, only the changed metrics are collected, but every
+  // counter is still latched.
+  Stats::MockSink* delta_sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(delta_sink);
+  EXPECT_CALL(*delta_sink, acceptsDeltaSnapshots()).WillRepeatedly(Return(true));
+  changed_counter.add(2);
+  EXPECT_CALL(*delta_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "changed_counter");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 2);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, true);
+
+  EXPECT_CALL(*delta_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.counters().empty());
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, true);
+}
+
 TEST(ServerInstanceUtil, RaiseFileLimits) {
   Api::MockOsSysCalls os_sys_calls_;
   TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls{&os_sys_calls_};